@@ -54,4 +54,5 @@ project("AssetPipelineCore")
 	
 	includedirs {
 		path.join(RootPath, "public"),
+		path.join(RootPath, "external"),
 	}
\ No newline at end of file
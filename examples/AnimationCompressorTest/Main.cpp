@@ -0,0 +1,149 @@
+#include "Animation/AnimationCompressor.h"
+#include "Base/Template.h"
+#include "IO/InputArchive.hpp"
+#include "IO/OutputArchive.hpp"
+#include "Scene/Track.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+// Scalar reference interpolation of reduced keys at times of source keys. Times out of key range are clamped.
+template<typename KeyFrameType, typename ErrorFunction>
+float CalculateMaxError(const std::vector<KeyFrameType>& sourceKeys, const std::vector<KeyFrameType>& reducedKeys, ErrorFunction calculateError)
+{
+	float maxError = 0.0f;
+	size_t keyIndex = 0U;
+	for (const KeyFrameType& sourceKey : sourceKeys)
+	{
+		float time = sourceKey.GetTime();
+		while (keyIndex + 1U < reducedKeys.size() && reducedKeys[keyIndex + 1U].GetTime() <= time)
+		{
+			++keyIndex;
+		}
+
+		auto value = reducedKeys[keyIndex].GetValue();
+		if (keyIndex + 1U < reducedKeys.size() && time > reducedKeys[keyIndex].GetTime())
+		{
+			const KeyFrameType& key0 = reducedKeys[keyIndex];
+			const KeyFrameType& key1 = reducedKeys[keyIndex + 1U];
+			float factor = (time - key0.GetTime()) / (key1.GetTime() - key0.GetTime());
+			if constexpr (std::is_same_v<decltype(value), cd::Quaternion>)
+			{
+				value = cd::Quaternion::SLerp(key0.GetValue(), key1.GetValue(), factor);
+			}
+			else
+			{
+				value = cd::Vec3f::Lerp(key0.GetValue(), key1.GetValue(), factor);
+			}
+		}
+
+		maxError = std::max(maxError, calculateError(value, sourceKey.GetValue()));
+	}
+
+	return maxError;
+}
+
+// Displacement of a point at unit distance which is rotated by the difference of two rotations.
+float CalculateRotationError(const cd::Quaternion& a, const cd::Quaternion& b)
+{
+	float cosHalfAngle = std::min(1.0f, std::abs(a.Dot(b)) / (a.Length() * b.Length()));
+	return 2.0f * std::sqrt(1.0f - cosHalfAngle * cosHalfAngle);
+}
+
+float CalculateVectorError(const cd::Vec3f& a, const cd::Vec3f& b)
+{
+	return (a - b).Length();
+}
+
+cd::Track CreateTrack()
+{
+	// 10 seconds at 60 frames per second : a sine wave, a linear ramp which stops, a constant speed rotation and a constant scale.
+	std::vector<cd::TranslationKey> translationKeys;
+	std::vector<cd::RotationKey> rotationKeys;
+	std::vector<cd::ScaleKey> scaleKeys;
+	for (uint32_t keyIndex = 0U; keyIndex < 600U; ++keyIndex)
+	{
+		float time = static_cast<float>(keyIndex) / 60.0f;
+		translationKeys.emplace_back(time, cd::Vec3f(std::sin(time * 3.0f), std::min(time, 5.0f), 0.0f));
+		rotationKeys.emplace_back(time, cd::Quaternion::RotateY(time * 0.7f));
+		scaleKeys.emplace_back(time, cd::Vec3f(1.0f, 1.0f, 1.0f));
+	}
+
+	cd::Track track(cd::TrackID(0U), "Bone");
+	track.SetTranslationKeys(cd::MoveTemp(translationKeys));
+	track.SetRotationKeys(cd::MoveTemp(rotationKeys));
+	track.SetScaleKeys(cd::MoveTemp(scaleKeys));
+	return track;
+}
+
+}
+
+int main()
+{
+	int failedCount = 0;
+	auto Check = [&failedCount](bool condition, const char* pDescription)
+	{
+		printf("%s : %s\n", pDescription, condition ? "passed" : "failed");
+		failedCount += condition ? 0 : 1;
+	};
+
+	const cd::Track sourceTrack = CreateTrack();
+
+	// Key reduction alone must keep errors within the bound.
+	cd::AnimationCompressionOptions options;
+	options.maxError = 0.001f;
+	options.quantize = false;
+	cd::Track reducedTrack = CreateTrack();
+	uint32_t removedKeyCount = cd::AnimationCompressor::Compress(reducedTrack, options);
+	float translationError = CalculateMaxError(sourceTrack.GetTranslationKeys(), reducedTrack.GetTranslationKeys(), CalculateVectorError);
+	float rotationError = CalculateMaxError(sourceTrack.GetRotationKeys(), reducedTrack.GetRotationKeys(), CalculateRotationError);
+	float scaleError = CalculateMaxError(sourceTrack.GetScaleKeys(), reducedTrack.GetScaleKeys(), CalculateVectorError);
+	printf("Reduce keys : removed %u, keys %u / %u / %u, errors %g / %g / %g\n", removedKeyCount, reducedTrack.GetTranslationKeyCount(),
+		reducedTrack.GetRotationKeyCount(), reducedTrack.GetScaleKeyCount(), translationError, rotationError, scaleError);
+	constexpr float FloatTolerance = 1e-5f;
+	Check(removedKeyCount > 0U, "Remove keys");
+	Check(translationError <= options.maxError + FloatTolerance && rotationError <= options.maxError + FloatTolerance &&
+		scaleError <= options.maxError + FloatTolerance, "Errors within the bound");
+
+	// Quantized tracks add small errors and must be serialized exactly as they are in memory.
+	options.quantize = true;
+	cd::Track quantizedTrack = CreateTrack();
+	cd::AnimationCompressor::Compress(quantizedTrack, options);
+	translationError = CalculateMaxError(sourceTrack.GetTranslationKeys(), quantizedTrack.GetTranslationKeys(), CalculateVectorError);
+	rotationError = CalculateMaxError(sourceTrack.GetRotationKeys(), quantizedTrack.GetRotationKeys(), CalculateRotationError);
+	printf("Quantize keys : errors %g / %g\n", translationError, rotationError);
+	Check(quantizedTrack.IsQuantized(), "Quantize track");
+	Check(translationError <= 2.0f * options.maxError && rotationError <= 2.0f * options.maxError, "Quantized errors within twice the bound");
+
+	std::stringstream stream;
+	cd::OutputArchive outputArchive(&stream);
+	quantizedTrack >> outputArchive;
+	cd::InputArchive inputArchive(&stream);
+	cd::Track loadedTrack(inputArchive);
+
+	bool isSame = loadedTrack.IsQuantized() && loadedTrack.GetTranslationKeyCount() == quantizedTrack.GetTranslationKeyCount() &&
+		loadedTrack.GetRotationKeyCount() == quantizedTrack.GetRotationKeyCount() && loadedTrack.GetScaleKeyCount() == quantizedTrack.GetScaleKeyCount();
+	for (uint32_t keyIndex = 0U; isSame && keyIndex < quantizedTrack.GetTranslationKeyCount(); ++keyIndex)
+	{
+		const cd::TranslationKey& loadedKey = loadedTrack.GetTranslationKeys()[keyIndex];
+		const cd::TranslationKey& key = quantizedTrack.GetTranslationKeys()[keyIndex];
+		isSame = loadedKey.GetTime() == key.GetTime() && CalculateVectorError(loadedKey.GetValue(), key.GetValue()) <= FloatTolerance;
+	}
+	for (uint32_t keyIndex = 0U; isSame && keyIndex < quantizedTrack.GetRotationKeyCount(); ++keyIndex)
+	{
+		const cd::RotationKey& loadedKey = loadedTrack.GetRotationKeys()[keyIndex];
+		const cd::RotationKey& key = quantizedTrack.GetRotationKeys()[keyIndex];
+		isSame = loadedKey.GetTime() == key.GetTime() && CalculateRotationError(loadedKey.GetValue(), key.GetValue()) <= FloatTolerance;
+	}
+	printf("Serialized size : %zu bytes\n", stream.str().size());
+	Check(isSame, "Quantized serialization round trip");
+
+	return 0 == failedCount ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include "Image/AtlasPacker.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main()
+{
+	constexpr uint32_t PageSize = 1024U;
+
+	// Random power of two sizes with padding like texture atlas items. The last item doesn't fit in any page.
+	std::mt19937 randomEngine(1);
+	std::vector<cd::AtlasItem> items;
+	uint64_t itemArea = 0U;
+	for (uint32_t itemIndex = 0U; itemIndex < 500U; ++itemIndex)
+	{
+		cd::AtlasItem item;
+		item.width = (16U << (randomEngine() % 5U)) + 8U;
+		item.height = (16U << (randomEngine() % 5U)) + 8U;
+		itemArea += static_cast<uint64_t>(item.width) * item.height;
+		items.push_back(item);
+	}
+	items.push_back(cd::AtlasItem{ PageSize + 1U, 16U });
+
+	std::vector<cd::AtlasPlacement> placements;
+	uint32_t pageCount = cd::AtlasPacker::Pack(PageSize, PageSize, items, placements);
+
+	uint32_t invalidCount = 0U;
+	uint32_t outOfPageCount = 0U;
+	uint32_t overlapCount = 0U;
+	for (size_t itemIndex = 0U; itemIndex + 1U < items.size(); ++itemIndex)
+	{
+		const cd::AtlasItem& item = items[itemIndex];
+		const cd::AtlasPlacement& placement = placements[itemIndex];
+		if (cd::AtlasPlacement::InvalidPage == placement.page || placement.page >= pageCount)
+		{
+			++invalidCount;
+			continue;
+		}
+
+		if (placement.x + item.width > PageSize || placement.y + item.height > PageSize)
+		{
+			++outOfPageCount;
+		}
+
+		// Brute force rectangle intersection against all other items on the same page.
+		for (size_t otherItemIndex = itemIndex + 1U; otherItemIndex + 1U < items.size(); ++otherItemIndex)
+		{
+			const cd::AtlasItem& otherItem = items[otherItemIndex];
+			const cd::AtlasPlacement& otherPlacement = placements[otherItemIndex];
+			if (otherPlacement.page != placement.page)
+			{
+				continue;
+			}
+
+			if (placement.x < otherPlacement.x + otherItem.width && otherPlacement.x < placement.x + item.width &&
+				placement.y < otherPlacement.y + otherItem.height && otherPlacement.y < placement.y + item.height)
+			{
+				++overlapCount;
+			}
+		}
+	}
+
+	bool isOversizeRejected = placements.size() == items.size() && cd::AtlasPlacement::InvalidPage == placements.back().page;
+	double occupancy = pageCount > 0U ? static_cast<double>(itemArea) / (static_cast<double>(pageCount) * PageSize * PageSize) : 0.0;
+	printf("Pack %zu items : %u pages, occupancy %.3f\n", items.size(), pageCount, occupancy);
+	printf("Invalid placements %u, out of page %u, overlaps %u, oversize item rejected %d\n", invalidCount, outOfPageCount, overlapCount, isOversizeRejected);
+
+	bool isPassed = placements.size() == items.size() && 0U == invalidCount && 0U == outOfPageCount && 0U == overlapCount && isOversizeRejected;
+	printf("%s\n", isPassed ? "passed" : "failed");
+	return isPassed ? 0 : 1;
+}
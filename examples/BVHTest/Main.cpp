@@ -0,0 +1,152 @@
+#include "Math/BVHBuilder.h"
+#include "Scene/Mesh.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Moller-Trumbore intersection which is the reference for BVH traversal.
+bool IntersectTriangle(const cd::Ray& ray, const cd::Point& v0, const cd::Point& v1, const cd::Point& v2, float& distance)
+{
+	cd::Direction edge1 = v1 - v0;
+	cd::Direction edge2 = v2 - v0;
+	cd::Direction p = ray.Direction().Cross(edge2);
+	float determinant = edge1.Dot(p);
+	if (std::abs(determinant) < FLT_MIN)
+	{
+		return false;
+	}
+
+	float inverseDeterminant = 1.0f / determinant;
+	cd::Direction s = ray.Origin() - v0;
+	float u = s.Dot(p) * inverseDeterminant;
+	if (u < 0.0f || u > 1.0f)
+	{
+		return false;
+	}
+
+	cd::Direction q = s.Cross(edge1);
+	float v = ray.Direction().Dot(q) * inverseDeterminant;
+	if (v < 0.0f || u + v > 1.0f)
+	{
+		return false;
+	}
+
+	distance = edge2.Dot(q) * inverseDeterminant;
+	return distance >= 0.0f;
+}
+
+}
+
+int main()
+{
+	// Triangle soup of small random triangles.
+	constexpr uint32_t TriangleCount = 20000U;
+	std::mt19937 randomEngine(1);
+	std::uniform_real_distribution<float> centerDistribution(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> offsetDistribution(-2.0f, 2.0f);
+	cd::Mesh mesh(cd::MeshID(0U), "Soup", TriangleCount * 3U, TriangleCount);
+	for (uint32_t triangleIndex = 0U; triangleIndex < TriangleCount; ++triangleIndex)
+	{
+		cd::Point center(centerDistribution(randomEngine), centerDistribution(randomEngine), centerDistribution(randomEngine));
+		for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+		{
+			mesh.SetVertexPosition(triangleIndex * 3U + cornerIndex, cd::Point(center.x() + offsetDistribution(randomEngine),
+				center.y() + offsetDistribution(randomEngine), center.z() + offsetDistribution(randomEngine)));
+		}
+		mesh.SetPolygon(triangleIndex, cd::Polygon(cd::VertexID(triangleIndex * 3U), cd::VertexID(triangleIndex * 3U + 1U), cd::VertexID(triangleIndex * 3U + 2U)));
+	}
+
+	cd::BVHBuildOptions options;
+	cd::BVHBuilder::Build(mesh, options);
+
+	// Structure : children are inside parents, leaves contain their triangles and every triangle is in exactly one leaf.
+	const std::vector<cd::BVHNode>& nodes = mesh.GetBVHNodes();
+	const std::vector<uint32_t>& polygonIndexes = mesh.GetBVHPolygonIndexes();
+	std::vector<uint32_t> polygonReferenceCounts(TriangleCount, 0U);
+	uint32_t structureErrorCount = 0U;
+	for (uint32_t nodeIndex = 0U; nodeIndex < nodes.size(); ++nodeIndex)
+	{
+		const cd::BVHNode& node = nodes[nodeIndex];
+		if (node.IsLeaf())
+		{
+			structureErrorCount += node.primitiveCount > options.maxLeafSize ? 1U : 0U;
+			for (uint32_t index = node.offset; index < node.offset + node.primitiveCount; ++index)
+			{
+				uint32_t polygonIndex = polygonIndexes[index];
+				++polygonReferenceCounts[polygonIndex];
+				for (uint32_t cornerIndex = 0U; cornerIndex < 3U; ++cornerIndex)
+				{
+					const cd::Point& position = mesh.GetVertexPosition(mesh.GetPolygon(polygonIndex)[cornerIndex].Data());
+					structureErrorCount += node.bounds.IsPointInside(position) ? 0U : 1U;
+				}
+			}
+			continue;
+		}
+
+		for (uint32_t childIndex : { nodeIndex + 1U, node.offset })
+		{
+			const cd::AABB& childBounds = nodes[childIndex].bounds;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				structureErrorCount += childBounds.Min()[axis] < node.bounds.Min()[axis] || childBounds.Max()[axis] > node.bounds.Max()[axis] ? 1U : 0U;
+			}
+		}
+	}
+
+	for (uint32_t referenceCount : polygonReferenceCounts)
+	{
+		structureErrorCount += 1U == referenceCount ? 0U : 1U;
+	}
+
+	// Closest hits of random rays must be the same as brute force.
+	constexpr uint32_t RayCount = 500U;
+	uint32_t hitCount = 0U;
+	uint32_t mismatchCount = 0U;
+	std::uniform_real_distribution<float> directionDistribution(-1.0f, 1.0f);
+	for (uint32_t rayIndex = 0U; rayIndex < RayCount; ++rayIndex)
+	{
+		cd::Point origin(centerDistribution(randomEngine), centerDistribution(randomEngine), centerDistribution(randomEngine));
+		cd::Direction direction(directionDistribution(randomEngine), directionDistribution(randomEngine), directionDistribution(randomEngine));
+		direction.Normalize();
+		cd::Ray ray(origin, direction);
+
+		uint32_t hitPolygonIndex;
+		float hitDistance;
+		bool isHit = cd::BVHBuilder::Raycast(mesh, ray, hitPolygonIndex, hitDistance);
+
+		uint32_t referencePolygonIndex = UINT32_MAX;
+		float referenceDistance = FLT_MAX;
+		for (uint32_t polygonIndex = 0U; polygonIndex < TriangleCount; ++polygonIndex)
+		{
+			const cd::Polygon& polygon = mesh.GetPolygon(polygonIndex);
+			float distance;
+			if (IntersectTriangle(ray, mesh.GetVertexPosition(polygon[0].Data()), mesh.GetVertexPosition(polygon[1].Data()),
+				mesh.GetVertexPosition(polygon[2].Data()), distance) && distance < referenceDistance)
+			{
+				referenceDistance = distance;
+				referencePolygonIndex = polygonIndex;
+			}
+		}
+
+		bool isReferenceHit = referencePolygonIndex != UINT32_MAX;
+		hitCount += isReferenceHit ? 1U : 0U;
+		if (isHit != isReferenceHit || (isHit && std::abs(hitDistance - referenceDistance) > 1e-3f * std::max(1.0f, referenceDistance)))
+		{
+			++mismatchCount;
+		}
+	}
+
+	printf("BVH of %u triangles : %zu nodes, structure errors %u\n", TriangleCount, nodes.size(), structureErrorCount);
+	printf("Rays %u : %u hits, mismatches against brute force %u\n", RayCount, hitCount, mismatchCount);
+
+	bool isPassed = 0U == structureErrorCount && 0U == mismatchCount && hitCount > 0U;
+	printf("%s\n", isPassed ? "passed" : "failed");
+	return isPassed ? 0 : 1;
+}
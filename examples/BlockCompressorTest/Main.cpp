@@ -0,0 +1,288 @@
+#include "Image/BlockCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t BlockDimension = 4U;
+constexpr uint32_t BlockPixelCount = BlockDimension * BlockDimension;
+
+// Reference decoders which follow the BCn specification. Decoded blocks are RGBA8 pixels in row-major order.
+using DecodedBlock = uint8_t[BlockPixelCount][4];
+
+void DecodeR5G6B5(uint16_t color, int (&result)[4])
+{
+	uint32_t r = (color >> 11) & 0x1F;
+	uint32_t g = (color >> 5) & 0x3F;
+	uint32_t b = color & 0x1F;
+	result[0] = static_cast<int>((r << 3) | (r >> 2));
+	result[1] = static_cast<int>((g << 2) | (g >> 4));
+	result[2] = static_cast<int>((b << 3) | (b >> 2));
+	result[3] = 255;
+}
+
+void DecodeColorBlock(const uint8_t* pInput, bool allowThreeColorMode, DecodedBlock& block)
+{
+	uint16_t color0 = static_cast<uint16_t>(pInput[0] | (pInput[1] << 8));
+	uint16_t color1 = static_cast<uint16_t>(pInput[2] | (pInput[3] << 8));
+	int palette[4][4];
+	DecodeR5G6B5(color0, palette[0]);
+	DecodeR5G6B5(color1, palette[1]);
+	bool isFourColorMode = !allowThreeColorMode || color0 > color1;
+	for (int i = 0; i < 3; ++i)
+	{
+		palette[2][i] = isFourColorMode ? (2 * palette[0][i] + palette[1][i]) / 3 : (palette[0][i] + palette[1][i]) / 2;
+		palette[3][i] = isFourColorMode ? (palette[0][i] + 2 * palette[1][i]) / 3 : 0;
+	}
+	palette[2][3] = 255;
+	palette[3][3] = isFourColorMode ? 255 : 0;
+
+	uint32_t indices = pInput[4] | (pInput[5] << 8) | (pInput[6] << 16) | (static_cast<uint32_t>(pInput[7]) << 24);
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		uint32_t paletteIndex = (indices >> (pixelIndex * 2U)) & 3U;
+		for (int i = 0; i < 4; ++i)
+		{
+			block[pixelIndex][i] = static_cast<uint8_t>(palette[paletteIndex][i]);
+		}
+	}
+}
+
+void DecodeSingleChannelBlock(const uint8_t* pInput, uint32_t channel, DecodedBlock& block)
+{
+	int palette[8];
+	palette[0] = pInput[0];
+	palette[1] = pInput[1];
+	if (palette[0] > palette[1])
+	{
+		for (int i = 2; i < 8; ++i)
+		{
+			palette[i] = ((8 - i) * palette[0] + (i - 1) * palette[1]) / 7;
+		}
+	}
+	else
+	{
+		for (int i = 2; i < 6; ++i)
+		{
+			palette[i] = ((6 - i) * palette[0] + (i - 1) * palette[1]) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	uint64_t indices = 0U;
+	for (uint32_t i = 0U; i < 6U; ++i)
+	{
+		indices |= static_cast<uint64_t>(pInput[2 + i]) << (i * 8U);
+	}
+
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		block[pixelIndex][channel] = static_cast<uint8_t>(palette[(indices >> (pixelIndex * 3U)) & 7U]);
+	}
+}
+
+uint32_t ReadBits(const uint8_t* pInput, uint32_t& bitOffset, uint32_t bitCount)
+{
+	uint32_t value = 0U;
+	for (uint32_t bitIndex = 0U; bitIndex < bitCount; ++bitIndex, ++bitOffset)
+	{
+		value |= ((pInput[bitOffset >> 3] >> (bitOffset & 7U)) & 1U) << bitIndex;
+	}
+	return value;
+}
+
+// Only mode 6 is decoded. Other modes are reported as failures.
+bool DecodeBC7Block(const uint8_t* pInput, DecodedBlock& block)
+{
+	constexpr int Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	uint32_t bitOffset = 0U;
+	if (ReadBits(pInput, bitOffset, 7U) != (1U << 6))
+	{
+		return false;
+	}
+
+	uint32_t endpoints[2][4];
+	for (uint32_t i = 0U; i < 4U; ++i)
+	{
+		endpoints[0][i] = ReadBits(pInput, bitOffset, 7U);
+		endpoints[1][i] = ReadBits(pInput, bitOffset, 7U);
+	}
+
+	for (uint32_t endpointIndex = 0U; endpointIndex < 2U; ++endpointIndex)
+	{
+		uint32_t pBit = ReadBits(pInput, bitOffset, 1U);
+		for (uint32_t i = 0U; i < 4U; ++i)
+		{
+			endpoints[endpointIndex][i] = (endpoints[endpointIndex][i] << 1) | pBit;
+		}
+	}
+
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		uint32_t weight = Weights[ReadBits(pInput, bitOffset, 0U == pixelIndex ? 3U : 4U)];
+		for (uint32_t i = 0U; i < 4U; ++i)
+		{
+			block[pixelIndex][i] = static_cast<uint8_t>(((64U - weight) * endpoints[0][i] + weight * endpoints[1][i] + 32U) >> 6);
+		}
+	}
+
+	return true;
+}
+
+bool DecodeBlock(cd::TextureFormat format, const uint8_t* pInput, DecodedBlock& block)
+{
+	std::memset(block, 0, sizeof(block));
+	switch (format)
+	{
+	case cd::TextureFormat::BC1:
+		DecodeColorBlock(pInput, true, block);
+		return true;
+	case cd::TextureFormat::BC3:
+		DecodeColorBlock(pInput + 8, false, block);
+		DecodeSingleChannelBlock(pInput, 3U, block);
+		return true;
+	case cd::TextureFormat::BC4:
+		DecodeSingleChannelBlock(pInput, 0U, block);
+		return true;
+	case cd::TextureFormat::BC5:
+		DecodeSingleChannelBlock(pInput, 0U, block);
+		DecodeSingleChannelBlock(pInput + 8, 1U, block);
+		return true;
+	case cd::TextureFormat::BC7:
+		return DecodeBC7Block(pInput, block);
+	default:
+		return false;
+	}
+}
+
+// Returns root mean square error over checked channels and the max absolute error.
+bool MeasureError(cd::TextureFormat format, const std::vector<std::byte>& pixels, uint32_t width, uint32_t height, uint32_t channelCount,
+	double& rootMeanSquareError, int& maxError)
+{
+	std::vector<std::byte> compressedData = cd::BlockCompressor::Compress(format, pixels.data(), width, height);
+	if (compressedData.size() != cd::BlockCompressor::GetCompressedSize(format, width, height))
+	{
+		return false;
+	}
+
+	uint32_t blockCountX = (width + BlockDimension - 1U) / BlockDimension;
+	uint32_t blockCountY = (height + BlockDimension - 1U) / BlockDimension;
+	uint32_t blockByteSize = cd::BlockCompressor::GetBlockByteSize(format);
+	const auto* pRGBA8 = reinterpret_cast<const uint8_t*>(pixels.data());
+	const auto* pCompressedData = reinterpret_cast<const uint8_t*>(compressedData.data());
+
+	double squareErrorSum = 0.0;
+	maxError = 0;
+	for (uint32_t blockY = 0U; blockY < blockCountY; ++blockY)
+	{
+		for (uint32_t blockX = 0U; blockX < blockCountX; ++blockX)
+		{
+			DecodedBlock block;
+			if (!DecodeBlock(format, pCompressedData + (static_cast<size_t>(blockY) * blockCountX + blockX) * blockByteSize, block))
+			{
+				return false;
+			}
+
+			// Border pixels out of the image are replicated by the compressor and are not checked.
+			for (uint32_t y = 0U; y < BlockDimension && blockY * BlockDimension + y < height; ++y)
+			{
+				for (uint32_t x = 0U; x < BlockDimension && blockX * BlockDimension + x < width; ++x)
+				{
+					const uint8_t* pSource = pRGBA8 + (static_cast<size_t>(blockY * BlockDimension + y) * width + blockX * BlockDimension + x) * 4U;
+					for (uint32_t i = 0U; i < channelCount; ++i)
+					{
+						int error = std::abs(static_cast<int>(block[y * BlockDimension + x][i]) - static_cast<int>(pSource[i]));
+						squareErrorSum += static_cast<double>(error * error);
+						maxError = std::max(maxError, error);
+					}
+				}
+			}
+		}
+	}
+
+	rootMeanSquareError = std::sqrt(squareErrorSum / (static_cast<double>(width) * height * channelCount));
+	return true;
+}
+
+}
+
+int main()
+{
+	// Smooth gradients with mild noise which are typical for textures. Size isn't multiple of 4 to cover border blocks.
+	// Alpha stays above 128 so that BC1 keeps all pixels opaque.
+	constexpr uint32_t Width = 62U;
+	constexpr uint32_t Height = 46U;
+	std::mt19937 randomEngine(1);
+	std::uniform_int_distribution<int> noise(-6, 6);
+	std::vector<std::byte> pixels(static_cast<size_t>(Width) * Height * 4U);
+	for (uint32_t y = 0U; y < Height; ++y)
+	{
+		for (uint32_t x = 0U; x < Width; ++x)
+		{
+			int values[4] = { static_cast<int>(x * 255U / Width), static_cast<int>(y * 255U / Height),
+				static_cast<int>(128.0 + 100.0 * std::sin(0.2 * x + 0.1 * y)), static_cast<int>(160U + (x + y) * 95U / (Width + Height)) };
+			for (uint32_t i = 0U; i < 4U; ++i)
+			{
+				pixels[(static_cast<size_t>(y) * Width + x) * 4U + i] = static_cast<std::byte>(std::clamp(values[i] + noise(randomEngine), 0, 255));
+			}
+		}
+	}
+
+	struct FormatCase
+	{
+		cd::TextureFormat format;
+		const char* pName;
+		uint32_t channelCount;
+		double maxRootMeanSquareError;
+	};
+
+	constexpr FormatCase FormatCases[] = {
+		{ cd::TextureFormat::BC1, "BC1", 3U, 8.0 },
+		{ cd::TextureFormat::BC3, "BC3", 4U, 8.0 },
+		{ cd::TextureFormat::BC4, "BC4", 1U, 5.0 },
+		{ cd::TextureFormat::BC5, "BC5", 2U, 5.0 },
+		{ cd::TextureFormat::BC7, "BC7", 4U, 6.0 },
+	};
+
+	int failedCount = 0;
+	for (const FormatCase& formatCase : FormatCases)
+	{
+		double rootMeanSquareError;
+		int maxError;
+		bool isDecoded = MeasureError(formatCase.format, pixels, Width, Height, formatCase.channelCount, rootMeanSquareError, maxError);
+		bool isPassed = isDecoded && rootMeanSquareError <= formatCase.maxRootMeanSquareError;
+		printf("%s gradients : rmse %.3f, max error %d, %s\n", formatCase.pName, isDecoded ? rootMeanSquareError : -1.0, maxError, isPassed ? "passed" : "failed");
+		failedCount += isPassed ? 0 : 1;
+	}
+
+	// Two colors whose difference is orthogonal to (1, 1, 1) must still be distinguished.
+	std::vector<std::byte> twoColorPixels(BlockPixelCount * 4U);
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		bool isRed = 0U != (pixelIndex & 1U);
+		twoColorPixels[pixelIndex * 4U + 0U] = static_cast<std::byte>(isRed ? 255 : 0);
+		twoColorPixels[pixelIndex * 4U + 1U] = static_cast<std::byte>(isRed ? 0 : 255);
+		twoColorPixels[pixelIndex * 4U + 2U] = static_cast<std::byte>(0);
+		twoColorPixels[pixelIndex * 4U + 3U] = static_cast<std::byte>(255);
+	}
+
+	for (cd::TextureFormat format : { cd::TextureFormat::BC1, cd::TextureFormat::BC7 })
+	{
+		double rootMeanSquareError;
+		int maxError;
+		bool isDecoded = MeasureError(format, twoColorPixels, BlockDimension, BlockDimension, 3U, rootMeanSquareError, maxError);
+		bool isPassed = isDecoded && maxError <= 4;
+		printf("%s red and green block : max error %d, %s\n", cd::TextureFormat::BC1 == format ? "BC1" : "BC7", maxError, isPassed ? "passed" : "failed");
+		failedCount += isPassed ? 0 : 1;
+	}
+
+	return 0 == failedCount ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include "Base/Template.h"
+#include "Scene/Mesh.h"
+#include "Scene/Morph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+size_t GetSerializedSize(const cd::Morph& morph)
+{
+	std::stringstream stream;
+	cd::OutputArchive outputArchive(&stream);
+	morph >> outputArchive;
+	return stream.str().size();
+}
+
+}
+
+int main()
+{
+	int failedCount = 0;
+	auto Check = [&failedCount](bool condition, const char* pDescription)
+	{
+		printf("%s : %s\n", pDescription, condition ? "passed" : "failed");
+		failedCount += condition ? 0 : 1;
+	};
+
+	// Dense morph which moves positions and normals of every 20th vertex. Tangents and bitangents never change.
+	constexpr uint32_t VertexCount = 20000U;
+	cd::Morph morph(cd::MorphID(3U), "Smile", VertexCount);
+	morph.SetWeight(0.5f);
+	for (uint32_t vertexIndex = 0U; vertexIndex < VertexCount; ++vertexIndex)
+	{
+		bool isMoved = 0U == vertexIndex % 20U;
+		morph.SetVertexSourceID(vertexIndex, vertexIndex);
+		morph.SetVertexPosition(vertexIndex, isMoved ? cd::Point(0.01f * std::sin(static_cast<float>(vertexIndex)), 0.02f, 0.0f) : cd::Point(0.0f, 0.0f, 0.0f));
+		morph.SetVertexNormal(vertexIndex, isMoved ? cd::Direction(0.0f, 0.1f, 0.0f) : cd::Direction(0.0f, 0.0f, 0.0f));
+		morph.SetVertexTangent(vertexIndex, cd::Direction(0.0f, 0.0f, 0.0f));
+		morph.SetVertexBiTangent(vertexIndex, cd::Direction(0.0f, 0.0f, 0.0f));
+	}
+
+	size_t denseSize = GetSerializedSize(morph);
+	uint32_t removedVertexCount = morph.RemoveUnchangedVertices(1e-5f);
+	printf("Remove unchanged vertices : removed %u, left %u, %zu -> %zu bytes\n", removedVertexCount, morph.GetVertexCount(), denseSize, GetSerializedSize(morph));
+	bool isSourceIDKept = true;
+	for (uint32_t vertexIndex = 0U; vertexIndex < morph.GetVertexCount(); ++vertexIndex)
+	{
+		isSourceIDKept = isSourceIDKept && morph.GetVertexSourceID(vertexIndex).Data() == vertexIndex * 20U;
+	}
+	Check(VertexCount / 20U == morph.GetVertexCount() && isSourceIDKept, "Keep changed vertices with their source IDs");
+	Check(morph.GetVertexNormals().size() == morph.GetVertexCount() && morph.GetVertexTangents().empty() && morph.GetVertexBiTangents().empty(),
+		"Drop unchanged channels");
+
+	// Quantization error is within one 16 bits step of the largest delta. Rounding makes it half a step plus float error.
+	std::vector<cd::Point> positions = morph.GetVertexPositions();
+	morph.Quantize();
+	float maxQuantizationError = 0.0f;
+	for (uint32_t vertexIndex = 0U; vertexIndex < morph.GetVertexCount(); ++vertexIndex)
+	{
+		for (int componentIndex = 0; componentIndex < 3; ++componentIndex)
+		{
+			maxQuantizationError = std::max(maxQuantizationError, std::abs(morph.GetVertexPosition(vertexIndex)[componentIndex] - positions[vertexIndex][componentIndex]));
+		}
+	}
+	printf("Quantize : error %g, %zu bytes\n", maxQuantizationError, GetSerializedSize(morph));
+	Check(morph.IsQuantized() && maxQuantizationError <= 0.02f / 32767.0f, "Quantization error within a step");
+
+	// Quantized morphs are loaded exactly as they are in memory.
+	std::stringstream stream;
+	cd::OutputArchive outputArchive(&stream);
+	morph >> outputArchive;
+	cd::InputArchive inputArchive(&stream);
+	cd::Morph loadedMorph(inputArchive);
+	bool isSame = loadedMorph.GetID().Data() == morph.GetID().Data() && loadedMorph.GetWeight() == morph.GetWeight() && loadedMorph.IsQuantized() &&
+		loadedMorph.GetVertexCount() == morph.GetVertexCount() && loadedMorph.GetVertexNormals().size() == morph.GetVertexNormals().size() &&
+		loadedMorph.GetVertexTangents().empty() && loadedMorph.GetVertexBiTangents().empty();
+	for (uint32_t vertexIndex = 0U; isSame && vertexIndex < morph.GetVertexCount(); ++vertexIndex)
+	{
+		isSame = loadedMorph.GetVertexSourceID(vertexIndex).Data() == morph.GetVertexSourceID(vertexIndex).Data() &&
+			(loadedMorph.GetVertexPosition(vertexIndex) - morph.GetVertexPosition(vertexIndex)).Length() <= 1e-7f &&
+			(loadedMorph.GetVertexNormal(vertexIndex) - morph.GetVertexNormal(vertexIndex)).Length() <= 1e-7f;
+	}
+	Check(isSame, "Quantized serialization round trip");
+
+	// Remapping mesh vertices duplicates and removes morph vertices, keeps dropped channels empty and erases morphs without vertices.
+	cd::Mesh mesh(cd::MeshID(0U), "Mesh", 4U, 1U);
+	cd::Morph sparseMorph(cd::MorphID(0U), "Sparse", 2U);
+	sparseMorph.SetVertexSourceID(0U, 1U);
+	sparseMorph.SetVertexSourceID(1U, 3U);
+	sparseMorph.SetVertexPosition(0U, cd::Point(1.0f, 0.0f, 0.0f));
+	sparseMorph.SetVertexPosition(1U, cd::Point(0.0f, 2.0f, 0.0f));
+	sparseMorph.RemoveUnchangedVertices(1e-5f);
+	cd::Morph removedMorph(cd::MorphID(1U), "Removed", 1U);
+	removedMorph.SetVertexSourceID(0U, 2U);
+	removedMorph.SetVertexPosition(0U, cd::Point(1.0f, 1.0f, 1.0f));
+	mesh.GetMorphs().push_back(cd::MoveTemp(sparseMorph));
+	mesh.GetMorphs().push_back(cd::MoveTemp(removedMorph));
+	mesh.RemapVertices({ 0U, 1U, 1U, 3U });
+
+	bool isRemapped = 1U == mesh.GetMorphCount() && 3U == mesh.GetMorph(0U).GetVertexCount() && mesh.GetMorph(0U).GetVertexNormals().empty();
+	if (isRemapped)
+	{
+		const cd::Morph& remappedMorph = mesh.GetMorph(0U);
+		const uint32_t expectedSourceIDs[] = { 1U, 2U, 3U };
+		const float expectedDeltas[] = { 1.0f, 1.0f, 2.0f };
+		for (uint32_t vertexIndex = 0U; vertexIndex < 3U; ++vertexIndex)
+		{
+			const cd::Point& position = remappedMorph.GetVertexPosition(vertexIndex);
+			isRemapped = isRemapped && remappedMorph.GetVertexSourceID(vertexIndex).Data() == expectedSourceIDs[vertexIndex] &&
+				std::max(position.x(), position.y()) == expectedDeltas[vertexIndex];
+		}
+	}
+	Check(isRemapped, "Remap morph vertices");
+
+	return 0 == failedCount ? 0 : 1;
+}
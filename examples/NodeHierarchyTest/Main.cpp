@@ -0,0 +1,155 @@
+#include "Base/Template.h"
+#include "Scene/NodeHierarchy.h"
+#include "Scene/SceneDatabase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+// Scalar reference which multiplies Transform::GetMatrix of all ancestors recursively. Nodes are indexed by IDs.
+const cd::Matrix4x4& CalculateWorldMatrix(const cd::SceneDatabase& sceneDatabase, uint32_t nodeID, std::vector<cd::Matrix4x4>& worldMatrices,
+	std::vector<bool>& isSolved)
+{
+	if (!isSolved[nodeID])
+	{
+		const cd::Node& node = sceneDatabase.GetNode(nodeID);
+		cd::Matrix4x4 localMatrix = node.GetTransform().GetMatrix();
+		worldMatrices[nodeID] = node.GetParentID().IsValid() ?
+			CalculateWorldMatrix(sceneDatabase, node.GetParentID().Data(), worldMatrices, isSolved) * localMatrix : localMatrix;
+		isSolved[nodeID] = true;
+	}
+
+	return worldMatrices[nodeID];
+}
+
+// Relative difference which tolerates float rounding of long matrix chains.
+float CalculateMatrixError(const cd::Matrix4x4& a, const cd::Matrix4x4& b)
+{
+	float maxError = 0.0f;
+	for (int elementIndex = 0; elementIndex < 16; ++elementIndex)
+	{
+		float error = std::abs(a.Data(elementIndex) - b.Data(elementIndex)) / (1.0f + std::abs(b.Data(elementIndex)));
+		maxError = std::max(maxError, error);
+	}
+
+	return maxError;
+}
+
+float CalculateMaxError(const cd::SceneDatabase& sceneDatabase, const cd::NodeHierarchy& nodeHierarchy)
+{
+	std::vector<cd::Matrix4x4> worldMatrices(sceneDatabase.GetNodeCount());
+	std::vector<bool> isSolved(sceneDatabase.GetNodeCount(), false);
+	float maxError = 0.0f;
+	for (uint32_t nodeID = 0U; nodeID < sceneDatabase.GetNodeCount(); ++nodeID)
+	{
+		const cd::Matrix4x4& worldMatrix = nodeHierarchy.GetWorldMatrices()[nodeHierarchy.GetNodeIndex(nodeID)];
+		maxError = std::max(maxError, CalculateMatrixError(worldMatrix, CalculateWorldMatrix(sceneDatabase, nodeID, worldMatrices, isSolved)));
+	}
+
+	return maxError;
+}
+
+}
+
+int main()
+{
+	int failedCount = 0;
+	auto Check = [&failedCount](bool condition, const char* pDescription)
+	{
+		printf("%s : %s\n", pDescription, condition ? "passed" : "failed");
+		failedCount += condition ? 0 : 1;
+	};
+
+	// Random tree whose node IDs are in reverse order of depth so that parents have larger IDs than children.
+	constexpr uint32_t NodeCount = 5000U;
+	std::mt19937 randomEngine(3);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	auto RandomTransform = [&randomEngine, &distribution]()
+	{
+		cd::Vec3f axis(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+		axis.Normalize();
+		return cd::Transform(cd::Vec3f(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)),
+			cd::Quaternion::FromAxisAngle(axis, distribution(randomEngine) * 3.0f),
+			cd::Vec3f(1.0f + 0.05f * distribution(randomEngine), 1.0f + 0.05f * distribution(randomEngine), 1.0f + 0.05f * distribution(randomEngine)));
+	};
+
+	std::vector<cd::Node> nodes;
+	for (uint32_t nodeIndex = 0U; nodeIndex < NodeCount; ++nodeIndex)
+	{
+		cd::Node node(cd::NodeID(NodeCount - 1U - nodeIndex), "Node");
+		if (nodeIndex > 0U)
+		{
+			node.SetParentID(NodeCount - 1U - randomEngine() % nodeIndex);
+		}
+		node.SetTransform(RandomTransform());
+		nodes.push_back(cd::MoveTemp(node));
+	}
+
+	// Scene nodes are indexed by IDs.
+	std::reverse(nodes.begin(), nodes.end());
+	cd::SceneDatabase sceneDatabase;
+	for (cd::Node& node : nodes)
+	{
+		sceneDatabase.AddNode(cd::MoveTemp(node));
+	}
+
+	cd::NodeHierarchy nodeHierarchy(sceneDatabase.GetNodes());
+	bool isParentFirst = NodeCount == nodeHierarchy.GetNodeCount();
+	for (uint32_t nodeIndex = 0U; isParentFirst && nodeIndex < nodeHierarchy.GetNodeCount(); ++nodeIndex)
+	{
+		uint32_t parentIndex = nodeHierarchy.GetParentIndexes()[nodeIndex];
+		const cd::Node& node = sceneDatabase.GetNode(nodeHierarchy.GetNodeIDs()[nodeIndex]);
+		uint32_t expectedParentIndex = node.GetParentID().IsValid() ? nodeHierarchy.GetNodeIndex(node.GetParentID().Data()) : cd::NodeHierarchy::InvalidIndex;
+		isParentFirst = parentIndex == expectedParentIndex && (cd::NodeHierarchy::InvalidIndex == parentIndex || parentIndex < nodeIndex);
+	}
+	Check(isParentFirst, "Parents before children");
+
+	constexpr float MaxError = 1e-5f;
+	float worldMatrixError = CalculateMaxError(sceneDatabase, nodeHierarchy);
+	printf("Nodes %u : world matrix error %g\n", nodeHierarchy.GetNodeCount(), worldMatrixError);
+	Check(worldMatrixError <= MaxError, "World matrices against Transform::GetMatrix chains");
+
+	// Changed local transforms affect all descendants after updating.
+	for (uint32_t nodeID = NodeCount - 1U; nodeID > NodeCount - 100U; --nodeID)
+	{
+		cd::Transform transform = RandomTransform();
+		sceneDatabase.GetNodes()[nodeID].SetTransform(transform);
+		nodeHierarchy.SetLocalTransform(nodeHierarchy.GetNodeIndex(nodeID), transform);
+	}
+	nodeHierarchy.UpdateWorldMatrices();
+	float updatedWorldMatrixError = CalculateMaxError(sceneDatabase, nodeHierarchy);
+	printf("Update local transforms : world matrix error %g\n", updatedWorldMatrixError);
+	Check(updatedWorldMatrixError <= MaxError, "Update world matrices");
+
+	// Scene serialization keeps the hierarchy as it is in memory.
+	sceneDatabase.GetNodeHierarchy() = nodeHierarchy;
+	std::stringstream stream;
+	cd::OutputArchive outputArchive(&stream);
+	sceneDatabase >> outputArchive;
+	cd::InputArchive inputArchive(&stream);
+	cd::SceneDatabase loadedSceneDatabase;
+	loadedSceneDatabase << inputArchive;
+
+	const cd::NodeHierarchy& loadedNodeHierarchy = loadedSceneDatabase.GetNodeHierarchy();
+	bool isSame = loadedNodeHierarchy.GetNodeCount() == nodeHierarchy.GetNodeCount();
+	for (uint32_t nodeIndex = 0U; isSame && nodeIndex < nodeHierarchy.GetNodeCount(); ++nodeIndex)
+	{
+		uint32_t nodeID = nodeHierarchy.GetNodeIDs()[nodeIndex];
+		cd::Transform loadedTransform = loadedNodeHierarchy.GetLocalTransform(nodeIndex);
+		cd::Transform transform = nodeHierarchy.GetLocalTransform(nodeIndex);
+		isSame = loadedNodeHierarchy.GetNodeIDs()[nodeIndex] == nodeID && loadedNodeHierarchy.GetNodeIndex(nodeID) == nodeIndex &&
+			loadedNodeHierarchy.GetParentIndexes()[nodeIndex] == nodeHierarchy.GetParentIndexes()[nodeIndex] &&
+			0 == std::memcmp(&loadedTransform, &transform, sizeof(cd::Transform)) &&
+			0 == std::memcmp(&loadedNodeHierarchy.GetWorldMatrices()[nodeIndex], &nodeHierarchy.GetWorldMatrices()[nodeIndex], sizeof(cd::Matrix4x4));
+	}
+	Check(isSame, "Serialization round trip");
+
+	return 0 == failedCount ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+#include "Animation/PoseEvaluator.h"
+#include "Base/Template.h"
+#include "Scene/SceneDatabase.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+// Scalar reference which searches keys linearly and interpolates them by Vec3f::Lerp and Quaternion::SLerp.
+// Times out of key range are clamped and empty channels return identity values.
+template<typename KeyFrameType, typename ValueType>
+ValueType SampleReference(const std::vector<KeyFrameType>& keys, float time, const ValueType& identity)
+{
+	if (keys.empty())
+	{
+		return identity;
+	}
+
+	if (time <= keys.front().GetTime())
+	{
+		return keys.front().GetValue();
+	}
+
+	if (time >= keys.back().GetTime())
+	{
+		return keys.back().GetValue();
+	}
+
+	size_t keyIndex = 0U;
+	while (keys[keyIndex + 1U].GetTime() <= time)
+	{
+		++keyIndex;
+	}
+
+	const KeyFrameType& key0 = keys[keyIndex];
+	const KeyFrameType& key1 = keys[keyIndex + 1U];
+	float factor = (time - key0.GetTime()) / (key1.GetTime() - key0.GetTime());
+	if constexpr (std::is_same_v<ValueType, cd::Quaternion>)
+	{
+		return cd::Quaternion::SLerp(key0.GetValue(), key1.GetValue(), factor);
+	}
+	else
+	{
+		return cd::Vec3f::Lerp(key0.GetValue(), key1.GetValue(), factor);
+	}
+}
+
+// Relative difference which tolerates float rounding of long matrix chains.
+float CalculateMatrixError(const cd::Matrix4x4& a, const cd::Matrix4x4& b)
+{
+	float maxError = 0.0f;
+	for (int elementIndex = 0; elementIndex < 16; ++elementIndex)
+	{
+		float error = std::abs(a.Data(elementIndex) - b.Data(elementIndex)) / std::max(1.0f, std::abs(b.Data(elementIndex)));
+		maxError = std::max(maxError, error);
+	}
+
+	return maxError;
+}
+
+}
+
+int main()
+{
+	int failedCount = 0;
+	auto Check = [&failedCount](bool condition, const char* pDescription)
+	{
+		printf("%s : %s\n", pDescription, condition ? "passed" : "failed");
+		failedCount += condition ? 0 : 1;
+	};
+
+	// Random skeleton whose bones are added in reverse order so that parents are after children in the scene.
+	constexpr uint32_t BoneCount = 60U;
+	std::mt19937 randomEngine(5);
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+	auto RandomVector = [&randomEngine, &distribution]() { return cd::Vec3f(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)); };
+	auto RandomRotation = [&randomEngine, &distribution, &RandomVector]()
+	{
+		cd::Vec3f axis = RandomVector();
+		axis.Normalize();
+		return cd::Quaternion::FromAxisAngle(axis, distribution(randomEngine) * 3.1f);
+	};
+
+	std::vector<uint32_t> parentBoneIDs(BoneCount, cd::PoseEvaluator::InvalidIndex);
+	for (uint32_t boneID = 1U; boneID < BoneCount; ++boneID)
+	{
+		parentBoneIDs[boneID] = randomEngine() % boneID;
+	}
+
+	cd::SceneDatabase sceneDatabase;
+	for (uint32_t boneIndex = 0U; boneIndex < BoneCount; ++boneIndex)
+	{
+		uint32_t boneID = BoneCount - 1U - boneIndex;
+		cd::Bone bone(cd::BoneID(boneID), "Bone" + std::to_string(boneID));
+		if (parentBoneIDs[boneID] != cd::PoseEvaluator::InvalidIndex)
+		{
+			bone.SetParentID(parentBoneIDs[boneID]);
+		}
+		bone.SetTransform(cd::Transform(RandomVector(), RandomRotation(), cd::Vec3f::One()));
+		bone.SetOffset(cd::Transform(RandomVector(), RandomRotation(), cd::Vec3f::One()).GetMatrix());
+		sceneDatabase.AddBone(cd::MoveTemp(bone));
+	}
+
+	// Every second bone is animated. Channels have keys at different times and only some tracks have scale keys.
+	cd::Animation animation(cd::AnimationID(0U), "Animation");
+	for (uint32_t boneID = 0U; boneID < BoneCount; boneID += 2U)
+	{
+		std::vector<cd::TranslationKey> translationKeys;
+		std::vector<cd::RotationKey> rotationKeys;
+		std::vector<cd::ScaleKey> scaleKeys;
+		for (uint32_t keyIndex = 0U; keyIndex < 20U; ++keyIndex)
+		{
+			float time = static_cast<float>(keyIndex);
+			rotationKeys.emplace_back(time, RandomRotation());
+			translationKeys.emplace_back(time + 0.3f, RandomVector());
+			if (0U == boneID % 4U)
+			{
+				scaleKeys.emplace_back(time, cd::Vec3f(1.0f + 0.5f * distribution(randomEngine), 1.0f, 1.0f));
+			}
+		}
+
+		cd::Track track(cd::TrackID(sceneDatabase.GetTrackCount()), "Bone" + std::to_string(boneID));
+		track.SetTranslationKeys(cd::MoveTemp(translationKeys));
+		track.SetRotationKeys(cd::MoveTemp(rotationKeys));
+		track.SetScaleKeys(cd::MoveTemp(scaleKeys));
+		animation.AddBoneTrackID(track.GetID().Data());
+		sceneDatabase.AddTrack(cd::MoveTemp(track));
+	}
+
+	cd::PoseEvaluator poseEvaluator(sceneDatabase, &animation);
+	printf("Bones %u, animated bones %u\n", poseEvaluator.GetBoneCount(), poseEvaluator.GetAnimatedBoneCount());
+	Check(BoneCount == poseEvaluator.GetBoneCount() && BoneCount / 2U == poseEvaluator.GetAnimatedBoneCount(), "Bind tracks by bone names");
+
+	bool isParentFirst = true;
+	for (uint32_t boneIndex = 0U; boneIndex < poseEvaluator.GetBoneCount(); ++boneIndex)
+	{
+		uint32_t parentIndex = poseEvaluator.GetParentIndexes()[boneIndex];
+		uint32_t boneID = poseEvaluator.GetBoneIDs()[boneIndex];
+		uint32_t expectedParentIndex = poseEvaluator.GetBoneIndex(parentBoneIDs[boneID]);
+		isParentFirst = isParentFirst && parentIndex == expectedParentIndex && (cd::PoseEvaluator::InvalidIndex == parentIndex || parentIndex < boneIndex);
+	}
+	Check(isParentFirst, "Parents before children");
+
+	// Scalar reference : local transforms from scalar interpolation and world matrices from recursive Transform::GetMatrix chains.
+	float maxRotationError = 0.0f;
+	float maxTranslationError = 0.0f;
+	float maxWorldMatrixError = 0.0f;
+	float maxSkinningMatrixError = 0.0f;
+	std::vector<cd::Transform> localTransforms;
+	std::vector<cd::Matrix4x4> worldMatrices;
+	std::vector<cd::Matrix4x4> skinningMatrices;
+	std::vector<cd::Matrix4x4> referenceWorldMatrices(BoneCount);
+	for (float time = -1.0f; time < 21.0f; time += 0.037f)
+	{
+		poseEvaluator.SampleLocalTransforms(time, localTransforms);
+		poseEvaluator.SolveWorldMatrices(localTransforms, worldMatrices);
+		poseEvaluator.CalculateSkinningMatrices(worldMatrices, skinningMatrices);
+
+		for (uint32_t boneIndex = 0U; boneIndex < poseEvaluator.GetBoneCount(); ++boneIndex)
+		{
+			uint32_t boneID = poseEvaluator.GetBoneIDs()[boneIndex];
+			// Bones are stored in reverse order of IDs.
+			const cd::Bone& bone = sceneDatabase.GetBone(BoneCount - 1U - boneID);
+			cd::Transform localTransform = bone.GetTransform();
+			if (0U == boneID % 2U)
+			{
+				const cd::Track& track = sceneDatabase.GetTrack(boneID / 2U);
+				localTransform = cd::Transform(SampleReference(track.GetTranslationKeys(), time, cd::Vec3f::Zero()),
+					SampleReference(track.GetRotationKeys(), time, cd::Quaternion::Identity()), SampleReference(track.GetScaleKeys(), time, cd::Vec3f::One()));
+			}
+
+			const cd::Transform& sampledTransform = localTransforms[boneIndex];
+			float rotationError = 1.0f - std::min(1.0f, std::abs(sampledTransform.GetRotation().Dot(localTransform.GetRotation())));
+			maxRotationError = std::max(maxRotationError, rotationError);
+			maxTranslationError = std::max(maxTranslationError, (sampledTransform.GetTranslation() - localTransform.GetTranslation()).Length());
+
+			uint32_t parentIndex = poseEvaluator.GetParentIndexes()[boneIndex];
+			referenceWorldMatrices[boneIndex] = cd::PoseEvaluator::InvalidIndex == parentIndex ? localTransform.GetMatrix() :
+				referenceWorldMatrices[parentIndex] * localTransform.GetMatrix();
+			maxWorldMatrixError = std::max(maxWorldMatrixError, CalculateMatrixError(worldMatrices[boneIndex], referenceWorldMatrices[boneIndex]));
+
+			cd::Matrix4x4 referenceSkinningMatrix = referenceWorldMatrices[boneIndex] * bone.GetOffset();
+			maxSkinningMatrixError = std::max(maxSkinningMatrixError, CalculateMatrixError(skinningMatrices[boneID], referenceSkinningMatrix));
+		}
+	}
+
+	printf("Errors : rotation %g, translation %g, world matrix %g, skinning matrix %g\n", maxRotationError, maxTranslationError,
+		maxWorldMatrixError, maxSkinningMatrixError);
+	constexpr float MaxError = 1e-4f;
+	Check(maxRotationError <= MaxError && maxTranslationError <= MaxError, "Local transforms against scalar interpolation");
+	Check(maxWorldMatrixError <= MaxError, "World matrices against Transform::GetMatrix chains");
+	Check(maxSkinningMatrixError <= MaxError, "Skinning matrices indexed by bone IDs");
+
+	return 0 == failedCount ? 0 : 1;
+}
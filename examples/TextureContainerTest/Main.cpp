@@ -0,0 +1,79 @@
+#include "Image/TextureContainer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+int main()
+{
+	// 2 layers of a 8x4 RGBA8 texture with 3 mips. Every byte has a different value in one layer so that misplaced levels are detected.
+	cd::TextureContainerHeader header;
+	header.format = cd::TextureFormat::RGBA8;
+	header.width = 8U;
+	header.height = 4U;
+	header.layerCount = 2U;
+	header.mipCount = 3U;
+
+	const std::vector<uint64_t> mipOffsets = { 0U, 8U * 4U * 4U, 8U * 4U * 4U + 4U * 2U * 4U };
+	const std::vector<uint64_t> mipSizes = { 8U * 4U * 4U, 4U * 2U * 4U, 2U * 1U * 4U };
+	uint64_t layerSize = mipOffsets.back() + mipSizes.back();
+	std::vector<std::byte> rawData(layerSize * header.layerCount);
+	for (size_t byteIndex = 0U; byteIndex < rawData.size(); ++byteIndex)
+	{
+		rawData[byteIndex] = static_cast<std::byte>(byteIndex * 7U + 3U);
+	}
+
+	std::vector<std::byte> container = cd::TextureContainer::Build(header, rawData.data(), rawData.size(), mipOffsets);
+
+	int failedCount = 0;
+	auto Check = [&failedCount](bool condition, const char* pDescription)
+	{
+		printf("%s : %s\n", pDescription, condition ? "passed" : "failed");
+		failedCount += condition ? 0 : 1;
+	};
+
+	// Only header bytes are given to ReadHeader as streaming runtime does.
+	uint64_t headerSize = cd::TextureContainer::GetHeaderSize(header.mipCount, header.layerCount);
+	cd::TextureContainerHeader readHeader;
+	std::vector<cd::TextureContainerLevel> levels;
+	bool isHeaderRead = container.size() >= headerSize && cd::TextureContainer::ReadHeader(container.data(), headerSize, readHeader, levels);
+	Check(isHeaderRead, "Read header");
+	if (!isHeaderRead)
+	{
+		return 1;
+	}
+
+	Check(readHeader.format == header.format && readHeader.width == header.width && readHeader.height == header.height &&
+		readHeader.depth == header.depth && readHeader.layerCount == header.layerCount && readHeader.mipCount == header.mipCount, "Header round trip");
+	Check(levels.size() == static_cast<size_t>(header.mipCount) * header.layerCount, "Level count");
+
+	bool isLevelDataSame = true;
+	bool isAligned = true;
+	bool isSmallestMipFirst = true;
+	for (uint32_t mipLevel = 0U; mipLevel < header.mipCount; ++mipLevel)
+	{
+		for (uint32_t layer = 0U; layer < header.layerCount; ++layer)
+		{
+			const cd::TextureContainerLevel& level = levels[mipLevel * header.layerCount + layer];
+			isAligned = isAligned && 0U == level.offset % cd::TextureContainer::LevelAlignment && level.offset >= headerSize;
+			isLevelDataSame = isLevelDataSame && level.size == mipSizes[mipLevel] && level.offset + level.size <= container.size() &&
+				0 == std::memcmp(container.data() + level.offset, rawData.data() + layer * layerSize + mipOffsets[mipLevel], mipSizes[mipLevel]);
+			if (mipLevel > 0U)
+			{
+				isSmallestMipFirst = isSmallestMipFirst && level.offset < levels[(mipLevel - 1U) * header.layerCount + layer].offset;
+			}
+		}
+	}
+	Check(isLevelDataSame, "Level data round trip");
+	Check(isAligned, "Level alignment");
+	Check(isSmallestMipFirst, "Smaller mips are stored first");
+
+	// Truncated or corrupted headers are rejected.
+	Check(!cd::TextureContainer::ReadHeader(container.data(), headerSize - 1U, readHeader, levels), "Reject truncated level table");
+	Check(!cd::TextureContainer::ReadFixedHeader(container.data(), cd::TextureContainer::FixedHeaderSize - 1U, readHeader), "Reject truncated fixed header");
+	std::vector<std::byte> corruptedContainer = container;
+	corruptedContainer[0] = static_cast<std::byte>(~static_cast<uint8_t>(corruptedContainer[0]));
+	Check(!cd::TextureContainer::ReadFixedHeader(corruptedContainer.data(), corruptedContainer.size(), readHeader), "Reject wrong magic");
+
+	return 0 == failedCount ? 0 : 1;
+}
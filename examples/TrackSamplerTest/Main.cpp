@@ -0,0 +1,162 @@
+#include "Animation/TrackSampler.h"
+#include "Base/Template.h"
+#include "Scene/Track.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+// Scalar reference which searches keys linearly and interpolates them by Vec3f::Lerp and Quaternion::SLerp.
+// Times out of key range are clamped and empty channels return identity values.
+template<typename KeyFrameType, typename ValueType>
+ValueType SampleReference(const std::vector<KeyFrameType>& keys, float time, const ValueType& identity)
+{
+	if (keys.empty())
+	{
+		return identity;
+	}
+
+	if (time <= keys.front().GetTime())
+	{
+		return keys.front().GetValue();
+	}
+
+	if (time >= keys.back().GetTime())
+	{
+		return keys.back().GetValue();
+	}
+
+	size_t keyIndex = 0U;
+	while (keys[keyIndex + 1U].GetTime() <= time)
+	{
+		++keyIndex;
+	}
+
+	const KeyFrameType& key0 = keys[keyIndex];
+	const KeyFrameType& key1 = keys[keyIndex + 1U];
+	float factor = (time - key0.GetTime()) / (key1.GetTime() - key0.GetTime());
+	if constexpr (std::is_same_v<ValueType, cd::Quaternion>)
+	{
+		return cd::Quaternion::SLerp(key0.GetValue(), key1.GetValue(), factor);
+	}
+	else
+	{
+		return cd::Vec3f::Lerp(key0.GetValue(), key1.GetValue(), factor);
+	}
+}
+
+// Maximum difference between the sampler and the scalar reference. q and -q are the same rotation.
+float CalculateMaxError(const cd::TrackSampler& sampler, const cd::Track& track, const std::vector<float>& times, cd::TrackCursor& cursor)
+{
+	float maxError = 0.0f;
+	for (float time : times)
+	{
+		cd::Transform transform = sampler.Sample(time, cursor);
+		cd::Vec3f translation = SampleReference(track.GetTranslationKeys(), time, cd::Vec3f::Zero());
+		cd::Quaternion rotation = SampleReference(track.GetRotationKeys(), time, cd::Quaternion::Identity());
+		cd::Vec3f scale = SampleReference(track.GetScaleKeys(), time, cd::Vec3f::One());
+
+		float translationError = (transform.GetTranslation() - translation).Length() / std::max(1.0f, translation.Length());
+		float rotationError = 1.0f - std::min(1.0f, std::abs(transform.GetRotation().Dot(rotation)));
+		float scaleError = (transform.GetScale() - scale).Length();
+		maxError = std::max({ maxError, translationError, rotationError, scaleError });
+	}
+
+	return maxError;
+}
+
+}
+
+int main()
+{
+	int failedCount = 0;
+	auto Check = [&failedCount](bool condition, const char* pDescription)
+	{
+		printf("%s : %s\n", pDescription, condition ? "passed" : "failed");
+		failedCount += condition ? 0 : 1;
+	};
+
+	// Non-uniform track : random key intervals, rotation keys at different times and no scale keys.
+	std::mt19937 randomEngine(3);
+	std::uniform_real_distribution<float> intervalDistribution(0.1f, 1.1f);
+	std::vector<cd::TranslationKey> translationKeys;
+	std::vector<cd::RotationKey> rotationKeys;
+	float keyTime = 0.0f;
+	for (uint32_t keyIndex = 0U; keyIndex < 200U; ++keyIndex)
+	{
+		keyTime += intervalDistribution(randomEngine);
+		translationKeys.emplace_back(keyTime, cd::Vec3f(keyTime, std::sin(keyTime), -2.0f * keyTime));
+		if (0U == keyIndex % 3U)
+		{
+			rotationKeys.emplace_back(keyTime, cd::Quaternion::RotateY(keyTime) * cd::Quaternion::RotateX(0.3f * keyTime));
+		}
+	}
+
+	cd::Track track(cd::TrackID(0U), "NonUniform");
+	track.SetTranslationKeys(cd::MoveTemp(translationKeys));
+	track.SetRotationKeys(cd::MoveTemp(rotationKeys));
+
+	// Uniform track : keys at multiples of 1 / 30 second in all channels as resampled tracks have. They are located without searching.
+	std::vector<cd::TranslationKey> uniformTranslationKeys;
+	std::vector<cd::RotationKey> uniformRotationKeys;
+	std::vector<cd::ScaleKey> uniformScaleKeys;
+	for (uint32_t keyIndex = 0U; keyIndex < 90U; ++keyIndex)
+	{
+		float time = static_cast<float>(keyIndex) / 30.0f;
+		uniformTranslationKeys.emplace_back(time, cd::Vec3f(std::cos(time * 4.0f), time, 0.0f));
+		uniformRotationKeys.emplace_back(time, cd::Quaternion::RotateZ(time * 2.5f));
+		uniformScaleKeys.emplace_back(time, cd::Vec3f(1.0f + time, 1.0f, 1.0f - 0.1f * time));
+	}
+
+	cd::Track uniformTrack(cd::TrackID(1U), "Uniform");
+	uniformTrack.SetTranslationKeys(cd::MoveTemp(uniformTranslationKeys));
+	uniformTrack.SetRotationKeys(cd::MoveTemp(uniformRotationKeys));
+	uniformTrack.SetScaleKeys(cd::MoveTemp(uniformScaleKeys));
+	uniformTrack.SetKeyInterval(1.0f / 30.0f);
+
+	constexpr float MaxError = 1e-4f;
+	for (const cd::Track* pTrack : { &track, &uniformTrack })
+	{
+		cd::TrackSampler sampler(*pTrack);
+		float startTime = pTrack->GetTranslationKeys().front().GetTime();
+		float endTime = pTrack->GetTranslationKeys().back().GetTime();
+
+		// Monotonic playback which starts before the first key and stops after the last key, then random access with the same cursor.
+		std::vector<float> playbackTimes;
+		for (float time = startTime - 1.0f; time < endTime + 1.0f; time += 0.01f)
+		{
+			playbackTimes.push_back(time);
+		}
+
+		std::vector<float> randomTimes;
+		std::uniform_real_distribution<float> timeDistribution(startTime - 1.0f, endTime + 1.0f);
+		for (uint32_t timeIndex = 0U; timeIndex < 5000U; ++timeIndex)
+		{
+			randomTimes.push_back(timeDistribution(randomEngine));
+		}
+
+		// Key times themselves are sampled exactly.
+		std::vector<float> keyTimes;
+		for (const cd::TranslationKey& key : pTrack->GetTranslationKeys())
+		{
+			keyTimes.push_back(key.GetTime());
+		}
+
+		cd::TrackCursor cursor;
+		float playbackError = CalculateMaxError(sampler, *pTrack, playbackTimes, cursor);
+		float randomError = CalculateMaxError(sampler, *pTrack, randomTimes, cursor);
+		float keyError = CalculateMaxError(sampler, *pTrack, keyTimes, cursor);
+		printf("%s track : key interval %g, errors %g / %g / %g\n", pTrack->GetName(), sampler.GetKeyInterval(), playbackError, randomError, keyError);
+		Check(playbackError <= MaxError, "Monotonic playback against scalar interpolation");
+		Check(randomError <= MaxError, "Random access against scalar interpolation");
+		Check(keyError <= MaxError, "Samples at key times");
+	}
+
+	return 0 == failedCount ? 0 : 1;
+}
@@ -1,4 +1,6 @@
+#include "Math/SIMD.hpp"
 #include "Scene/SceneDatabase.h"
+#include "Utilities/ParallelFor.h"
 
 #define __STDC_LIB_EXT1__ // prefer sprintf_s
 #define STB_IMAGE_IMPLEMENTATION
@@ -7,8 +9,12 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb/stb_image_write.h"
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace cdtools
@@ -46,18 +52,20 @@ struct Texture2D
 		assert(data == nullptr);
 		size = rect.x() * rect.y() * channel;
 		assert(size > 0);
-		data = new stbi_uc[size];
+		// Use stb allocator to match stbi_image_free in destructor.
+		data = static_cast<stbi_uc*>(STBI_MALLOC(size));
 		memset(data, 0, size);
 	}
 
-	stbi_uc GetPixelData(int i, int j, int colorIndex) const
+	// Pixels are stored row by row.
+	stbi_uc GetPixelData(int x, int y, int colorIndex) const
 	{
-		return data[(i * channel * rect.x()) + (j * channel) + colorIndex];
+		return data[(y * rect.x() + x) * channel + colorIndex];
 	}
 
-	void SetPixelData(int i, int j, int colorIndex, stbi_uc value)
+	void SetPixelData(int x, int y, int colorIndex, stbi_uc value)
 	{
-		data[(i * channel * rect.x()) + (j * channel) + colorIndex] = value;
+		data[(y * rect.x() + x) * channel + colorIndex] = value;
 	}
 
 	bool Save(const char* pFilePath)
@@ -66,6 +74,149 @@ struct Texture2D
 	}
 };
 
+// Decoded texture files shared by all materials. Every file is decoded only once by the first material which needs it,
+// and released after the last material which needs it finishes packing.
+class TextureDecodeCache
+{
+public:
+	struct Entry
+	{
+		std::once_flag decodeFlag;
+		std::unique_ptr<Texture2D> pTexture2D;
+		std::atomic<uint32_t> userCount = 0U;
+	};
+
+public:
+	TextureDecodeCache() = default;
+	TextureDecodeCache(const TextureDecodeCache&) = delete;
+	TextureDecodeCache& operator=(const TextureDecodeCache&) = delete;
+	TextureDecodeCache(TextureDecodeCache&&) = delete;
+	TextureDecodeCache& operator=(TextureDecodeCache&&) = delete;
+	~TextureDecodeCache() = default;
+
+	// Not thread safe. Register all users before acquiring.
+	void AddUser(const std::string& filePath)
+	{
+		auto itEntry = m_entries.find(filePath);
+		if (itEntry == m_entries.end())
+		{
+			itEntry = m_entries.emplace(filePath, std::make_unique<Entry>()).first;
+		}
+		++itEntry->second->userCount;
+	}
+
+	// Thread safe. Returns nullptr if the file failed to decode.
+	const Texture2D* Acquire(const std::string& filePath)
+	{
+		Entry& entry = *m_entries.at(filePath);
+		std::call_once(entry.decodeFlag, [&entry, &filePath]()
+		{
+			auto pTexture2D = std::make_unique<Texture2D>();
+			pTexture2D->channel = RequestChannelCount;
+			pTexture2D->data = stbi_load(filePath.c_str(), &pTexture2D->rect.x(), &pTexture2D->rect.y(), nullptr, RequestChannelCount);
+			pTexture2D->size = pTexture2D->rect.x() * pTexture2D->rect.y() * pTexture2D->channel;
+			if (pTexture2D->data)
+			{
+				entry.pTexture2D = std::move(pTexture2D);
+			}
+		});
+
+		return entry.pTexture2D.get();
+	}
+
+	// Thread safe. Every AddUser should have one Release.
+	void Release(const std::string& filePath)
+	{
+		Entry& entry = *m_entries.at(filePath);
+		if (1U == entry.userCount.fetch_sub(1U))
+		{
+			entry.pTexture2D.reset();
+		}
+	}
+
+private:
+	std::unordered_map<std::string, std::unique_ptr<Entry>> m_entries;
+};
+
+// Packs channels of RGB8 pixels row by row.
+// Every output channel is selected from its source pixels or a constant value by byte masks. 48 bytes are 16 pixels in 3 SIMD registers.
+class ChannelPacker
+{
+public:
+	static constexpr int BlockByteCount = 48;
+
+	// pSources[channel] is nullptr if the channel uses default value.
+	ChannelPacker(const stbi_uc* const (&pSources)[RequestChannelCount], const stbi_uc (&defaultValues)[RequestChannelCount])
+	{
+		for (int channel = 0; channel < RequestChannelCount; ++channel)
+		{
+			m_pSources[channel] = pSources[channel];
+			for (int byteIndex = 0; byteIndex < BlockByteCount; ++byteIndex)
+			{
+				m_masks[channel][byteIndex] = byteIndex % RequestChannelCount == channel ? 0xFF : 0x00;
+			}
+		}
+
+		for (int byteIndex = 0; byteIndex < BlockByteCount; ++byteIndex)
+		{
+			m_constants[byteIndex] = defaultValues[byteIndex % RequestChannelCount];
+		}
+	}
+
+	void Pack(stbi_uc* pTarget, size_t byteCount) const
+	{
+		size_t byteIndex = 0;
+		for (; byteIndex + BlockByteCount <= byteCount; byteIndex += BlockByteCount)
+		{
+			for (int offset = 0; offset < BlockByteCount; offset += 16)
+			{
+				PackRegister(pTarget + byteIndex + offset, byteIndex + offset, offset);
+			}
+		}
+
+		for (; byteIndex < byteCount; ++byteIndex)
+		{
+			int channel = static_cast<int>(byteIndex % RequestChannelCount);
+			pTarget[byteIndex] = m_pSources[channel] ? m_pSources[channel][byteIndex] : m_constants[channel];
+		}
+	}
+
+private:
+	void PackRegister(stbi_uc* pTarget, size_t sourceOffset, int maskOffset) const
+	{
+#if defined(CD_SIMD_SSE)
+		__m128i result = _mm_setzero_si128();
+		for (int channel = 0; channel < RequestChannelCount; ++channel)
+		{
+			const stbi_uc* pSource = m_pSources[channel] ? m_pSources[channel] + sourceOffset : m_constants + maskOffset;
+			__m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource));
+			__m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_masks[channel] + maskOffset));
+			result = _mm_or_si128(result, _mm_and_si128(source, mask));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pTarget), result);
+#elif defined(CD_SIMD_NEON)
+		uint8x16_t result = vdupq_n_u8(0);
+		for (int channel = 0; channel < RequestChannelCount; ++channel)
+		{
+			const stbi_uc* pSource = m_pSources[channel] ? m_pSources[channel] + sourceOffset : m_constants + maskOffset;
+			result = vbslq_u8(vld1q_u8(m_masks[channel] + maskOffset), vld1q_u8(pSource), result);
+		}
+		vst1q_u8(pTarget, result);
+#else
+		for (int byteIndex = 0; byteIndex < 16; ++byteIndex)
+		{
+			int channel = (maskOffset + byteIndex) % RequestChannelCount;
+			pTarget[byteIndex] = m_pSources[channel] ? m_pSources[channel][sourceOffset + byteIndex] : m_constants[maskOffset + byteIndex];
+		}
+#endif
+	}
+
+private:
+	const stbi_uc* m_pSources[RequestChannelCount];
+	stbi_uc m_masks[RequestChannelCount][BlockByteCount];
+	stbi_uc m_constants[BlockByteCount];
+};
+
 class MergeTextureConsumer : public cdtools::IConsumer
 {
 public:
@@ -96,9 +247,14 @@ public:
 		assert(!m_mergedTextureSuffixAndExtension.empty() && "Need to specify merged texture suffix and output file extension.");
 		assert(!m_textureColorIndex.empty() && "Forgot to set texture type and its according color index?");
 
-		for (const auto& material : pSceneDatabase->GetMaterials())
+		// Collect texture files of every material at first so that shared files are decoded only once.
+		const std::vector<cd::Material>& materials = pSceneDatabase->GetMaterials();
+		std::vector<std::map<std::string, std::vector<cd::MaterialTextureType>>> materialTextureFiles(materials.size());
+		TextureDecodeCache decodeCache;
+		for (size_t materialIndex = 0; materialIndex < materials.size(); ++materialIndex)
 		{
-			std::map<std::string, std::vector<cd::MaterialTextureType>> textureFileSupportTypes;
+			const cd::Material& material = materials[materialIndex];
+			auto& textureFileSupportTypes = materialTextureFiles[materialIndex];
 			for (const auto& [textureType, _] : m_textureColorIndex)
 			{
 				if (!material.IsTextureSetup(textureType))
@@ -111,110 +267,104 @@ public:
 				textureFileSupportTypes[texture.GetPath()].push_back(textureType);
 			}
 
-			if (textureFileSupportTypes.size() < 1)
+			for (const auto& [textureFilePath, _] : textureFileSupportTypes)
 			{
-				// Material only has one texture type.
-				// TextureTypes already share same texture file path.
-				continue;
+				decodeCache.AddUser(textureFilePath);
 			}
+		}
 
-			// Validate all texture files have same width and height.
-			// Validate all texture files can be loaded successfully.
-			// TODO : texture type is a valid 2D texture.
-			// TextureType : 2D, 3D, Volume, Cubemap...
-			std::vector<Texture2D> texture2DStorage;
-			texture2DStorage.reserve(textureFileSupportTypes.size());
-
-			std::map<cd::MaterialTextureType, Texture2D*> loadedTexturesData;
-			std::optional<Texture2DRect> mergedTextureRect;
-			std::filesystem::path mergedTextureFilePath;
-			bool isAnyUnknownTexture = false;
-			bool isSameTextureSize = true;
-			for (const auto& [textureFilePath, textureTypes] : textureFileSupportTypes)
+		cd::ParallelFor(static_cast<uint32_t>(materials.size()), [this, &materials, &materialTextureFiles, &decodeCache](uint32_t materialIndex)
+		{
+			const auto& textureFileSupportTypes = materialTextureFiles[materialIndex];
+			MergeMaterialTextures(materials[materialIndex], textureFileSupportTypes, decodeCache);
+			for (const auto& [textureFilePath, _] : textureFileSupportTypes)
 			{
-				Texture2D& texture2D = texture2DStorage.emplace_back();
-				texture2D.channel = RequestChannelCount;
-				texture2D.data = stbi_load(textureFilePath.c_str(), &texture2D.rect.x(), &texture2D.rect.y(), nullptr, RequestChannelCount);
-				texture2D.size = texture2D.rect.x() * texture2D.rect.y() * texture2D.channel;
-				if (!texture2D.data)
-				{
-					// Failed to load texture file.
-					isAnyUnknownTexture = true;
-					break;
-				}
+				decodeCache.Release(textureFilePath);
+			}
+		});
+	}
 
-				if (!mergedTextureRect.has_value())
-				{
-					mergedTextureRect = texture2D.rect;
-					mergedTextureFilePath = textureFilePath.c_str();
-				}
-				else if (mergedTextureRect != texture2D.rect)
-				{
-					isSameTextureSize = false;
-					break;
-				}
+private:
+	void MergeMaterialTextures(const cd::Material& material, const std::map<std::string, std::vector<cd::MaterialTextureType>>& textureFileSupportTypes,
+		TextureDecodeCache& decodeCache) const
+	{
+		if (textureFileSupportTypes.size() < 1)
+		{
+			// Material only has one texture type.
+			// TextureTypes already share same texture file path.
+			return;
+		}
 
-				for (cd::MaterialTextureType textureType : textureTypes)
-				{
-					loadedTexturesData[textureType] = &texture2D;
-				}
+		// Validate all texture files have same width and height.
+		// Validate all texture files can be loaded successfully.
+		// TODO : texture type is a valid 2D texture.
+		// TextureType : 2D, 3D, Volume, Cubemap...
+		std::map<cd::MaterialTextureType, const Texture2D*> loadedTexturesData;
+		std::optional<Texture2DRect> mergedTextureRect;
+		std::filesystem::path mergedTextureFilePath;
+		for (const auto& [textureFilePath, textureTypes] : textureFileSupportTypes)
+		{
+			const Texture2D* pTexture2D = decodeCache.Acquire(textureFilePath);
+			if (!pTexture2D)
+			{
+				// Failed to load texture file.
+				return;
 			}
 
-			if (isAnyUnknownTexture || !isSameTextureSize)
+			if (!mergedTextureRect.has_value())
 			{
-				continue;
+				mergedTextureRect = pTexture2D->rect;
+				mergedTextureFilePath = textureFilePath.c_str();
 			}
-
-			// Only need to consider 8bit per pixel channel because stb will help convert 16 to 8.
-			Texture2D mergedTexture;
-			mergedTexture.rect = mergedTextureRect.value();
-			mergedTexture.channel = RequestChannelCount;
-			mergedTexture.Allocate();
-
-			for (const auto& [textureType, colorValue] : m_textureColorDefaultValue)
+			else if (mergedTextureRect != pTexture2D->rect)
 			{
-				// Init default color value if file not loaded.
-				if (!loadedTexturesData.contains(textureType))
-				{
-					assert(m_textureColorDefaultValue.contains(textureType));
-					int colorIndex = static_cast<int>(m_textureColorIndex[textureType]);
-					uint8_t defaultValue = m_textureColorDefaultValue[textureType];
-					for (int i = 0; i < mergedTexture.rect.x(); ++i)
-					{
-						for (int j = 0; j < mergedTexture.rect.y(); ++j)
-						{
-							mergedTexture.SetPixelData(i, j, colorIndex, defaultValue);
-						}
-					}
-				}
+				return;
 			}
 
-			for (const auto& [textureType, pTexture2D] : loadedTexturesData)
+			for (cd::MaterialTextureType textureType : textureTypes)
 			{
-				int colorIndex = static_cast<int>(m_textureColorIndex[textureType]);
-				for (int i = 0; i < mergedTexture.rect.x(); ++i)
-				{
-					for (int j = 0; j < mergedTexture.rect.y(); ++j)
-					{
-						mergedTexture.SetPixelData(i, j, colorIndex, pTexture2D->GetPixelData(i, j, colorIndex));
-					}
-				}
+				loadedTexturesData[textureType] = pTexture2D;
 			}
+		}
 
-			std::filesystem::path mergedFilePath = mergedTextureFilePath.parent_path() / material.GetName();
-			//mergedFilePath += "_" + std::to_string(mergedTextureRect.value().x());
-			//mergedFilePath += "x" + std::to_string(mergedTextureRect.value().y());
-			mergedFilePath += "_" + m_mergedTextureSuffixAndExtension;
-			std::string outputFilePath = mergedFilePath.string();
-			if (!mergedTexture.Save(outputFilePath.c_str()))
+		// Every channel comes from the same channel of its source texture, or its default color value if file not loaded.
+		const stbi_uc* pSources[RequestChannelCount] = {};
+		stbi_uc defaultValues[RequestChannelCount] = {};
+		for (const auto& [textureType, colorIndex] : m_textureColorIndex)
+		{
+			int channel = static_cast<int>(colorIndex);
+			if (auto itTexture = loadedTexturesData.find(textureType); itTexture != loadedTexturesData.end())
 			{
-				printf("Failed to save %s while merging textures.\n", outputFilePath.c_str());
+				pSources[channel] = itTexture->second->data;
 			}
-			else
+			else if (auto itDefaultValue = m_textureColorDefaultValue.find(textureType); itDefaultValue != m_textureColorDefaultValue.end())
 			{
-				printf("Succeed to save merged texture : %s.\n", outputFilePath.c_str());
+				defaultValues[channel] = itDefaultValue->second;
 			}
 		}
+
+		// Only need to consider 8bit per pixel channel because stb will help convert 16 to 8.
+		Texture2D mergedTexture;
+		mergedTexture.rect = mergedTextureRect.value();
+		mergedTexture.channel = RequestChannelCount;
+		mergedTexture.Allocate();
+
+		ChannelPacker packer(pSources, defaultValues);
+		packer.Pack(mergedTexture.data, static_cast<size_t>(mergedTexture.size));
+
+		std::filesystem::path mergedFilePath = mergedTextureFilePath.parent_path() / material.GetName();
+		//mergedFilePath += "_" + std::to_string(mergedTextureRect.value().x());
+		//mergedFilePath += "x" + std::to_string(mergedTextureRect.value().y());
+		mergedFilePath += "_" + m_mergedTextureSuffixAndExtension;
+		std::string outputFilePath = mergedFilePath.string();
+		if (!mergedTexture.Save(outputFilePath.c_str()))
+		{
+			printf("Failed to save %s while merging textures.\n", outputFilePath.c_str());
+		}
+		else
+		{
+			printf("Succeed to save merged texture : %s.\n", outputFilePath.c_str());
+		}
 	}
 
 private:
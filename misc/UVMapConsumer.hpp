@@ -1,4 +1,5 @@
 #include "Scene/SceneDatabase.h"
+#include "Utilities/ParallelFor.h"
 
 #define __STDC_LIB_EXT1__ // prefer sprintf_s
 #define STB_IMAGE_IMPLEMENTATION
@@ -7,17 +8,38 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb/stb_image_write.h"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 #include <vector>
 
 namespace cdtools
 {
 
+enum class UVMapDrawMode
+{
+	Wireframe, // Triangle edges in pen color.
+	Filled,    // Texels covered by one triangle in fill color and texels covered by more than one triangle in overlap color.
+};
+
+// UVMapConsumer draws UV layout of all meshes into a picture.
+// Triangles are binned into square tiles and every tile is rasterized on its own thread.
+// Coverage pass always runs so overlapped texels can be detected in both draw modes.
 class UVMapConsumer : public cdtools::IConsumer
 {
 public:
 	using Point2d = cd::TVector<int, 2>;
 
+	static constexpr int32_t TileSize = 64;
+
+	// Triangle vertices in pixel space.
+	struct RasterTriangle
+	{
+		cd::Vec2f v0;
+		cd::Vec2f v1;
+		cd::Vec2f v2;
+	};
+
 public:
 	UVMapConsumer() = delete;
 	explicit UVMapConsumer(const char* pFilePath) : m_filePath(pFilePath) {}
@@ -34,8 +56,8 @@ public:
 
 	void SetUVMapUnitSize(int width, int height)
 	{
-		m_uvmapWidth = width;
-		m_uvmapHeight = height;
+		m_uvmapUnitWidth = width;
+		m_uvmapUnitHeight = height;
 	}
 
 	void SetUVMapMaxSize(int width, int height)
@@ -44,9 +66,23 @@ public:
 		m_uvmapMaxHeight = height;
 	}
 
+	void SetDrawMode(UVMapDrawMode drawMode)
+	{
+		m_drawMode = drawMode;
+	}
+
+	// Results of the last Execute.
+	int32_t GetUVMapWidth() const { return m_uvmapWidth; }
+	int32_t GetUVMapHeight() const { return m_uvmapHeight; }
+	// Triangle count which covers every texel center. Stored row by row.
+	const std::vector<uint32_t>& GetTexelCoverages() const { return m_texelCoverages; }
+	uint64_t GetCoveredTexelCount() const { return m_coveredTexelCount; }
+	uint64_t GetOverlappedTexelCount() const { return m_overlappedTexelCount; }
+
 	virtual void Execute(const cd::SceneDatabase* pSceneDatabase) override
 	{
 		cd::Rect uvmapRect = cd::Rect::Empty();
+		uint32_t triangleCount = 0U;
 		for (const auto& mesh : pSceneDatabase->GetMeshes())
 		{
 			if (mesh.GetVertexUVSetCount() < m_uvSetIndex + 1)
@@ -55,29 +91,13 @@ public:
 			}
 
 			cd::UV minUV(FLT_MAX);
-			cd::UV maxUV(FLT_MIN);
-			for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+			cd::UV maxUV(-FLT_MAX);
+			for (const auto& uv : mesh.GetVertexUV(m_uvSetIndex))
 			{
-				const auto& uv = mesh.GetVertexUV(m_uvSetIndex, vertexIndex);
-				if(uv.x() < minUV.x())
-				{
-					minUV.x() = uv.x();
-				}
-
-				if(uv.x() > maxUV.x())
-				{
-					maxUV.x() = uv.x();
-				}
-
-				if (uv.y() < minUV.y())
-				{
-					minUV.y() = uv.y();
-				}
-
-				if (uv.y() > maxUV.y())
-				{
-					maxUV.y() = uv.y();
-				}
+				minUV.x() = std::min(minUV.x(), uv.x());
+				minUV.y() = std::min(minUV.y(), uv.y());
+				maxUV.x() = std::max(maxUV.x(), uv.x());
+				maxUV.y() = std::max(maxUV.y(), uv.y());
 			}
 
 			cd::Rect uvShell(minUV, maxUV);
@@ -85,34 +105,44 @@ public:
 			{
 				uvmapRect.Merge(uvShell);
 			}
+
+			triangleCount += mesh.GetPolygonCount();
 		}
 
-		cd::Vec2f rectSize = uvmapRect.Size();
-		int targetUVMapWidth = static_cast<int>(std::ceil(rectSize.x()) * m_uvmapUnitWidth);
-		int targetUVMapHeight = static_cast<int>(std::ceil(rectSize.y()) * m_uvmapUnitHeight);
+		if (uvmapRect.IsEmpty())
+		{
+			printf("No UV set %u to draw.\n", m_uvSetIndex);
+			return;
+		}
+
+		// UV map starts from the integer part of min UV so that unit squares align with picture pixels.
+		cd::UV uvOffsetInPicture(std::floor(uvmapRect.Min().x()), std::floor(uvmapRect.Min().y()));
+		float unitCountX = std::max(1.0f, std::ceil(uvmapRect.Max().x() - uvOffsetInPicture.x()));
+		float unitCountY = std::max(1.0f, std::ceil(uvmapRect.Max().y() - uvOffsetInPicture.y()));
+		int targetUVMapWidth = static_cast<int>(unitCountX * m_uvmapUnitWidth);
+		int targetUVMapHeight = static_cast<int>(unitCountY * m_uvmapUnitHeight);
 
 		if(targetUVMapWidth > m_uvmapMaxWidth ||
-			targetUVMapHeight > m_uvmapHeight)
+			targetUVMapHeight > m_uvmapMaxHeight)
 		{
-			m_uvmapWidth = m_uvmapMaxWidth;
-			m_uvmapHeight = m_uvmapMaxHeight;
-			int uvmapUnitWidth = static_cast<int>(m_uvmapWidth / std::ceil(rectSize.x()));
-			int uvmapUnitHeight = static_cast<int>(m_uvmapHeight / std::ceil(rectSize.y()));
+			int uvmapUnitWidth = static_cast<int>(m_uvmapMaxWidth / unitCountX);
+			int uvmapUnitHeight = static_cast<int>(m_uvmapMaxHeight / unitCountY);
 
-			m_uvmapUnitWidth = std::min(uvmapUnitWidth, uvmapUnitHeight);
+			m_uvmapUnitWidth = std::max(1, std::min(uvmapUnitWidth, uvmapUnitHeight));
 			m_uvmapUnitHeight = m_uvmapUnitWidth;
-		}
-		else
-		{
-			m_uvmapWidth = targetUVMapWidth;
-			m_uvmapHeight = targetUVMapHeight;
+			targetUVMapWidth = static_cast<int>(unitCountX * m_uvmapUnitWidth);
+			targetUVMapHeight = static_cast<int>(unitCountY * m_uvmapUnitHeight);
 		}
 
+		m_uvmapWidth = targetUVMapWidth;
+		m_uvmapHeight = targetUVMapHeight;
 		m_uvmapStride = m_uvmapWidth * m_channelCount;
-		m_uvmapContent.resize(m_uvmapHeight * m_uvmapStride);
-		std::fill(m_uvmapContent.begin(), m_uvmapContent.end(), 0);
+		m_uvmapContent.assign(static_cast<size_t>(m_uvmapHeight) * m_uvmapStride, 0);
+		m_texelCoverages.assign(static_cast<size_t>(m_uvmapWidth) * m_uvmapHeight, 0U);
 
-		cd::UV uvOffsetInPicture = uvmapRect.Min();
+		// Transform all triangles to pixel space.
+		std::vector<RasterTriangle> triangles;
+		triangles.reserve(triangleCount);
 		for (const auto& mesh : pSceneDatabase->GetMeshes())
 		{
 			if (mesh.GetVertexUVSetCount() < m_uvSetIndex + 1)
@@ -120,93 +150,225 @@ public:
 				continue;
 			}
 
-			for (uint32_t polygonIndex = 0U; polygonIndex < mesh.GetPolygonCount(); ++polygonIndex)
+			size_t triangleOffset = triangles.size();
+			triangles.resize(triangleOffset + mesh.GetPolygonCount());
+			cd::ParallelFor(mesh.GetPolygonCount(), [this, &mesh, &triangles, &uvOffsetInPicture, triangleOffset](uint32_t polygonIndex)
 			{
 				const auto& polygon = mesh.GetPolygon(polygonIndex);
-				const auto& t0UV = mesh.GetVertexUV(m_uvSetIndex, polygon[0].Data()) - uvOffsetInPicture;
-				const auto& t1UV = mesh.GetVertexUV(m_uvSetIndex, polygon[1].Data()) - uvOffsetInPicture;
-				const auto& t2UV = mesh.GetVertexUV(m_uvSetIndex, polygon[2].Data()) - uvOffsetInPicture;
-				
-				DrawTriangle(CastUVToPoint2d(t0UV), CastUVToPoint2d(t1UV), CastUVToPoint2d(t2UV));
-			}
+				RasterTriangle& triangle = triangles[triangleOffset + polygonIndex];
+				triangle.v0 = CastUVToPixel(mesh.GetVertexUV(m_uvSetIndex, polygon[0].Data()) - uvOffsetInPicture);
+				triangle.v1 = CastUVToPixel(mesh.GetVertexUV(m_uvSetIndex, polygon[1].Data()) - uvOffsetInPicture);
+				triangle.v2 = CastUVToPixel(mesh.GetVertexUV(m_uvSetIndex, polygon[2].Data()) - uvOffsetInPicture);
+			});
+		}
+
+		RasterizeTiles(triangles);
+
+		m_coveredTexelCount = 0U;
+		m_overlappedTexelCount = 0U;
+		for (uint32_t coverage : m_texelCoverages)
+		{
+			m_coveredTexelCount += coverage > 0U ? 1U : 0U;
+			m_overlappedTexelCount += coverage > 1U ? 1U : 0U;
 		}
+		printf("UV map : %u triangles, %llu covered texels, %llu overlapped texels.\n", static_cast<uint32_t>(triangles.size()),
+			static_cast<unsigned long long>(m_coveredTexelCount), static_cast<unsigned long long>(m_overlappedTexelCount));
 
 		SavePicture();
 	}
 
 private:
-	Point2d CastUVToPoint2d(const cd::UV& uv)
+	cd::Vec2f CastUVToPixel(const cd::UV& uv) const
 	{
-		float xMax = std::ceil(uv.x());
-		float xMin = xMax - 1.0f;
-		float yMax = std::ceil(uv.y());
-		float yMin = yMax - 1.0f;
-
-		int uvmapX = static_cast<int>(cd::Math::GetValueInNewRange(uv.x(), xMin, xMax, xMin * m_uvmapUnitWidth, xMax * m_uvmapUnitWidth - 1.0f));
-		int uvmapY = static_cast<int>(cd::Math::GetValueInNewRange(uv.y(), yMin, yMax, yMin * m_uvmapUnitHeight, yMax * m_uvmapUnitHeight - 1.0f));
-		return Point2d(uvmapX, uvmapY);
+		return cd::Vec2f(uv.x() * m_uvmapUnitWidth, uv.y() * m_uvmapUnitHeight);
 	}
 
-	void DrawPoint(const Point2d& p)
+	void RasterizeTiles(const std::vector<RasterTriangle>& triangles)
 	{
-		int x = std::max(0, p.x());
-		int y = std::max(0, p.y());
+		int32_t tileCountX = (m_uvmapWidth + TileSize - 1) / TileSize;
+		int32_t tileCountY = (m_uvmapHeight + TileSize - 1) / TileSize;
+		uint32_t tileCount = static_cast<uint32_t>(tileCountX * tileCountY);
+
+		// Bin triangles by their bounding boxes. Every chunk of triangles has its own bins to avoid locks.
+		// Chunks are visited in order later so triangles keep the same order in every tile.
+		uint32_t triangleCount = static_cast<uint32_t>(triangles.size());
+		uint32_t chunkCount = std::max(1U, std::min(cd::GetParallelThreadCount() * 4U, triangleCount / 1024U));
+		uint32_t chunkSize = (triangleCount + chunkCount - 1U) / chunkCount;
+		std::vector<std::vector<std::vector<uint32_t>>> chunkTileBins(chunkCount, std::vector<std::vector<uint32_t>>(tileCount));
+		cd::ParallelFor(chunkCount, [this, &triangles, &chunkTileBins, chunkSize, triangleCount, tileCountX, tileCountY](uint32_t chunkIndex)
+		{
+			std::vector<std::vector<uint32_t>>& tileBins = chunkTileBins[chunkIndex];
+			uint32_t triangleEnd = std::min(triangleCount, (chunkIndex + 1U) * chunkSize);
+			for (uint32_t triangleIndex = chunkIndex * chunkSize; triangleIndex < triangleEnd; ++triangleIndex)
+			{
+				const RasterTriangle& triangle = triangles[triangleIndex];
+				float minX = std::min({ triangle.v0.x(), triangle.v1.x(), triangle.v2.x() });
+				float minY = std::min({ triangle.v0.y(), triangle.v1.y(), triangle.v2.y() });
+				float maxX = std::max({ triangle.v0.x(), triangle.v1.x(), triangle.v2.x() });
+				float maxY = std::max({ triangle.v0.y(), triangle.v1.y(), triangle.v2.y() });
+				int32_t minTileX = std::clamp(static_cast<int32_t>(std::floor(minX)) / TileSize, 0, tileCountX - 1);
+				int32_t minTileY = std::clamp(static_cast<int32_t>(std::floor(minY)) / TileSize, 0, tileCountY - 1);
+				int32_t maxTileX = std::clamp(static_cast<int32_t>(std::floor(maxX)) / TileSize, 0, tileCountX - 1);
+				int32_t maxTileY = std::clamp(static_cast<int32_t>(std::floor(maxY)) / TileSize, 0, tileCountY - 1);
+				for (int32_t tileY = minTileY; tileY <= maxTileY; ++tileY)
+				{
+					for (int32_t tileX = minTileX; tileX <= maxTileX; ++tileX)
+					{
+						tileBins[tileY * tileCountX + tileX].push_back(triangleIndex);
+					}
+				}
+			}
+		});
+
+		// Tiles don't share texels so they can be drawn without synchronization.
+		cd::ParallelFor(tileCount, [this, &triangles, &chunkTileBins, tileCountX](uint32_t tileIndex)
+		{
+			int32_t tileMinX = static_cast<int32_t>(tileIndex) % tileCountX * TileSize;
+			int32_t tileMinY = static_cast<int32_t>(tileIndex) / tileCountX * TileSize;
+			int32_t tileMaxX = std::min(tileMinX + TileSize, m_uvmapWidth) - 1;
+			int32_t tileMaxY = std::min(tileMinY + TileSize, m_uvmapHeight) - 1;
+			for (const auto& tileBins : chunkTileBins)
+			{
+				for (uint32_t triangleIndex : tileBins[tileIndex])
+				{
+					const RasterTriangle& triangle = triangles[triangleIndex];
+					FillTriangle(triangle, tileMinX, tileMinY, tileMaxX, tileMaxY);
+					if (UVMapDrawMode::Wireframe == m_drawMode)
+					{
+						DrawLine(triangle.v0, triangle.v1, tileMinX, tileMinY, tileMaxX, tileMaxY);
+						DrawLine(triangle.v1, triangle.v2, tileMinX, tileMinY, tileMaxX, tileMaxY);
+						DrawLine(triangle.v2, triangle.v0, tileMinX, tileMinY, tileMaxX, tileMaxY);
+					}
+				}
+			}
 
-		m_uvmapContent[(y * m_uvmapWidth + x) * m_channelCount] = m_penColor.x();
-		m_uvmapContent[(y * m_uvmapWidth + x) * m_channelCount + 1] = m_penColor.y();
-		m_uvmapContent[(y * m_uvmapWidth + x) * m_channelCount + 2] = m_penColor.z();
+			if (UVMapDrawMode::Filled == m_drawMode)
+			{
+				for (int32_t y = tileMinY; y <= tileMaxY; ++y)
+				{
+					for (int32_t x = tileMinX; x <= tileMaxX; ++x)
+					{
+						uint32_t coverage = m_texelCoverages[static_cast<size_t>(y) * m_uvmapWidth + x];
+						if (coverage > 0U)
+						{
+							DrawPoint(Point2d(x, y), coverage > 1U ? m_overlapColor : m_fillColor);
+						}
+					}
+				}
+			}
+		});
 	}
 
-	void DrawLine(const Point2d& start, const Point2d& end)
+	// Counts triangles covering texel centers inside the tile by edge functions.
+	// Top-left fill rule makes texels on shared edges belong to only one triangle.
+	void FillTriangle(const RasterTriangle& triangle, int32_t tileMinX, int32_t tileMinY, int32_t tileMaxX, int32_t tileMaxY)
 	{
-		int x1 = start.x();
-		int y1 = start.y();
-		int x2 = end.x();
-		int y2 = end.y();
-
-		float k = 1.0f * (y2 - y1) / (x2 - x1);
+		cd::Vec2f v0 = triangle.v0;
+		cd::Vec2f v1 = triangle.v1;
+		cd::Vec2f v2 = triangle.v2;
+		float area = (v1.x() - v0.x()) * (v2.y() - v0.y()) - (v1.y() - v0.y()) * (v2.x() - v0.x());
+		if (0.0f == area)
+		{
+			return;
+		}
 
-		int flag = 0;
-		if (k > 1 || k < -1)
+		// Mirrored UV shells have opposite winding.
+		if (area < 0.0f)
 		{
-			flag = 1;
-			x1 ^= y1 ^= x1 ^= y1;
-			x2 ^= y2 ^= x2 ^= y2;
-			k = 1.0f * (y2 - y1) / (x2 - x1);
+			std::swap(v1, v2);
 		}
 
-		float d = 0.5f - k;
-		if (x1 > x2)
+		int32_t minX = std::max(tileMinX, static_cast<int32_t>(std::floor(std::min({ v0.x(), v1.x(), v2.x() }))));
+		int32_t minY = std::max(tileMinY, static_cast<int32_t>(std::floor(std::min({ v0.y(), v1.y(), v2.y() }))));
+		int32_t maxX = std::min(tileMaxX, static_cast<int32_t>(std::ceil(std::max({ v0.x(), v1.x(), v2.x() }))));
+		int32_t maxY = std::min(tileMaxY, static_cast<int32_t>(std::ceil(std::max({ v0.y(), v1.y(), v2.y() }))));
+		if (minX > maxX || minY > maxY)
 		{
-			x1 ^= x2 ^= x1 ^= x2;
-			y1 ^= y2 ^= y1 ^= y2;
+			return;
 		}
 
-		while (x1 != x2)
+		struct EdgeFunction
+		{
+			float a;
+			float b;
+			float c;
+			bool isTopLeft;
+		};
+
+		auto makeEdge = [](const cd::Vec2f& start, const cd::Vec2f& end)
+		{
+			EdgeFunction edge;
+			edge.a = start.y() - end.y();
+			edge.b = end.x() - start.x();
+			edge.c = start.x() * end.y() - start.y() * end.x();
+			// Texel rows grow downward so top edges are horizontal edges going left and left edges are edges going up.
+			edge.isTopLeft = (edge.a == 0.0f && edge.b < 0.0f) || edge.a > 0.0f;
+			return edge;
+		};
+
+		EdgeFunction edges[3] = { makeEdge(v1, v2), makeEdge(v2, v0), makeEdge(v0, v1) };
+		for (int32_t y = minY; y <= maxY; ++y)
 		{
-			if (k > 0.0f && d < 0.0f)
+			float sampleY = static_cast<float>(y) + 0.5f;
+			for (int32_t x = minX; x <= maxX; ++x)
 			{
-				++y1;
-				++d;
+				float sampleX = static_cast<float>(x) + 0.5f;
+				bool isInside = true;
+				for (const EdgeFunction& edge : edges)
+				{
+					float distance = edge.a * sampleX + edge.b * sampleY + edge.c;
+					isInside = isInside && (distance > 0.0f || (0.0f == distance && edge.isTopLeft));
+				}
+
+				if (isInside)
+				{
+					++m_texelCoverages[static_cast<size_t>(y) * m_uvmapWidth + x];
+				}
 			}
-			else if (k < 0.0f && d > 0.0f)
+		}
+	}
+
+	// DDA line which only writes texels inside the tile.
+	void DrawLine(const cd::Vec2f& start, const cd::Vec2f& end, int32_t tileMinX, int32_t tileMinY, int32_t tileMaxX, int32_t tileMaxY)
+	{
+		float deltaX = end.x() - start.x();
+		float deltaY = end.y() - start.y();
+		bool isXMajor = std::abs(deltaX) >= std::abs(deltaY);
+		float majorStart = isXMajor ? start.x() : start.y();
+		float majorEnd = isXMajor ? end.x() : end.y();
+		float minorStart = isXMajor ? start.y() : start.x();
+		float slope = isXMajor ? (0.0f == deltaX ? 0.0f : deltaY / deltaX) : deltaX / deltaY;
+		if (majorStart > majorEnd)
+		{
+			std::swap(majorStart, majorEnd);
+			minorStart = isXMajor ? end.y() : end.x();
+		}
+
+		int32_t tileMajorMin = isXMajor ? tileMinX : tileMinY;
+		int32_t tileMajorMax = isXMajor ? tileMaxX : tileMaxY;
+		int32_t tileMinorMin = isXMajor ? tileMinY : tileMinX;
+		int32_t tileMinorMax = isXMajor ? tileMaxY : tileMaxX;
+		int32_t beginMajor = std::max(tileMajorMin, static_cast<int32_t>(std::floor(majorStart)));
+		int32_t endMajor = std::min(tileMajorMax, static_cast<int32_t>(std::floor(majorEnd)));
+		for (int32_t major = beginMajor; major <= endMajor; ++major)
+		{
+			float center = std::clamp(static_cast<float>(major) + 0.5f, majorStart, majorEnd);
+			int32_t minor = static_cast<int32_t>(std::floor(minorStart + (center - majorStart) * slope));
+			if (minor < tileMinorMin || minor > tileMinorMax)
 			{
-				--y1;
-				--d;
+				continue;
 			}
 
-			d -= k;
-			++x1;
-
-			DrawPoint(flag == 0 ? Point2d(x1, y1) : Point2d(y1, x1));
+			DrawPoint(isXMajor ? Point2d(major, minor) : Point2d(minor, major), m_penColor);
 		}
 	}
 
-	void DrawTriangle(const Point2d& t0, const Point2d& t1, const Point2d& t2)
+	void DrawPoint(const Point2d& p, const cd::TVector<uint8_t, 3>& color)
 	{
-		DrawLine(t0, t1);
-		DrawLine(t0, t2);
-		DrawLine(t1, t2);
+		size_t texelOffset = (static_cast<size_t>(p.y()) * m_uvmapWidth + p.x()) * m_channelCount;
+		m_uvmapContent[texelOffset] = color.x();
+		m_uvmapContent[texelOffset + 1] = color.y();
+		m_uvmapContent[texelOffset + 2] = color.z();
 	}
 
 	void SavePicture() const
@@ -221,14 +383,20 @@ private:
 	int32_t m_uvmapUnitHeight = 512;
 	int32_t m_uvmapMaxWidth = 4096;
 	int32_t m_uvmapMaxHeight = 4096;
+	UVMapDrawMode m_drawMode = UVMapDrawMode::Wireframe;
 
-	int32_t m_uvmapWidth;
-	int32_t m_uvmapHeight;
-	int32_t m_uvmapStride;
+	int32_t m_uvmapWidth = 0;
+	int32_t m_uvmapHeight = 0;
+	int32_t m_uvmapStride = 0;
 
 	std::string m_filePath;
 	cd::TVector<uint8_t, 3> m_penColor { 255, 0, 0 };
+	cd::TVector<uint8_t, 3> m_fillColor { 0, 160, 0 };
+	cd::TVector<uint8_t, 3> m_overlapColor { 255, 0, 0 };
 	std::vector<uint8_t> m_uvmapContent;
+	std::vector<uint32_t> m_texelCoverages;
+	uint64_t m_coveredTexelCount = 0U;
+	uint64_t m_overlappedTexelCount = 0U;
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,132 @@
+#include "Animation/AnimatedAABBBaker.h"
+
+#include "Animation/AnimationResampler.h"
+#include "Animation/PoseEvaluator.h"
+#include "Scene/SceneDatabase.h"
+#include "Utilities/ParallelFor.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace
+{
+
+// Merging any box into it returns that box.
+cd::AABB InvalidAABB()
+{
+	return cd::AABB(FLT_MAX, -FLT_MAX);
+}
+
+bool IsValid(const cd::AABB& aabb)
+{
+	return aabb.Min().x() <= aabb.Max().x();
+}
+
+void MergePoint(cd::AABB& aabb, const cd::Point& point)
+{
+	aabb.Merge(cd::AABB(point, point));
+}
+
+cd::Point TransformPoint(const cd::Matrix4x4& matrix, const cd::Point& point)
+{
+	cd::Vec4f result = matrix * cd::Vec4f(point.x(), point.y(), point.z(), 1.0f);
+	return cd::Point(result.x(), result.y(), result.z());
+}
+
+}
+
+namespace cd
+{
+
+bool AnimatedAABBBaker::Bake(const SceneDatabase& sceneDatabase, Animation& animation, float sampleRate, uint32_t windowFrameCount)
+{
+	PoseEvaluator poseEvaluator(sceneDatabase, &animation);
+	uint32_t boneCount = poseEvaluator.GetBoneCount();
+
+	// Bound vertices in the space of every bone which influences them. Vertices without valid influences don't move.
+	std::vector<AABB> boneAABBs(boneCount, InvalidAABB());
+	AABB rigidAABB = InvalidAABB();
+	bool hasSkinnedVertex = false;
+	for (const Mesh& mesh : sceneDatabase.GetMeshes())
+	{
+		if (0U == mesh.GetVertexInfluenceCount())
+		{
+			continue;
+		}
+
+		for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+		{
+			const Point& position = mesh.GetVertexPosition(vertexIndex);
+			bool isSkinned = false;
+			for (uint32_t influenceIndex = 0U; influenceIndex < mesh.GetVertexInfluenceCount(); ++influenceIndex)
+			{
+				uint32_t boneIndex = poseEvaluator.GetBoneIndex(mesh.GetVertexBoneID(influenceIndex, vertexIndex).Data());
+				if (mesh.GetVertexWeight(influenceIndex, vertexIndex) <= 0.0f || PoseEvaluator::InvalidIndex == boneIndex)
+				{
+					continue;
+				}
+
+				const Bone& bone = sceneDatabase.GetBone(poseEvaluator.GetBoneIDs()[boneIndex]);
+				MergePoint(boneAABBs[boneIndex], TransformPoint(bone.GetOffset(), position));
+				isSkinned = true;
+			}
+
+			if (!isSkinned)
+			{
+				MergePoint(rigidAABB, position);
+			}
+			hasSkinnedVertex |= isSkinned;
+		}
+	}
+
+	if (!hasSkinnedVertex)
+	{
+		return false;
+	}
+
+	uint32_t frameCount;
+	float frameInterval = AnimationResampler::CalculateKeyInterval(animation, sampleRate, frameCount);
+	windowFrameCount = std::max(windowFrameCount, 1U);
+	uint32_t windowCount = std::max(1U, (frameCount - 1U + windowFrameCount - 1U) / windowFrameCount);
+
+	std::vector<AABB> windowAABBs(windowCount);
+	ParallelFor(windowCount, [&](uint32_t windowIndex)
+	{
+		// Evaluators keep key cursors so every window uses its own copy.
+		PoseEvaluator windowPoseEvaluator(poseEvaluator);
+		std::vector<Transform> localTransforms;
+		std::vector<Matrix4x4> worldMatrices;
+
+		AABB windowAABB = rigidAABB;
+		uint32_t beginFrame = windowIndex * windowFrameCount;
+		uint32_t endFrame = std::min(beginFrame + windowFrameCount, frameCount - 1U);
+		for (uint32_t frameIndex = beginFrame; frameIndex <= endFrame; ++frameIndex)
+		{
+			windowPoseEvaluator.SampleLocalTransforms(static_cast<float>(frameIndex) * frameInterval, localTransforms);
+			windowPoseEvaluator.SolveWorldMatrices(localTransforms, worldMatrices);
+			for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+			{
+				if (IsValid(boneAABBs[boneIndex]))
+				{
+					AABB boneAABB = boneAABBs[boneIndex];
+					windowAABB.Merge(boneAABB.Transform(worldMatrices[boneIndex]));
+				}
+			}
+		}
+		windowAABBs[windowIndex] = windowAABB;
+	});
+
+	AABB aabb = InvalidAABB();
+	for (const AABB& windowAABB : windowAABBs)
+	{
+		aabb.Merge(windowAABB);
+	}
+
+	animation.SetAABB(cd::MoveTemp(aabb));
+	animation.SetWindowAABBDuration(static_cast<float>(windowFrameCount) * frameInterval);
+	animation.SetWindowAABBs(cd::MoveTemp(windowAABBs));
+
+	return true;
+}
+
+}
@@ -0,0 +1,169 @@
+#include "Animation/AnimationCompressor.h"
+
+#include "Animation/KeyFrameQuantizer.hpp"
+#include "Scene/Track.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Interpolation spans are limited so reducing long linear channels doesn't become quadratic.
+constexpr size_t MaxReduceSpan = 256U;
+
+cd::Vec3f Interpolate(const cd::Vec3f& a, const cd::Vec3f& b, float factor)
+{
+	return cd::Vec3f::Lerp(a, b, factor);
+}
+
+cd::Quaternion Interpolate(const cd::Quaternion& a, const cd::Quaternion& b, float factor)
+{
+	return cd::Quaternion::SLerp(a, b, factor);
+}
+
+float MeasureError(const cd::TranslationKey&, const cd::Vec3f& a, const cd::Vec3f& b, const cd::AnimationCompressionOptions&)
+{
+	return (a - b).Length();
+}
+
+float MeasureError(const cd::RotationKey&, const cd::Quaternion& a, const cd::Quaternion& b, const cd::AnimationCompressionOptions& options)
+{
+	// Chord length of the arc which a point at errorDistance moves along : 2 * d * sin(angle / 2).
+	float cosHalfAngle = std::min(std::abs(a.Dot(b)) / (a.Length() * b.Length()), 1.0f);
+	return 2.0f * options.errorDistance * std::sqrt(1.0f - cosHalfAngle * cosHalfAngle);
+}
+
+float MeasureError(const cd::ScaleKey&, const cd::Vec3f& a, const cd::Vec3f& b, const cd::AnimationCompressionOptions& options)
+{
+	return (a - b).Length() * options.errorDistance;
+}
+
+template<typename KeyFrameType>
+bool CanInterpolate(const std::vector<KeyFrameType>& keys, size_t beginIndex, size_t endIndex, const cd::AnimationCompressionOptions& options)
+{
+	const KeyFrameType& beginKey = keys[beginIndex];
+	const KeyFrameType& endKey = keys[endIndex];
+	float inverseDuration = 1.0f / (endKey.GetTime() - beginKey.GetTime());
+	for (size_t keyIndex = beginIndex + 1U; keyIndex < endIndex; ++keyIndex)
+	{
+		const KeyFrameType& key = keys[keyIndex];
+		float factor = (key.GetTime() - beginKey.GetTime()) * inverseDuration;
+		if (MeasureError(key, Interpolate(beginKey.GetValue(), endKey.GetValue(), factor), key.GetValue(), options) > options.maxError)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename KeyFrameType>
+uint32_t ReduceKeyFrames(std::vector<KeyFrameType>& keys, const cd::AnimationCompressionOptions& options)
+{
+	if (keys.size() < 2U)
+	{
+		return 0U;
+	}
+
+	// Constant channel only needs one key.
+	if (std::all_of(keys.begin(), keys.end(), [&keys, &options](const KeyFrameType& key) { return MeasureError(key, keys.front().GetValue(), key.GetValue(), options) <= options.maxError; }))
+	{
+		auto removedKeyCount = static_cast<uint32_t>(keys.size() - 1U);
+		keys.resize(1U);
+		return removedKeyCount;
+	}
+
+	// Greedy : extend the span from the last kept key until any key inside can't be reproduced.
+	std::vector<KeyFrameType> reducedKeys;
+	reducedKeys.push_back(keys.front());
+	size_t anchorIndex = 0U;
+	for (size_t endIndex = 2U; endIndex < keys.size(); ++endIndex)
+	{
+		if (endIndex - anchorIndex > MaxReduceSpan || !CanInterpolate(keys, anchorIndex, endIndex, options))
+		{
+			anchorIndex = endIndex - 1U;
+			reducedKeys.push_back(keys[anchorIndex]);
+		}
+	}
+	reducedKeys.push_back(keys.back());
+
+	auto removedKeyCount = static_cast<uint32_t>(keys.size() - reducedKeys.size());
+	keys = cd::MoveTemp(reducedKeys);
+	return removedKeyCount;
+}
+
+template<typename KeyFrameType>
+bool QuantizeKeyFrames(const std::vector<KeyFrameType>& keys, bool isUniform, std::vector<KeyFrameType>& quantizedKeys)
+{
+	cd::KeyFrameQuantizer::Decode(cd::KeyFrameQuantizer::Encode(keys), quantizedKeys);
+	if (isUniform)
+	{
+		// Times of uniform tracks are implicit and not quantized.
+		for (size_t keyIndex = 0U; keyIndex < quantizedKeys.size(); ++keyIndex)
+		{
+			quantizedKeys[keyIndex].SetTime(keys[keyIndex].GetTime());
+		}
+		return true;
+	}
+
+	for (size_t keyIndex = 1U; keyIndex < quantizedKeys.size(); ++keyIndex)
+	{
+		if (quantizedKeys[keyIndex].GetTime() <= quantizedKeys[keyIndex - 1U].GetTime())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+}
+
+namespace cd
+{
+
+uint32_t AnimationCompressor::ReduceKeys(Track& track, const AnimationCompressionOptions& options)
+{
+	// Removing keys breaks implicit times of uniform tracks.
+	if (track.IsUniform())
+	{
+		return 0U;
+	}
+
+	return ReduceKeyFrames(track.GetTranslationKeys(), options) +
+		ReduceKeyFrames(track.GetRotationKeys(), options) +
+		ReduceKeyFrames(track.GetScaleKeys(), options);
+}
+
+bool AnimationCompressor::Quantize(Track& track)
+{
+	std::vector<TranslationKey> translationKeys;
+	std::vector<RotationKey> rotationKeys;
+	std::vector<ScaleKey> scaleKeys;
+	if (!QuantizeKeyFrames(track.GetTranslationKeys(), track.IsUniform(), translationKeys) ||
+		!QuantizeKeyFrames(track.GetRotationKeys(), track.IsUniform(), rotationKeys) ||
+		!QuantizeKeyFrames(track.GetScaleKeys(), track.IsUniform(), scaleKeys))
+	{
+		return false;
+	}
+
+	track.SetTranslationKeys(MoveTemp(translationKeys));
+	track.SetRotationKeys(MoveTemp(rotationKeys));
+	track.SetScaleKeys(MoveTemp(scaleKeys));
+	track.SetQuantized(true);
+	return true;
+}
+
+uint32_t AnimationCompressor::Compress(Track& track, const AnimationCompressionOptions& options)
+{
+	uint32_t removedKeyCount = ReduceKeys(track, options);
+	if (options.quantize)
+	{
+		Quantize(track);
+	}
+
+	return removedKeyCount;
+}
+
+}
@@ -0,0 +1,72 @@
+#include "Animation/AnimationResampler.h"
+
+#include "Animation/TrackSampler.h"
+#include "Scene/Animation.h"
+#include "Scene/Track.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Assimp uses 25 ticks per second when files don't specify it.
+constexpr float DefaultTicksPerSecond = 25.0f;
+
+template<typename KeyFrameType, typename SampleFunction>
+void ResampleKeyFrames(std::vector<KeyFrameType>& keys, float keyInterval, uint32_t keyCount, SampleFunction sample)
+{
+	if (keys.empty())
+	{
+		return;
+	}
+
+	keys.resize(keyCount);
+	for (uint32_t keyIndex = 0U; keyIndex < keyCount; ++keyIndex)
+	{
+		float time = static_cast<float>(keyIndex) * keyInterval;
+		keys[keyIndex].SetTime(time);
+		keys[keyIndex].SetValue(sample(time));
+	}
+}
+
+}
+
+namespace cd
+{
+
+float AnimationResampler::CalculateKeyInterval(const Animation& animation, float sampleRate, uint32_t& keyCount)
+{
+	float ticksPerSecond = animation.GetTicksPerSecnod() > 0.0f && std::isfinite(animation.GetTicksPerSecnod()) ? animation.GetTicksPerSecnod() : DefaultTicksPerSecond;
+	float validSampleRate = sampleRate > 0.0f && std::isfinite(sampleRate) ? std::min(sampleRate, MaxSampleRate) : DefaultSampleRate;
+	float keyInterval = ticksPerSecond / validSampleRate;
+
+	float duration = animation.GetDuration();
+	if (!(duration > 0.0f) || !std::isfinite(duration))
+	{
+		keyCount = 1U;
+		return keyInterval;
+	}
+
+	// Clamp before converting to integer because out of range float to integer conversion is undefined.
+	double intervals = std::round(static_cast<double>(duration) / keyInterval);
+	auto intervalCount = static_cast<uint32_t>(std::clamp(intervals, 1.0, static_cast<double>(MaxKeyCount - 1U)));
+	keyCount = intervalCount + 1U;
+	return duration / static_cast<float>(intervalCount);
+}
+
+void AnimationResampler::Resample(Track& track, float keyInterval, uint32_t keyCount)
+{
+	// Channels are sampled from a copy of source keys before they are overwritten.
+	TrackSampler sampler(track);
+	TrackCursor cursor;
+
+	ResampleKeyFrames(track.GetTranslationKeys(), keyInterval, keyCount, [&sampler, &cursor](float time) { return sampler.SampleTranslation(time, cursor); });
+	ResampleKeyFrames(track.GetRotationKeys(), keyInterval, keyCount, [&sampler, &cursor](float time) { return sampler.SampleRotation(time, cursor); });
+	ResampleKeyFrames(track.GetScaleKeys(), keyInterval, keyCount, [&sampler, &cursor](float time) { return sampler.SampleScale(time, cursor); });
+
+	track.SetKeyInterval(keyInterval);
+	track.SetQuantized(false);
+}
+
+}
@@ -0,0 +1,348 @@
+#include "Animation/PoseEvaluator.h"
+
+#include "Math/SIMD.hpp"
+#include "Scene/SceneDatabase.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace
+{
+
+constexpr uint32_t LaneCount = 4U;
+
+// Batch values [0, 4) are interpolation sources and [4, 8) are targets. Results are written back to sources.
+template<typename ValueType>
+void GatherKeys(const std::vector<float>& times, const std::vector<ValueType>& values, float keyInterval, const ValueType& restValue, float time, uint32_t& cursorKeyIndex,
+	std::vector<float>* pBatchValues, std::vector<float>& batchFactors, uint32_t lane)
+{
+	const ValueType* pSource = &restValue;
+	const ValueType* pTarget = &restValue;
+	float factor = 0.0f;
+	if (!values.empty())
+	{
+		uint32_t keyIndex = keyInterval > 0.0f ? cd::TrackSampler::FindUniformKey(static_cast<uint32_t>(values.size()), keyInterval, time, factor) :
+			cd::TrackSampler::FindKey(times, time, cursorKeyIndex, factor);
+		pSource = &values[keyIndex];
+		pTarget = &values[std::min(keyIndex + 1U, static_cast<uint32_t>(values.size()) - 1U)];
+	}
+
+	// Interpolate rotations along the shortest arc.
+	float targetSign = 1.0f;
+	if constexpr (std::is_same_v<ValueType, cd::Quaternion>)
+	{
+		targetSign = pSource->Dot(*pTarget) < 0.0f ? -1.0f : 1.0f;
+	}
+
+	for (uint32_t componentIndex = 0U; componentIndex < ValueType::Size; ++componentIndex)
+	{
+		pBatchValues[componentIndex][lane] = *(pSource->Begin() + componentIndex);
+		pBatchValues[LaneCount + componentIndex][lane] = *(pTarget->Begin() + componentIndex) * targetSign;
+	}
+	batchFactors[lane] = factor;
+}
+
+void LerpBatch(std::vector<float>* pBatchValues, const std::vector<float>& batchFactors, uint32_t componentCount)
+{
+	for (size_t lane = 0U; lane < batchFactors.size(); lane += LaneCount)
+	{
+		cd::Float4 factor = cd::Float4::Load(&batchFactors[lane]);
+		for (uint32_t componentIndex = 0U; componentIndex < componentCount; ++componentIndex)
+		{
+			cd::Float4 source = cd::Float4::Load(&pBatchValues[componentIndex][lane]);
+			cd::Float4 target = cd::Float4::Load(&pBatchValues[LaneCount + componentIndex][lane]);
+			cd::Float4::MultiplyAdd(target - source, factor, source).Store(&pBatchValues[componentIndex][lane]);
+		}
+	}
+}
+
+// "A Fast and Accurate Algorithm for Computing SLERP" David Eberly, 2011.
+// sin(t * angle) / sin(angle) is expanded as a series of (cos(angle) - 1) with only multiplications and additions.
+// The last term is scaled by mu to compensate the truncated terms so it runs in SIMD lanes without acos and sin.
+// Results are renormalized because the series converges slowly when two rotations are 180 degrees apart.
+void SLerpBatch(std::vector<float>* pBatchValues, const std::vector<float>& batchFactors)
+{
+	constexpr float Mu = 1.85298109240830f;
+	constexpr float U[8] = { 1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9), 1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), Mu / (8 * 17) };
+	constexpr float V[8] = { 1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9, 5.0f / 11, 6.0f / 13, 7.0f / 15, Mu * 8 / 17 };
+
+	cd::Float4 one = cd::Float4::Splat(1.0f);
+	for (size_t lane = 0U; lane < batchFactors.size(); lane += LaneCount)
+	{
+		cd::Float4 sources[4];
+		cd::Float4 targets[4];
+		cd::Float4 cosAngle = cd::Float4::Zero();
+		for (uint32_t componentIndex = 0U; componentIndex < 4U; ++componentIndex)
+		{
+			sources[componentIndex] = cd::Float4::Load(&pBatchValues[componentIndex][lane]);
+			targets[componentIndex] = cd::Float4::Load(&pBatchValues[LaneCount + componentIndex][lane]);
+			cosAngle = cd::Float4::MultiplyAdd(sources[componentIndex], targets[componentIndex], cosAngle);
+		}
+
+		cd::Float4 t = cd::Float4::Load(&batchFactors[lane]);
+		cd::Float4 d = one - t;
+		cd::Float4 squareT = t * t;
+		cd::Float4 squareD = d * d;
+		cd::Float4 cosAngleMinusOne = cosAngle - one;
+
+		cd::Float4 targetScale = one;
+		cd::Float4 sourceScale = one;
+		for (int termIndex = 7; termIndex >= 0; --termIndex)
+		{
+			cd::Float4 v = cd::Float4::Splat(V[termIndex]);
+			targetScale = cd::Float4::MultiplyAdd((squareT * U[termIndex] - v) * cosAngleMinusOne, targetScale, one);
+			sourceScale = cd::Float4::MultiplyAdd((squareD * U[termIndex] - v) * cosAngleMinusOne, sourceScale, one);
+		}
+		targetScale *= t;
+		sourceScale *= d;
+
+		cd::Float4 results[4];
+		cd::Float4 lengthSquare = cd::Float4::Zero();
+		for (uint32_t componentIndex = 0U; componentIndex < 4U; ++componentIndex)
+		{
+			results[componentIndex] = cd::Float4::MultiplyAdd(targets[componentIndex], targetScale, sources[componentIndex] * sourceScale);
+			lengthSquare = cd::Float4::MultiplyAdd(results[componentIndex], results[componentIndex], lengthSquare);
+		}
+
+		// Padding lanes are zero quaternions which are kept as they are.
+		cd::Float4 inverseLength = one / cd::Float4::Sqrt(cd::Float4::Max(lengthSquare, cd::Float4::Splat(1e-12f)));
+		for (uint32_t componentIndex = 0U; componentIndex < 4U; ++componentIndex)
+		{
+			(results[componentIndex] * inverseLength).Store(&pBatchValues[componentIndex][lane]);
+		}
+	}
+}
+
+cd::Matrix4x4 CalculateLocalMatrix(const cd::Transform& transform)
+{
+	cd::Matrix3x3 rotation = transform.GetRotation().ToMatrix3x3();
+	const cd::Vec3f& scale = transform.GetScale();
+	const cd::Vec3f& translation = transform.GetTranslation();
+
+	cd::Matrix4x4 localMatrix;
+	for (int columnIndex = 0; columnIndex < 3; ++columnIndex)
+	{
+		const cd::Vec3f& column = rotation.GetColumn(columnIndex);
+		localMatrix.GetColumn(columnIndex) = cd::Vec4f(column.x() * scale[columnIndex], column.y() * scale[columnIndex], column.z() * scale[columnIndex], 0.0f);
+	}
+	localMatrix.GetColumn(3) = cd::Vec4f(translation.x(), translation.y(), translation.z(), 1.0f);
+
+	return localMatrix;
+}
+
+// Column major a * b. Every result column is a linear combination of columns of a.
+cd::Matrix4x4 MultiplyMatrix(const cd::Matrix4x4& a, const cd::Matrix4x4& b)
+{
+	cd::Float4 aColumns[4];
+	for (int columnIndex = 0; columnIndex < 4; ++columnIndex)
+	{
+		aColumns[columnIndex] = cd::Float4::Load(a.Begin() + columnIndex * 4);
+	}
+
+	cd::Matrix4x4 result;
+	for (int columnIndex = 0; columnIndex < 4; ++columnIndex)
+	{
+		const float* pB = b.Begin() + columnIndex * 4;
+		cd::Float4 column = aColumns[0] * pB[0];
+		column = cd::Float4::MultiplyAdd(aColumns[1], cd::Float4::Splat(pB[1]), column);
+		column = cd::Float4::MultiplyAdd(aColumns[2], cd::Float4::Splat(pB[2]), column);
+		column = cd::Float4::MultiplyAdd(aColumns[3], cd::Float4::Splat(pB[3]), column);
+		column.Store(result.Begin() + columnIndex * 4);
+	}
+
+	return result;
+}
+
+}
+
+namespace cd
+{
+
+PoseEvaluator::PoseEvaluator(const SceneDatabase& sceneDatabase, const Animation* pAnimation)
+{
+	Init(sceneDatabase, pAnimation);
+}
+
+void PoseEvaluator::Init(const SceneDatabase& sceneDatabase, const Animation* pAnimation)
+{
+	const std::vector<Bone>& bones = sceneDatabase.GetBones();
+	auto boneCount = static_cast<uint32_t>(bones.size());
+
+	uint32_t boneIDCount = 0U;
+	for (const Bone& bone : bones)
+	{
+		boneIDCount = std::max(boneIDCount, bone.GetID().Data() + 1U);
+	}
+
+	std::vector<uint32_t> boneIDToSourceIndexes(boneIDCount, InvalidIndex);
+	for (uint32_t sourceIndex = 0U; sourceIndex < boneCount; ++sourceIndex)
+	{
+		boneIDToSourceIndexes[bones[sourceIndex].GetID().Data()] = sourceIndex;
+	}
+
+	auto GetSourceParentIndex = [&bones, &boneIDToSourceIndexes](uint32_t sourceIndex)
+	{
+		const BoneID& parentID = bones[sourceIndex].GetParentID();
+		return parentID.IsValid() && parentID.Data() < boneIDToSourceIndexes.size() ? boneIDToSourceIndexes[parentID.Data()] : InvalidIndex;
+	};
+
+	// Depths are calculated by walking up to the first bone whose depth is known. Broken parent loops are cut as roots.
+	std::vector<uint32_t> depths(boneCount, InvalidIndex);
+	std::vector<uint32_t> chain;
+	for (uint32_t sourceIndex = 0U; sourceIndex < boneCount; ++sourceIndex)
+	{
+		chain.clear();
+		uint32_t currentIndex = sourceIndex;
+		while (currentIndex != InvalidIndex && InvalidIndex == depths[currentIndex] && chain.size() <= boneCount)
+		{
+			chain.push_back(currentIndex);
+			currentIndex = GetSourceParentIndex(currentIndex);
+		}
+
+		uint32_t depth = currentIndex != InvalidIndex && depths[currentIndex] != InvalidIndex ? depths[currentIndex] + 1U : 0U;
+		for (auto itChain = chain.rbegin(); itChain != chain.rend(); ++itChain)
+		{
+			if (InvalidIndex == depths[*itChain])
+			{
+				depths[*itChain] = depth++;
+			}
+		}
+	}
+
+	std::vector<uint32_t> sortedSourceIndexes(boneCount);
+	std::iota(sortedSourceIndexes.begin(), sortedSourceIndexes.end(), 0U);
+	std::stable_sort(sortedSourceIndexes.begin(), sortedSourceIndexes.end(), [&depths](uint32_t lhs, uint32_t rhs) { return depths[lhs] < depths[rhs]; });
+
+	m_boneIDs.resize(boneCount);
+	m_parentIndexes.resize(boneCount);
+	m_restTransforms.resize(boneCount);
+	m_offsetMatrices.resize(boneCount);
+	m_boneIDToIndexes.assign(boneIDCount, InvalidIndex);
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		const Bone& bone = bones[sortedSourceIndexes[boneIndex]];
+		m_boneIDs[boneIndex] = bone.GetID().Data();
+		m_restTransforms[boneIndex] = bone.GetTransform();
+		m_offsetMatrices[boneIndex] = bone.GetOffset();
+		m_boneIDToIndexes[bone.GetID().Data()] = boneIndex;
+	}
+
+	for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+	{
+		uint32_t sourceParentIndex = GetSourceParentIndex(sortedSourceIndexes[boneIndex]);
+		uint32_t parentIndex = InvalidIndex != sourceParentIndex ? m_boneIDToIndexes[bones[sourceParentIndex].GetID().Data()] : InvalidIndex;
+		m_parentIndexes[boneIndex] = parentIndex < boneIndex ? parentIndex : InvalidIndex;
+	}
+
+	m_trackSamplers.clear();
+	m_trackCursors.clear();
+	m_trackBoneIndexes.clear();
+	if (pAnimation)
+	{
+		std::unordered_map<std::string, uint32_t> boneNameToIndexes;
+		for (uint32_t boneIndex = 0U; boneIndex < boneCount; ++boneIndex)
+		{
+			boneNameToIndexes[bones[sortedSourceIndexes[boneIndex]].GetName()] = boneIndex;
+		}
+
+		for (const TrackID& trackID : pAnimation->GetBoneTrackIDs())
+		{
+			if (trackID.Data() >= sceneDatabase.GetTrackCount())
+			{
+				continue;
+			}
+
+			const Track& track = sceneDatabase.GetTrack(trackID.Data());
+			auto itBone = boneNameToIndexes.find(track.GetName());
+			if (itBone != boneNameToIndexes.end())
+			{
+				m_trackSamplers.emplace_back(track);
+				m_trackBoneIndexes.push_back(itBone->second);
+			}
+		}
+		m_trackCursors.resize(m_trackSamplers.size());
+	}
+
+	uint32_t batchSize = (GetAnimatedBoneCount() + LaneCount - 1U) / LaneCount * LaneCount;
+	for (std::vector<float>& batchValues : m_batchValues)
+	{
+		batchValues.assign(batchSize, 0.0f);
+	}
+	m_batchFactors.assign(batchSize, 0.0f);
+}
+
+void PoseEvaluator::SampleLocalTransforms(float time, std::vector<Transform>& localTransforms)
+{
+	localTransforms = m_restTransforms;
+
+	uint32_t animatedBoneCount = GetAnimatedBoneCount();
+	for (uint32_t animatedBoneIndex = 0U; animatedBoneIndex < animatedBoneCount; ++animatedBoneIndex)
+	{
+		const TrackSampler& sampler = m_trackSamplers[animatedBoneIndex];
+		GatherKeys(sampler.GetTranslationTimes(), sampler.GetTranslations(), sampler.GetKeyInterval(), m_restTransforms[m_trackBoneIndexes[animatedBoneIndex]].GetTranslation(),
+			time, m_trackCursors[animatedBoneIndex].translationKeyIndex, m_batchValues, m_batchFactors, animatedBoneIndex);
+	}
+	LerpBatch(m_batchValues, m_batchFactors, 3U);
+	for (uint32_t animatedBoneIndex = 0U; animatedBoneIndex < animatedBoneCount; ++animatedBoneIndex)
+	{
+		localTransforms[m_trackBoneIndexes[animatedBoneIndex]].SetTranslation(Vec3f(m_batchValues[0][animatedBoneIndex], m_batchValues[1][animatedBoneIndex], m_batchValues[2][animatedBoneIndex]));
+	}
+
+	for (uint32_t animatedBoneIndex = 0U; animatedBoneIndex < animatedBoneCount; ++animatedBoneIndex)
+	{
+		const TrackSampler& sampler = m_trackSamplers[animatedBoneIndex];
+		GatherKeys(sampler.GetRotationTimes(), sampler.GetRotations(), sampler.GetKeyInterval(), m_restTransforms[m_trackBoneIndexes[animatedBoneIndex]].GetRotation(),
+			time, m_trackCursors[animatedBoneIndex].rotationKeyIndex, m_batchValues, m_batchFactors, animatedBoneIndex);
+	}
+	SLerpBatch(m_batchValues, m_batchFactors);
+	for (uint32_t animatedBoneIndex = 0U; animatedBoneIndex < animatedBoneCount; ++animatedBoneIndex)
+	{
+		localTransforms[m_trackBoneIndexes[animatedBoneIndex]].SetRotation(Quaternion(m_batchValues[3][animatedBoneIndex],
+			m_batchValues[0][animatedBoneIndex], m_batchValues[1][animatedBoneIndex], m_batchValues[2][animatedBoneIndex]));
+	}
+
+	for (uint32_t animatedBoneIndex = 0U; animatedBoneIndex < animatedBoneCount; ++animatedBoneIndex)
+	{
+		const TrackSampler& sampler = m_trackSamplers[animatedBoneIndex];
+		GatherKeys(sampler.GetScaleTimes(), sampler.GetScales(), sampler.GetKeyInterval(), m_restTransforms[m_trackBoneIndexes[animatedBoneIndex]].GetScale(),
+			time, m_trackCursors[animatedBoneIndex].scaleKeyIndex, m_batchValues, m_batchFactors, animatedBoneIndex);
+	}
+	LerpBatch(m_batchValues, m_batchFactors, 3U);
+	for (uint32_t animatedBoneIndex = 0U; animatedBoneIndex < animatedBoneCount; ++animatedBoneIndex)
+	{
+		localTransforms[m_trackBoneIndexes[animatedBoneIndex]].SetScale(Vec3f(m_batchValues[0][animatedBoneIndex], m_batchValues[1][animatedBoneIndex], m_batchValues[2][animatedBoneIndex]));
+	}
+}
+
+void PoseEvaluator::SolveWorldMatrices(const std::vector<Transform>& localTransforms, std::vector<Matrix4x4>& worldMatrices) const
+{
+	// Parents are always before children so one pass is enough.
+	worldMatrices.resize(GetBoneCount());
+	for (uint32_t boneIndex = 0U; boneIndex < GetBoneCount(); ++boneIndex)
+	{
+		Matrix4x4 localMatrix = CalculateLocalMatrix(localTransforms[boneIndex]);
+		uint32_t parentIndex = m_parentIndexes[boneIndex];
+		worldMatrices[boneIndex] = InvalidIndex == parentIndex ? localMatrix : MultiplyMatrix(worldMatrices[parentIndex], localMatrix);
+	}
+}
+
+void PoseEvaluator::CalculateSkinningMatrices(const std::vector<Matrix4x4>& worldMatrices, std::vector<Matrix4x4>& skinningMatrices) const
+{
+	skinningMatrices.assign(m_boneIDToIndexes.size(), Matrix4x4::Identity());
+	for (uint32_t boneIndex = 0U; boneIndex < GetBoneCount(); ++boneIndex)
+	{
+		skinningMatrices[m_boneIDs[boneIndex]] = MultiplyMatrix(worldMatrices[boneIndex], m_offsetMatrices[boneIndex]);
+	}
+}
+
+void PoseEvaluator::Evaluate(float time, std::vector<Matrix4x4>& skinningMatrices)
+{
+	SampleLocalTransforms(time, m_localTransforms);
+	SolveWorldMatrices(m_localTransforms, m_worldMatrices);
+	CalculateSkinningMatrices(m_worldMatrices, skinningMatrices);
+}
+
+}
@@ -0,0 +1,355 @@
+#include "Animation/SkinningOptimizer.h"
+
+#include "Scene/Mesh.h"
+#include "Scene/VertexFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+
+constexpr uint32_t InvalidIndex = 0xFFFFFFFF;
+
+struct Influence
+{
+	cd::BoneID boneID;
+	cd::VertexWeight weight;
+};
+
+// Returns the number of influences which have positive weights. They are sorted by weights in descending order.
+uint32_t GatherInfluences(const cd::Mesh& mesh, uint32_t vertexIndex, std::array<Influence, cd::MaxBoneInfluenceCount>& influences)
+{
+	uint32_t influenceCount = 0U;
+	for (uint32_t influenceIndex = 0U; influenceIndex < mesh.GetVertexInfluenceCount(); ++influenceIndex)
+	{
+		cd::VertexWeight weight = mesh.GetVertexWeight(influenceIndex, vertexIndex);
+		if (weight > 0.0f)
+		{
+			influences[influenceCount++] = Influence{ mesh.GetVertexBoneID(influenceIndex, vertexIndex), weight };
+		}
+	}
+
+	std::sort(influences.begin(), influences.begin() + influenceCount, [](const Influence& lhs, const Influence& rhs)
+	{
+		return lhs.weight != rhs.weight ? lhs.weight > rhs.weight : lhs.boneID.Data() < rhs.boneID.Data();
+	});
+
+	return influenceCount;
+}
+
+uint32_t GetMaxBoneID(const cd::Mesh& mesh)
+{
+	uint32_t maxBoneID = 0U;
+	for (uint32_t influenceIndex = 0U; influenceIndex < mesh.GetVertexInfluenceCount(); ++influenceIndex)
+	{
+		for (const cd::BoneID& boneID : mesh.GetVertexBoneIDs(influenceIndex))
+		{
+			maxBoneID = std::max(maxBoneID, boneID.Data());
+		}
+	}
+
+	return maxBoneID;
+}
+
+template<typename T>
+std::vector<T> GatherArrayElements(const std::vector<T>& data, const std::vector<uint32_t>& sourceIndexes)
+{
+	std::vector<T> gatheredData;
+	if (data.empty())
+	{
+		return gatheredData;
+	}
+
+	gatheredData.reserve(sourceIndexes.size());
+	for (uint32_t sourceIndex : sourceIndexes)
+	{
+		gatheredData.push_back(data[sourceIndex]);
+	}
+
+	return gatheredData;
+}
+
+// Copies polygons and vertices which they refer to. Vertices are ordered by their first references.
+cd::Mesh ExtractPolygons(const cd::Mesh& sourceMesh, const std::vector<uint32_t>& polygonIndexes, cd::MeshID meshID, const char* pMeshName)
+{
+	std::vector<uint32_t> oldToNewVertexIndexes(sourceMesh.GetVertexCount(), InvalidIndex);
+	std::vector<uint32_t> newToOldVertexIndexes;
+	std::vector<cd::Polygon> polygons;
+	polygons.reserve(polygonIndexes.size());
+	for (uint32_t polygonIndex : polygonIndexes)
+	{
+		cd::Polygon polygon = sourceMesh.GetPolygon(polygonIndex);
+		for (uint32_t cornerIndex = 0U; cornerIndex < cd::Polygon::Size; ++cornerIndex)
+		{
+			uint32_t oldVertexIndex = polygon[cornerIndex].Data();
+			if (InvalidIndex == oldToNewVertexIndexes[oldVertexIndex])
+			{
+				oldToNewVertexIndexes[oldVertexIndex] = static_cast<uint32_t>(newToOldVertexIndexes.size());
+				newToOldVertexIndexes.push_back(oldVertexIndex);
+			}
+			polygon[cornerIndex] = cd::VertexID(oldToNewVertexIndexes[oldVertexIndex]);
+		}
+		polygons.push_back(polygon);
+	}
+
+	cd::Mesh mesh(meshID, pMeshName, static_cast<uint32_t>(newToOldVertexIndexes.size()), static_cast<uint32_t>(polygons.size()));
+	mesh.SetMaterialID(sourceMesh.GetMaterialID().Data());
+	for (const cd::VertexAttributeLayout& layout : sourceMesh.GetVertexFormat().GetVertexLayout())
+	{
+		mesh.GetVertexFormat().AddAttributeLayout(layout.vertexAttributeType, layout.attributeValueType, layout.attributeCount);
+	}
+
+	mesh.GetPolygons() = cd::MoveTemp(polygons);
+	mesh.GetVertexPositions() = GatherArrayElements(sourceMesh.GetVertexPositions(), newToOldVertexIndexes);
+	mesh.GetVertexNormals() = GatherArrayElements(sourceMesh.GetVertexNormals(), newToOldVertexIndexes);
+	mesh.GetVertexTangents() = GatherArrayElements(sourceMesh.GetVertexTangents(), newToOldVertexIndexes);
+	mesh.GetVertexBiTangents() = GatherArrayElements(sourceMesh.GetVertexBiTangents(), newToOldVertexIndexes);
+
+	mesh.SetVertexUVSetCount(sourceMesh.GetVertexUVSetCount());
+	for (uint32_t uvSetIndex = 0U; uvSetIndex < sourceMesh.GetVertexUVSetCount(); ++uvSetIndex)
+	{
+		mesh.GetVertexUVs(uvSetIndex) = GatherArrayElements(sourceMesh.GetVertexUV(uvSetIndex), newToOldVertexIndexes);
+	}
+
+	mesh.SetVertexColorSetCount(sourceMesh.GetVertexColorSetCount());
+	for (uint32_t colorSetIndex = 0U; colorSetIndex < sourceMesh.GetVertexColorSetCount(); ++colorSetIndex)
+	{
+		mesh.GetVertexColors(colorSetIndex) = GatherArrayElements(sourceMesh.GetVertexColor(colorSetIndex), newToOldVertexIndexes);
+	}
+
+	mesh.SetVertexInfluenceCount(sourceMesh.GetVertexInfluenceCount());
+	for (uint32_t influenceIndex = 0U; influenceIndex < sourceMesh.GetVertexInfluenceCount(); ++influenceIndex)
+	{
+		mesh.GetVertexBoneIDs(influenceIndex) = GatherArrayElements(sourceMesh.GetVertexBoneIDs(influenceIndex), newToOldVertexIndexes);
+		mesh.GetVertexWeights(influenceIndex) = GatherArrayElements(sourceMesh.GetVertexWeights(influenceIndex), newToOldVertexIndexes);
+	}
+
+	// Morph targets keep vertices which are in the part. Morph targets without such vertices are dropped.
+	// Source morph IDs are kept on purpose. Morph IDs are mesh local and parts of one mesh share them.
+	for (const cd::Morph& sourceMorph : sourceMesh.GetMorphs())
+	{
+		std::vector<uint32_t> morphVertexIndexes;
+		for (uint32_t morphVertexIndex = 0U; morphVertexIndex < sourceMorph.GetVertexCount(); ++morphVertexIndex)
+		{
+			uint32_t oldVertexIndex = sourceMorph.GetVertexSourceID(morphVertexIndex).Data();
+			if (oldVertexIndex < oldToNewVertexIndexes.size() && InvalidIndex != oldToNewVertexIndexes[oldVertexIndex])
+			{
+				morphVertexIndexes.push_back(morphVertexIndex);
+			}
+		}
+
+		if (morphVertexIndexes.empty())
+		{
+			continue;
+		}
+
+		cd::Morph morph(sourceMorph.GetID(), sourceMorph.GetName(), static_cast<uint32_t>(morphVertexIndexes.size()));
+		morph.SetWeight(sourceMorph.GetWeight());
+		morph.GetVertexPositions() = GatherArrayElements(sourceMorph.GetVertexPositions(), morphVertexIndexes);
+		morph.GetVertexNormals() = GatherArrayElements(sourceMorph.GetVertexNormals(), morphVertexIndexes);
+		morph.GetVertexTangents() = GatherArrayElements(sourceMorph.GetVertexTangents(), morphVertexIndexes);
+		morph.GetVertexBiTangents() = GatherArrayElements(sourceMorph.GetVertexBiTangents(), morphVertexIndexes);
+		for (uint32_t morphVertexIndex = 0U; morphVertexIndex < morphVertexIndexes.size(); ++morphVertexIndex)
+		{
+			uint32_t oldVertexIndex = sourceMorph.GetVertexSourceID(morphVertexIndexes[morphVertexIndex]).Data();
+			morph.SetVertexSourceID(morphVertexIndex, oldToNewVertexIndexes[oldVertexIndex]);
+		}
+		mesh.GetMorphs().push_back(cd::MoveTemp(morph));
+	}
+
+	return mesh;
+}
+
+}
+
+namespace cd
+{
+
+uint32_t SkinningOptimizer::LimitInfluences(Mesh& mesh, uint32_t maxInfluenceCount)
+{
+	uint32_t influenceCount = mesh.GetVertexInfluenceCount();
+	uint32_t newInfluenceCount = std::clamp(maxInfluenceCount, 1U, MaxBoneInfluenceCount);
+	if (0U == influenceCount)
+	{
+		return 0U;
+	}
+
+	uint32_t reducedVertexCount = 0U;
+	std::array<Influence, MaxBoneInfluenceCount> influences;
+	for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+	{
+		uint32_t vertexInfluenceCount = GatherInfluences(mesh, vertexIndex, influences);
+		if (vertexInfluenceCount > newInfluenceCount)
+		{
+			vertexInfluenceCount = newInfluenceCount;
+			++reducedVertexCount;
+		}
+
+		VertexWeight totalWeight = 0.0f;
+		for (uint32_t influenceIndex = 0U; influenceIndex < vertexInfluenceCount; ++influenceIndex)
+		{
+			totalWeight += influences[influenceIndex].weight;
+		}
+
+		// Sorted influences are written back in place. Unused slots are cleared.
+		for (uint32_t influenceIndex = 0U; influenceIndex < influenceCount; ++influenceIndex)
+		{
+			bool isUsed = influenceIndex < vertexInfluenceCount;
+			mesh.GetVertexBoneID(influenceIndex, vertexIndex) = isUsed ? influences[influenceIndex].boneID : BoneID(0U);
+			mesh.GetVertexWeight(influenceIndex, vertexIndex) = isUsed ? influences[influenceIndex].weight / totalWeight : 0.0f;
+		}
+	}
+
+	if (newInfluenceCount < influenceCount)
+	{
+		for (uint32_t influenceIndex = newInfluenceCount; influenceIndex < influenceCount; ++influenceIndex)
+		{
+			mesh.GetVertexBoneIDs(influenceIndex).clear();
+			mesh.GetVertexWeights(influenceIndex).clear();
+		}
+		mesh.SetVertexInfluenceCount(newInfluenceCount);
+	}
+
+	return reducedVertexCount;
+}
+
+std::vector<Mesh> SkinningOptimizer::SplitByPalette(const Mesh& mesh, uint32_t maxPaletteSize)
+{
+	std::vector<Mesh> parts;
+	uint32_t influenceCount = mesh.GetVertexInfluenceCount();
+	if (0U == influenceCount)
+	{
+		return parts;
+	}
+
+	// A polygon can't be split so every palette should be able to hold bones of any polygon.
+	maxPaletteSize = std::clamp(maxPaletteSize, influenceCount * static_cast<uint32_t>(Polygon::Size), MaxPaletteSize);
+
+	std::vector<std::vector<uint32_t>> polygonBoneIDs(mesh.GetPolygonCount());
+	for (uint32_t polygonIndex = 0U; polygonIndex < mesh.GetPolygonCount(); ++polygonIndex)
+	{
+		std::vector<uint32_t>& boneIDs = polygonBoneIDs[polygonIndex];
+		for (uint32_t cornerIndex = 0U; cornerIndex < Polygon::Size; ++cornerIndex)
+		{
+			uint32_t vertexIndex = mesh.GetPolygonVertexID(polygonIndex, cornerIndex).Data();
+			for (uint32_t influenceIndex = 0U; influenceIndex < influenceCount; ++influenceIndex)
+			{
+				if (mesh.GetVertexWeight(influenceIndex, vertexIndex) > 0.0f)
+				{
+					boneIDs.push_back(mesh.GetVertexBoneID(influenceIndex, vertexIndex).Data());
+				}
+			}
+		}
+		std::sort(boneIDs.begin(), boneIDs.end());
+		boneIDs.erase(std::unique(boneIDs.begin(), boneIDs.end()), boneIDs.end());
+	}
+
+	// Polygons which use the same bones are usually close in bone ID order so visiting polygons in this order keeps palettes compact.
+	std::vector<uint32_t> sortedPolygonIndexes(mesh.GetPolygonCount());
+	std::iota(sortedPolygonIndexes.begin(), sortedPolygonIndexes.end(), 0U);
+	std::stable_sort(sortedPolygonIndexes.begin(), sortedPolygonIndexes.end(), [&polygonBoneIDs](uint32_t lhs, uint32_t rhs)
+	{
+		return polygonBoneIDs[lhs] < polygonBoneIDs[rhs];
+	});
+
+	// Greedily add polygons to the current part until its palette is full.
+	std::vector<uint32_t> boneLastPartIndexes(GetMaxBoneID(mesh) + 1U, InvalidIndex);
+	std::vector<std::vector<uint32_t>> partPolygonIndexes(1);
+	uint32_t paletteSize = 0U;
+	for (uint32_t polygonIndex : sortedPolygonIndexes)
+	{
+		const std::vector<uint32_t>& boneIDs = polygonBoneIDs[polygonIndex];
+		auto partIndex = static_cast<uint32_t>(partPolygonIndexes.size() - 1U);
+		auto newBoneCount = static_cast<uint32_t>(std::count_if(boneIDs.begin(), boneIDs.end(),
+			[&boneLastPartIndexes, partIndex](uint32_t boneID) { return boneLastPartIndexes[boneID] != partIndex; }));
+		if (paletteSize + newBoneCount > maxPaletteSize)
+		{
+			partPolygonIndexes.emplace_back();
+			++partIndex;
+			paletteSize = 0U;
+			newBoneCount = static_cast<uint32_t>(boneIDs.size());
+		}
+
+		for (uint32_t boneID : boneIDs)
+		{
+			boneLastPartIndexes[boneID] = partIndex;
+		}
+		paletteSize += newBoneCount;
+		partPolygonIndexes.back().push_back(polygonIndex);
+	}
+
+	if (partPolygonIndexes.size() <= 1U)
+	{
+		return parts;
+	}
+
+	parts.reserve(partPolygonIndexes.size());
+	for (uint32_t partIndex = 0U; partIndex < partPolygonIndexes.size(); ++partIndex)
+	{
+		std::string partName = 0U == partIndex ? mesh.GetName() : std::string(mesh.GetName()) + "_part" + std::to_string(partIndex);
+		parts.push_back(ExtractPolygons(mesh, partPolygonIndexes[partIndex], mesh.GetID(), partName.c_str()));
+	}
+
+	return parts;
+}
+
+bool SkinningOptimizer::PackInfluences(Mesh& mesh)
+{
+	uint32_t influenceCount = mesh.GetVertexInfluenceCount();
+	uint32_t vertexCount = mesh.GetVertexCount();
+
+	std::vector<BoneID> bonePalette;
+	std::vector<uint32_t> boneLocalIndexes(GetMaxBoneID(mesh) + 1U, InvalidIndex);
+	std::vector<uint8_t> boneIndexes(vertexCount * influenceCount, 0U);
+	std::vector<uint16_t> boneWeights(vertexCount * influenceCount, 0U);
+	std::array<Influence, MaxBoneInfluenceCount> influences;
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		uint32_t vertexInfluenceCount = GatherInfluences(mesh, vertexIndex, influences);
+		VertexWeight totalWeight = 0.0f;
+		for (uint32_t influenceIndex = 0U; influenceIndex < vertexInfluenceCount; ++influenceIndex)
+		{
+			totalWeight += influences[influenceIndex].weight;
+		}
+
+		// Round weights and give the rounding residual to the largest one so that they sum to 1 exactly.
+		uint32_t totalCode = 0U;
+		for (uint32_t influenceIndex = 0U; influenceIndex < vertexInfluenceCount; ++influenceIndex)
+		{
+			uint32_t boneID = influences[influenceIndex].boneID.Data();
+			if (InvalidIndex == boneLocalIndexes[boneID])
+			{
+				if (bonePalette.size() >= MaxPaletteSize)
+				{
+					return false;
+				}
+
+				boneLocalIndexes[boneID] = static_cast<uint32_t>(bonePalette.size());
+				bonePalette.push_back(influences[influenceIndex].boneID);
+			}
+
+			uint32_t weightCode = static_cast<uint32_t>(std::round(influences[influenceIndex].weight / totalWeight * 65535.0f));
+			boneIndexes[vertexIndex * influenceCount + influenceIndex] = static_cast<uint8_t>(boneLocalIndexes[boneID]);
+			boneWeights[vertexIndex * influenceCount + influenceIndex] = static_cast<uint16_t>(weightCode);
+			totalCode += weightCode;
+		}
+
+		if (vertexInfluenceCount > 0U)
+		{
+			uint16_t& largestWeight = boneWeights[vertexIndex * influenceCount];
+			largestWeight = static_cast<uint16_t>(static_cast<int32_t>(largestWeight) + 65535 - static_cast<int32_t>(totalCode));
+		}
+	}
+
+	mesh.SetBonePalette(MoveTemp(bonePalette));
+	mesh.SetPackedInfluenceCount(influenceCount);
+	mesh.GetPackedBoneIndexes() = MoveTemp(boneIndexes);
+	mesh.GetPackedBoneWeights() = MoveTemp(boneWeights);
+
+	return true;
+}
+
+}
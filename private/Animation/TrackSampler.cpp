@@ -0,0 +1,144 @@
+#include "Animation/TrackSampler.h"
+
+#include "Scene/Track.h"
+
+#include <algorithm>
+
+namespace
+{
+
+template<typename KeyFrameType, typename ValueType>
+void SplitKeys(const std::vector<KeyFrameType>& keys, std::vector<float>& times, std::vector<ValueType>& values)
+{
+	times.resize(keys.size());
+	values.resize(keys.size());
+	for (size_t keyIndex = 0U; keyIndex < keys.size(); ++keyIndex)
+	{
+		times[keyIndex] = keys[keyIndex].GetTime();
+		values[keyIndex] = keys[keyIndex].GetValue();
+	}
+}
+
+template<typename ValueType, typename Interpolate>
+ValueType SampleChannel(const std::vector<float>& times, const std::vector<ValueType>& values, float keyInterval, float time, uint32_t& cursorKeyIndex,
+	const ValueType& defaultValue, Interpolate interpolate)
+{
+	if (values.empty())
+	{
+		return defaultValue;
+	}
+
+	float factor;
+	uint32_t keyIndex = keyInterval > 0.0f ? cd::TrackSampler::FindUniformKey(static_cast<uint32_t>(values.size()), keyInterval, time, factor) :
+		cd::TrackSampler::FindKey(times, time, cursorKeyIndex, factor);
+	if (keyIndex + 1U >= values.size())
+	{
+		return values[keyIndex];
+	}
+
+	return interpolate(values[keyIndex], values[keyIndex + 1U], factor);
+}
+
+}
+
+namespace cd
+{
+
+TrackSampler::TrackSampler(const Track& track)
+{
+	Init(track);
+}
+
+void TrackSampler::Init(const Track& track)
+{
+	SplitKeys(track.GetTranslationKeys(), m_translationTimes, m_translations);
+	SplitKeys(track.GetRotationKeys(), m_rotationTimes, m_rotations);
+	SplitKeys(track.GetScaleKeys(), m_scaleTimes, m_scales);
+	m_keyInterval = track.GetKeyInterval();
+	ResetCursor();
+}
+
+uint32_t TrackSampler::FindKey(const std::vector<float>& times, float time, uint32_t& cursorKeyIndex, float& factor)
+{
+	factor = 0.0f;
+
+	auto keyCount = static_cast<uint32_t>(times.size());
+	if (keyCount <= 1U || time <= times.front())
+	{
+		cursorKeyIndex = 0U;
+		return 0U;
+	}
+
+	if (time >= times.back())
+	{
+		cursorKeyIndex = keyCount - 1U;
+		return cursorKeyIndex;
+	}
+
+	// Now there is a segment [keyIndex, keyIndex + 1] in [0, keyCount - 1] which contains time.
+	uint32_t keyIndex = std::min(cursorKeyIndex, keyCount - 2U);
+	if (times[keyIndex] <= time)
+	{
+		// Monotonic playback usually stays in the same segment or moves to the next one.
+		if (time >= times[keyIndex + 1U])
+		{
+			++keyIndex;
+			if (time >= times[keyIndex + 1U])
+			{
+				keyIndex = static_cast<uint32_t>(std::upper_bound(times.begin() + keyIndex + 1U, times.end(), time) - times.begin()) - 1U;
+			}
+		}
+	}
+	else
+	{
+		keyIndex = static_cast<uint32_t>(std::upper_bound(times.begin(), times.begin() + keyIndex, time) - times.begin()) - 1U;
+	}
+
+	cursorKeyIndex = keyIndex;
+	factor = (time - times[keyIndex]) / (times[keyIndex + 1U] - times[keyIndex]);
+	return keyIndex;
+}
+
+uint32_t TrackSampler::FindUniformKey(uint32_t keyCount, float keyInterval, float time, float& factor)
+{
+	factor = 0.0f;
+	if (keyCount <= 1U || time <= 0.0f)
+	{
+		return 0U;
+	}
+
+	float keyPosition = time / keyInterval;
+	auto keyIndex = static_cast<uint32_t>(keyPosition);
+	if (keyIndex >= keyCount - 1U)
+	{
+		return keyCount - 1U;
+	}
+
+	factor = keyPosition - static_cast<float>(keyIndex);
+	return keyIndex;
+}
+
+Vec3f TrackSampler::SampleTranslation(float time, TrackCursor& cursor) const
+{
+	return SampleChannel(m_translationTimes, m_translations, m_keyInterval, time, cursor.translationKeyIndex, TranslationKey::Identitiy(),
+		[](const Vec3f& a, const Vec3f& b, float factor) { return Vec3f::Lerp(a, b, factor); });
+}
+
+Quaternion TrackSampler::SampleRotation(float time, TrackCursor& cursor) const
+{
+	return SampleChannel(m_rotationTimes, m_rotations, m_keyInterval, time, cursor.rotationKeyIndex, RotationKey::Identitiy(),
+		[](const Quaternion& a, const Quaternion& b, float factor) { return Quaternion::SLerp(a, b, factor); });
+}
+
+Vec3f TrackSampler::SampleScale(float time, TrackCursor& cursor) const
+{
+	return SampleChannel(m_scaleTimes, m_scales, m_keyInterval, time, cursor.scaleKeyIndex, ScaleKey::Identitiy(),
+		[](const Vec3f& a, const Vec3f& b, float factor) { return Vec3f::Lerp(a, b, factor); });
+}
+
+Transform TrackSampler::Sample(float time, TrackCursor& cursor) const
+{
+	return Transform(SampleTranslation(time, cursor), SampleRotation(time, cursor), SampleScale(time, cursor));
+}
+
+}
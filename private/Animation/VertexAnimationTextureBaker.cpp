@@ -0,0 +1,219 @@
+#include "Animation/VertexAnimationTextureBaker.h"
+
+#include "Animation/AnimationResampler.h"
+#include "Animation/PoseEvaluator.h"
+#include "Scene/SceneDatabase.h"
+#include "Scene/VertexFormat.h"
+#include "Utilities/ParallelFor.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+constexpr uint32_t ChannelCount = 4U;
+
+// Rounds to the nearest half float and ties to even. Overflowed values become infinity.
+uint16_t FloatToHalf(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	uint32_t sign = (bits >> 16U) & 0x8000U;
+	uint32_t floatExponent = (bits >> 23U) & 0xFFU;
+	uint32_t mantissa = bits & 0x7FFFFFU;
+	if (0xFFU == floatExponent)
+	{
+		return static_cast<uint16_t>(sign | 0x7C00U | (0U != mantissa ? 0x200U : 0U));
+	}
+
+	int32_t exponent = static_cast<int32_t>(floatExponent) - 127 + 15;
+	if (exponent >= 31)
+	{
+		return static_cast<uint16_t>(sign | 0x7C00U);
+	}
+
+	uint32_t shift = 13U;
+	uint32_t half = sign;
+	if (exponent <= 0)
+	{
+		// Subnormal halves store the implicit leading bit in the mantissa.
+		if (exponent < -10)
+		{
+			return static_cast<uint16_t>(sign);
+		}
+		mantissa |= 0x800000U;
+		shift = static_cast<uint32_t>(14 - exponent);
+	}
+	else
+	{
+		half |= static_cast<uint32_t>(exponent) << 10U;
+	}
+
+	half |= mantissa >> shift;
+	uint32_t remainder = mantissa & ((1U << shift) - 1U);
+	uint32_t halfway = 1U << (shift - 1U);
+
+	// Carry into the exponent is still the correctly rounded value.
+	if (remainder > halfway || (remainder == halfway && 0U != (half & 1U)))
+	{
+		++half;
+	}
+
+	return static_cast<uint16_t>(half);
+}
+
+void WriteTexel(uint16_t* pTexel, float x, float y, float z, float w)
+{
+	pTexel[0] = FloatToHalf(x);
+	pTexel[1] = FloatToHalf(y);
+	pTexel[2] = FloatToHalf(z);
+	pTexel[3] = FloatToHalf(w);
+}
+
+uint32_t GetTextureWidth(uint32_t vertexCount)
+{
+	return std::min(vertexCount, cd::VertexAnimationTextureBaker::MaxTextureWidth);
+}
+
+uint32_t GetRowsPerFrame(uint32_t vertexCount)
+{
+	uint32_t width = GetTextureWidth(vertexCount);
+	return (vertexCount + width - 1U) / width;
+}
+
+}
+
+namespace cd
+{
+
+bool VertexAnimationTextureBaker::GenerateLookupUVs(Mesh& mesh, uint32_t uvSetIndex)
+{
+	uint32_t vertexCount = mesh.GetVertexCount();
+	if (0U == vertexCount || uvSetIndex >= cd::MaxUVSetCount)
+	{
+		return false;
+	}
+
+	if (uvSetIndex >= mesh.GetVertexUVSetCount())
+	{
+		uint32_t uvLayoutCount = static_cast<uint32_t>(std::count_if(mesh.GetVertexFormat().GetVertexLayout().begin(), mesh.GetVertexFormat().GetVertexLayout().end(),
+			[](const VertexAttributeLayout& layout) { return VertexAttributeType::UV == layout.vertexAttributeType; }));
+		for (uint32_t layoutIndex = uvLayoutCount; layoutIndex <= uvSetIndex; ++layoutIndex)
+		{
+			mesh.GetVertexFormat().AddAttributeLayout(VertexAttributeType::UV, GetAttributeValueType<UV::ValueType>(), UV::Size);
+		}
+		mesh.SetVertexUVSetCount(uvSetIndex + 1U);
+	}
+
+	uint32_t width = GetTextureWidth(vertexCount);
+	uint32_t rowsPerFrame = GetRowsPerFrame(vertexCount);
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		float u = (static_cast<float>(vertexIndex % width) + 0.5f) / static_cast<float>(width);
+		float v = (static_cast<float>(vertexIndex / width) + 0.5f) / static_cast<float>(rowsPerFrame);
+		mesh.SetVertexUV(uvSetIndex, vertexIndex, UV(u, v));
+	}
+
+	return true;
+}
+
+bool VertexAnimationTextureBaker::Bake(const SceneDatabase& sceneDatabase, const Animation& animation, const Mesh& mesh, float sampleRate, Texture& texture)
+{
+	uint32_t vertexCount = mesh.GetVertexCount();
+	uint32_t influenceCount = mesh.GetVertexInfluenceCount();
+	if (0U == vertexCount || 0U == influenceCount)
+	{
+		return false;
+	}
+
+	PoseEvaluator poseEvaluator(sceneDatabase, &animation);
+	if (0U == poseEvaluator.GetBoneCount())
+	{
+		return false;
+	}
+
+	uint32_t frameCount;
+	float frameInterval = AnimationResampler::CalculateKeyInterval(animation, sampleRate, frameCount);
+	uint32_t width = GetTextureWidth(vertexCount);
+	uint32_t frameTexelCount = width * GetRowsPerFrame(vertexCount);
+	uint32_t height = 2U * frameCount * GetRowsPerFrame(vertexCount);
+
+	std::vector<std::byte> pixels(static_cast<size_t>(width) * height * ChannelCount * sizeof(uint16_t));
+	auto* pTexels = reinterpret_cast<uint16_t*>(pixels.data());
+	uint16_t* pNormalTexels = pTexels + static_cast<size_t>(frameCount) * frameTexelCount * ChannelCount;
+
+	// Consecutive frames are evaluated by one evaluator copy so that its key cursors move forward monotonically.
+	uint32_t batchCount = std::min(frameCount, GetParallelThreadCount() * 4U);
+	ParallelFor(batchCount, [&](uint32_t batchIndex)
+	{
+		PoseEvaluator batchPoseEvaluator(poseEvaluator);
+		std::vector<Matrix4x4> skinningMatrices;
+
+		uint32_t beginFrame = static_cast<uint32_t>(static_cast<uint64_t>(frameCount) * batchIndex / batchCount);
+		uint32_t endFrame = static_cast<uint32_t>(static_cast<uint64_t>(frameCount) * (batchIndex + 1U) / batchCount);
+		for (uint32_t frameIndex = beginFrame; frameIndex < endFrame; ++frameIndex)
+		{
+			batchPoseEvaluator.Evaluate(static_cast<float>(frameIndex) * frameInterval, skinningMatrices);
+
+			size_t frameOffset = static_cast<size_t>(frameIndex) * frameTexelCount;
+			for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+			{
+				const Point& position = mesh.GetVertexPosition(vertexIndex);
+				const Direction& normal = mesh.GetVertexNormal(vertexIndex);
+				Vec4f skinnedPosition(0.0f, 0.0f, 0.0f, 0.0f);
+				Vec4f skinnedNormal(0.0f, 0.0f, 0.0f, 0.0f);
+				float totalWeight = 0.0f;
+				for (uint32_t influenceIndex = 0U; influenceIndex < influenceCount; ++influenceIndex)
+				{
+					float weight = mesh.GetVertexWeight(influenceIndex, vertexIndex);
+					uint32_t boneID = mesh.GetVertexBoneID(influenceIndex, vertexIndex).Data();
+					if (weight <= 0.0f || PoseEvaluator::InvalidIndex == batchPoseEvaluator.GetBoneIndex(boneID))
+					{
+						continue;
+					}
+
+					const Matrix4x4& skinningMatrix = skinningMatrices[boneID];
+					skinnedPosition += skinningMatrix * Vec4f(position.x(), position.y(), position.z(), 1.0f) * weight;
+					skinnedNormal += skinningMatrix * Vec4f(normal.x(), normal.y(), normal.z(), 0.0f) * weight;
+					totalWeight += weight;
+				}
+
+				Point finalPosition = position;
+				Direction finalNormal = normal;
+				if (totalWeight > 0.0f)
+				{
+					float inverseWeight = 1.0f / totalWeight;
+					finalPosition = Point(skinnedPosition.x(), skinnedPosition.y(), skinnedPosition.z()) * inverseWeight;
+
+					// Non uniform scales are ignored like most runtime skinning shaders do.
+					finalNormal = Direction(skinnedNormal.x(), skinnedNormal.y(), skinnedNormal.z());
+					float length = finalNormal.Length();
+					if (length > 0.0f)
+					{
+						finalNormal = finalNormal * (1.0f / length);
+					}
+				}
+
+				size_t texelOffset = (frameOffset + vertexIndex) * ChannelCount;
+				WriteTexel(pTexels + texelOffset, finalPosition.x(), finalPosition.y(), finalPosition.z(), 1.0f);
+				WriteTexel(pNormalTexels + texelOffset, finalNormal.x(), finalNormal.y(), finalNormal.z(), 0.0f);
+			}
+		}
+	});
+
+	texture.SetFormat(TextureFormat::RGBA16F);
+	texture.SetWidth(width);
+	texture.SetHeight(height);
+	texture.SetDepth(1U);
+	texture.SetUseMipMap(false);
+	texture.SetUMapMode(TextureMapMode::Clamp);
+	texture.SetVMapMode(TextureMapMode::Clamp);
+	texture.SetRawData(cd::MoveTemp(pixels));
+	texture.SetRawDataType(TextureRawDataType::Pixels);
+
+	return true;
+}
+
+}
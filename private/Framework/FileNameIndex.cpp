@@ -0,0 +1,170 @@
+#include "FileNameIndex.h"
+
+#include "Base/Template.h"
+#include "IO/InputArchive.hpp"
+#include "IO/OutputArchive.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+// Change this value when the cache layout changes to invalidate old cache files.
+constexpr uint32_t FileNameIndexCacheVersion = 1U;
+
+}
+
+namespace cdtools
+{
+
+std::string FileNameIndex::GetKey(std::string fileName) const
+{
+	if (!m_caseSensitive)
+	{
+		std::transform(fileName.begin(), fileName.end(), fileName.begin(),
+			[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	}
+
+	return fileName;
+}
+
+void FileNameIndex::AddFile(std::string key, std::string filePath, uint32_t folderIndex, uint32_t depth)
+{
+	auto itEntry = m_entries.find(key);
+	if (itEntry == m_entries.end())
+	{
+		m_entries.emplace(cd::MoveTemp(key), Entry{ cd::MoveTemp(filePath), folderIndex, depth });
+		return;
+	}
+
+	Entry& entry = itEntry->second;
+	if (folderIndex < entry.folderIndex || (folderIndex == entry.folderIndex && depth < entry.depth))
+	{
+		entry = Entry{ cd::MoveTemp(filePath), folderIndex, depth };
+	}
+}
+
+void FileNameIndex::AddFolder(const std::string& folderPath, bool recursive)
+{
+	uint32_t folderIndex = static_cast<uint32_t>(m_folders.size());
+	m_folders.push_back(folderPath);
+
+	std::error_code errorCode;
+	if (!std::filesystem::is_directory(folderPath, errorCode))
+	{
+		return;
+	}
+
+	auto options = std::filesystem::directory_options::skip_permission_denied;
+	std::filesystem::recursive_directory_iterator itFile(folderPath, options, errorCode);
+	for (; !errorCode && itFile != std::filesystem::recursive_directory_iterator(); itFile.increment(errorCode))
+	{
+		if (!recursive)
+		{
+			itFile.disable_recursion_pending();
+		}
+
+		// directory_entry caches file type from the directory listing so it doesn't need extra stat calls in most platforms.
+		if (!itFile->is_regular_file(errorCode))
+		{
+			continue;
+		}
+
+		const std::filesystem::path& filePath = itFile->path();
+		AddFile(GetKey(filePath.filename().string()), filePath.string(), folderIndex, static_cast<uint32_t>(itFile.depth()));
+	}
+}
+
+void FileNameIndex::Clear()
+{
+	m_folders.clear();
+	m_entries.clear();
+}
+
+const std::string* FileNameIndex::Find(const std::string& fileName) const
+{
+	auto itEntry = m_entries.find(GetKey(fileName));
+	return itEntry != m_entries.end() ? &itEntry->second.filePath : nullptr;
+}
+
+bool FileNameIndex::Load(const char* pCacheFilePath, const std::vector<std::string>& expectedFolders)
+{
+	std::ifstream fin(pCacheFilePath, std::ios::in | std::ios::binary);
+	if (!fin.is_open())
+	{
+		return false;
+	}
+
+	cd::InputArchive inputArchive(&fin);
+
+	uint32_t version;
+	bool caseSensitive;
+	uint32_t folderCount;
+	inputArchive >> version >> caseSensitive >> folderCount;
+	if (!fin.good() || version != FileNameIndexCacheVersion || caseSensitive != m_caseSensitive || folderCount != expectedFolders.size())
+	{
+		return false;
+	}
+
+	std::vector<std::string> folders(folderCount);
+	for (std::string& folder : folders)
+	{
+		inputArchive >> folder;
+	}
+
+	if (!fin.good() || folders != expectedFolders)
+	{
+		return false;
+	}
+
+	uint32_t entryCount;
+	inputArchive >> entryCount;
+
+	std::unordered_map<std::string, Entry> entries;
+	entries.reserve(entryCount);
+	for (uint32_t entryIndex = 0U; entryIndex < entryCount && fin.good(); ++entryIndex)
+	{
+		std::string key;
+		Entry entry;
+		inputArchive >> key >> entry.filePath >> entry.folderIndex >> entry.depth;
+		entries.emplace(cd::MoveTemp(key), cd::MoveTemp(entry));
+	}
+
+	if (!fin.good())
+	{
+		return false;
+	}
+
+	m_folders = cd::MoveTemp(folders);
+	m_entries = cd::MoveTemp(entries);
+	return true;
+}
+
+bool FileNameIndex::Save(const char* pCacheFilePath) const
+{
+	std::ofstream fout(pCacheFilePath, std::ios::out | std::ios::binary);
+	if (!fout.is_open())
+	{
+		return false;
+	}
+
+	cd::OutputArchive outputArchive(&fout);
+	outputArchive << FileNameIndexCacheVersion << m_caseSensitive << static_cast<uint32_t>(m_folders.size());
+	for (const std::string& folder : m_folders)
+	{
+		outputArchive << folder;
+	}
+
+	outputArchive << static_cast<uint32_t>(m_entries.size());
+	for (const auto& [key, entry] : m_entries)
+	{
+		outputArchive << key << entry.filePath << entry.folderIndex << entry.depth;
+	}
+
+	return fout.good();
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cdtools
+{
+
+// FileNameIndex maps file names to file paths for a list of folders which are scanned recursively only once.
+// Then every query is a hash lookup instead of a filesystem stat which is expensive on networked filesystems.
+// When multiple files share the same name, the file in the earlier added folder wins.
+// Inside one folder, the file with the shallower depth wins.
+class FileNameIndex final
+{
+public:
+	FileNameIndex() = default;
+	explicit FileNameIndex(bool caseSensitive) : m_caseSensitive(caseSensitive) {}
+	FileNameIndex(const FileNameIndex&) = default;
+	FileNameIndex& operator=(const FileNameIndex&) = default;
+	FileNameIndex(FileNameIndex&&) = default;
+	FileNameIndex& operator=(FileNameIndex&&) = default;
+	~FileNameIndex() = default;
+
+	bool IsCaseSensitive() const { return m_caseSensitive; }
+	const std::vector<std::string>& GetFolders() const { return m_folders; }
+	uint32_t GetFileCount() const { return static_cast<uint32_t>(m_entries.size()); }
+
+	void AddFolder(const std::string& folderPath, bool recursive = true);
+	void Clear();
+
+	// Returns nullptr if there is no file with the same name in all indexed folders.
+	const std::string* Find(const std::string& fileName) const;
+
+	// Cache the index to a file so that batch runs can skip to scan the same folders again.
+	// Load fails if the cache file is missing or it was built with different folders/case sensitivity.
+	bool Load(const char* pCacheFilePath, const std::vector<std::string>& expectedFolders);
+	bool Save(const char* pCacheFilePath) const;
+
+private:
+	struct Entry
+	{
+		std::string filePath;
+		uint32_t folderIndex;
+		uint32_t depth;
+	};
+
+	std::string GetKey(std::string fileName) const;
+	void AddFile(std::string key, std::string filePath, uint32_t folderIndex, uint32_t depth);
+
+private:
+	bool m_caseSensitive = true;
+	std::vector<std::string> m_folders;
+	std::unordered_map<std::string, Entry> m_entries;
+};
+
+}
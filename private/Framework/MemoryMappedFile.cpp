@@ -0,0 +1,119 @@
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cdtools
+{
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const char* pFilePath)
+{
+	HANDLE fileHandle = CreateFileA(pFilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (INVALID_HANDLE_VALUE == fileHandle)
+	{
+		return;
+	}
+	m_fileHandle = fileHandle;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		return;
+	}
+
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	if (0 == m_size)
+	{
+		m_isValid = true;
+		return;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (nullptr == mappingHandle)
+	{
+		return;
+	}
+	m_mappingHandle = mappingHandle;
+
+	m_pData = static_cast<const std::byte*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	m_isValid = m_pData != nullptr;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	if (m_pData)
+	{
+		UnmapViewOfFile(m_pData);
+	}
+
+	if (m_mappingHandle)
+	{
+		CloseHandle(m_mappingHandle);
+	}
+
+	if (m_fileHandle)
+	{
+		CloseHandle(m_fileHandle);
+	}
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const char* pFilePath)
+{
+	int fileDescriptor = open(pFilePath, O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return;
+	}
+
+	struct stat fileStatus;
+	if (0 == fstat(fileDescriptor, &fileStatus) && S_ISREG(fileStatus.st_mode))
+	{
+		m_size = static_cast<size_t>(fileStatus.st_size);
+		if (0 == m_size)
+		{
+			m_isValid = true;
+		}
+		else
+		{
+			void* pMappedData = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+			if (pMappedData != MAP_FAILED)
+			{
+				// Whole file will be copied out sequentially.
+				madvise(pMappedData, m_size, MADV_SEQUENTIAL);
+				m_pData = static_cast<const std::byte*>(pMappedData);
+				m_isValid = true;
+			}
+		}
+	}
+
+	// Mapping keeps a reference to the file so the descriptor can be closed now.
+	close(fileDescriptor);
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	if (m_pData)
+	{
+		munmap(const_cast<std::byte*>(m_pData), m_size);
+	}
+}
+
+#endif
+
+}
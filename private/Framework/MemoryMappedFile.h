@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+namespace cdtools
+{
+
+// Read-only memory mapping of a file. Pages are loaded on demand by OS which avoids
+// extra buffering in file streams and lets multiple threads read files without locks.
+class MemoryMappedFile final
+{
+public:
+	MemoryMappedFile() = delete;
+	explicit MemoryMappedFile(const char* pFilePath);
+	MemoryMappedFile(const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+	MemoryMappedFile(MemoryMappedFile&&) = delete;
+	MemoryMappedFile& operator=(MemoryMappedFile&&) = delete;
+	~MemoryMappedFile();
+
+	// An empty file is valid but has no mapped data.
+	bool IsValid() const { return m_isValid; }
+	const std::byte* GetData() const { return m_pData; }
+	size_t GetSize() const { return m_size; }
+
+private:
+	bool m_isValid = false;
+	const std::byte* m_pData = nullptr;
+	size_t m_size = 0;
+
+#ifdef _WIN32
+	void* m_fileHandle = nullptr;
+	void* m_mappingHandle = nullptr;
+#endif
+};
+
+}
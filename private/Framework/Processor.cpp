@@ -18,6 +18,26 @@ Processor::~Processor()
 	}
 }
 
+void Processor::SetPackTextureContainersEnable(bool enable)
+{
+	m_pProcessorImpl->SetPackTextureContainersEnable(enable);
+}
+
+bool Processor::IsPackTextureContainersEnabled() const
+{
+	return m_pProcessorImpl->IsPackTextureContainersEnabled();
+}
+
+void Processor::SetTextureContainerOutputFolder(const char* pFolder)
+{
+	m_pProcessorImpl->SetTextureContainerOutputFolder(pFolder);
+}
+
+const char* Processor::GetTextureContainerOutputFolder() const
+{
+	return m_pProcessorImpl->GetTextureContainerOutputFolder();
+}
+
 const cd::SceneDatabase* Processor::GetSceneDatabase() const
 {
 	return m_pProcessorImpl->GetSceneDatabase();
@@ -78,6 +98,296 @@ bool Processor::IsCalculateConnetivityDataEnabled() const
 	return m_pProcessorImpl->IsCalculateConnetivityDataEnabled();
 }
 
+void Processor::SetGenerateLightmapUVsEnable(bool enable)
+{
+	m_pProcessorImpl->SetGenerateLightmapUVsEnable(enable);
+}
+
+bool Processor::IsGenerateLightmapUVsEnabled() const
+{
+	return m_pProcessorImpl->IsGenerateLightmapUVsEnabled();
+}
+
+void Processor::SetLightmapUVSetIndex(uint32_t uvSetIndex)
+{
+	m_pProcessorImpl->SetLightmapUVSetIndex(uvSetIndex);
+}
+
+uint32_t Processor::GetLightmapUVSetIndex() const
+{
+	return m_pProcessorImpl->GetLightmapUVSetIndex();
+}
+
+void Processor::SetLightmapResolution(uint32_t resolution)
+{
+	m_pProcessorImpl->SetLightmapResolution(resolution);
+}
+
+uint32_t Processor::GetLightmapResolution() const
+{
+	return m_pProcessorImpl->GetLightmapResolution();
+}
+
+void Processor::SetLightmapPadding(uint32_t padding)
+{
+	m_pProcessorImpl->SetLightmapPadding(padding);
+}
+
+uint32_t Processor::GetLightmapPadding() const
+{
+	return m_pProcessorImpl->GetLightmapPadding();
+}
+
+void Processor::SetLightmapChartMaxAngle(float degrees)
+{
+	m_pProcessorImpl->SetLightmapChartMaxAngle(degrees);
+}
+
+float Processor::GetLightmapChartMaxAngle() const
+{
+	return m_pProcessorImpl->GetLightmapChartMaxAngle();
+}
+
+void Processor::SetBuildBVHEnable(bool enable)
+{
+	m_pProcessorImpl->SetBuildBVHEnable(enable);
+}
+
+bool Processor::IsBuildBVHEnabled() const
+{
+	return m_pProcessorImpl->IsBuildBVHEnabled();
+}
+
+void Processor::SetBVHMaxLeafSize(uint32_t size)
+{
+	m_pProcessorImpl->SetBVHMaxLeafSize(size);
+}
+
+uint32_t Processor::GetBVHMaxLeafSize() const
+{
+	return m_pProcessorImpl->GetBVHMaxLeafSize();
+}
+
+void Processor::SetBakeVertexAOEnable(bool enable)
+{
+	m_pProcessorImpl->SetBakeVertexAOEnable(enable);
+}
+
+bool Processor::IsBakeVertexAOEnabled() const
+{
+	return m_pProcessorImpl->IsBakeVertexAOEnabled();
+}
+
+void Processor::SetVertexAOSceneOcclusionEnable(bool enable)
+{
+	m_pProcessorImpl->SetVertexAOSceneOcclusionEnable(enable);
+}
+
+bool Processor::IsVertexAOSceneOcclusionEnabled() const
+{
+	return m_pProcessorImpl->IsVertexAOSceneOcclusionEnabled();
+}
+
+void Processor::SetVertexAOColorSetIndex(uint32_t colorSetIndex)
+{
+	m_pProcessorImpl->SetVertexAOColorSetIndex(colorSetIndex);
+}
+
+uint32_t Processor::GetVertexAOColorSetIndex() const
+{
+	return m_pProcessorImpl->GetVertexAOColorSetIndex();
+}
+
+void Processor::SetVertexAORayCount(uint32_t rayCount)
+{
+	m_pProcessorImpl->SetVertexAORayCount(rayCount);
+}
+
+uint32_t Processor::GetVertexAORayCount() const
+{
+	return m_pProcessorImpl->GetVertexAORayCount();
+}
+
+void Processor::SetVertexAOMaxDistance(float distance)
+{
+	m_pProcessorImpl->SetVertexAOMaxDistance(distance);
+}
+
+float Processor::GetVertexAOMaxDistance() const
+{
+	return m_pProcessorImpl->GetVertexAOMaxDistance();
+}
+
+void Processor::SetCompressAnimationsEnable(bool enable)
+{
+	m_pProcessorImpl->SetCompressAnimationsEnable(enable);
+}
+
+bool Processor::IsCompressAnimationsEnabled() const
+{
+	return m_pProcessorImpl->IsCompressAnimationsEnabled();
+}
+
+void Processor::SetAnimationCompressionMaxError(float maxError)
+{
+	m_pProcessorImpl->SetAnimationCompressionMaxError(maxError);
+}
+
+float Processor::GetAnimationCompressionMaxError() const
+{
+	return m_pProcessorImpl->GetAnimationCompressionMaxError();
+}
+
+void Processor::SetAnimationCompressionErrorDistance(float distance)
+{
+	m_pProcessorImpl->SetAnimationCompressionErrorDistance(distance);
+}
+
+float Processor::GetAnimationCompressionErrorDistance() const
+{
+	return m_pProcessorImpl->GetAnimationCompressionErrorDistance();
+}
+
+void Processor::SetQuantizeAnimationsEnable(bool enable)
+{
+	m_pProcessorImpl->SetQuantizeAnimationsEnable(enable);
+}
+
+bool Processor::IsQuantizeAnimationsEnabled() const
+{
+	return m_pProcessorImpl->IsQuantizeAnimationsEnabled();
+}
+
+void Processor::SetResampleAnimationsEnable(bool enable)
+{
+	m_pProcessorImpl->SetResampleAnimationsEnable(enable);
+}
+
+bool Processor::IsResampleAnimationsEnabled() const
+{
+	return m_pProcessorImpl->IsResampleAnimationsEnabled();
+}
+
+void Processor::SetAnimationSampleRate(float sampleRate)
+{
+	m_pProcessorImpl->SetAnimationSampleRate(sampleRate);
+}
+
+float Processor::GetAnimationSampleRate() const
+{
+	return m_pProcessorImpl->GetAnimationSampleRate();
+}
+
+void Processor::SetBakeAnimatedAABBsEnable(bool enable)
+{
+	m_pProcessorImpl->SetBakeAnimatedAABBsEnable(enable);
+}
+
+bool Processor::IsBakeAnimatedAABBsEnabled() const
+{
+	return m_pProcessorImpl->IsBakeAnimatedAABBsEnabled();
+}
+
+void Processor::SetAnimatedAABBWindowFrameCount(uint32_t frameCount)
+{
+	m_pProcessorImpl->SetAnimatedAABBWindowFrameCount(frameCount);
+}
+
+uint32_t Processor::GetAnimatedAABBWindowFrameCount() const
+{
+	return m_pProcessorImpl->GetAnimatedAABBWindowFrameCount();
+}
+
+void Processor::SetPrepareSkinningEnable(bool enable)
+{
+	m_pProcessorImpl->SetPrepareSkinningEnable(enable);
+}
+
+bool Processor::IsPrepareSkinningEnabled() const
+{
+	return m_pProcessorImpl->IsPrepareSkinningEnabled();
+}
+
+void Processor::SetMaxSkinInfluenceCount(uint32_t influenceCount)
+{
+	m_pProcessorImpl->SetMaxSkinInfluenceCount(influenceCount);
+}
+
+uint32_t Processor::GetMaxSkinInfluenceCount() const
+{
+	return m_pProcessorImpl->GetMaxSkinInfluenceCount();
+}
+
+void Processor::SetSkinPaletteSize(uint32_t paletteSize)
+{
+	m_pProcessorImpl->SetSkinPaletteSize(paletteSize);
+}
+
+uint32_t Processor::GetSkinPaletteSize() const
+{
+	return m_pProcessorImpl->GetSkinPaletteSize();
+}
+
+void Processor::SetCompressMorphsEnable(bool enable)
+{
+	m_pProcessorImpl->SetCompressMorphsEnable(enable);
+}
+
+bool Processor::IsCompressMorphsEnabled() const
+{
+	return m_pProcessorImpl->IsCompressMorphsEnabled();
+}
+
+void Processor::SetMorphDeltaThreshold(float threshold)
+{
+	m_pProcessorImpl->SetMorphDeltaThreshold(threshold);
+}
+
+float Processor::GetMorphDeltaThreshold() const
+{
+	return m_pProcessorImpl->GetMorphDeltaThreshold();
+}
+
+void Processor::SetQuantizeMorphsEnable(bool enable)
+{
+	m_pProcessorImpl->SetQuantizeMorphsEnable(enable);
+}
+
+bool Processor::IsQuantizeMorphsEnabled() const
+{
+	return m_pProcessorImpl->IsQuantizeMorphsEnabled();
+}
+
+void Processor::SetBakeVertexAnimationTexturesEnable(bool enable)
+{
+	m_pProcessorImpl->SetBakeVertexAnimationTexturesEnable(enable);
+}
+
+bool Processor::IsBakeVertexAnimationTexturesEnabled() const
+{
+	return m_pProcessorImpl->IsBakeVertexAnimationTexturesEnabled();
+}
+
+void Processor::SetVertexAnimationUVSetIndex(uint32_t uvSetIndex)
+{
+	m_pProcessorImpl->SetVertexAnimationUVSetIndex(uvSetIndex);
+}
+
+uint32_t Processor::GetVertexAnimationUVSetIndex() const
+{
+	return m_pProcessorImpl->GetVertexAnimationUVSetIndex();
+}
+
+void Processor::SetBuildNodeHierarchyEnable(bool enable)
+{
+	m_pProcessorImpl->SetBuildNodeHierarchyEnable(enable);
+}
+
+bool Processor::IsBuildNodeHierarchyEnabled() const
+{
+	return m_pProcessorImpl->IsBuildNodeHierarchyEnabled();
+}
+
 void Processor::AddExtraTextureSearchFolder(const char* pFolderPath)
 {
 	m_pProcessorImpl->AddExtraTextureSearchFolder(pFolderPath);
@@ -88,6 +398,46 @@ bool Processor::IsSearchMissingTexturesEnabled() const
 	return m_pProcessorImpl->IsSearchMissingTexturesEnabled();
 }
 
+void Processor::SetSearchTexturesCaseInsensitiveEnable(bool enable)
+{
+	m_pProcessorImpl->SetSearchTexturesCaseInsensitiveEnable(enable);
+}
+
+bool Processor::IsSearchTexturesCaseInsensitiveEnabled() const
+{
+	return m_pProcessorImpl->IsSearchTexturesCaseInsensitiveEnabled();
+}
+
+void Processor::SetTextureSearchIndexCacheFilePath(const char* pFilePath)
+{
+	m_pProcessorImpl->SetTextureSearchIndexCacheFilePath(pFilePath);
+}
+
+const char* Processor::GetTextureSearchIndexCacheFilePath() const
+{
+	return m_pProcessorImpl->GetTextureSearchIndexCacheFilePath();
+}
+
+void Processor::SetDeduplicateTexturesEnable(bool enable)
+{
+	m_pProcessorImpl->SetDeduplicateTexturesEnable(enable);
+}
+
+bool Processor::IsDeduplicateTexturesEnabled() const
+{
+	return m_pProcessorImpl->IsDeduplicateTexturesEnabled();
+}
+
+void Processor::SetProbeTextureMetadataEnable(bool enable)
+{
+	m_pProcessorImpl->SetProbeTextureMetadataEnable(enable);
+}
+
+bool Processor::IsProbeTextureMetadataEnabled() const
+{
+	return m_pProcessorImpl->IsProbeTextureMetadataEnabled();
+}
+
 void Processor::SetEmbedTextureFilesEnable(bool enable)
 {
 	m_pProcessorImpl->SetEmbedTextureFilesEnable(enable);
@@ -98,4 +448,184 @@ bool Processor::IsEmbedTextureFilesEnabled() const
 	return m_pProcessorImpl->IsEmbedTextureFilesEnabled();
 }
 
+void Processor::SetEmbedTextureFilesIOThreadCount(uint32_t count)
+{
+	m_pProcessorImpl->SetEmbedTextureFilesIOThreadCount(count);
+}
+
+uint32_t Processor::GetEmbedTextureFilesIOThreadCount() const
+{
+	return m_pProcessorImpl->GetEmbedTextureFilesIOThreadCount();
+}
+
+void Processor::SetBakeTextureAtlasesEnable(bool enable)
+{
+	m_pProcessorImpl->SetBakeTextureAtlasesEnable(enable);
+}
+
+bool Processor::IsBakeTextureAtlasesEnabled() const
+{
+	return m_pProcessorImpl->IsBakeTextureAtlasesEnabled();
+}
+
+void Processor::SetTextureAtlasMaxSize(uint32_t size)
+{
+	m_pProcessorImpl->SetTextureAtlasMaxSize(size);
+}
+
+uint32_t Processor::GetTextureAtlasMaxSize() const
+{
+	return m_pProcessorImpl->GetTextureAtlasMaxSize();
+}
+
+void Processor::SetTextureAtlasPadding(uint32_t padding)
+{
+	m_pProcessorImpl->SetTextureAtlasPadding(padding);
+}
+
+uint32_t Processor::GetTextureAtlasPadding() const
+{
+	return m_pProcessorImpl->GetTextureAtlasPadding();
+}
+
+void Processor::SetAnalyzeUVStatisticsEnable(bool enable)
+{
+	m_pProcessorImpl->SetAnalyzeUVStatisticsEnable(enable);
+}
+
+bool Processor::IsAnalyzeUVStatisticsEnabled() const
+{
+	return m_pProcessorImpl->IsAnalyzeUVStatisticsEnabled();
+}
+
+void Processor::SetUVStatisticsUVSetIndex(uint32_t uvSetIndex)
+{
+	m_pProcessorImpl->SetUVStatisticsUVSetIndex(uvSetIndex);
+}
+
+uint32_t Processor::GetUVStatisticsUVSetIndex() const
+{
+	return m_pProcessorImpl->GetUVStatisticsUVSetIndex();
+}
+
+void Processor::SetUVStatisticsResolution(uint32_t resolution)
+{
+	m_pProcessorImpl->SetUVStatisticsResolution(resolution);
+}
+
+uint32_t Processor::GetUVStatisticsResolution() const
+{
+	return m_pProcessorImpl->GetUVStatisticsResolution();
+}
+
+void Processor::SetUVStatisticsReportFilePath(const char* pFilePath)
+{
+	m_pProcessorImpl->SetUVStatisticsReportFilePath(pFilePath);
+}
+
+const char* Processor::GetUVStatisticsReportFilePath() const
+{
+	return m_pProcessorImpl->GetUVStatisticsReportFilePath();
+}
+
+void Processor::SetTexelDensityToleranceRatio(float ratio)
+{
+	m_pProcessorImpl->SetTexelDensityToleranceRatio(ratio);
+}
+
+float Processor::GetTexelDensityToleranceRatio() const
+{
+	return m_pProcessorImpl->GetTexelDensityToleranceRatio();
+}
+
+void Processor::SetTargetTexelDensity(float texelsPerUnit)
+{
+	m_pProcessorImpl->SetTargetTexelDensity(texelsPerUnit);
+}
+
+float Processor::GetTargetTexelDensity() const
+{
+	return m_pProcessorImpl->GetTargetTexelDensity();
+}
+
+void Processor::SetEnforceTextureBudgetEnable(bool enable)
+{
+	m_pProcessorImpl->SetEnforceTextureBudgetEnable(enable);
+}
+
+bool Processor::IsEnforceTextureBudgetEnabled() const
+{
+	return m_pProcessorImpl->IsEnforceTextureBudgetEnabled();
+}
+
+void Processor::SetTextureMaxResolution(cd::MaterialTextureType textureType, uint32_t maxResolution)
+{
+	m_pProcessorImpl->SetTextureMaxResolution(textureType, maxResolution);
+}
+
+uint32_t Processor::GetTextureMaxResolution(cd::MaterialTextureType textureType) const
+{
+	return m_pProcessorImpl->GetTextureMaxResolution(textureType);
+}
+
+void Processor::SetTextureMemoryBudget(uint64_t bytes)
+{
+	m_pProcessorImpl->SetTextureMemoryBudget(bytes);
+}
+
+uint64_t Processor::GetTextureMemoryBudget() const
+{
+	return m_pProcessorImpl->GetTextureMemoryBudget();
+}
+
+void Processor::SetGenerateMipmapsEnable(bool enable)
+{
+	m_pProcessorImpl->SetGenerateMipmapsEnable(enable);
+}
+
+bool Processor::IsGenerateMipmapsEnabled() const
+{
+	return m_pProcessorImpl->IsGenerateMipmapsEnabled();
+}
+
+void Processor::SetMipmapFilter(cd::ResampleFilter filter)
+{
+	m_pProcessorImpl->SetMipmapFilter(filter);
+}
+
+cd::ResampleFilter Processor::GetMipmapFilter() const
+{
+	return m_pProcessorImpl->GetMipmapFilter();
+}
+
+void Processor::SetMipmapAlphaCoverageReference(float reference)
+{
+	m_pProcessorImpl->SetMipmapAlphaCoverageReference(reference);
+}
+
+float Processor::GetMipmapAlphaCoverageReference() const
+{
+	return m_pProcessorImpl->GetMipmapAlphaCoverageReference();
+}
+
+void Processor::SetCompressTexturesEnable(bool enable)
+{
+	m_pProcessorImpl->SetCompressTexturesEnable(enable);
+}
+
+bool Processor::IsCompressTexturesEnabled() const
+{
+	return m_pProcessorImpl->IsCompressTexturesEnabled();
+}
+
+void Processor::SetTextureCompressionFormat(cd::MaterialTextureType textureType, cd::TextureFormat format)
+{
+	m_pProcessorImpl->SetTextureCompressionFormat(textureType, format);
+}
+
+cd::TextureFormat Processor::GetTextureCompressionFormat(cd::MaterialTextureType textureType) const
+{
+	return m_pProcessorImpl->GetTextureCompressionFormat(textureType);
+}
+
 }
\ No newline at end of file
@@ -1,13 +1,40 @@
 #include "ProcessorImpl.h"
 
+#include "FileNameIndex.h"
 #include "Framework/IConsumer.h"
 #include "Framework/IProducer.h"
+#include "Hashers/PicoSHA2/picosha2.h"
+#include "Image/AtlasPacker.h"
+#include "Image/BlockCompressor.h"
+#include "Image/ImageCodec.h"
+#include "Image/MipmapGenerator.h"
+#include "Image/TextureContainer.h"
+#include "Animation/AnimatedAABBBaker.h"
+#include "Animation/AnimationCompressor.h"
+#include "Animation/AnimationResampler.h"
+#include "Animation/SkinningOptimizer.h"
+#include "Animation/VertexAnimationTextureBaker.h"
+#include "Math/AmbientOcclusionBaker.h"
+#include "Math/BVHBuilder.h"
+#include "Math/SIMD.hpp"
+#include "MemoryMappedFile.h"
+#include "Scene/NodeHierarchy.h"
 #include "Scene/SceneDatabase.h"
+#include "Scene/VertexFormat.h"
+#include "Utilities/ParallelFor.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cfloat>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <numeric>
+#include <queue>
+#include <type_traits>
+#include <unordered_map>
 
 namespace details
 {
@@ -39,26 +66,55 @@ void Dump(const cd::Transform& transform)
 	details::Dump("\tScale", transform.GetScale());
 }
 
-void CalculateNodeTransforms(std::vector<cd::Matrix4x4>& nodeFinalTransforms, const cd::SceneDatabase* pSceneDatabase, const cd::Node& node)
+cd::Direction TransformDirection(const cd::Matrix4x4& matrix, const cd::Direction& direction)
 {
-	// DFS gurantees that parent node's transform will be calculated before child nodes.
-	cd::Matrix4x4 parentTransform = cd::Matrix4x4::Identity();
-	if (node.GetParentID().IsValid())
+	cd::Vec4f result = matrix * cd::Vec4f(direction.x(), direction.y(), direction.z(), 0.0f);
+	return cd::Direction(result.x(), result.y(), result.z());
+}
+
+cd::Direction TransformUnitDirection(const cd::Matrix4x4& matrix, const cd::Direction& direction)
+{
+	cd::Direction result = TransformDirection(matrix, direction);
+	float length = result.Length();
+	return length > 0.0f ? result * (1.0f / length) : result;
+}
+
+// Moves mesh vertices from node space to world space. Normals use the inverse transpose matrix to stay perpendicular under non uniform scales.
+// Morph deltas are offsets so they only need the linear part. Normal deltas use the same normal matrix as normals.
+void TransformMeshVertices(cd::Mesh& mesh, const cd::Matrix4x4& transform)
+{
+	cd::Matrix4x4 normalTransform = transform.Inverse().Transpose();
+	for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
 	{
-		parentTransform = nodeFinalTransforms[node.GetParentID().Data()];
+		const cd::Point& position = mesh.GetVertexPosition(vertexIndex);
+		cd::Vec4f newPosition = transform * cd::Vec4f(position.x(), position.y(), position.z(), 1.0f);
+		mesh.SetVertexPosition(vertexIndex, cd::Point(newPosition.x(), newPosition.y(), newPosition.z()));
+		mesh.SetVertexNormal(vertexIndex, TransformUnitDirection(normalTransform, mesh.GetVertexNormal(vertexIndex)));
+		mesh.SetVertexTangent(vertexIndex, TransformUnitDirection(transform, mesh.GetVertexTangent(vertexIndex)));
+		mesh.SetVertexBiTangent(vertexIndex, TransformUnitDirection(transform, mesh.GetVertexBiTangent(vertexIndex)));
 	}
 
-	const cd::Transform& sourceTransform = node.GetTransform();
-	cd::Matrix4x4 localTransform = sourceTransform.GetMatrix();
-	nodeFinalTransforms[node.GetID().Data()] = parentTransform * localTransform;
-
-	const std::vector<cd::NodeID>& childIDs = node.GetChildIDs();
-	for (uint32_t childIndex = 0U; childIndex < node.GetChildCount(); ++childIndex)
+	// Optional delta channels may be empty.
+	for (cd::Morph& morph : mesh.GetMorphs())
 	{
-		cd::NodeID childNodeID = childIDs[childIndex];
-		CalculateNodeTransforms(nodeFinalTransforms, pSceneDatabase, pSceneDatabase->GetNode(childNodeID.Data()));
+		for (cd::Point& position : morph.GetVertexPositions())
+		{
+			position = TransformDirection(transform, position);
+		}
+		for (cd::Direction& normal : morph.GetVertexNormals())
+		{
+			normal = TransformDirection(normalTransform, normal);
+		}
+		for (cd::Direction& tangent : morph.GetVertexTangents())
+		{
+			tangent = TransformDirection(transform, tangent);
+		}
+		for (cd::Direction& biTangent : morph.GetVertexBiTangents())
+		{
+			biTangent = TransformDirection(transform, biTangent);
+		}
 	}
-};
+}
 
 class SceneDatabaseValidator
 {
@@ -90,24 +146,284 @@ private:
 	cdtools::ProcessorImpl* m_pProcessImpl = nullptr;
 };
 
-std::vector<std::byte> LoadFile(const char* pFilePath)
+std::shared_ptr<const std::vector<std::byte>> LoadFile(const char* pFilePath)
+{
+	cdtools::MemoryMappedFile mappedFile(pFilePath);
+	if (!mappedFile.IsValid())
+	{
+		return nullptr;
+	}
+
+	return std::make_shared<const std::vector<std::byte>>(mappedFile.GetData(), mappedFile.GetData() + mappedFile.GetSize());
+}
+
+// Texture pixels can be loaded from RGBA8 raw pixels, embedded image file or texture file.
+bool CanLoadTexturePixels(const cd::Texture& texture)
+{
+	if (texture.ExistRawData())
+	{
+		return cd::TextureRawDataType::ImageFile == texture.GetRawDataType() ||
+			(cd::TextureRawDataType::Pixels == texture.GetRawDataType() && cd::TextureFormat::RGBA8 == texture.GetFormat());
+	}
+
+	return cd::TextureRawDataType::Container != texture.GetRawDataType() && texture.GetPath()[0] != '\0';
+}
+
+// Returns RGBA8 pixels of a texture. Texture raw data is shared directly if it is already RGBA8 pixels.
+std::shared_ptr<const std::vector<std::byte>> LoadTexturePixels(const cd::Texture& texture, uint32_t& width, uint32_t& height)
+{
+	if (texture.ExistRawData())
+	{
+		if (cd::TextureRawDataType::Pixels == texture.GetRawDataType())
+		{
+			if (cd::TextureFormat::RGBA8 != texture.GetFormat())
+			{
+				return nullptr;
+			}
+
+			width = texture.GetWidth();
+			height = texture.GetHeight();
+			return texture.GetSharedRawData();
+		}
+
+		const std::vector<std::byte>& fileData = texture.GetRawData();
+		std::vector<std::byte> pixels = cd::ImageCodec::Decode(fileData.data(), fileData.size(), 4U, width, height);
+		return pixels.empty() ? nullptr : std::make_shared<const std::vector<std::byte>>(cd::MoveTemp(pixels));
+	}
+
+	cdtools::MemoryMappedFile mappedFile(texture.GetPath());
+	if (!mappedFile.IsValid())
+	{
+		return nullptr;
+	}
+
+	std::vector<std::byte> pixels = cd::ImageCodec::Decode(mappedFile.GetData(), mappedFile.GetSize(), 4U, width, height);
+	return pixels.empty() ? nullptr : std::make_shared<const std::vector<std::byte>>(cd::MoveTemp(pixels));
+}
+
+bool IsAnyTextureSizeUnknown(const std::vector<cd::Texture>& textures)
+{
+	return std::any_of(textures.begin(), textures.end(), [](const cd::Texture& texture)
+	{
+		return CanLoadTexturePixels(texture) && (0U == texture.GetWidth() || 0U == texture.GetHeight());
+	});
+}
+
+bool IsSRGBTextureType(cd::MaterialTextureType textureType)
+{
+	return cd::MaterialTextureType::BaseColor == textureType || cd::MaterialTextureType::Emissive == textureType;
+}
+
+// Estimated bytes of one texture level in GPU memory.
+uint64_t EstimateTextureLevelBytes(cd::TextureFormat format, uint32_t width, uint32_t height)
+{
+	if (cd::BlockCompressor::IsSupported(format))
+	{
+		return cd::BlockCompressor::GetCompressedSize(format, width, height);
+	}
+
+	uint64_t bytesPerPixel;
+	switch (format)
+	{
+	case cd::TextureFormat::R8:
+	case cd::TextureFormat::A8:
+		bytesPerPixel = 1U;
+		break;
+	case cd::TextureFormat::RG8:
+	case cd::TextureFormat::R16:
+	case cd::TextureFormat::R16F:
+		bytesPerPixel = 2U;
+		break;
+	case cd::TextureFormat::RGB8:
+		bytesPerPixel = 3U;
+		break;
+	case cd::TextureFormat::RG16:
+	case cd::TextureFormat::RG16F:
+	case cd::TextureFormat::R32F:
+	case cd::TextureFormat::R32I:
+		bytesPerPixel = 4U;
+		break;
+	case cd::TextureFormat::RGBA16:
+	case cd::TextureFormat::RGBA16F:
+	case cd::TextureFormat::RG32F:
+		bytesPerPixel = 8U;
+		break;
+	case cd::TextureFormat::RGBA32F:
+		bytesPerPixel = 16U;
+		break;
+	default:
+		bytesPerPixel = 4U;
+		break;
+	}
+
+	return bytesPerPixel * width * height;
+}
+
+struct UVStatistics
+{
+	uint32_t triangleCount = 0U;
+	uint32_t flippedTriangleCount = 0U;
+	uint32_t degenerateTriangleCount = 0U;
+	double worldArea = 0.0;
+	double uvArea = 0.0;
+	// Ratios of [0, 1] UV square which is covered by at least one triangle and more than one triangle.
+	double utilization = 0.0;
+	double overlapArea = 0.0;
+};
+
+// Adds areas of 4 triangles at once. Triangles are gathered to SIMD lanes by components.
+void AccumulateTriangleAreas(const cd::Mesh& mesh, uint32_t uvSetIndex, UVStatistics& statistics)
+{
+	const std::vector<cd::Point>& positions = mesh.GetVertexPositions();
+	const std::vector<cd::UV>& uvs = mesh.GetVertexUV(uvSetIndex);
+	const std::vector<cd::Polygon>& polygons = mesh.GetPolygons();
+
+	uint32_t positiveTriangleCount = 0U;
+	uint32_t negativeTriangleCount = 0U;
+	cd::Float4 worldAreaSum = cd::Float4::Zero();
+	cd::Float4 uvAreaSum = cd::Float4::Zero();
+	for (size_t polygonIndex = 0U; polygonIndex < polygons.size(); polygonIndex += 4U)
+	{
+		alignas(16) float edges[10][4] = {};
+		for (size_t lane = 0U; lane < 4U && polygonIndex + lane < polygons.size(); ++lane)
+		{
+			const cd::Polygon& polygon = polygons[polygonIndex + lane];
+			const cd::Point& p0 = positions[polygon[0].Data()];
+			const cd::Point& p1 = positions[polygon[1].Data()];
+			const cd::Point& p2 = positions[polygon[2].Data()];
+			const cd::UV& uv0 = uvs[polygon[0].Data()];
+			const cd::UV& uv1 = uvs[polygon[1].Data()];
+			const cd::UV& uv2 = uvs[polygon[2].Data()];
+			edges[0][lane] = p1.x() - p0.x();
+			edges[1][lane] = p1.y() - p0.y();
+			edges[2][lane] = p1.z() - p0.z();
+			edges[3][lane] = p2.x() - p0.x();
+			edges[4][lane] = p2.y() - p0.y();
+			edges[5][lane] = p2.z() - p0.z();
+			edges[6][lane] = uv1.x() - uv0.x();
+			edges[7][lane] = uv1.y() - uv0.y();
+			edges[8][lane] = uv2.x() - uv0.x();
+			edges[9][lane] = uv2.y() - uv0.y();
+		}
+
+		cd::Float4 e1x = cd::Float4::Load(edges[0]);
+		cd::Float4 e1y = cd::Float4::Load(edges[1]);
+		cd::Float4 e1z = cd::Float4::Load(edges[2]);
+		cd::Float4 e2x = cd::Float4::Load(edges[3]);
+		cd::Float4 e2y = cd::Float4::Load(edges[4]);
+		cd::Float4 e2z = cd::Float4::Load(edges[5]);
+		cd::Float4 crossX = e1y * e2z - e1z * e2y;
+		cd::Float4 crossY = e1z * e2x - e1x * e2z;
+		cd::Float4 crossZ = e1x * e2y - e1y * e2x;
+		cd::Float4 doubleWorldAreas = cd::Float4::Sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ);
+		cd::Float4 doubleUVAreas = cd::Float4::Load(edges[6]) * cd::Float4::Load(edges[9]) - cd::Float4::Load(edges[7]) * cd::Float4::Load(edges[8]);
+		worldAreaSum += doubleWorldAreas;
+		uvAreaSum += cd::Float4::Max(doubleUVAreas, cd::Float4::Zero()) - cd::Float4::Min(doubleUVAreas, cd::Float4::Zero());
+
+		for (size_t lane = 0U; lane < 4U && polygonIndex + lane < polygons.size(); ++lane)
+		{
+			float doubleUVArea = doubleUVAreas.Get(static_cast<int>(lane));
+			if (std::abs(doubleUVArea) <= FLT_EPSILON * FLT_EPSILON || doubleWorldAreas.Get(static_cast<int>(lane)) <= FLT_EPSILON * FLT_EPSILON)
+			{
+				++statistics.degenerateTriangleCount;
+			}
+			else if (doubleUVArea > 0.0f)
+			{
+				++positiveTriangleCount;
+			}
+			else
+			{
+				++negativeTriangleCount;
+			}
+		}
+	}
+
+	// Triangles whose UV winding is against the majority winding are flipped.
+	statistics.triangleCount = static_cast<uint32_t>(polygons.size());
+	statistics.flippedTriangleCount = std::min(positiveTriangleCount, negativeTriangleCount);
+	statistics.worldArea = 0.5 * cd::Float4::Dot4(worldAreaSum, cd::Float4::Splat(1.0f));
+	statistics.uvArea = 0.5 * cd::Float4::Dot4(uvAreaSum, cd::Float4::Splat(1.0f));
+}
+
+// Rasterizes UV triangles into a coverage grid over [0, 1] UV square. Top-left fill rule keeps shared edges from counting as overlaps.
+// Coverages are saturated at 2 which means overlapped. Meshes sharing a texture can be rasterized into the same grid.
+void RasterizeUVCoverage(const cd::Mesh& mesh, uint32_t uvSetIndex, uint32_t resolution, std::vector<uint8_t>& coverages)
 {
-	std::vector<std::byte> fileData;
+	const std::vector<cd::UV>& uvs = mesh.GetVertexUV(uvSetIndex);
+	for (const cd::Polygon& polygon : mesh.GetPolygons())
+	{
+		cd::Vec2f v0 = uvs[polygon[0].Data()] * static_cast<float>(resolution);
+		cd::Vec2f v1 = uvs[polygon[1].Data()] * static_cast<float>(resolution);
+		cd::Vec2f v2 = uvs[polygon[2].Data()] * static_cast<float>(resolution);
+		float doubleArea = (v1.x() - v0.x()) * (v2.y() - v0.y()) - (v1.y() - v0.y()) * (v2.x() - v0.x());
+		if (0.0f == doubleArea)
+		{
+			continue;
+		}
+		else if (doubleArea < 0.0f)
+		{
+			std::swap(v1, v2);
+		}
+
+		int32_t maxTexel = static_cast<int32_t>(resolution) - 1;
+		int32_t minX = std::max(0, static_cast<int32_t>(std::floor(std::min({ v0.x(), v1.x(), v2.x() }))));
+		int32_t minY = std::max(0, static_cast<int32_t>(std::floor(std::min({ v0.y(), v1.y(), v2.y() }))));
+		int32_t maxX = std::min(maxTexel, static_cast<int32_t>(std::ceil(std::max({ v0.x(), v1.x(), v2.x() }))));
+		int32_t maxY = std::min(maxTexel, static_cast<int32_t>(std::ceil(std::max({ v0.y(), v1.y(), v2.y() }))));
+
+		const cd::Vec2f* edgeVertices[3][2] = { { &v1, &v2 }, { &v2, &v0 }, { &v0, &v1 } };
+		float edgeA[3];
+		float edgeB[3];
+		float edgeC[3];
+		bool isTopLeft[3];
+		for (int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+		{
+			const cd::Vec2f& start = *edgeVertices[edgeIndex][0];
+			const cd::Vec2f& end = *edgeVertices[edgeIndex][1];
+			edgeA[edgeIndex] = start.y() - end.y();
+			edgeB[edgeIndex] = end.x() - start.x();
+			edgeC[edgeIndex] = start.x() * end.y() - start.y() * end.x();
+			isTopLeft[edgeIndex] = edgeA[edgeIndex] > 0.0f || (0.0f == edgeA[edgeIndex] && edgeB[edgeIndex] < 0.0f);
+		}
+
+		for (int32_t y = minY; y <= maxY; ++y)
+		{
+			float sampleY = static_cast<float>(y) + 0.5f;
+			for (int32_t x = minX; x <= maxX; ++x)
+			{
+				float sampleX = static_cast<float>(x) + 0.5f;
+				bool isInside = true;
+				for (int edgeIndex = 0; edgeIndex < 3; ++edgeIndex)
+				{
+					float distance = edgeA[edgeIndex] * sampleX + edgeB[edgeIndex] * sampleY + edgeC[edgeIndex];
+					isInside = isInside && (distance > 0.0f || (0.0f == distance && isTopLeft[edgeIndex]));
+				}
+
+				uint8_t& coverage = coverages[static_cast<size_t>(y) * resolution + x];
+				coverage = isInside && coverage < 2U ? coverage + 1U : coverage;
+			}
+		}
+	}
+}
 
-	std::ifstream fin(pFilePath, std::ios::in | std::ios::binary);
-	if (!fin.is_open())
+void CalculateUVCoverage(const std::vector<uint8_t>& coverages, UVStatistics& statistics)
+{
+	size_t coveredTexelCount = 0U;
+	size_t overlappedTexelCount = 0U;
+	for (uint8_t coverage : coverages)
 	{
-		return fileData;
+		coveredTexelCount += coverage > 0U ? 1U : 0U;
+		overlappedTexelCount += coverage > 1U ? 1U : 0U;
 	}
 
-	fin.seekg(0L, std::ios::end);
-	size_t fileSize = fin.tellg();
-	fin.seekg(0L, std::ios::beg);
-	fileData.resize(fileSize);
-	fin.read(reinterpret_cast<char*>(fileData.data()), fileSize);
-	fin.close();
+	statistics.utilization = static_cast<double>(coveredTexelCount) / coverages.size();
+	statistics.overlapArea = static_cast<double>(overlappedTexelCount) / coverages.size();
+}
 
-	return fileData;
+// Texels per world unit in one direction.
+double CalculateTexelDensity(double worldArea, double uvArea, uint32_t textureWidth, uint32_t textureHeight)
+{
+	return worldArea > 0.0 ? std::sqrt(uvArea * textureWidth * textureHeight / worldArea) : 0.0;
 }
 
 }
@@ -153,25 +469,115 @@ void ProcessorImpl::Run()
 			FlattenSceneDatabase();
 		}
 
+		if (IsBuildNodeHierarchyEnabled())
+		{
+			BuildNodeHierarchy();
+		}
+
+		if (IsPrepareSkinningEnabled())
+		{
+			PrepareSkinning();
+		}
+
 		if (IsCalculateAABBForSceneDatabaseEnabled())
 		{
 			CalculateAABBForSceneDatabase();
 		}
 
+		if (IsGenerateLightmapUVsEnabled())
+		{
+			GenerateLightmapUVs();
+		}
+
 		if (IsCalculateConnetivityDataEnabled())
 		{
 			CalculateConnetivityData();
 		}
 
+		if (IsBuildBVHEnabled())
+		{
+			BuildBVH();
+		}
+
+		if (IsBakeVertexAOEnabled())
+		{
+			BakeVertexAO();
+		}
+
+		if (IsResampleAnimationsEnabled())
+		{
+			ResampleAnimations();
+		}
+
+		if (IsCompressAnimationsEnabled())
+		{
+			CompressAnimations();
+		}
+
+		if (IsCompressMorphsEnabled())
+		{
+			CompressMorphs();
+		}
+
+		if (IsBakeAnimatedAABBsEnabled())
+		{
+			BakeAnimatedAABBs();
+		}
+
+		if (IsBakeVertexAnimationTexturesEnabled())
+		{
+			BakeVertexAnimationTextures();
+		}
+
 		if (IsSearchMissingTexturesEnabled())
 		{
 			SearchMissingTextures();
 		}
 
+		if (IsDeduplicateTexturesEnabled())
+		{
+			DeduplicateTextures();
+		}
+
+		if (IsProbeTextureMetadataEnabled())
+		{
+			ProbeTextureMetadata();
+		}
+
 		if (IsEmbedTextureFilesEnabled())
 		{
 			EmbedTextureFiles();
 		}
+
+		if (IsBakeTextureAtlasesEnabled())
+		{
+			BakeTextureAtlases();
+		}
+
+		if (IsAnalyzeUVStatisticsEnabled())
+		{
+			AnalyzeUVStatistics();
+		}
+
+		if (IsEnforceTextureBudgetEnabled())
+		{
+			EnforceTextureBudget();
+		}
+
+		if (IsGenerateMipmapsEnabled())
+		{
+			GenerateMipmaps();
+		}
+
+		if (IsCompressTexturesEnabled())
+		{
+			CompressTextures();
+		}
+
+		if (IsPackTextureContainersEnabled())
+		{
+			PackTextureContainers();
+		}
 	}
 
 	// Dump all information finally.
@@ -534,137 +940,1730 @@ void ProcessorImpl::CalculateConnetivityData()
 	}
 }
 
-void ProcessorImpl::CalculateAABBForSceneDatabase()
+void ProcessorImpl::GenerateLightmapUVs()
 {
-	// Update mesh AABB by its current vertex positions.
+	if (m_lightmapUVSetIndex >= cd::MaxUVSetCount)
+	{
+		printf("Lightmap UV set index is out of range : %u\n", m_lightmapUVSetIndex);
+		return;
+	}
+
+	// Charts of one mesh are processed sequentially. Meshes are independent.
 	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
-	for (uint32_t meshIndex = 0U; meshIndex < m_pCurrentSceneDatabase->GetMeshCount(); ++meshIndex)
+	uint32_t meshCount = static_cast<uint32_t>(meshes.size());
+	std::vector<uint8_t> meshResults(meshCount, 0U);
+	cd::ParallelFor(meshCount, [this, &meshes, &meshResults](uint32_t meshIndex)
 	{
-		cd::Mesh& mesh = meshes[meshIndex];
+		meshResults[meshIndex] = cd::LightmapUVGenerator::Generate(meshes[meshIndex], m_lightmapUVSetIndex, m_lightmapUVOptions) ? 1U : 0U;
+	});
 
-		// Apply transform to vertex position.
-		cd::Point minPoint(FLT_MAX);
-		cd::Point maxPoint(-FLT_MAX);
-		for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		if (0U == meshResults[meshIndex] && meshes[meshIndex].GetPolygonCount() > 0U)
 		{
-			const cd::Point& position = mesh.GetVertexPosition(vertexIndex);
-			minPoint.x() = minPoint.x() > position.x() ? position.x() : minPoint.x();
-			minPoint.y() = minPoint.y() > position.y() ? position.y() : minPoint.y();
-			minPoint.z() = minPoint.z() > position.z() ? position.z() : minPoint.z();
-			maxPoint.x() = maxPoint.x() > position.x() ? maxPoint.x() : position.x();
-			maxPoint.y() = maxPoint.y() > position.y() ? maxPoint.y() : position.y();
-			maxPoint.z() = maxPoint.z() > position.z() ? maxPoint.z() : position.z();
+			printf("Failed to generate lightmap UVs : %s\n", meshes[meshIndex].GetName());
 		}
-
-		mesh.SetAABB(cd::AABB(cd::MoveTemp(minPoint), cd::MoveTemp(maxPoint)));
 	}
-
-	// Update scene AABB by meshes' AABB.
-	m_pCurrentSceneDatabase->UpdateAABB();
 }
 
-void ProcessorImpl::FlattenSceneDatabase()
+void ProcessorImpl::BuildBVH()
 {
-	uint32_t totalNodeCount = m_pCurrentSceneDatabase->GetNodeCount();
-	if (0U == totalNodeCount)
-	{
-		return;
-	}
+	cd::BVHBuildOptions options;
+	options.maxLeafSize = m_bvhMaxLeafSize;
 
-	// Init every node's final transform matrix after removing node hierarchy.
-	std::vector<cd::Matrix4x4> nodeFinalTransforms;
-	nodeFinalTransforms.reserve(totalNodeCount);
-	std::map<uint32_t, uint32_t> mapMeshIDToAssociatedNodeID;
-	for (uint32_t nodeIndex = 0U; nodeIndex < totalNodeCount; ++nodeIndex)
+	// Large meshes use all threads inside the builder. Small meshes are built in parallel by one thread for each.
+	constexpr uint32_t LargeMeshPolygonCount = 65536U;
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	std::vector<uint32_t> smallMeshIndexes;
+	for (uint32_t meshIndex = 0U; meshIndex < meshes.size(); ++meshIndex)
 	{
-		const cd::Node& node = m_pCurrentSceneDatabase->GetNode(nodeIndex);
-		const std::vector<cd::MeshID>& nodeMeshIDs = node.GetMeshIDs();
-		for (uint32_t nodeMeshIndex = 0U; nodeMeshIndex < node.GetMeshCount(); ++nodeMeshIndex)
+		if (meshes[meshIndex].GetPolygonCount() >= LargeMeshPolygonCount)
+		{
+			cd::BVHBuilder::Build(meshes[meshIndex], options);
+		}
+		else
 		{
-			mapMeshIDToAssociatedNodeID[nodeMeshIDs[nodeMeshIndex].Data()] = nodeIndex;
+			smallMeshIndexes.push_back(meshIndex);
 		}
+	}
 
-		nodeFinalTransforms.push_back(cd::Transform::Identity().GetMatrix());
+	cd::BVHBuildOptions smallMeshOptions = options;
+	smallMeshOptions.maxThreadCount = 1U;
+	cd::ParallelFor(static_cast<uint32_t>(smallMeshIndexes.size()), [&meshes, &smallMeshIndexes, &smallMeshOptions](uint32_t index)
+	{
+		cd::BVHBuilder::Build(meshes[smallMeshIndexes[index]], smallMeshOptions);
+	});
+
+	std::vector<cd::AABB> meshBounds;
+	meshBounds.reserve(meshes.size());
+	for (const cd::Mesh& mesh : meshes)
+	{
+		meshBounds.push_back(mesh.GetAABB());
 	}
+	cd::BVHBuilder::Build(meshBounds, options, m_pCurrentSceneDatabase->GetMeshBVHNodes(), m_pCurrentSceneDatabase->GetMeshBVHMeshIndexes());
+}
 
-	const cd::Node& rootNode = m_pCurrentSceneDatabase->GetNode(0);
-	details::CalculateNodeTransforms(nodeFinalTransforms, m_pCurrentSceneDatabase, rootNode);
+void ProcessorImpl::BakeVertexAO()
+{
+	if (m_vertexAOColorSetIndex >= cd::MaxColorSetCount)
+	{
+		printf("Vertex AO color set index is out of range : %u\n", m_vertexAOColorSetIndex);
+		return;
+	}
 
 	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
-	for (uint32_t meshIndex = 0U; meshIndex < m_pCurrentSceneDatabase->GetMeshCount(); ++meshIndex)
+	bool isAnyBVHMissing = std::any_of(meshes.begin(), meshes.end(), [](const cd::Mesh& mesh) { return mesh.GetBVHNodes().empty() && mesh.GetPolygonCount() > 0U; });
+	if (isAnyBVHMissing || (IsVertexAOSceneOcclusionEnabled() && m_pCurrentSceneDatabase->GetMeshBVHNodes().empty()))
 	{
-		cd::Mesh& mesh = meshes[meshIndex];
-		if (0U != mesh.GetVertexInfluenceCount())
+		BuildBVH();
+	}
+
+	std::vector<std::vector<float>> meshVertexAccessibilities;
+	if (IsVertexAOSceneOcclusionEnabled())
+	{
+		cd::AmbientOcclusionBaker::Bake(*m_pCurrentSceneDatabase, m_vertexAOOptions, meshVertexAccessibilities);
+	}
+	else
+	{
+		meshVertexAccessibilities.resize(meshes.size());
+		for (uint32_t meshIndex = 0U; meshIndex < meshes.size(); ++meshIndex)
 		{
-			// Don't need to support flatten SkinMesh currently.
-			continue;
+			cd::AmbientOcclusionBaker::Bake(meshes[meshIndex], m_vertexAOOptions, meshVertexAccessibilities[meshIndex]);
 		}
+	}
 
-		// Apply transform to vertex position.
-		auto itNodeIndex = mapMeshIDToAssociatedNodeID.find(meshIndex);
-		if (itNodeIndex == mapMeshIDToAssociatedNodeID.end())
+	for (uint32_t meshIndex = 0U; meshIndex < meshes.size(); ++meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+		if (m_vertexAOColorSetIndex >= mesh.GetVertexColorSetCount())
 		{
-			// If a mesh doesn't find its associated node, no need to process.
-			continue;
+			const std::vector<cd::VertexAttributeLayout>& vertexLayout = mesh.GetVertexFormat().GetVertexLayout();
+			auto colorLayoutCount = static_cast<uint32_t>(std::count_if(vertexLayout.begin(), vertexLayout.end(),
+				[](const cd::VertexAttributeLayout& layout) { return cd::VertexAttributeType::Color == layout.vertexAttributeType; }));
+			for (uint32_t layoutIndex = colorLayoutCount; layoutIndex <= m_vertexAOColorSetIndex; ++layoutIndex)
+			{
+				mesh.GetVertexFormat().AddAttributeLayout(cd::VertexAttributeType::Color, cd::GetAttributeValueType<cd::Color::ValueType>(), cd::Color::Size);
+			}
+			mesh.SetVertexColorSetCount(m_vertexAOColorSetIndex + 1U);
 		}
 
-		uint32_t nodeIndex = itNodeIndex->second;
-		const cd::Matrix4x4& finalTransform = nodeFinalTransforms[nodeIndex];
+		const std::vector<float>& vertexAccessibilities = meshVertexAccessibilities[meshIndex];
 		for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
 		{
-			const cd::Point& position = mesh.GetVertexPosition(vertexIndex);
-			cd::Vec4f newPosition = finalTransform * cd::Vec4f(position.x(), position.y(), position.z(), 1.0f);
-			mesh.SetVertexPosition(vertexIndex, cd::Point(newPosition.x(), newPosition.y(), newPosition.z()));
+			float accessibility = vertexAccessibilities[vertexIndex];
+			mesh.SetVertexColor(m_vertexAOColorSetIndex, vertexIndex, cd::Color(accessibility, accessibility, accessibility, 1.0f));
 		}
 	}
-
-	// Delete all nodes.
-	m_pCurrentSceneDatabase->GetNodes().clear();
-	m_pCurrentSceneDatabase->SetNodeCount(0U);
 }
 
-void ProcessorImpl::SearchMissingTextures()
+void ProcessorImpl::ResampleAnimations()
 {
-	for (auto& texture : m_pCurrentSceneDatabase->GetTextures())
+	std::vector<cd::Track>& tracks = m_pCurrentSceneDatabase->GetTracks();
+	for (const cd::Animation& animation : m_pCurrentSceneDatabase->GetAnimations())
 	{
-		std::filesystem::path originFilePath(texture.GetPath());
-		if (std::filesystem::exists(originFilePath))
-		{
-			continue;
-		}
+		uint32_t keyCount;
+		float keyInterval = cd::AnimationResampler::CalculateKeyInterval(animation, m_animationSampleRate, keyCount);
 
-		for (const std::string& textureSearchFolder : m_textureSearchFolders)
+		const std::vector<cd::TrackID>& trackIDs = animation.GetBoneTrackIDs();
+		cd::ParallelFor(static_cast<uint32_t>(trackIDs.size()), [&tracks, &trackIDs, keyInterval, keyCount](uint32_t trackIndex)
 		{
-			std::filesystem::path newFilePath(textureSearchFolder);
-			newFilePath /= originFilePath.filename();
+			cd::AnimationResampler::Resample(tracks[trackIDs[trackIndex].Data()], keyInterval, keyCount);
+		});
 
-			if (std::filesystem::exists(newFilePath))
-			{
-				texture.SetPath(newFilePath.string().c_str());
-				break;
-			}
-		}
+		printf("Resample animation %s : %u keys per channel\n", animation.GetName(), keyCount);
 	}
 }
 
-void ProcessorImpl::EmbedTextureFiles()
+void ProcessorImpl::CompressAnimations()
 {
-	for (auto& texture : m_pCurrentSceneDatabase->GetTextures())
+	auto CountKeys = [](const std::vector<cd::Track>& tracks)
 	{
-		if (texture.ExistRawData())
+		uint32_t keyCount = 0U;
+		for (const cd::Track& track : tracks)
 		{
-			continue;
+			keyCount += track.GetTranslationKeyCount() + track.GetRotationKeyCount() + track.GetScaleKeyCount();
 		}
+		return keyCount;
+	};
 
-		const char* pFilePath = texture.GetPath();
-		if (!std::filesystem::exists(pFilePath))
-		{
-			continue;
-		}
+	std::vector<cd::Track>& tracks = m_pCurrentSceneDatabase->GetTracks();
+	uint32_t keyCount = CountKeys(tracks);
 
-		// Just embed texture file, not parse its information.
-		texture.SetRawData(details::LoadFile(pFilePath));
-	}
+	cd::ParallelFor(static_cast<uint32_t>(tracks.size()), [this, &tracks](uint32_t trackIndex)
+	{
+		cd::AnimationCompressor::Compress(tracks[trackIndex], m_animationCompressionOptions);
+	});
+
+	printf("Compress animation keys : %u -> %u\n", keyCount, CountKeys(tracks));
 }
 
-}
\ No newline at end of file
+void ProcessorImpl::CompressMorphs()
+{
+	uint32_t vertexCount = 0U;
+	uint32_t removedVertexCount = 0U;
+	uint32_t removedMorphCount = 0U;
+	auto CompressMorphs = [this, &vertexCount, &removedVertexCount, &removedMorphCount](std::vector<cd::Morph>& morphs)
+	{
+		for (cd::Morph& morph : morphs)
+		{
+			vertexCount += morph.GetVertexCount();
+			removedVertexCount += morph.RemoveUnchangedVertices(m_morphDeltaThreshold);
+			if (m_enableQuantizeMorphs)
+			{
+				morph.Quantize();
+			}
+		}
+
+		// Morphs without changed vertices do nothing. Empty morphs also can't be loaded.
+		auto itRemoved = std::remove_if(morphs.begin(), morphs.end(), [](const cd::Morph& morph) { return 0U == morph.GetVertexCount(); });
+		removedMorphCount += static_cast<uint32_t>(morphs.end() - itRemoved);
+		morphs.erase(itRemoved, morphs.end());
+	};
+
+	for (cd::Mesh& mesh : m_pCurrentSceneDatabase->GetMeshes())
+	{
+		CompressMorphs(mesh.GetMorphs());
+	}
+	CompressMorphs(m_pCurrentSceneDatabase->GetMorphs());
+
+	printf("Compress morph vertices : %u -> %u, removed %u empty morphs\n", vertexCount, vertexCount - removedVertexCount, removedMorphCount);
+}
+
+void ProcessorImpl::BakeAnimatedAABBs()
+{
+	for (cd::Animation& animation : m_pCurrentSceneDatabase->GetAnimations())
+	{
+		if (!cd::AnimatedAABBBaker::Bake(*m_pCurrentSceneDatabase, animation, m_animationSampleRate, m_animatedAABBWindowFrameCount))
+		{
+			printf("Failed to bake animated AABBs : %s doesn't have skinned vertices\n", animation.GetName());
+			continue;
+		}
+
+		const cd::AABB& aabb = animation.GetAABB();
+		printf("Bake animated AABBs %s : %u windows, size (%f, %f, %f)\n", animation.GetName(), animation.GetWindowAABBCount(),
+			aabb.Size().x(), aabb.Size().y(), aabb.Size().z());
+	}
+}
+
+void ProcessorImpl::BakeVertexAnimationTextures()
+{
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	const std::vector<cd::Animation>& animations = m_pCurrentSceneDatabase->GetAnimations();
+	for (cd::Mesh& mesh : meshes)
+	{
+		if (0U == mesh.GetVertexInfluenceCount() || animations.empty())
+		{
+			continue;
+		}
+
+		// Lookup UVs must not overwrite other UV sets such as lightmap UVs.
+		uint32_t uvSetIndex = m_vertexAnimationUVSetIndex;
+		if (Processor::NextFreeUVSetIndex == uvSetIndex)
+		{
+			uvSetIndex = mesh.GetVertexUVSetCount();
+		}
+		else if (uvSetIndex < mesh.GetVertexUVSetCount())
+		{
+			printf("Failed to generate vertex animation UVs : %s already has data in UV set %u\n", mesh.GetName(), uvSetIndex);
+			continue;
+		}
+
+		// Frames of one texture are baked in parallel. Textures are named <mesh>_<animation>_VAT which is how runtime finds them.
+		std::vector<cd::Texture> bakedTextures;
+		for (const cd::Animation& animation : animations)
+		{
+			cd::TextureID textureID(m_pCurrentSceneDatabase->GetTextureCount() + static_cast<uint32_t>(bakedTextures.size()));
+			std::string textureName = std::string(mesh.GetName()) + "_" + animation.GetName() + "_VAT";
+			cd::Texture texture(textureID, textureName.c_str(), cd::MaterialTextureType::General);
+			if (!cd::VertexAnimationTextureBaker::Bake(*m_pCurrentSceneDatabase, animation, mesh, m_animationSampleRate, texture))
+			{
+				printf("Failed to bake vertex animation texture : %s\n", textureName.c_str());
+				continue;
+			}
+
+			printf("Bake vertex animation texture %s : %u x %u\n", textureName.c_str(), texture.GetWidth(), texture.GetHeight());
+			bakedTextures.push_back(cd::MoveTemp(texture));
+		}
+
+		// Lookup UVs are only useful when at least one texture is baked.
+		if (bakedTextures.empty())
+		{
+			continue;
+		}
+
+		if (!cd::VertexAnimationTextureBaker::GenerateLookupUVs(mesh, uvSetIndex))
+		{
+			printf("Failed to generate vertex animation UVs : %s\n", mesh.GetName());
+			continue;
+		}
+
+		for (cd::Texture& texture : bakedTextures)
+		{
+			m_pCurrentSceneDatabase->AddTexture(cd::MoveTemp(texture));
+		}
+	}
+}
+
+void ProcessorImpl::PrepareSkinning()
+{
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	auto meshCount = static_cast<uint32_t>(meshes.size());
+
+	uint32_t reducedVertexCount = 0U;
+	uint32_t splitMeshCount = 0U;
+	std::vector<cd::Mesh> newMeshes;
+	std::vector<std::pair<uint32_t, uint32_t>> newMeshSourceIDs;
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+		if (0U == mesh.GetVertexInfluenceCount())
+		{
+			continue;
+		}
+
+		reducedVertexCount += cd::SkinningOptimizer::LimitInfluences(mesh, m_maxSkinInfluenceCount);
+
+		std::vector<cd::Mesh> parts = cd::SkinningOptimizer::SplitByPalette(mesh, m_skinPaletteSize);
+		if (!parts.empty())
+		{
+			++splitMeshCount;
+			mesh = cd::MoveTemp(parts[0]);
+			for (uint32_t partIndex = 1U; partIndex < parts.size(); ++partIndex)
+			{
+				uint32_t newMeshID = meshCount + static_cast<uint32_t>(newMeshes.size());
+				parts[partIndex].SetID(cd::MeshID(newMeshID));
+				cd::SkinningOptimizer::PackInfluences(parts[partIndex]);
+				newMeshes.push_back(cd::MoveTemp(parts[partIndex]));
+				newMeshSourceIDs.emplace_back(meshIndex, newMeshID);
+			}
+		}
+
+		if (!cd::SkinningOptimizer::PackInfluences(mesh))
+		{
+			printf("Failed to pack skin influences : %s uses more than %u bones\n", mesh.GetName(), cd::SkinningOptimizer::MaxPaletteSize);
+		}
+	}
+
+	// Nodes which refer to split meshes refer to all their parts.
+	for (cd::Node& node : m_pCurrentSceneDatabase->GetNodes())
+	{
+		for (const auto& [sourceMeshID, newMeshID] : newMeshSourceIDs)
+		{
+			const std::vector<cd::MeshID>& meshIDs = node.GetMeshIDs();
+			if (std::find(meshIDs.begin(), meshIDs.end(), cd::MeshID(sourceMeshID)) != meshIDs.end())
+			{
+				node.AddMeshID(newMeshID);
+			}
+		}
+	}
+
+	for (cd::Mesh& newMesh : newMeshes)
+	{
+		m_pCurrentSceneDatabase->AddMesh(cd::MoveTemp(newMesh));
+	}
+
+	printf("Prepare skinning : %u vertices dropped influences, %u meshes are split to %u more parts\n",
+		reducedVertexCount, splitMeshCount, static_cast<uint32_t>(newMeshes.size()));
+}
+
+void ProcessorImpl::CalculateAABBForSceneDatabase()
+{
+	// Update mesh AABB by its current vertex positions.
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	for (uint32_t meshIndex = 0U; meshIndex < m_pCurrentSceneDatabase->GetMeshCount(); ++meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+
+		// Apply transform to vertex position.
+		cd::Point minPoint(FLT_MAX);
+		cd::Point maxPoint(-FLT_MAX);
+		for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+		{
+			const cd::Point& position = mesh.GetVertexPosition(vertexIndex);
+			minPoint.x() = minPoint.x() > position.x() ? position.x() : minPoint.x();
+			minPoint.y() = minPoint.y() > position.y() ? position.y() : minPoint.y();
+			minPoint.z() = minPoint.z() > position.z() ? position.z() : minPoint.z();
+			maxPoint.x() = maxPoint.x() > position.x() ? maxPoint.x() : position.x();
+			maxPoint.y() = maxPoint.y() > position.y() ? maxPoint.y() : position.y();
+			maxPoint.z() = maxPoint.z() > position.z() ? maxPoint.z() : position.z();
+		}
+
+		mesh.SetAABB(cd::AABB(cd::MoveTemp(minPoint), cd::MoveTemp(maxPoint)));
+	}
+
+	// Update scene AABB by meshes' AABB.
+	m_pCurrentSceneDatabase->UpdateAABB();
+}
+
+void ProcessorImpl::FlattenSceneDatabase()
+{
+	uint32_t totalNodeCount = m_pCurrentSceneDatabase->GetNodeCount();
+	if (0U == totalNodeCount)
+	{
+		return;
+	}
+
+	// World matrices of all nodes are solved in one linear pass over the depth sorted hierarchy.
+	cd::NodeHierarchy nodeHierarchy(m_pCurrentSceneDatabase->GetNodes());
+	std::map<uint32_t, uint32_t> mapMeshIDToAssociatedNodeID;
+	for (uint32_t nodeIndex = 0U; nodeIndex < totalNodeCount; ++nodeIndex)
+	{
+		const cd::Node& node = m_pCurrentSceneDatabase->GetNode(nodeIndex);
+		const std::vector<cd::MeshID>& nodeMeshIDs = node.GetMeshIDs();
+		for (uint32_t nodeMeshIndex = 0U; nodeMeshIndex < node.GetMeshCount(); ++nodeMeshIndex)
+		{
+			mapMeshIDToAssociatedNodeID[nodeMeshIDs[nodeMeshIndex].Data()] = nodeHierarchy.GetNodeIndex(node.GetID().Data());
+		}
+	}
+
+	std::vector<cd::Bone>& bones = m_pCurrentSceneDatabase->GetBones();
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	uint32_t meshCount = m_pCurrentSceneDatabase->GetMeshCount();
+	auto GetMeshTransform = [&mapMeshIDToAssociatedNodeID, &nodeHierarchy](uint32_t meshIndex)
+	{
+		auto itNodeIndex = mapMeshIDToAssociatedNodeID.find(meshIndex);
+		return itNodeIndex != mapMeshIDToAssociatedNodeID.end() ? nodeHierarchy.GetWorldMatrices()[itNodeIndex->second] : cd::Matrix4x4::Identity();
+	};
+
+	// There is only one offset for every bone. Skinned meshes which share bones are grouped and
+	// a group can only be flattened when all its meshes have the same node transform.
+	// Nodes are deleted after flattening, so the scene is either flattened completely or kept untouched.
+	std::vector<uint32_t> meshGroups(meshCount);
+	std::iota(meshGroups.begin(), meshGroups.end(), 0U);
+	auto FindGroup = [&meshGroups](uint32_t meshIndex)
+	{
+		while (meshGroups[meshIndex] != meshIndex)
+		{
+			meshIndex = meshGroups[meshIndex] = meshGroups[meshGroups[meshIndex]];
+		}
+		return meshIndex;
+	};
+
+	std::vector<uint32_t> boneMeshIndexes(bones.size(), UINT32_MAX);
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		const cd::Mesh& mesh = meshes[meshIndex];
+		for (uint32_t influenceIndex = 0U; influenceIndex < mesh.GetVertexInfluenceCount(); ++influenceIndex)
+		{
+			for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+			{
+				uint32_t boneID = mesh.GetVertexBoneID(influenceIndex, vertexIndex).Data();
+				if (mesh.GetVertexWeight(influenceIndex, vertexIndex) <= 0.0f || boneID >= bones.size())
+				{
+					continue;
+				}
+
+				if (UINT32_MAX == boneMeshIndexes[boneID])
+				{
+					boneMeshIndexes[boneID] = meshIndex;
+				}
+				meshGroups[FindGroup(meshIndex)] = FindGroup(boneMeshIndexes[boneID]);
+			}
+		}
+	}
+
+	constexpr float TransformTolerance = 1e-5f;
+	bool canFlatten = true;
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		const cd::Mesh& mesh = meshes[meshIndex];
+		if (0U == mesh.GetVertexInfluenceCount())
+		{
+			continue;
+		}
+
+		cd::Matrix4x4 meshTransform = GetMeshTransform(meshIndex);
+		cd::Matrix4x4 groupTransform = GetMeshTransform(FindGroup(meshIndex));
+		for (int elementIndex = 0; elementIndex < 16; ++elementIndex)
+		{
+			float meshElement = *(meshTransform.Begin() + elementIndex);
+			float groupElement = *(groupTransform.Begin() + elementIndex);
+			if (std::abs(meshElement - groupElement) > TransformTolerance * std::max(1.0f, std::abs(groupElement)))
+			{
+				printf("Failed to flatten skinned mesh : %s shares bones with meshes under different node transforms\n", mesh.GetName());
+				canFlatten = false;
+				break;
+			}
+		}
+	}
+
+	if (!canFlatten)
+	{
+		printf("Failed to flatten scene database : nodes are kept\n");
+		return;
+	}
+
+	std::vector<bool> isBoneOffsetBaked(bones.size(), false);
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		cd::Mesh& mesh = meshes[meshIndex];
+
+		// Apply transform to vertex position.
+		auto itNodeIndex = mapMeshIDToAssociatedNodeID.find(meshIndex);
+		if (itNodeIndex == mapMeshIDToAssociatedNodeID.end())
+		{
+			// If a mesh doesn't find its associated node, no need to process.
+			continue;
+		}
+
+		uint32_t nodeIndex = itNodeIndex->second;
+		const cd::Matrix4x4& finalTransform = nodeHierarchy.GetWorldMatrices()[nodeIndex];
+		details::TransformMeshVertices(mesh, finalTransform);
+
+		if (0U == mesh.GetVertexInfluenceCount())
+		{
+			continue;
+		}
+
+		// Offsets map node space vertices to bone space. offset * inverse(nodeTransform) maps baked vertices to the same bone space,
+		// so skinned results don't change.
+		cd::Matrix4x4 inverseFinalTransform = finalTransform.Inverse();
+		for (uint32_t influenceIndex = 0U; influenceIndex < mesh.GetVertexInfluenceCount(); ++influenceIndex)
+		{
+			for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+			{
+				uint32_t boneID = mesh.GetVertexBoneID(influenceIndex, vertexIndex).Data();
+				if (mesh.GetVertexWeight(influenceIndex, vertexIndex) <= 0.0f || boneID >= bones.size() || isBoneOffsetBaked[boneID])
+				{
+					continue;
+				}
+
+				cd::Bone& bone = bones[boneID];
+				bone.SetOffset(bone.GetOffset() * inverseFinalTransform);
+				isBoneOffsetBaked[boneID] = true;
+			}
+		}
+	}
+
+	// Delete all nodes.
+	m_pCurrentSceneDatabase->GetNodes().clear();
+	m_pCurrentSceneDatabase->SetNodeCount(0U);
+	m_pCurrentSceneDatabase->GetNodeHierarchy().Clear();
+}
+
+void ProcessorImpl::BuildNodeHierarchy()
+{
+	cd::NodeHierarchy& nodeHierarchy = m_pCurrentSceneDatabase->GetNodeHierarchy();
+	nodeHierarchy.Init(m_pCurrentSceneDatabase->GetNodes());
+
+	uint32_t maxDepth = 0U;
+	std::vector<uint32_t> depths(nodeHierarchy.GetNodeCount(), 0U);
+	for (uint32_t nodeIndex = 0U; nodeIndex < nodeHierarchy.GetNodeCount(); ++nodeIndex)
+	{
+		uint32_t parentIndex = nodeHierarchy.GetParentIndexes()[nodeIndex];
+		depths[nodeIndex] = cd::NodeHierarchy::InvalidIndex == parentIndex ? 0U : depths[parentIndex] + 1U;
+		maxDepth = std::max(maxDepth, depths[nodeIndex]);
+	}
+
+	printf("Build node hierarchy : %u nodes, max depth %u\n", nodeHierarchy.GetNodeCount(), maxDepth);
+}
+
+void ProcessorImpl::SearchMissingTextures()
+{
+	bool caseSensitive = !IsSearchTexturesCaseInsensitiveEnabled();
+
+	// Build file name index for search folders. Reuse the cache file if it matches current search folders.
+	FileNameIndex searchFolderIndex(caseSensitive);
+	bool useIndexCache = !m_textureSearchIndexCacheFilePath.empty();
+	if (!useIndexCache || !searchFolderIndex.Load(m_textureSearchIndexCacheFilePath.c_str(), m_textureSearchFolders))
+	{
+		for (const std::string& textureSearchFolder : m_textureSearchFolders)
+		{
+			searchFolderIndex.AddFolder(textureSearchFolder);
+		}
+
+		if (useIndexCache && !searchFolderIndex.Save(m_textureSearchIndexCacheFilePath.c_str()))
+		{
+			printf("Failed to save texture search index cache : %s\n", m_textureSearchIndexCacheFilePath.c_str());
+		}
+	}
+
+	// Textures usually come from a few folders. List every origin folder once instead of checking files one by one.
+	std::unordered_map<std::string, FileNameIndex> originFolderIndexes;
+	for (auto& texture : m_pCurrentSceneDatabase->GetTextures())
+	{
+		std::filesystem::path originFilePath(texture.GetPath());
+		std::string originFolderPath = originFilePath.has_parent_path() ? originFilePath.parent_path().string() : ".";
+		std::string originFileName = originFilePath.filename().string();
+
+		auto itOriginFolderIndex = originFolderIndexes.find(originFolderPath);
+		if (itOriginFolderIndex == originFolderIndexes.end())
+		{
+			FileNameIndex originFolderIndex(caseSensitive);
+			originFolderIndex.AddFolder(originFolderPath, false);
+			itOriginFolderIndex = originFolderIndexes.emplace(originFolderPath, cd::MoveTemp(originFolderIndex)).first;
+		}
+
+		// Case insensitive search may find the file with different casing. Use its real name for case sensitive filesystems.
+		if (const std::string* pFoundFilePath = itOriginFolderIndex->second.Find(originFileName))
+		{
+			texture.SetPath(pFoundFilePath->c_str());
+			continue;
+		}
+
+		if (const std::string* pNewFilePath = searchFolderIndex.Find(originFileName))
+		{
+			texture.SetPath(pNewFilePath->c_str());
+		}
+	}
+}
+
+void ProcessorImpl::DeduplicateTextures()
+{
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	uint32_t textureCount = static_cast<uint32_t>(textures.size());
+
+	// Get content size firstly. Only textures which have the same size with others need to be hashed.
+	constexpr uint64_t InvalidContentSize = UINT64_MAX;
+	std::vector<uint64_t> contentSizes(textureCount, InvalidContentSize);
+	std::unordered_map<uint64_t, uint32_t> contentSizeCounts;
+	for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		if (texture.ExistRawData())
+		{
+			contentSizes[textureIndex] = texture.GetRawData().size();
+		}
+		else
+		{
+			std::error_code errorCode;
+			uint64_t fileSize = std::filesystem::file_size(texture.GetPath(), errorCode);
+			if (errorCode)
+			{
+				continue;
+			}
+			contentSizes[textureIndex] = fileSize;
+		}
+
+		++contentSizeCounts[contentSizes[textureIndex]];
+	}
+
+	std::vector<uint32_t> hashTextureIndexes;
+	for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+	{
+		if (contentSizes[textureIndex] != InvalidContentSize && contentSizeCounts[contentSizes[textureIndex]] > 1U)
+		{
+			hashTextureIndexes.push_back(textureIndex);
+		}
+	}
+
+	if (hashTextureIndexes.empty())
+	{
+		return;
+	}
+
+	// Hash contents in parallel. Raw data is preferred and texture files are read through memory mapping.
+	std::vector<std::string> contentHashes(textureCount);
+	cd::ParallelFor(static_cast<uint32_t>(hashTextureIndexes.size()), [&textures, &hashTextureIndexes, &contentHashes](uint32_t index)
+	{
+		uint32_t textureIndex = hashTextureIndexes[index];
+		const cd::Texture& texture = textures[textureIndex];
+
+		std::string& contentHash = contentHashes[textureIndex];
+		contentHash.resize(picosha2::k_digest_size);
+		if (texture.ExistRawData())
+		{
+			const auto* pData = reinterpret_cast<const unsigned char*>(texture.GetRawData().data());
+			picosha2::hash256(pData, pData + texture.GetRawData().size(), contentHash.begin(), contentHash.end());
+			return;
+		}
+
+		MemoryMappedFile mappedFile(texture.GetPath());
+		if (!mappedFile.IsValid())
+		{
+			contentHash.clear();
+			return;
+		}
+
+		const auto* pData = reinterpret_cast<const unsigned char*>(mappedFile.GetData());
+		picosha2::hash256(pData, pData + mappedFile.GetSize(), contentHash.begin(), contentHash.end());
+	});
+
+	// Textures with the same contents but different sampler settings, usages or pixel layouts are different textures.
+	// Raw pixels don't describe their own layout so the same bytes may be different images.
+	auto appendKey = [](std::string& key, const auto& value)
+	{
+		key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+	};
+
+	std::unordered_map<std::string, uint32_t> contentKeyToTextureIndex;
+	std::vector<uint32_t> survivorTextureIndexes(textureCount);
+	for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+	{
+		survivorTextureIndexes[textureIndex] = textureIndex;
+
+		std::string contentKey = cd::MoveTemp(contentHashes[textureIndex]);
+		if (contentKey.empty())
+		{
+			continue;
+		}
+
+		const cd::Texture& texture = textures[textureIndex];
+		appendKey(contentKey, contentSizes[textureIndex]);
+		appendKey(contentKey, texture.GetType());
+		appendKey(contentKey, texture.GetUMapMode());
+		appendKey(contentKey, texture.GetVMapMode());
+		appendKey(contentKey, texture.GetUVOffset());
+		appendKey(contentKey, texture.GetUVScale());
+		appendKey(contentKey, texture.GetWidth());
+		appendKey(contentKey, texture.GetHeight());
+		appendKey(contentKey, texture.GetDepth());
+		appendKey(contentKey, texture.GetFormat());
+		appendKey(contentKey, texture.GetRawDataType());
+
+		auto [itContentKey, inserted] = contentKeyToTextureIndex.emplace(cd::MoveTemp(contentKey), textureIndex);
+		survivorTextureIndexes[textureIndex] = itContentKey->second;
+	}
+
+	if (contentKeyToTextureIndex.size() == hashTextureIndexes.size())
+	{
+		return;
+	}
+
+	// Compact textures and build the map from old texture ID to new texture ID.
+	std::vector<cd::TextureID> newTextureIDs(textureCount);
+	std::vector<cd::Texture> survivorTextures;
+	survivorTextures.reserve(textureCount);
+	for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+	{
+		uint32_t survivorTextureIndex = survivorTextureIndexes[textureIndex];
+		if (survivorTextureIndex != textureIndex)
+		{
+			newTextureIDs[textureIndex] = newTextureIDs[survivorTextureIndex];
+			continue;
+		}
+
+		cd::TextureID newTextureID(static_cast<uint32_t>(survivorTextures.size()));
+		newTextureIDs[textureIndex] = newTextureID;
+		survivorTextures.emplace_back(cd::MoveTemp(textures[textureIndex]));
+		survivorTextures.back().SetID(newTextureID);
+	}
+
+	printf("Deduplicate textures : %u -> %u\n", textureCount, static_cast<uint32_t>(survivorTextures.size()));
+	textures = cd::MoveTemp(survivorTextures);
+
+	for (auto& material : m_pCurrentSceneDatabase->GetMaterials())
+	{
+		for (int textureTypeIndex = 0; textureTypeIndex < static_cast<int>(cd::MaterialTextureType::Count); ++textureTypeIndex)
+		{
+			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+			if (!material.IsTextureSetup(textureType))
+			{
+				continue;
+			}
+
+			cd::TextureID textureID = material.GetTextureID(textureType);
+			if (textureID.Data() < textureCount)
+			{
+				material.SetTextureID(textureType, newTextureIDs[textureID.Data()]);
+			}
+		}
+	}
+}
+
+void ProcessorImpl::ProbeTextureMetadata()
+{
+	if (!cd::ImageCodec::IsDecodeSupported())
+	{
+		printf("Failed to probe textures because image decoder is not available.\n");
+		return;
+	}
+
+	std::vector<uint32_t> probeTextureIndexes;
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		bool isPixelData = texture.ExistRawData() && cd::TextureRawDataType::Pixels == texture.GetRawDataType();
+		bool isMetadataReady = texture.GetWidth() > 0U && texture.GetHeight() > 0U && texture.GetFormat() != cd::TextureFormat::Count;
+		if (isPixelData || isMetadataReady)
+		{
+			continue;
+		}
+
+		probeTextureIndexes.push_back(textureIndex);
+	}
+
+	// Only image headers are parsed. Memory mapping makes sure that only the first pages of files are read.
+	cd::ParallelFor(static_cast<uint32_t>(probeTextureIndexes.size()), [&textures, &probeTextureIndexes](uint32_t index)
+	{
+		cd::Texture& texture = textures[probeTextureIndexes[index]];
+
+		uint32_t width;
+		uint32_t height;
+		cd::TextureFormat format;
+		bool success;
+		if (texture.ExistRawData())
+		{
+			const std::vector<std::byte>& fileData = texture.GetRawData();
+			success = cd::ImageCodec::GetInfo(fileData.data(), fileData.size(), width, height, format);
+		}
+		else
+		{
+			MemoryMappedFile mappedFile(texture.GetPath());
+			success = mappedFile.IsValid() && cd::ImageCodec::GetInfo(mappedFile.GetData(), mappedFile.GetSize(), width, height, format);
+		}
+
+		if (!success)
+		{
+			printf("Failed to probe texture : %s\n", texture.GetPath());
+			return;
+		}
+
+		texture.SetWidth(width);
+		texture.SetHeight(height);
+		texture.SetDepth(1U);
+		texture.SetFormat(format);
+	}, m_embedTextureFilesIOThreadCount);
+}
+
+void ProcessorImpl::EmbedTextureFiles()
+{
+	// Multiple textures can reference the same file. Load every file only once and share its buffer.
+	std::vector<std::string> filePaths;
+	std::vector<std::vector<uint32_t>> fileTextureIndexes;
+	std::unordered_map<std::string, uint32_t> filePathToIndex;
+
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		if (texture.ExistRawData())
+		{
+			continue;
+		}
+
+		auto [itFile, inserted] = filePathToIndex.emplace(texture.GetPath(), static_cast<uint32_t>(filePaths.size()));
+		if (inserted)
+		{
+			filePaths.push_back(itFile->first);
+			fileTextureIndexes.emplace_back();
+		}
+		fileTextureIndexes[itFile->second].push_back(textureIndex);
+	}
+
+	// Just embed texture file, not parse its information.
+	// Embedding is I/O latency bound so read files concurrently. Thread count bounds outstanding I/O requests.
+	std::vector<std::shared_ptr<const std::vector<std::byte>>> fileDatas(filePaths.size());
+	cd::ParallelFor(static_cast<uint32_t>(filePaths.size()), [&filePaths, &fileDatas](uint32_t fileIndex)
+	{
+		fileDatas[fileIndex] = details::LoadFile(filePaths[fileIndex].c_str());
+	}, m_embedTextureFilesIOThreadCount);
+
+	for (uint32_t fileIndex = 0U; fileIndex < filePaths.size(); ++fileIndex)
+	{
+		if (!fileDatas[fileIndex])
+		{
+			continue;
+		}
+
+		for (uint32_t textureIndex : fileTextureIndexes[fileIndex])
+		{
+			textures[textureIndex].SetRawData(fileDatas[fileIndex]);
+			textures[textureIndex].SetRawDataType(cd::TextureRawDataType::ImageFile);
+		}
+	}
+}
+
+void ProcessorImpl::BakeTextureAtlases()
+{
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	std::vector<cd::Material>& materials = m_pCurrentSceneDatabase->GetMaterials();
+	std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	if (details::IsAnyTextureSizeUnknown(textures))
+	{
+		ProbeTextureMetadata();
+	}
+
+	// Atlas can only replace textures which are sampled inside [0, 1] by the first UV set.
+	uint32_t materialCount = static_cast<uint32_t>(materials.size());
+	std::vector<bool> atlasables(materialCount, true);
+	for (const cd::Mesh& mesh : meshes)
+	{
+		cd::MaterialID materialID = mesh.GetMaterialID();
+		if (!materialID.IsValid() || materialID.Data() >= materialCount)
+		{
+			continue;
+		}
+
+		bool isUVInRange = mesh.GetVertexUVSetCount() > 0U;
+		for (uint32_t vertexIndex = 0U; isUVInRange && vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+		{
+			const cd::UV& uv = mesh.GetVertexUV(0U, vertexIndex);
+			constexpr float epsilon = 0.001f;
+			isUVInRange = uv.x() >= -epsilon && uv.x() <= 1.0f + epsilon && uv.y() >= -epsilon && uv.y() <= 1.0f + epsilon;
+		}
+
+		if (!isUVInRange)
+		{
+			atlasables[materialID.Data()] = false;
+		}
+	}
+
+	// Every material occupies one region whose size is the max size of its textures. All texture types share the same region.
+	uint32_t regionPadding = m_textureAtlasPadding;
+	std::vector<cd::AtlasItem> regionSizes(materialCount);
+	std::map<std::string, std::vector<uint32_t>> groupMaterialIndexes;
+	for (uint32_t materialIndex = 0U; materialIndex < materialCount; ++materialIndex)
+	{
+		const cd::Material& material = materials[materialIndex];
+		std::string groupKey(1, static_cast<char>(material.GetType()));
+		bool isAtlasable = atlasables[materialIndex];
+		for (int textureTypeIndex = 0; isAtlasable && textureTypeIndex < static_cast<int>(cd::MaterialTextureType::Count); ++textureTypeIndex)
+		{
+			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+			if (!material.IsTextureSetup(textureType))
+			{
+				continue;
+			}
+
+			uint32_t textureIndex = material.GetTextureID(textureType).Data();
+			if (textureIndex >= textures.size())
+			{
+				isAtlasable = false;
+				break;
+			}
+
+			const cd::Texture& texture = textures[textureIndex];
+			isAtlasable = details::CanLoadTexturePixels(texture) && texture.GetWidth() > 0U && texture.GetHeight() > 0U &&
+				texture.GetUVOffset() == cd::Vec2f::Zero() && texture.GetUVScale() == cd::Vec2f::One();
+			regionSizes[materialIndex].width = std::max(regionSizes[materialIndex].width, texture.GetWidth() + regionPadding * 2U);
+			regionSizes[materialIndex].height = std::max(regionSizes[materialIndex].height, texture.GetHeight() + regionPadding * 2U);
+			groupKey += static_cast<char>(textureTypeIndex);
+		}
+
+		// Materials larger than half of atlas can't save draw calls.
+		if (!isAtlasable || 1U == groupKey.size() ||
+			regionSizes[materialIndex].width * 2U > m_textureAtlasMaxSize || regionSizes[materialIndex].height * 2U > m_textureAtlasMaxSize)
+		{
+			continue;
+		}
+
+		// Materials can merge only if all parameters except textures are the same.
+		const cd::PropertyMap& propertyGroups = material.GetPropertyGroups();
+		auto appendProperties = [&groupKey](const auto& properties)
+		{
+			for (const auto& [key, value] : properties)
+			{
+				if (key.ends_with(cd::GetMaterialPropertyName(cd::MaterialProperty::Texture)) ||
+					key.ends_with(cd::GetMaterialPropertyName(cd::MaterialProperty::Name)))
+				{
+					continue;
+				}
+
+				groupKey += key;
+				if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>)
+				{
+					groupKey += value;
+				}
+				else
+				{
+					groupKey.append(reinterpret_cast<const char*>(&value), sizeof(value));
+				}
+			}
+		};
+		appendProperties(propertyGroups.GetStringProperty());
+		appendProperties(propertyGroups.GetByte4Property());
+		appendProperties(propertyGroups.GetByte8Property());
+		appendProperties(propertyGroups.GetByte12Property());
+
+		groupMaterialIndexes[cd::MoveTemp(groupKey)].push_back(materialIndex);
+	}
+
+	std::vector<std::vector<uint32_t>> materialMeshIndexes(materialCount);
+	for (uint32_t meshIndex = 0U; meshIndex < meshes.size(); ++meshIndex)
+	{
+		cd::MaterialID materialID = meshes[meshIndex].GetMaterialID();
+		if (materialID.IsValid() && materialID.Data() < materialCount)
+		{
+			materialMeshIndexes[materialID.Data()].push_back(meshIndex);
+		}
+	}
+
+	std::vector<uint32_t> mergedMaterialIndexes(materialCount);
+	for (uint32_t materialIndex = 0U; materialIndex < materialCount; ++materialIndex)
+	{
+		mergedMaterialIndexes[materialIndex] = materialIndex;
+	}
+
+	uint32_t atlasCount = 0U;
+	std::vector<bool> isTextureReplaced(textures.size(), false);
+	for (const auto& [_, materialIndexes] : groupMaterialIndexes)
+	{
+		if (materialIndexes.size() < 2U)
+		{
+			continue;
+		}
+
+		std::vector<cd::AtlasItem> items;
+		for (uint32_t materialIndex : materialIndexes)
+		{
+			items.push_back(regionSizes[materialIndex]);
+		}
+
+		std::vector<cd::AtlasPlacement> placements;
+		uint32_t pageCount = cd::AtlasPacker::Pack(m_textureAtlasMaxSize, m_textureAtlasMaxSize, items, placements);
+		for (uint32_t page = 0U; page < pageCount; ++page)
+		{
+			std::vector<uint32_t> pageItemIndexes;
+			uint32_t usedWidth = 0U;
+			uint32_t usedHeight = 0U;
+			for (uint32_t itemIndex = 0U; itemIndex < items.size(); ++itemIndex)
+			{
+				if (placements[itemIndex].page == page)
+				{
+					pageItemIndexes.push_back(itemIndex);
+					usedWidth = std::max(usedWidth, placements[itemIndex].x + items[itemIndex].width);
+					usedHeight = std::max(usedHeight, placements[itemIndex].y + items[itemIndex].height);
+				}
+			}
+
+			if (pageItemIndexes.size() < 2U)
+			{
+				continue;
+			}
+
+			// Power of two atlas keeps full mip chains aligned to block boundaries.
+			uint32_t atlasWidth = std::min(std::bit_ceil(usedWidth), m_textureAtlasMaxSize);
+			uint32_t atlasHeight = std::min(std::bit_ceil(usedHeight), m_textureAtlasMaxSize);
+			uint32_t atlasMaterialIndex = materialIndexes[pageItemIndexes[0]];
+			cd::Material& atlasMaterial = materials[atlasMaterialIndex];
+			std::string atlasName = std::string(atlasMaterial.GetName()) + "_Atlas";
+
+			for (int textureTypeIndex = 0; textureTypeIndex < static_cast<int>(cd::MaterialTextureType::Count); ++textureTypeIndex)
+			{
+				auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+				if (!atlasMaterial.IsTextureSetup(textureType))
+				{
+					continue;
+				}
+
+				bool isSRGB = details::IsSRGBTextureType(textureType);
+				bool isNormalMap = cd::MaterialTextureType::Normal == textureType;
+				std::vector<std::byte> atlasPixels(static_cast<size_t>(atlasWidth) * atlasHeight * 4U);
+				cd::ParallelFor(static_cast<uint32_t>(pageItemIndexes.size()), [&](uint32_t index)
+				{
+					uint32_t itemIndex = pageItemIndexes[index];
+					const cd::Material& material = materials[materialIndexes[itemIndex]];
+					const cd::Texture& texture = textures[material.GetTextureID(textureType).Data()];
+
+					uint32_t width;
+					uint32_t height;
+					std::shared_ptr<const std::vector<std::byte>> pPixels = details::LoadTexturePixels(texture, width, height);
+					if (!pPixels || static_cast<size_t>(width) * height * 4U > pPixels->size())
+					{
+						printf("Failed to decode texture : %s\n", texture.GetPath());
+						return;
+					}
+
+					uint32_t regionWidth = items[itemIndex].width - regionPadding * 2U;
+					uint32_t regionHeight = items[itemIndex].height - regionPadding * 2U;
+					if (width != regionWidth || height != regionHeight)
+					{
+						pPixels = std::make_shared<const std::vector<std::byte>>(cd::ImageResampler::Resize(pPixels->data(), width, height,
+							regionWidth, regionHeight, isSRGB, isNormalMap, cd::ResampleFilter::Kaiser, 1U));
+					}
+
+					// Padding repeats edge pixels so that bilinear filtering and low mips don't bleed neighbor regions.
+					const cd::AtlasPlacement& placement = placements[itemIndex];
+					for (uint32_t y = 0U; y < items[itemIndex].height; ++y)
+					{
+						uint32_t sourceY = std::min(y > regionPadding ? y - regionPadding : 0U, regionHeight - 1U);
+						std::byte* pTargetRow = atlasPixels.data() + ((static_cast<size_t>(placement.y) + y) * atlasWidth + placement.x) * 4U;
+						const std::byte* pSourceRow = pPixels->data() + static_cast<size_t>(sourceY) * regionWidth * 4U;
+						for (uint32_t x = 0U; x < regionPadding; ++x)
+						{
+							std::memcpy(pTargetRow + x * 4U, pSourceRow, 4U);
+							std::memcpy(pTargetRow + (regionPadding + regionWidth + x) * 4U, pSourceRow + (regionWidth - 1U) * 4U, 4U);
+						}
+						std::memcpy(pTargetRow + regionPadding * 4U, pSourceRow, static_cast<size_t>(regionWidth) * 4U);
+					}
+				});
+
+				cd::TextureID atlasTextureID(static_cast<uint32_t>(textures.size()));
+				std::string atlasTextureName = atlasName + "_" + cd::GetMaterialPropertyGroupName(textureType);
+				cd::Texture& atlasTexture = textures.emplace_back(atlasTextureID, atlasTextureName.c_str(), textureType);
+				atlasTexture.SetUMapMode(cd::TextureMapMode::Clamp);
+				atlasTexture.SetVMapMode(cd::TextureMapMode::Clamp);
+				atlasTexture.SetFormat(cd::TextureFormat::RGBA8);
+				atlasTexture.SetWidth(atlasWidth);
+				atlasTexture.SetHeight(atlasHeight);
+				atlasTexture.SetDepth(1U);
+				atlasTexture.SetRawData(cd::MoveTemp(atlasPixels));
+				atlasTexture.SetRawDataType(cd::TextureRawDataType::Pixels);
+
+				for (uint32_t itemIndex : pageItemIndexes)
+				{
+					isTextureReplaced[materials[materialIndexes[itemIndex]].GetTextureID(textureType).Data()] = true;
+				}
+				atlasMaterial.SetTextureID(textureType, atlasTextureID);
+			}
+
+			// Remap the first UV set to regions. UV (0, 0) is the top left corner of images.
+			for (uint32_t itemIndex : pageItemIndexes)
+			{
+				uint32_t materialIndex = materialIndexes[itemIndex];
+				mergedMaterialIndexes[materialIndex] = atlasMaterialIndex;
+
+				const cd::AtlasPlacement& placement = placements[itemIndex];
+				cd::Vec2f uvOffset(static_cast<float>(placement.x + regionPadding) / atlasWidth, static_cast<float>(placement.y + regionPadding) / atlasHeight);
+				cd::Vec2f uvScale(static_cast<float>(items[itemIndex].width - regionPadding * 2U) / atlasWidth,
+					static_cast<float>(items[itemIndex].height - regionPadding * 2U) / atlasHeight);
+				for (uint32_t meshIndex : materialMeshIndexes[materialIndex])
+				{
+					for (cd::UV& uv : meshes[meshIndex].GetVertexUVs(0U))
+					{
+						uv.x() = uvOffset.x() + std::clamp(uv.x(), 0.0f, 1.0f) * uvScale.x();
+						uv.y() = uvOffset.y() + std::clamp(uv.y(), 0.0f, 1.0f) * uvScale.y();
+					}
+				}
+			}
+
+			atlasMaterial.SetName(atlasName.c_str());
+			++atlasCount;
+		}
+	}
+
+	if (0U == atlasCount)
+	{
+		return;
+	}
+
+	// Compact materials and textures which are replaced by atlases.
+	std::vector<uint32_t> newMaterialIDs(materialCount, cd::MaterialID::InvalidID);
+	std::vector<cd::Material> survivorMaterials;
+	for (uint32_t materialIndex = 0U; materialIndex < materialCount; ++materialIndex)
+	{
+		if (mergedMaterialIndexes[materialIndex] != materialIndex)
+		{
+			continue;
+		}
+
+		newMaterialIDs[materialIndex] = static_cast<uint32_t>(survivorMaterials.size());
+		survivorMaterials.emplace_back(cd::MoveTemp(materials[materialIndex]));
+		survivorMaterials.back().SetID(cd::MaterialID(newMaterialIDs[materialIndex]));
+	}
+
+	for (cd::Mesh& mesh : meshes)
+	{
+		cd::MaterialID materialID = mesh.GetMaterialID();
+		if (materialID.IsValid() && materialID.Data() < materialCount)
+		{
+			mesh.SetMaterialID(newMaterialIDs[mergedMaterialIndexes[materialID.Data()]]);
+		}
+	}
+
+	printf("Bake texture atlases : %u materials -> %u materials in %u atlases\n", materialCount, static_cast<uint32_t>(survivorMaterials.size()), atlasCount);
+	materials = cd::MoveTemp(survivorMaterials);
+
+	// Remove textures which are replaced by atlases and not used by other materials.
+	uint32_t textureCount = static_cast<uint32_t>(textures.size());
+	isTextureReplaced.resize(textureCount, false);
+	for (const cd::Material& material : materials)
+	{
+		for (int textureTypeIndex = 0; textureTypeIndex < static_cast<int>(cd::MaterialTextureType::Count); ++textureTypeIndex)
+		{
+			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+			if (material.IsTextureSetup(textureType) && material.GetTextureID(textureType).Data() < textureCount)
+			{
+				isTextureReplaced[material.GetTextureID(textureType).Data()] = false;
+			}
+		}
+	}
+
+	std::vector<cd::TextureID> newTextureIDs(textureCount);
+	std::vector<cd::Texture> survivorTextures;
+	survivorTextures.reserve(textureCount);
+	for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+	{
+		if (isTextureReplaced[textureIndex])
+		{
+			continue;
+		}
+
+		cd::TextureID newTextureID(static_cast<uint32_t>(survivorTextures.size()));
+		newTextureIDs[textureIndex] = newTextureID;
+		survivorTextures.emplace_back(cd::MoveTemp(textures[textureIndex]));
+		survivorTextures.back().SetID(newTextureID);
+	}
+	textures = cd::MoveTemp(survivorTextures);
+
+	for (cd::Material& material : materials)
+	{
+		for (int textureTypeIndex = 0; textureTypeIndex < static_cast<int>(cd::MaterialTextureType::Count); ++textureTypeIndex)
+		{
+			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+			if (material.IsTextureSetup(textureType) && material.GetTextureID(textureType).Data() < textureCount)
+			{
+				material.SetTextureID(textureType, newTextureIDs[material.GetTextureID(textureType).Data()]);
+			}
+		}
+	}
+}
+
+void ProcessorImpl::AnalyzeUVStatistics()
+{
+	const std::vector<cd::Mesh>& meshes = m_pCurrentSceneDatabase->GetMeshes();
+	const std::vector<cd::Material>& materials = m_pCurrentSceneDatabase->GetMaterials();
+	const std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	if (details::IsAnyTextureSizeUnknown(textures))
+	{
+		ProbeTextureMetadata();
+	}
+
+	uint32_t uvSetIndex = m_uvStatisticsUVSetIndex;
+	uint32_t meshCount = static_cast<uint32_t>(meshes.size());
+	size_t coverageTexelCount = static_cast<size_t>(m_uvStatisticsResolution) * m_uvStatisticsResolution;
+	std::vector<details::UVStatistics> meshStatistics(meshCount);
+	cd::ParallelFor(meshCount, [this, &meshes, &meshStatistics, uvSetIndex, coverageTexelCount](uint32_t meshIndex)
+	{
+		const cd::Mesh& mesh = meshes[meshIndex];
+		if (mesh.GetVertexUVSetCount() <= uvSetIndex)
+		{
+			return;
+		}
+
+		details::AccumulateTriangleAreas(mesh, uvSetIndex, meshStatistics[meshIndex]);
+		std::vector<uint8_t> coverages(coverageTexelCount, 0U);
+		details::RasterizeUVCoverage(mesh, uvSetIndex, m_uvStatisticsResolution, coverages);
+		details::CalculateUVCoverage(coverages, meshStatistics[meshIndex]);
+	});
+
+	// Texture resolution of a material is the max size of its textures.
+	uint32_t materialCount = static_cast<uint32_t>(materials.size());
+	std::vector<std::pair<uint32_t, uint32_t>> materialTextureSizes(materialCount);
+	for (uint32_t materialIndex = 0U; materialIndex < materialCount; ++materialIndex)
+	{
+		for (int textureTypeIndex = 0; textureTypeIndex < static_cast<int>(cd::MaterialTextureType::Count); ++textureTypeIndex)
+		{
+			auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+			if (materials[materialIndex].IsTextureSetup(textureType) && materials[materialIndex].GetTextureID(textureType).Data() < textures.size())
+			{
+				const cd::Texture& texture = textures[materials[materialIndex].GetTextureID(textureType).Data()];
+				materialTextureSizes[materialIndex].first = std::max(materialTextureSizes[materialIndex].first, texture.GetWidth());
+				materialTextureSizes[materialIndex].second = std::max(materialTextureSizes[materialIndex].second, texture.GetHeight());
+			}
+		}
+	}
+
+	std::vector<details::UVStatistics> materialStatistics(materialCount);
+	std::vector<double> materialMinTexelDensities(materialCount, DBL_MAX);
+	std::vector<double> materialMaxTexelDensities(materialCount, 0.0);
+	std::vector<double> meshTexelDensities(meshCount, 0.0);
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		cd::MaterialID materialID = meshes[meshIndex].GetMaterialID();
+		if (!materialID.IsValid() || materialID.Data() >= materialCount)
+		{
+			continue;
+		}
+
+		const details::UVStatistics& statistics = meshStatistics[meshIndex];
+		const auto& [textureWidth, textureHeight] = materialTextureSizes[materialID.Data()];
+		meshTexelDensities[meshIndex] = details::CalculateTexelDensity(statistics.worldArea, statistics.uvArea, textureWidth, textureHeight);
+		if (statistics.worldArea > 0.0)
+		{
+			materialMinTexelDensities[materialID.Data()] = std::min(materialMinTexelDensities[materialID.Data()], meshTexelDensities[meshIndex]);
+			materialMaxTexelDensities[materialID.Data()] = std::max(materialMaxTexelDensities[materialID.Data()], meshTexelDensities[meshIndex]);
+		}
+
+		details::UVStatistics& total = materialStatistics[materialID.Data()];
+		total.triangleCount += statistics.triangleCount;
+		total.flippedTriangleCount += statistics.flippedTriangleCount;
+		total.degenerateTriangleCount += statistics.degenerateTriangleCount;
+		total.worldArea += statistics.worldArea;
+		total.uvArea += statistics.uvArea;
+	}
+
+	// Meshes sharing a material share the texture space so they are rasterized into one coverage grid.
+	// Then overlaps between different meshes are also counted.
+	std::vector<std::vector<uint32_t>> materialMeshIndexes(materialCount);
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		cd::MaterialID materialID = meshes[meshIndex].GetMaterialID();
+		if (materialID.IsValid() && materialID.Data() < materialCount && meshes[meshIndex].GetVertexUVSetCount() > uvSetIndex)
+		{
+			materialMeshIndexes[materialID.Data()].push_back(meshIndex);
+		}
+	}
+
+	cd::ParallelFor(materialCount, [this, &meshes, &materialMeshIndexes, &materialStatistics, uvSetIndex, coverageTexelCount](uint32_t materialIndex)
+	{
+		if (materialMeshIndexes[materialIndex].empty())
+		{
+			return;
+		}
+
+		std::vector<uint8_t> coverages(coverageTexelCount, 0U);
+		for (uint32_t meshIndex : materialMeshIndexes[materialIndex])
+		{
+			details::RasterizeUVCoverage(meshes[meshIndex], uvSetIndex, m_uvStatisticsResolution, coverages);
+		}
+		details::CalculateUVCoverage(coverages, materialStatistics[materialIndex]);
+	});
+
+	// Textures which are denser than the target density on every material using them can be downscaled.
+	m_textureDensityMaxResolutions.assign(textures.size(), 0U);
+	if (m_targetTexelDensity > 0.0f)
+	{
+		std::vector<double> textureMaxDensityScales(textures.size(), 0.0);
+		for (uint32_t materialIndex = 0U; materialIndex < materialCount; ++materialIndex)
+		{
+			const details::UVStatistics& statistics = materialStatistics[materialIndex];
+			for (int textureTypeIndex = 0; textureTypeIndex < static_cast<int>(cd::MaterialTextureType::Count); ++textureTypeIndex)
+			{
+				auto textureType = static_cast<cd::MaterialTextureType>(textureTypeIndex);
+				if (!materials[materialIndex].IsTextureSetup(textureType) || materials[materialIndex].GetTextureID(textureType).Data() >= textures.size())
+				{
+					continue;
+				}
+
+				// Every texture has its own density. Unknown density means the texture must keep its size.
+				uint32_t textureIndex = materials[materialIndex].GetTextureID(textureType).Data();
+				const cd::Texture& texture = textures[textureIndex];
+				double texelDensity = details::CalculateTexelDensity(statistics.worldArea, statistics.uvArea, texture.GetWidth(), texture.GetHeight());
+				double densityScale = texelDensity > 0.0 ? m_targetTexelDensity / texelDensity : 1.0;
+				textureMaxDensityScales[textureIndex] = std::max(textureMaxDensityScales[textureIndex], densityScale);
+			}
+		}
+
+		for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+		{
+			double densityScale = textureMaxDensityScales[textureIndex];
+			uint32_t maxSize = std::max(textures[textureIndex].GetWidth(), textures[textureIndex].GetHeight());
+			if (densityScale > 0.0 && densityScale < 1.0 && maxSize > 0U)
+			{
+				// Round up to power of two to keep some margin.
+				m_textureDensityMaxResolutions[textureIndex] = std::bit_ceil(std::max(1U, static_cast<uint32_t>(std::ceil(maxSize * densityScale))));
+			}
+		}
+	}
+
+	uint32_t inconsistentMaterialCount = 0U;
+	for (uint32_t materialIndex = 0U; materialIndex < materialCount; ++materialIndex)
+	{
+		if (materialMaxTexelDensities[materialIndex] > 0.0 && materialMaxTexelDensities[materialIndex] > materialMinTexelDensities[materialIndex] * m_texelDensityToleranceRatio)
+		{
+			++inconsistentMaterialCount;
+		}
+	}
+	printf("UV statistics : %u meshes, %u materials with inconsistent texel density.\n", meshCount, inconsistentMaterialCount);
+
+	if (m_uvStatisticsReportFilePath.empty())
+	{
+		return;
+	}
+
+	FILE* pReportFile = fopen(m_uvStatisticsReportFilePath.c_str(), "w");
+	if (!pReportFile)
+	{
+		printf("Failed to write UV statistics report : %s\n", m_uvStatisticsReportFilePath.c_str());
+		return;
+	}
+
+	auto writeString = [pReportFile](const char* pString)
+	{
+		fputc('"', pReportFile);
+		for (const char* pChar = pString; *pChar != '\0'; ++pChar)
+		{
+			if ('"' == *pChar || '\\' == *pChar)
+			{
+				fputc('\\', pReportFile);
+			}
+
+			if (static_cast<unsigned char>(*pChar) >= 0x20U)
+			{
+				fputc(*pChar, pReportFile);
+			}
+		}
+		fputc('"', pReportFile);
+	};
+
+	auto writeStatistics = [pReportFile](const details::UVStatistics& statistics, double texelDensity)
+	{
+		fprintf(pReportFile, "\"triangleCount\": %u, \"flippedTriangleCount\": %u, \"degenerateTriangleCount\": %u, "
+			"\"worldArea\": %.9g, \"uvArea\": %.9g, \"utilization\": %.6f, \"overlapArea\": %.6f, \"texelDensity\": %.6g",
+			statistics.triangleCount, statistics.flippedTriangleCount, statistics.degenerateTriangleCount,
+			statistics.worldArea, statistics.uvArea, statistics.utilization, statistics.overlapArea, texelDensity);
+	};
+
+	fprintf(pReportFile, "{\n\t\"uvSetIndex\": %u,\n\t\"meshes\": [\n", uvSetIndex);
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		fprintf(pReportFile, "\t\t{ \"name\": ");
+		writeString(meshes[meshIndex].GetName());
+		cd::MaterialID materialID = meshes[meshIndex].GetMaterialID();
+		fprintf(pReportFile, ", \"material\": %d, ", materialID.IsValid() ? static_cast<int>(materialID.Data()) : -1);
+		writeStatistics(meshStatistics[meshIndex], meshTexelDensities[meshIndex]);
+		fprintf(pReportFile, " }%s\n", meshIndex + 1U < meshCount ? "," : "");
+	}
+
+	fprintf(pReportFile, "\t],\n\t\"materials\": [\n");
+	for (uint32_t materialIndex = 0U; materialIndex < materialCount; ++materialIndex)
+	{
+		const details::UVStatistics& statistics = materialStatistics[materialIndex];
+		const auto& [textureWidth, textureHeight] = materialTextureSizes[materialIndex];
+		double minTexelDensity = materialMaxTexelDensities[materialIndex] > 0.0 ? materialMinTexelDensities[materialIndex] : 0.0;
+		fprintf(pReportFile, "\t\t{ \"name\": ");
+		writeString(materials[materialIndex].GetName());
+		fprintf(pReportFile, ", \"textureWidth\": %u, \"textureHeight\": %u, ", textureWidth, textureHeight);
+		writeStatistics(statistics, details::CalculateTexelDensity(statistics.worldArea, statistics.uvArea, textureWidth, textureHeight));
+		fprintf(pReportFile, ", \"minMeshTexelDensity\": %.6g, \"maxMeshTexelDensity\": %.6g }%s\n",
+			minTexelDensity, materialMaxTexelDensities[materialIndex], materialIndex + 1U < materialCount ? "," : "");
+	}
+
+	fprintf(pReportFile, "\t]\n}\n");
+	fclose(pReportFile);
+}
+
+uint32_t ProcessorImpl::GetTextureMaxResolution(cd::MaterialTextureType textureType) const
+{
+	auto itMaxResolution = m_textureMaxResolutions.find(textureType);
+	return itMaxResolution != m_textureMaxResolutions.end() ? itMaxResolution->second : 0U;
+}
+
+void ProcessorImpl::EnforceTextureBudget()
+{
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+
+	// Budget needs texture sizes. Probe image headers if they are still unknown.
+	if (details::IsAnyTextureSizeUnknown(textures))
+	{
+		ProbeTextureMetadata();
+	}
+
+	uint32_t textureCount = static_cast<uint32_t>(textures.size());
+	std::vector<uint32_t> targetWidths(textureCount);
+	std::vector<uint32_t> targetHeights(textureCount);
+	std::vector<bool> resizables(textureCount);
+	for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		uint32_t width = texture.GetWidth();
+		uint32_t height = texture.GetHeight();
+		resizables[textureIndex] = width > 0U && height > 0U && details::CanLoadTexturePixels(texture);
+
+		uint32_t maxResolution = GetTextureMaxResolution(texture.GetType());
+		if (textureIndex < m_textureDensityMaxResolutions.size() && m_textureDensityMaxResolutions[textureIndex] > 0U)
+		{
+			maxResolution = 0U == maxResolution ? m_textureDensityMaxResolutions[textureIndex] : std::min(maxResolution, m_textureDensityMaxResolutions[textureIndex]);
+		}
+
+		uint32_t maxSize = std::max(width, height);
+		if (resizables[textureIndex] && maxResolution > 0U && maxSize > maxResolution)
+		{
+			// Keep aspect ratio.
+			double scale = static_cast<double>(maxResolution) / static_cast<double>(maxSize);
+			width = std::max(1U, static_cast<uint32_t>(width * scale + 0.5));
+			height = std::max(1U, static_cast<uint32_t>(height * scale + 0.5));
+		}
+
+		targetWidths[textureIndex] = width;
+		targetHeights[textureIndex] = height;
+	}
+
+	// Halve the largest texture repeatedly until the total size fits the memory budget.
+	if (m_textureMemoryBudget > 0U)
+	{
+		auto estimateBytes = [this, &textures, &targetWidths, &targetHeights](uint32_t textureIndex)
+		{
+			const cd::Texture& texture = textures[textureIndex];
+			cd::TextureFormat format = IsCompressTexturesEnabled() && cd::BlockCompressor::IsSupported(GetTextureCompressionFormat(texture.GetType())) ?
+				GetTextureCompressionFormat(texture.GetType()) : texture.GetFormat();
+			uint64_t bytes = details::EstimateTextureLevelBytes(format, targetWidths[textureIndex], targetHeights[textureIndex]);
+			// Full mip chain costs about 1/3 more.
+			return texture.UseMipMap() ? bytes * 4U / 3U : bytes;
+		};
+
+		uint64_t totalBytes = 0U;
+		std::priority_queue<std::pair<uint64_t, uint32_t>> resizableTextureBytes;
+		for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+		{
+			uint64_t bytes = estimateBytes(textureIndex);
+			totalBytes += bytes;
+			if (resizables[textureIndex])
+			{
+				resizableTextureBytes.emplace(bytes, textureIndex);
+			}
+		}
+
+		while (totalBytes > m_textureMemoryBudget && !resizableTextureBytes.empty())
+		{
+			auto [bytes, textureIndex] = resizableTextureBytes.top();
+			resizableTextureBytes.pop();
+			if (1U == targetWidths[textureIndex] && 1U == targetHeights[textureIndex])
+			{
+				continue;
+			}
+
+			targetWidths[textureIndex] = std::max(1U, targetWidths[textureIndex] / 2U);
+			targetHeights[textureIndex] = std::max(1U, targetHeights[textureIndex] / 2U);
+			uint64_t newBytes = estimateBytes(textureIndex);
+			totalBytes = totalBytes - bytes + newBytes;
+			resizableTextureBytes.emplace(newBytes, textureIndex);
+		}
+
+		if (totalBytes > m_textureMemoryBudget)
+		{
+			printf("Texture memory budget %llu bytes can't be satisfied : %llu bytes\n",
+				static_cast<unsigned long long>(m_textureMemoryBudget), static_cast<unsigned long long>(totalBytes));
+		}
+	}
+
+	std::vector<uint32_t> resizeTextureIndexes;
+	for (uint32_t textureIndex = 0U; textureIndex < textureCount; ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		if (resizables[textureIndex] && (targetWidths[textureIndex] != texture.GetWidth() || targetHeights[textureIndex] != texture.GetHeight()))
+		{
+			resizeTextureIndexes.push_back(textureIndex);
+		}
+	}
+
+	uint32_t resizeTextureCount = static_cast<uint32_t>(resizeTextureIndexes.size());
+	bool parallelTextures = resizeTextureCount >= cd::GetParallelThreadCount();
+	cd::ParallelFor(resizeTextureCount, [&textures, &resizeTextureIndexes, &targetWidths, &targetHeights, parallelTextures](uint32_t index)
+	{
+		uint32_t textureIndex = resizeTextureIndexes[index];
+		cd::Texture& texture = textures[textureIndex];
+
+		uint32_t width;
+		uint32_t height;
+		std::shared_ptr<const std::vector<std::byte>> pPixels = details::LoadTexturePixels(texture, width, height);
+		if (!pPixels || static_cast<size_t>(width) * height * 4U > pPixels->size())
+		{
+			printf("Failed to decode texture : %s\n", texture.GetPath());
+			return;
+		}
+
+		bool isSRGB = details::IsSRGBTextureType(texture.GetType());
+		bool isNormalMap = cd::MaterialTextureType::Normal == texture.GetType();
+		texture.SetRawData(cd::ImageResampler::Resize(pPixels->data(), width, height, targetWidths[textureIndex], targetHeights[textureIndex],
+			isSRGB, isNormalMap, cd::ResampleFilter::Kaiser, parallelTextures ? 1U : 0U));
+		texture.SetMipOffsets(std::vector<uint64_t>());
+		texture.SetRawDataType(cd::TextureRawDataType::Pixels);
+		texture.SetFormat(cd::TextureFormat::RGBA8);
+		texture.SetWidth(targetWidths[textureIndex]);
+		texture.SetHeight(targetHeights[textureIndex]);
+		texture.SetDepth(1U);
+	}, parallelTextures ? 0U : 1U);
+}
+
+void ProcessorImpl::GenerateMipmaps()
+{
+	std::vector<uint32_t> mipmapTextureIndexes;
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		if (!texture.UseMipMap() || texture.GetMipCount() > 1U || !details::CanLoadTexturePixels(texture))
+		{
+			continue;
+		}
+
+		mipmapTextureIndexes.push_back(textureIndex);
+	}
+
+	uint32_t mipmapTextureCount = static_cast<uint32_t>(mipmapTextureIndexes.size());
+	bool parallelTextures = mipmapTextureCount >= cd::GetParallelThreadCount();
+	cd::ParallelFor(mipmapTextureCount, [this, &textures, &mipmapTextureIndexes, parallelTextures](uint32_t index)
+	{
+		cd::Texture& texture = textures[mipmapTextureIndexes[index]];
+
+		uint32_t width;
+		uint32_t height;
+		std::shared_ptr<const std::vector<std::byte>> pPixels = details::LoadTexturePixels(texture, width, height);
+		if (!pPixels || static_cast<size_t>(width) * height * 4U > pPixels->size())
+		{
+			printf("Failed to decode texture : %s\n", texture.GetPath());
+			return;
+		}
+
+		cd::MipmapGenerateOptions options;
+		options.filter = m_mipmapFilter;
+		options.maxThreadCount = parallelTextures ? 1U : 0U;
+		switch (texture.GetType())
+		{
+		case cd::MaterialTextureType::BaseColor:
+		case cd::MaterialTextureType::Emissive:
+			options.content = cd::MipmapContent::Color;
+			break;
+		case cd::MaterialTextureType::Normal:
+			options.content = cd::MipmapContent::NormalMap;
+			break;
+		default:
+			options.content = cd::MipmapContent::Linear;
+			break;
+		}
+
+		if (cd::MaterialTextureType::BaseColor == texture.GetType() || cd::MaterialTextureType::AlphaMap == texture.GetType())
+		{
+			options.alphaCoverageReference = m_mipmapAlphaCoverageReference;
+		}
+
+		std::vector<uint64_t> mipOffsets;
+		texture.SetRawData(cd::MipmapGenerator::Generate(pPixels->data(), width, height, options, mipOffsets));
+		texture.SetMipOffsets(cd::MoveTemp(mipOffsets));
+		texture.SetRawDataType(cd::TextureRawDataType::Pixels);
+		texture.SetFormat(cd::TextureFormat::RGBA8);
+		texture.SetWidth(width);
+		texture.SetHeight(height);
+		texture.SetDepth(1U);
+	}, parallelTextures ? 0U : 1U);
+}
+
+cd::TextureFormat ProcessorImpl::GetTextureCompressionFormat(cd::MaterialTextureType textureType) const
+{
+	auto itFormat = m_textureCompressionFormats.find(textureType);
+	if (itFormat != m_textureCompressionFormats.end())
+	{
+		return itFormat->second;
+	}
+
+	switch (textureType)
+	{
+	case cd::MaterialTextureType::Normal:
+		return cd::TextureFormat::BC5;
+	case cd::MaterialTextureType::Occlusion:
+	case cd::MaterialTextureType::Roughness:
+	case cd::MaterialTextureType::Metallic:
+	case cd::MaterialTextureType::AlphaMap:
+		return cd::TextureFormat::BC4;
+	case cd::MaterialTextureType::Emissive:
+		return cd::TextureFormat::BC1;
+	case cd::MaterialTextureType::Elevation:
+		// Elevation needs precision.
+		return cd::TextureFormat::Count;
+	default:
+		return cd::TextureFormat::BC7;
+	}
+}
+
+void ProcessorImpl::CompressTextures()
+{
+	if (!cd::ImageCodec::IsDecodeSupported())
+	{
+		printf("Failed to compress textures because image decoder is not available.\n");
+		return;
+	}
+
+	std::vector<uint32_t> compressTextureIndexes;
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	for (uint32_t textureIndex = 0U; textureIndex < textures.size(); ++textureIndex)
+	{
+		const cd::Texture& texture = textures[textureIndex];
+		if (!details::CanLoadTexturePixels(texture) || !cd::BlockCompressor::IsSupported(GetTextureCompressionFormat(texture.GetType())))
+		{
+			continue;
+		}
+
+		compressTextureIndexes.push_back(textureIndex);
+	}
+
+	// Many textures : every thread decodes and compresses its own texture.
+	// A few textures : compress blocks of one texture in parallel.
+	uint32_t compressTextureCount = static_cast<uint32_t>(compressTextureIndexes.size());
+	bool parallelTextures = compressTextureCount >= cd::GetParallelThreadCount();
+	cd::ParallelFor(compressTextureCount, [this, &textures, &compressTextureIndexes, parallelTextures](uint32_t index)
+	{
+		cd::Texture& texture = textures[compressTextureIndexes[index]];
+
+		uint32_t width;
+		uint32_t height;
+		std::shared_ptr<const std::vector<std::byte>> pPixels = details::LoadTexturePixels(texture, width, height);
+		if (!pPixels || static_cast<size_t>(width) * height * 4U > pPixels->size())
+		{
+			printf("Failed to decode texture : %s\n", texture.GetPath());
+			return;
+		}
+
+		// Compress every mip level if mipmaps were generated.
+		cd::TextureFormat format = GetTextureCompressionFormat(texture.GetType());
+		uint32_t mipCount = texture.GetMipCount();
+		std::vector<uint64_t> compressedMipOffsets(mipCount);
+		size_t compressedSize = 0U;
+		for (uint32_t mipLevel = 0U; mipLevel < mipCount; ++mipLevel)
+		{
+			compressedMipOffsets[mipLevel] = compressedSize;
+			compressedSize += cd::BlockCompressor::GetCompressedSize(format,
+				cd::MipmapGenerator::GetMipSize(width, mipLevel), cd::MipmapGenerator::GetMipSize(height, mipLevel));
+		}
+
+		std::vector<std::byte> compressedData(compressedSize);
+		for (uint32_t mipLevel = 0U; mipLevel < mipCount; ++mipLevel)
+		{
+			uint64_t mipOffset = mipCount > 1U ? texture.GetMipOffsets()[mipLevel] : 0U;
+			cd::BlockCompressor::Compress(format, pPixels->data() + mipOffset,
+				cd::MipmapGenerator::GetMipSize(width, mipLevel), cd::MipmapGenerator::GetMipSize(height, mipLevel),
+				compressedData.data() + compressedMipOffsets[mipLevel], parallelTextures ? 1U : 0U);
+		}
+
+		texture.SetRawData(cd::MoveTemp(compressedData));
+		texture.SetMipOffsets(mipCount > 1U ? cd::MoveTemp(compressedMipOffsets) : std::vector<uint64_t>());
+		texture.SetRawDataType(cd::TextureRawDataType::Pixels);
+		texture.SetFormat(format);
+		texture.SetWidth(width);
+		texture.SetHeight(height);
+		texture.SetDepth(1U);
+	}, parallelTextures ? 0U : 1U);
+}
+
+void ProcessorImpl::PackTextureContainers()
+{
+	bool writeFiles = !m_textureContainerOutputFolder.empty();
+	if (writeFiles)
+	{
+		std::filesystem::create_directories(m_textureContainerOutputFolder);
+	}
+
+	std::vector<cd::Texture>& textures = m_pCurrentSceneDatabase->GetTextures();
+	cd::ParallelFor(static_cast<uint32_t>(textures.size()), [this, &textures, writeFiles](uint32_t textureIndex)
+	{
+		cd::Texture& texture = textures[textureIndex];
+		if (!texture.ExistRawData() || cd::TextureRawDataType::Pixels != texture.GetRawDataType())
+		{
+			return;
+		}
+
+		cd::TextureContainerHeader header;
+		header.format = texture.GetFormat();
+		header.width = texture.GetWidth();
+		header.height = texture.GetHeight();
+		header.depth = std::max(1U, texture.GetDepth());
+		header.layerCount = 1U;
+
+		const std::vector<std::byte>& rawData = texture.GetRawData();
+		std::vector<std::byte> container = cd::TextureContainer::Build(header, rawData.data(), rawData.size(), texture.GetMipOffsets());
+
+		// Container has its own level table.
+		texture.SetMipOffsets(std::vector<uint64_t>());
+		texture.SetRawDataType(cd::TextureRawDataType::Container);
+		if (!writeFiles)
+		{
+			texture.SetRawData(cd::MoveTemp(container));
+			return;
+		}
+
+		std::filesystem::path stem = std::filesystem::path(texture.GetPath()).stem();
+		if (stem.empty())
+		{
+			stem = texture.GetName();
+		}
+
+		std::filesystem::path containerFilePath = std::filesystem::path(m_textureContainerOutputFolder) /
+			(stem.string() + "_" + std::to_string(texture.GetID().Data()) + ".cdtex");
+		std::ofstream containerFile(containerFilePath, std::ios::binary);
+		containerFile.write(reinterpret_cast<const char*>(container.data()), container.size());
+		if (!containerFile)
+		{
+			printf("Failed to write texture container : %s\n", containerFilePath.string().c_str());
+			texture.SetRawData(cd::MoveTemp(container));
+			return;
+		}
+
+		texture.SetPath(containerFilePath.string().c_str());
+		texture.SetRawData(std::shared_ptr<const std::vector<std::byte>>());
+	}, writeFiles ? m_embedTextureFilesIOThreadCount : 0U);
+}
+
+}
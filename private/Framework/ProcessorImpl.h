@@ -1,5 +1,16 @@
 #pragma once
 
+#include "Base/Platform.h"
+#include "Framework/Processor.h"
+#include "Image/ImageResampler.h"
+#include "Animation/AnimationCompressor.h"
+#include "Math/AmbientOcclusionBaker.h"
+#include "Math/LightmapUVGenerator.h"
+#include "Scene/MaterialTextureType.h"
+#include "Scene/TextureFormat.h"
+
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,22 +54,199 @@ public:
 	void SetFlattenSceneDatabaseEnable(bool enable) { m_enableFlattenSceneDatabase = enable; }
 	bool IsFlattenSceneDatabaseEnabled() const { return m_enableFlattenSceneDatabase; }
 
+	void SetBuildNodeHierarchyEnable(bool enable) { m_enableBuildNodeHierarchy = enable; }
+	bool IsBuildNodeHierarchyEnabled() const { return m_enableBuildNodeHierarchy; }
+
+	void SetPrepareSkinningEnable(bool enable) { m_enablePrepareSkinning = enable; }
+	bool IsPrepareSkinningEnabled() const { return m_enablePrepareSkinning; }
+
+	void SetMaxSkinInfluenceCount(uint32_t influenceCount) { m_maxSkinInfluenceCount = influenceCount; }
+	uint32_t GetMaxSkinInfluenceCount() const { return m_maxSkinInfluenceCount; }
+
+	void SetSkinPaletteSize(uint32_t paletteSize) { m_skinPaletteSize = paletteSize; }
+	uint32_t GetSkinPaletteSize() const { return m_skinPaletteSize; }
+
 	void SetCalculateConnetivityDataEnable(bool enable) { m_enableCalculateConnetivityData = enable; }
 	bool IsCalculateConnetivityDataEnabled() const { return m_enableCalculateConnetivityData; }
 
+	void SetGenerateLightmapUVsEnable(bool enable) { m_enableGenerateLightmapUVs = enable; }
+	bool IsGenerateLightmapUVsEnabled() const { return m_enableGenerateLightmapUVs; }
+
+	void SetLightmapUVSetIndex(uint32_t uvSetIndex) { m_lightmapUVSetIndex = uvSetIndex; }
+	uint32_t GetLightmapUVSetIndex() const { return m_lightmapUVSetIndex; }
+
+	void SetLightmapResolution(uint32_t resolution) { m_lightmapUVOptions.resolution = resolution; }
+	uint32_t GetLightmapResolution() const { return m_lightmapUVOptions.resolution; }
+
+	void SetLightmapPadding(uint32_t padding) { m_lightmapUVOptions.padding = padding; }
+	uint32_t GetLightmapPadding() const { return m_lightmapUVOptions.padding; }
+
+	void SetLightmapChartMaxAngle(float degrees) { m_lightmapUVOptions.chartMaxAngle = degrees; }
+	float GetLightmapChartMaxAngle() const { return m_lightmapUVOptions.chartMaxAngle; }
+
+	void SetBuildBVHEnable(bool enable) { m_enableBuildBVH = enable; }
+	bool IsBuildBVHEnabled() const { return m_enableBuildBVH; }
+
+	void SetBVHMaxLeafSize(uint32_t size) { m_bvhMaxLeafSize = size; }
+	uint32_t GetBVHMaxLeafSize() const { return m_bvhMaxLeafSize; }
+
+	void SetBakeVertexAOEnable(bool enable) { m_enableBakeVertexAO = enable; }
+	bool IsBakeVertexAOEnabled() const { return m_enableBakeVertexAO; }
+
+	void SetVertexAOSceneOcclusionEnable(bool enable) { m_enableVertexAOSceneOcclusion = enable; }
+	bool IsVertexAOSceneOcclusionEnabled() const { return m_enableVertexAOSceneOcclusion; }
+
+	void SetVertexAOColorSetIndex(uint32_t colorSetIndex) { m_vertexAOColorSetIndex = colorSetIndex; }
+	uint32_t GetVertexAOColorSetIndex() const { return m_vertexAOColorSetIndex; }
+
+	void SetVertexAORayCount(uint32_t rayCount) { m_vertexAOOptions.rayCount = rayCount; }
+	uint32_t GetVertexAORayCount() const { return m_vertexAOOptions.rayCount; }
+
+	void SetVertexAOMaxDistance(float distance) { m_vertexAOOptions.maxDistance = distance; }
+	float GetVertexAOMaxDistance() const { return m_vertexAOOptions.maxDistance; }
+
+	void SetResampleAnimationsEnable(bool enable) { m_enableResampleAnimations = enable; }
+	bool IsResampleAnimationsEnabled() const { return m_enableResampleAnimations; }
+
+	void SetAnimationSampleRate(float sampleRate) { m_animationSampleRate = sampleRate; }
+	float GetAnimationSampleRate() const { return m_animationSampleRate; }
+
+	void SetCompressAnimationsEnable(bool enable) { m_enableCompressAnimations = enable; }
+	bool IsCompressAnimationsEnabled() const { return m_enableCompressAnimations; }
+
+	void SetAnimationCompressionMaxError(float maxError) { m_animationCompressionOptions.maxError = maxError; }
+	float GetAnimationCompressionMaxError() const { return m_animationCompressionOptions.maxError; }
+
+	void SetAnimationCompressionErrorDistance(float distance) { m_animationCompressionOptions.errorDistance = distance; }
+	float GetAnimationCompressionErrorDistance() const { return m_animationCompressionOptions.errorDistance; }
+
+	void SetQuantizeAnimationsEnable(bool enable) { m_animationCompressionOptions.quantize = enable; }
+	bool IsQuantizeAnimationsEnabled() const { return m_animationCompressionOptions.quantize; }
+
+	void SetCompressMorphsEnable(bool enable) { m_enableCompressMorphs = enable; }
+	bool IsCompressMorphsEnabled() const { return m_enableCompressMorphs; }
+
+	void SetMorphDeltaThreshold(float threshold) { m_morphDeltaThreshold = threshold; }
+	float GetMorphDeltaThreshold() const { return m_morphDeltaThreshold; }
+
+	void SetQuantizeMorphsEnable(bool enable) { m_enableQuantizeMorphs = enable; }
+	bool IsQuantizeMorphsEnabled() const { return m_enableQuantizeMorphs; }
+
+	void SetBakeAnimatedAABBsEnable(bool enable) { m_enableBakeAnimatedAABBs = enable; }
+	bool IsBakeAnimatedAABBsEnabled() const { return m_enableBakeAnimatedAABBs; }
+
+	void SetAnimatedAABBWindowFrameCount(uint32_t frameCount) { m_animatedAABBWindowFrameCount = frameCount; }
+	uint32_t GetAnimatedAABBWindowFrameCount() const { return m_animatedAABBWindowFrameCount; }
+
+	void SetBakeVertexAnimationTexturesEnable(bool enable) { m_enableBakeVertexAnimationTextures = enable; }
+	bool IsBakeVertexAnimationTexturesEnabled() const { return m_enableBakeVertexAnimationTextures; }
+
+	void SetVertexAnimationUVSetIndex(uint32_t uvSetIndex) { m_vertexAnimationUVSetIndex = uvSetIndex; }
+	uint32_t GetVertexAnimationUVSetIndex() const { return m_vertexAnimationUVSetIndex; }
+
 	void AddExtraTextureSearchFolder(const char* pFolderPath) { m_textureSearchFolders.push_back(pFolderPath); }
 	bool IsSearchMissingTexturesEnabled() const { return !m_textureSearchFolders.empty(); }
 
+	void SetSearchTexturesCaseInsensitiveEnable(bool enable) { m_enableSearchTexturesCaseInsensitive = enable; }
+	bool IsSearchTexturesCaseInsensitiveEnabled() const { return m_enableSearchTexturesCaseInsensitive; }
+
+	void SetTextureSearchIndexCacheFilePath(const char* pFilePath) { m_textureSearchIndexCacheFilePath = pFilePath; }
+	const char* GetTextureSearchIndexCacheFilePath() const { return m_textureSearchIndexCacheFilePath.c_str(); }
+
+	void SetDeduplicateTexturesEnable(bool enable) { m_enableDeduplicateTextures = enable; }
+	bool IsDeduplicateTexturesEnabled() const { return m_enableDeduplicateTextures; }
+
+	void SetProbeTextureMetadataEnable(bool enable) { m_enableProbeTextureMetadata = enable; }
+	bool IsProbeTextureMetadataEnabled() const { return m_enableProbeTextureMetadata; }
+
 	void SetEmbedTextureFilesEnable(bool enable) { m_enableEmbedTextureFiles = enable; }
 	bool IsEmbedTextureFilesEnabled() const { return m_enableEmbedTextureFiles; }
 
+	void SetEmbedTextureFilesIOThreadCount(uint32_t count) { m_embedTextureFilesIOThreadCount = count; }
+	uint32_t GetEmbedTextureFilesIOThreadCount() const { return m_embedTextureFilesIOThreadCount; }
+
+	void SetBakeTextureAtlasesEnable(bool enable) { m_enableBakeTextureAtlases = enable; }
+	bool IsBakeTextureAtlasesEnabled() const { return m_enableBakeTextureAtlases; }
+
+	void SetTextureAtlasMaxSize(uint32_t size) { m_textureAtlasMaxSize = size; }
+	uint32_t GetTextureAtlasMaxSize() const { return m_textureAtlasMaxSize; }
+
+	void SetTextureAtlasPadding(uint32_t padding) { m_textureAtlasPadding = padding; }
+	uint32_t GetTextureAtlasPadding() const { return m_textureAtlasPadding; }
+
+	void SetAnalyzeUVStatisticsEnable(bool enable) { m_enableAnalyzeUVStatistics = enable; }
+	bool IsAnalyzeUVStatisticsEnabled() const { return m_enableAnalyzeUVStatistics; }
+
+	void SetUVStatisticsUVSetIndex(uint32_t uvSetIndex) { m_uvStatisticsUVSetIndex = uvSetIndex; }
+	uint32_t GetUVStatisticsUVSetIndex() const { return m_uvStatisticsUVSetIndex; }
+
+	void SetUVStatisticsResolution(uint32_t resolution) { m_uvStatisticsResolution = resolution; }
+	uint32_t GetUVStatisticsResolution() const { return m_uvStatisticsResolution; }
+
+	void SetUVStatisticsReportFilePath(const char* pFilePath) { m_uvStatisticsReportFilePath = pFilePath; }
+	const char* GetUVStatisticsReportFilePath() const { return m_uvStatisticsReportFilePath.c_str(); }
+
+	void SetTexelDensityToleranceRatio(float ratio) { m_texelDensityToleranceRatio = ratio; }
+	float GetTexelDensityToleranceRatio() const { return m_texelDensityToleranceRatio; }
+
+	void SetTargetTexelDensity(float texelsPerUnit) { m_targetTexelDensity = texelsPerUnit; }
+	float GetTargetTexelDensity() const { return m_targetTexelDensity; }
+
+	void SetEnforceTextureBudgetEnable(bool enable) { m_enableEnforceTextureBudget = enable; }
+	bool IsEnforceTextureBudgetEnabled() const { return m_enableEnforceTextureBudget; }
+
+	void SetTextureMaxResolution(cd::MaterialTextureType textureType, uint32_t maxResolution) { m_textureMaxResolutions[textureType] = maxResolution; }
+	uint32_t GetTextureMaxResolution(cd::MaterialTextureType textureType) const;
+
+	void SetTextureMemoryBudget(uint64_t bytes) { m_textureMemoryBudget = bytes; }
+	uint64_t GetTextureMemoryBudget() const { return m_textureMemoryBudget; }
+
+	void SetGenerateMipmapsEnable(bool enable) { m_enableGenerateMipmaps = enable; }
+	bool IsGenerateMipmapsEnabled() const { return m_enableGenerateMipmaps; }
+
+	void SetMipmapFilter(cd::ResampleFilter filter) { m_mipmapFilter = filter; }
+	cd::ResampleFilter GetMipmapFilter() const { return m_mipmapFilter; }
+
+	void SetMipmapAlphaCoverageReference(float reference) { m_mipmapAlphaCoverageReference = reference; }
+	float GetMipmapAlphaCoverageReference() const { return m_mipmapAlphaCoverageReference; }
+
+	void SetCompressTexturesEnable(bool enable) { m_enableCompressTextures = enable; }
+	bool IsCompressTexturesEnabled() const { return m_enableCompressTextures; }
+
+	void SetTextureCompressionFormat(cd::MaterialTextureType textureType, cd::TextureFormat format) { m_textureCompressionFormats[textureType] = format; }
+	cd::TextureFormat GetTextureCompressionFormat(cd::MaterialTextureType textureType) const;
+
+	void SetPackTextureContainersEnable(bool enable) { m_enablePackTextureContainers = enable; }
+	bool IsPackTextureContainersEnabled() const { return m_enablePackTextureContainers; }
+
+	void SetTextureContainerOutputFolder(const char* pFolder) { m_textureContainerOutputFolder = pFolder; }
+	const char* GetTextureContainerOutputFolder() const { return m_textureContainerOutputFolder.c_str(); }
+
 	void DumpSceneDatabase();
 	void ValidateSceneDatabase();
 	void CalculateAABBForSceneDatabase();
 	void FlattenSceneDatabase();
+	void BuildNodeHierarchy();
+	void PrepareSkinning();
 	void CalculateConnetivityData();
+	void GenerateLightmapUVs();
+	void BuildBVH();
+	void BakeVertexAO();
+	void ResampleAnimations();
+	void CompressAnimations();
+	void CompressMorphs();
+	void BakeAnimatedAABBs();
+	void BakeVertexAnimationTextures();
 	void SearchMissingTextures();
+	void DeduplicateTextures();
+	void ProbeTextureMetadata();
 	void EmbedTextureFiles();
+	void BakeTextureAtlases();
+	void AnalyzeUVStatistics();
+	void EnforceTextureBudget();
+	void GenerateMipmaps();
+	void CompressTextures();
+	void PackTextureContainers();
 
 private:
 	IProducer* m_pProducer = nullptr;
@@ -66,14 +254,63 @@ private:
 
 	cd::SceneDatabase* m_pCurrentSceneDatabase;
 	std::unique_ptr<cd::SceneDatabase> m_pLocalSceneDatabase;
+	uint32_t m_lightmapUVSetIndex = 1U;
+	cd::LightmapUVOptions m_lightmapUVOptions;
+	uint32_t m_bvhMaxLeafSize = 4U;
+	uint32_t m_vertexAOColorSetIndex = 0U;
+	cd::AmbientOcclusionOptions m_vertexAOOptions;
+	uint32_t m_maxSkinInfluenceCount = 4U;
+	uint32_t m_skinPaletteSize = 64U;
+	float m_animationSampleRate = 30.0f;
+	cd::AnimationCompressionOptions m_animationCompressionOptions;
+	uint32_t m_animatedAABBWindowFrameCount = 8U;
+	uint32_t m_vertexAnimationUVSetIndex = Processor::NextFreeUVSetIndex;
+	float m_morphDeltaThreshold = 1e-5f;
 	std::vector<std::string> m_textureSearchFolders;
+	std::string m_textureSearchIndexCacheFilePath;
+	uint32_t m_embedTextureFilesIOThreadCount = 8U;
+	uint32_t m_textureAtlasMaxSize = 2048U;
+	uint32_t m_textureAtlasPadding = 4U;
+	uint32_t m_uvStatisticsUVSetIndex = 0U;
+	uint32_t m_uvStatisticsResolution = 256U;
+	std::string m_uvStatisticsReportFilePath;
+	float m_texelDensityToleranceRatio = 4.0f;
+	float m_targetTexelDensity = 0.0f;
+	std::vector<uint32_t> m_textureDensityMaxResolutions;
+	std::map<cd::MaterialTextureType, uint32_t> m_textureMaxResolutions;
+	uint64_t m_textureMemoryBudget = 0U;
+	cd::ResampleFilter m_mipmapFilter = cd::ResampleFilter::Kaiser;
+	float m_mipmapAlphaCoverageReference = 0.0f;
+	std::map<cd::MaterialTextureType, cd::TextureFormat> m_textureCompressionFormats;
+	std::string m_textureContainerOutputFolder;
 
 	bool m_enableDumpSceneDatabase = true;
 	bool m_enableValidateSceneDatabase = true;
 	bool m_enableCalculateAABBForSceneDatabase = true;
 	bool m_enableFlattenSceneDatabase = false;
+	bool m_enableBuildNodeHierarchy = false;
+	bool m_enablePrepareSkinning = false;
 	bool m_enableCalculateConnetivityData = false;
+	bool m_enableGenerateLightmapUVs = false;
+	bool m_enableBuildBVH = false;
+	bool m_enableBakeVertexAO = false;
+	bool m_enableVertexAOSceneOcclusion = true;
+	bool m_enableResampleAnimations = false;
+	bool m_enableCompressAnimations = false;
+	bool m_enableBakeAnimatedAABBs = false;
+	bool m_enableBakeVertexAnimationTextures = false;
+	bool m_enableCompressMorphs = false;
+	bool m_enableQuantizeMorphs = true;
+	bool m_enableDeduplicateTextures = false;
+	bool m_enableProbeTextureMetadata = false;
 	bool m_enableEmbedTextureFiles = false;
+	bool m_enableBakeTextureAtlases = false;
+	bool m_enableAnalyzeUVStatistics = false;
+	bool m_enableEnforceTextureBudget = false;
+	bool m_enableGenerateMipmaps = false;
+	bool m_enableCompressTextures = false;
+	bool m_enablePackTextureContainers = false;
+	bool m_enableSearchTexturesCaseInsensitive = false;
 };
 
 }
\ No newline at end of file
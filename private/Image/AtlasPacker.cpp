@@ -0,0 +1,172 @@
+#include "Image/AtlasPacker.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+
+// Top edge of packed rectangles from x to x + width.
+struct SkylineSegment
+{
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+};
+
+class SkylinePage
+{
+public:
+	SkylinePage(uint32_t width, uint32_t height) :
+		m_width(width),
+		m_height(height)
+	{
+		m_segments.push_back(SkylineSegment{ 0U, 0U, width });
+	}
+
+	bool Insert(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y)
+	{
+		// Bottom-left : choose the lowest top edge, then the leftmost position.
+		size_t bestSegmentIndex = SIZE_MAX;
+		uint32_t bestY = UINT32_MAX;
+		for (size_t segmentIndex = 0U; segmentIndex < m_segments.size(); ++segmentIndex)
+		{
+			uint32_t fitY;
+			if (Fit(segmentIndex, width, height, fitY) && fitY < bestY)
+			{
+				bestSegmentIndex = segmentIndex;
+				bestY = fitY;
+			}
+		}
+
+		if (SIZE_MAX == bestSegmentIndex)
+		{
+			return false;
+		}
+
+		x = m_segments[bestSegmentIndex].x;
+		y = bestY;
+		AddSegment(bestSegmentIndex, SkylineSegment{ x, y + height, width });
+		return true;
+	}
+
+private:
+	// Item rests on the highest segment it spans when its left edge starts at the segment.
+	bool Fit(size_t segmentIndex, uint32_t width, uint32_t height, uint32_t& fitY) const
+	{
+		uint32_t x = m_segments[segmentIndex].x;
+		if (x + width > m_width)
+		{
+			return false;
+		}
+
+		uint32_t remainWidth = width;
+		fitY = 0U;
+		for (size_t index = segmentIndex; remainWidth > 0U; ++index)
+		{
+			fitY = std::max(fitY, m_segments[index].y);
+			if (fitY + height > m_height)
+			{
+				return false;
+			}
+
+			remainWidth -= std::min(remainWidth, m_segments[index].width);
+		}
+
+		return true;
+	}
+
+	void AddSegment(size_t segmentIndex, const SkylineSegment& newSegment)
+	{
+		m_segments.insert(m_segments.begin() + segmentIndex, newSegment);
+
+		// Shrink or remove segments covered by the new segment.
+		uint32_t newSegmentEnd = newSegment.x + newSegment.width;
+		size_t index = segmentIndex + 1U;
+		while (index < m_segments.size())
+		{
+			SkylineSegment& segment = m_segments[index];
+			if (segment.x >= newSegmentEnd)
+			{
+				break;
+			}
+
+			uint32_t segmentEnd = segment.x + segment.width;
+			if (segmentEnd <= newSegmentEnd)
+			{
+				m_segments.erase(m_segments.begin() + index);
+				continue;
+			}
+
+			segment.width = segmentEnd - newSegmentEnd;
+			segment.x = newSegmentEnd;
+			break;
+		}
+
+		// Merge neighbor segments at the same height.
+		for (index = 0U; index + 1U < m_segments.size();)
+		{
+			if (m_segments[index].y == m_segments[index + 1U].y)
+			{
+				m_segments[index].width += m_segments[index + 1U].width;
+				m_segments.erase(m_segments.begin() + index + 1U);
+			}
+			else
+			{
+				++index;
+			}
+		}
+	}
+
+private:
+	uint32_t m_width;
+	uint32_t m_height;
+	std::vector<SkylineSegment> m_segments;
+};
+
+}
+
+namespace cd
+{
+
+uint32_t AtlasPacker::Pack(uint32_t pageWidth, uint32_t pageHeight, const std::vector<AtlasItem>& items, std::vector<AtlasPlacement>& placements)
+{
+	placements.assign(items.size(), AtlasPlacement());
+
+	std::vector<uint32_t> itemIndexes(items.size());
+	std::iota(itemIndexes.begin(), itemIndexes.end(), 0U);
+	std::stable_sort(itemIndexes.begin(), itemIndexes.end(), [&items](uint32_t lhs, uint32_t rhs)
+	{
+		return items[lhs].height != items[rhs].height ? items[lhs].height > items[rhs].height : items[lhs].width > items[rhs].width;
+	});
+
+	std::vector<SkylinePage> pages;
+	for (uint32_t itemIndex : itemIndexes)
+	{
+		const AtlasItem& item = items[itemIndex];
+		if (0U == item.width || 0U == item.height || item.width > pageWidth || item.height > pageHeight)
+		{
+			continue;
+		}
+
+		AtlasPlacement& placement = placements[itemIndex];
+		for (uint32_t pageIndex = 0U; pageIndex < pages.size(); ++pageIndex)
+		{
+			if (pages[pageIndex].Insert(item.width, item.height, placement.x, placement.y))
+			{
+				placement.page = pageIndex;
+				break;
+			}
+		}
+
+		if (AtlasPlacement::InvalidPage == placement.page)
+		{
+			placement.page = static_cast<uint32_t>(pages.size());
+			pages.emplace_back(pageWidth, pageHeight).Insert(item.width, item.height, placement.x, placement.y);
+		}
+	}
+
+	return static_cast<uint32_t>(pages.size());
+}
+
+}
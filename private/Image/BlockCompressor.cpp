@@ -0,0 +1,665 @@
+#include "Image/BlockCompressor.h"
+
+#include "Utilities/ParallelFor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+constexpr uint32_t BlockDimension = 4U;
+constexpr uint32_t BlockPixelCount = BlockDimension * BlockDimension;
+
+struct ColorBlock
+{
+	// RGBA8 pixels in row-major order.
+	uint8_t pixels[BlockPixelCount][4];
+};
+
+void FetchBlock(ColorBlock& block, const uint8_t* pRGBA8, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY)
+{
+	for (uint32_t y = 0U; y < BlockDimension; ++y)
+	{
+		uint32_t pixelY = std::min(blockY * BlockDimension + y, height - 1U);
+		for (uint32_t x = 0U; x < BlockDimension; ++x)
+		{
+			uint32_t pixelX = std::min(blockX * BlockDimension + x, width - 1U);
+			std::memcpy(block.pixels[y * BlockDimension + x], pRGBA8 + (static_cast<size_t>(pixelY) * width + pixelX) * 4U, 4U);
+		}
+	}
+}
+
+void WriteUInt16(uint8_t* pOutput, uint16_t value)
+{
+	pOutput[0] = static_cast<uint8_t>(value & 0xFF);
+	pOutput[1] = static_cast<uint8_t>(value >> 8);
+}
+
+// Finds the principal axis of colors by power iteration on covariance matrix.
+// Iteration starts from the channel with the max variance. A fixed seed such as (1, 1, 1) may be orthogonal to all variance,
+// e.g. a red and green block, and then the block collapses to one color.
+template<uint32_t N>
+void CalculatePrincipalAxis(const float (&colors)[BlockPixelCount][N], const float (&mean)[N], float (&axis)[N])
+{
+	float covariance[N][N] = {};
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		float delta[N];
+		for (uint32_t i = 0U; i < N; ++i)
+		{
+			delta[i] = colors[pixelIndex][i] - mean[i];
+		}
+
+		for (uint32_t i = 0U; i < N; ++i)
+		{
+			for (uint32_t j = 0U; j < N; ++j)
+			{
+				covariance[i][j] += delta[i] * delta[j];
+			}
+		}
+	}
+
+	uint32_t maxVarianceChannel = 0U;
+	float trace = 0.0f;
+	for (uint32_t i = 0U; i < N; ++i)
+	{
+		trace += covariance[i][i];
+		if (covariance[i][i] > covariance[maxVarianceChannel][maxVarianceChannel])
+		{
+			maxVarianceChannel = i;
+		}
+	}
+
+	// Other channels are tried as seeds if the product vanishes while colors still vary.
+	for (uint32_t seedIndex = 0U; seedIndex < N; ++seedIndex)
+	{
+		uint32_t seedChannel = (maxVarianceChannel + seedIndex) % N;
+		for (uint32_t i = 0U; i < N; ++i)
+		{
+			axis[i] = i == seedChannel ? 1.0f : 0.0f;
+		}
+
+		bool vanished = false;
+		for (uint32_t iteration = 0U; iteration < 8U; ++iteration)
+		{
+			float newAxis[N] = {};
+			float maxComponent = 0.0f;
+			for (uint32_t i = 0U; i < N; ++i)
+			{
+				for (uint32_t j = 0U; j < N; ++j)
+				{
+					newAxis[i] += covariance[i][j] * axis[j];
+				}
+				maxComponent = std::max(maxComponent, std::abs(newAxis[i]));
+			}
+
+			if (maxComponent <= 0.0f)
+			{
+				vanished = true;
+				break;
+			}
+
+			for (uint32_t i = 0U; i < N; ++i)
+			{
+				axis[i] = newAxis[i] / maxComponent;
+			}
+		}
+
+		if (!vanished || trace <= 0.0f)
+		{
+			return;
+		}
+	}
+}
+
+// Projects colors to the principal axis and returns the two extreme colors as endpoints.
+template<uint32_t N>
+void CalculateEndpoints(const float (&colors)[BlockPixelCount][N], uint32_t pixelCount, float (&endpoint0)[N], float (&endpoint1)[N])
+{
+	float mean[N] = {};
+	for (uint32_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		for (uint32_t i = 0U; i < N; ++i)
+		{
+			mean[i] += colors[pixelIndex][i];
+		}
+	}
+
+	for (uint32_t i = 0U; i < N; ++i)
+	{
+		mean[i] /= static_cast<float>(pixelCount);
+	}
+
+	// Pixels out of pixelCount are ignored by making them equal to mean.
+	float validColors[BlockPixelCount][N];
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		for (uint32_t i = 0U; i < N; ++i)
+		{
+			validColors[pixelIndex][i] = pixelIndex < pixelCount ? colors[pixelIndex][i] : mean[i];
+		}
+	}
+
+	float axis[N];
+	CalculatePrincipalAxis<N>(validColors, mean, axis);
+
+	float minProjection = FLT_MAX;
+	float maxProjection = -FLT_MAX;
+	for (uint32_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		float projection = 0.0f;
+		for (uint32_t i = 0U; i < N; ++i)
+		{
+			projection += (validColors[pixelIndex][i] - mean[i]) * axis[i];
+		}
+		minProjection = std::min(minProjection, projection);
+		maxProjection = std::max(maxProjection, projection);
+	}
+
+	float axisLengthSquare = 0.0f;
+	for (uint32_t i = 0U; i < N; ++i)
+	{
+		axisLengthSquare += axis[i] * axis[i];
+	}
+
+	float scale = axisLengthSquare > 0.0f ? 1.0f / axisLengthSquare : 0.0f;
+	for (uint32_t i = 0U; i < N; ++i)
+	{
+		endpoint0[i] = std::clamp(mean[i] + axis[i] * maxProjection * scale, 0.0f, 255.0f);
+		endpoint1[i] = std::clamp(mean[i] + axis[i] * minProjection * scale, 0.0f, 255.0f);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// BC1
+///////////////////////////////////////////////////////////////////////////////////////
+uint16_t QuantizeR5G6B5(const float (&color)[3])
+{
+	uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+	uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+	uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void DequantizeR5G6B5(uint16_t color, float (&result)[3])
+{
+	uint32_t r = (color >> 11) & 0x1F;
+	uint32_t g = (color >> 5) & 0x3F;
+	uint32_t b = color & 0x1F;
+	result[0] = static_cast<float>((r << 3) | (r >> 2));
+	result[1] = static_cast<float>((g << 2) | (g >> 4));
+	result[2] = static_cast<float>((b << 3) | (b >> 2));
+}
+
+uint32_t FindClosestColorIndices(const float (&colors)[BlockPixelCount][3], const float (&palette)[4][3], uint32_t paletteCount,
+	const bool (&transparent)[BlockPixelCount], uint8_t (&indices)[BlockPixelCount])
+{
+	float totalError = 0.0f;
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		if (transparent[pixelIndex])
+		{
+			indices[pixelIndex] = 3U;
+			continue;
+		}
+
+		float bestError = FLT_MAX;
+		uint8_t bestIndex = 0U;
+		for (uint32_t paletteIndex = 0U; paletteIndex < paletteCount; ++paletteIndex)
+		{
+			float dr = colors[pixelIndex][0] - palette[paletteIndex][0];
+			float dg = colors[pixelIndex][1] - palette[paletteIndex][1];
+			float db = colors[pixelIndex][2] - palette[paletteIndex][2];
+			float error = dr * dr + dg * dg + db * db;
+			if (error < bestError)
+			{
+				bestError = error;
+				bestIndex = static_cast<uint8_t>(paletteIndex);
+			}
+		}
+		indices[pixelIndex] = bestIndex;
+		totalError += bestError;
+	}
+
+	return static_cast<uint32_t>(totalError);
+}
+
+// Solves least squares endpoints for fixed indices in 4 color mode.
+bool RefineColorEndpoints(const float (&colors)[BlockPixelCount][3], const uint8_t (&indices)[BlockPixelCount], float (&endpoint0)[3], float (&endpoint1)[3])
+{
+	constexpr float Weights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+	float alpha2Sum = 0.0f;
+	float beta2Sum = 0.0f;
+	float alphaBetaSum = 0.0f;
+	float alphaXSum[3] = {};
+	float betaXSum[3] = {};
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		float beta = Weights[indices[pixelIndex]];
+		float alpha = 1.0f - beta;
+		alpha2Sum += alpha * alpha;
+		beta2Sum += beta * beta;
+		alphaBetaSum += alpha * beta;
+		for (uint32_t i = 0U; i < 3U; ++i)
+		{
+			alphaXSum[i] += alpha * colors[pixelIndex][i];
+			betaXSum[i] += beta * colors[pixelIndex][i];
+		}
+	}
+
+	float denominator = alpha2Sum * beta2Sum - alphaBetaSum * alphaBetaSum;
+	if (std::abs(denominator) < 1e-6f)
+	{
+		return false;
+	}
+
+	float factor = 1.0f / denominator;
+	for (uint32_t i = 0U; i < 3U; ++i)
+	{
+		endpoint0[i] = std::clamp((alphaXSum[i] * beta2Sum - betaXSum[i] * alphaBetaSum) * factor, 0.0f, 255.0f);
+		endpoint1[i] = std::clamp((betaXSum[i] * alpha2Sum - alphaXSum[i] * alphaBetaSum) * factor, 0.0f, 255.0f);
+	}
+
+	return true;
+}
+
+void BuildColorPalette(uint16_t color0, uint16_t color1, bool useFourColors, float (&palette)[4][3])
+{
+	DequantizeR5G6B5(color0, palette[0]);
+	DequantizeR5G6B5(color1, palette[1]);
+	for (uint32_t i = 0U; i < 3U; ++i)
+	{
+		if (useFourColors)
+		{
+			palette[2][i] = (2.0f * palette[0][i] + palette[1][i]) / 3.0f;
+			palette[3][i] = (palette[0][i] + 2.0f * palette[1][i]) / 3.0f;
+		}
+		else
+		{
+			palette[2][i] = (palette[0][i] + palette[1][i]) * 0.5f;
+			palette[3][i] = 0.0f;
+		}
+	}
+}
+
+// Four color mode is forced for BC2/BC3 color blocks.
+void CompressColorBlock(const ColorBlock& block, uint8_t* pOutput, bool allowOneBitAlpha)
+{
+	float colors[BlockPixelCount][3];
+	bool transparent[BlockPixelCount];
+	float opaqueColors[BlockPixelCount][3];
+	uint32_t opaqueCount = 0U;
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		for (uint32_t i = 0U; i < 3U; ++i)
+		{
+			colors[pixelIndex][i] = static_cast<float>(block.pixels[pixelIndex][i]);
+		}
+
+		transparent[pixelIndex] = allowOneBitAlpha && block.pixels[pixelIndex][3] < 128U;
+		if (!transparent[pixelIndex])
+		{
+			std::memcpy(opaqueColors[opaqueCount++], colors[pixelIndex], sizeof(colors[pixelIndex]));
+		}
+	}
+
+	if (0U == opaqueCount)
+	{
+		// All transparent : color0 <= color1 and all indices are 3.
+		WriteUInt16(pOutput, 0U);
+		WriteUInt16(pOutput + 2, 0U);
+		std::memset(pOutput + 4, 0xFF, 4U);
+		return;
+	}
+
+	float endpoint0[3];
+	float endpoint1[3];
+	CalculateEndpoints<3>(opaqueColors, opaqueCount, endpoint0, endpoint1);
+
+	bool useFourColors = opaqueCount == BlockPixelCount;
+	uint16_t color0 = QuantizeR5G6B5(endpoint0);
+	uint16_t color1 = QuantizeR5G6B5(endpoint1);
+	if (useFourColors)
+	{
+		// Four color mode needs color0 > color1.
+		if (color0 < color1)
+		{
+			std::swap(color0, color1);
+		}
+	}
+	else if (color0 > color1)
+	{
+		// Three color mode needs color0 <= color1.
+		std::swap(color0, color1);
+	}
+
+	uint8_t indices[BlockPixelCount];
+	float palette[4][3];
+	if (useFourColors && color0 == color1)
+	{
+		std::memset(indices, 0, sizeof(indices));
+	}
+	else
+	{
+		BuildColorPalette(color0, color1, useFourColors, palette);
+		uint32_t error = FindClosestColorIndices(colors, palette, useFourColors ? 4U : 3U, transparent, indices);
+
+		// Refine endpoints by least squares once which reduces error for gradients a lot.
+		if (useFourColors && RefineColorEndpoints(colors, indices, endpoint0, endpoint1))
+		{
+			uint16_t refinedColor0 = QuantizeR5G6B5(endpoint0);
+			uint16_t refinedColor1 = QuantizeR5G6B5(endpoint1);
+			if (refinedColor0 < refinedColor1)
+			{
+				std::swap(refinedColor0, refinedColor1);
+			}
+
+			if (refinedColor0 != refinedColor1)
+			{
+				uint8_t refinedIndices[BlockPixelCount];
+				float refinedPalette[4][3];
+				BuildColorPalette(refinedColor0, refinedColor1, true, refinedPalette);
+				uint32_t refinedError = FindClosestColorIndices(colors, refinedPalette, 4U, transparent, refinedIndices);
+				if (refinedError < error)
+				{
+					color0 = refinedColor0;
+					color1 = refinedColor1;
+					std::memcpy(indices, refinedIndices, sizeof(indices));
+				}
+			}
+		}
+	}
+
+	WriteUInt16(pOutput, color0);
+	WriteUInt16(pOutput + 2, color1);
+	for (uint32_t row = 0U; row < BlockDimension; ++row)
+	{
+		uint8_t packedIndices = 0U;
+		for (uint32_t column = 0U; column < BlockDimension; ++column)
+		{
+			packedIndices |= static_cast<uint8_t>(indices[row * BlockDimension + column] << (column * 2U));
+		}
+		pOutput[4 + row] = packedIndices;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// BC4
+///////////////////////////////////////////////////////////////////////////////////////
+void CompressSingleChannelBlock(const ColorBlock& block, uint32_t channel, uint8_t* pOutput)
+{
+	uint8_t minValue = 255U;
+	uint8_t maxValue = 0U;
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		minValue = std::min(minValue, block.pixels[pixelIndex][channel]);
+		maxValue = std::max(maxValue, block.pixels[pixelIndex][channel]);
+	}
+
+	pOutput[0] = maxValue;
+	pOutput[1] = minValue;
+	if (minValue == maxValue)
+	{
+		std::memset(pOutput + 2, 0, 6U);
+		return;
+	}
+
+	// Eight values mode as endpoint0 > endpoint1.
+	int palette[8];
+	palette[0] = maxValue;
+	palette[1] = minValue;
+	for (int i = 2; i < 8; ++i)
+	{
+		palette[i] = ((8 - i) * maxValue + (i - 1) * minValue) / 7;
+	}
+
+	uint64_t packedIndices = 0U;
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		int value = block.pixels[pixelIndex][channel];
+		int bestError = INT32_MAX;
+		uint64_t bestIndex = 0U;
+		for (uint32_t paletteIndex = 0U; paletteIndex < 8U; ++paletteIndex)
+		{
+			int error = std::abs(value - palette[paletteIndex]);
+			if (error < bestError)
+			{
+				bestError = error;
+				bestIndex = paletteIndex;
+			}
+		}
+		packedIndices |= bestIndex << (pixelIndex * 3U);
+	}
+
+	for (uint32_t i = 0U; i < 6U; ++i)
+	{
+		pOutput[2 + i] = static_cast<uint8_t>((packedIndices >> (i * 8U)) & 0xFF);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+// BC7
+///////////////////////////////////////////////////////////////////////////////////////
+class BitWriter
+{
+public:
+	explicit BitWriter(uint8_t* pOutput) : m_pOutput(pOutput)
+	{
+		std::memset(m_pOutput, 0, 16U);
+	}
+
+	void Write(uint32_t value, uint32_t bitCount)
+	{
+		for (uint32_t bitIndex = 0U; bitIndex < bitCount; ++bitIndex, ++m_bitOffset)
+		{
+			if ((value >> bitIndex) & 1U)
+			{
+				m_pOutput[m_bitOffset >> 3] |= static_cast<uint8_t>(1U << (m_bitOffset & 7U));
+			}
+		}
+	}
+
+private:
+	uint8_t* m_pOutput;
+	uint32_t m_bitOffset = 0U;
+};
+
+// Mode 6 : one subset, RGBA 7.7.7.7 endpoints with unique p-bits, 4 bits indices.
+void CompressBC7Block(const ColorBlock& block, uint8_t* pOutput)
+{
+	constexpr int Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	float colors[BlockPixelCount][4];
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		for (uint32_t i = 0U; i < 4U; ++i)
+		{
+			colors[pixelIndex][i] = static_cast<float>(block.pixels[pixelIndex][i]);
+		}
+	}
+
+	float endpoints[2][4];
+	CalculateEndpoints<4>(colors, BlockPixelCount, endpoints[0], endpoints[1]);
+
+	// Choose p-bit for every endpoint to minimize quantization error.
+	uint32_t quantized[2][4];
+	uint32_t pBits[2];
+	int unquantized[2][4];
+	for (uint32_t endpointIndex = 0U; endpointIndex < 2U; ++endpointIndex)
+	{
+		float bestError = FLT_MAX;
+		for (uint32_t pBit = 0U; pBit < 2U; ++pBit)
+		{
+			float error = 0.0f;
+			uint32_t candidate[4];
+			for (uint32_t i = 0U; i < 4U; ++i)
+			{
+				float value = (endpoints[endpointIndex][i] - static_cast<float>(pBit)) * 0.5f;
+				candidate[i] = static_cast<uint32_t>(std::clamp(std::lround(value), 0L, 127L));
+				float delta = static_cast<float>((candidate[i] << 1) | pBit) - endpoints[endpointIndex][i];
+				error += delta * delta;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				pBits[endpointIndex] = pBit;
+				std::memcpy(quantized[endpointIndex], candidate, sizeof(candidate));
+			}
+		}
+
+		for (uint32_t i = 0U; i < 4U; ++i)
+		{
+			unquantized[endpointIndex][i] = static_cast<int>((quantized[endpointIndex][i] << 1) | pBits[endpointIndex]);
+		}
+	}
+
+	int palette[16][4];
+	for (uint32_t paletteIndex = 0U; paletteIndex < 16U; ++paletteIndex)
+	{
+		for (uint32_t i = 0U; i < 4U; ++i)
+		{
+			palette[paletteIndex][i] = ((64 - Weights[paletteIndex]) * unquantized[0][i] + Weights[paletteIndex] * unquantized[1][i] + 32) >> 6;
+		}
+	}
+
+	uint32_t indices[BlockPixelCount];
+	for (uint32_t pixelIndex = 0U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		int bestError = INT32_MAX;
+		uint32_t bestIndex = 0U;
+		for (uint32_t paletteIndex = 0U; paletteIndex < 16U; ++paletteIndex)
+		{
+			int error = 0;
+			for (uint32_t i = 0U; i < 4U; ++i)
+			{
+				int delta = block.pixels[pixelIndex][i] - palette[paletteIndex][i];
+				error += delta * delta;
+			}
+
+			if (error < bestError)
+			{
+				bestError = error;
+				bestIndex = paletteIndex;
+			}
+		}
+		indices[pixelIndex] = bestIndex;
+	}
+
+	// The most significant bit of anchor index is implicit 0. Swap endpoints to satisfy it.
+	if (indices[0] >= 8U)
+	{
+		std::swap(quantized[0], quantized[1]);
+		std::swap(pBits[0], pBits[1]);
+		for (uint32_t& index : indices)
+		{
+			index = 15U - index;
+		}
+	}
+
+	BitWriter writer(pOutput);
+	writer.Write(1U << 6, 7U);
+	for (uint32_t i = 0U; i < 4U; ++i)
+	{
+		writer.Write(quantized[0][i], 7U);
+		writer.Write(quantized[1][i], 7U);
+	}
+	writer.Write(pBits[0], 1U);
+	writer.Write(pBits[1], 1U);
+	writer.Write(indices[0], 3U);
+	for (uint32_t pixelIndex = 1U; pixelIndex < BlockPixelCount; ++pixelIndex)
+	{
+		writer.Write(indices[pixelIndex], 4U);
+	}
+}
+
+void CompressBlock(cd::TextureFormat format, const ColorBlock& block, uint8_t* pOutput)
+{
+	switch (format)
+	{
+	case cd::TextureFormat::BC1:
+		CompressColorBlock(block, pOutput, true);
+		break;
+	case cd::TextureFormat::BC3:
+		CompressSingleChannelBlock(block, 3U, pOutput);
+		CompressColorBlock(block, pOutput + 8, false);
+		break;
+	case cd::TextureFormat::BC4:
+		CompressSingleChannelBlock(block, 0U, pOutput);
+		break;
+	case cd::TextureFormat::BC5:
+		CompressSingleChannelBlock(block, 0U, pOutput);
+		CompressSingleChannelBlock(block, 1U, pOutput + 8);
+		break;
+	case cd::TextureFormat::BC7:
+		CompressBC7Block(block, pOutput);
+		break;
+	default:
+		assert(false && "Unsupported block compression format.");
+		break;
+	}
+}
+
+}
+
+namespace cd
+{
+
+bool BlockCompressor::IsSupported(TextureFormat format)
+{
+	return TextureFormat::BC1 == format || TextureFormat::BC3 == format || TextureFormat::BC4 == format ||
+		TextureFormat::BC5 == format || TextureFormat::BC7 == format;
+}
+
+uint32_t BlockCompressor::GetBlockByteSize(TextureFormat format)
+{
+	return TextureFormat::BC1 == format || TextureFormat::BC4 == format ? 8U : 16U;
+}
+
+size_t BlockCompressor::GetCompressedSize(TextureFormat format, uint32_t width, uint32_t height)
+{
+	size_t blockCountX = (width + BlockDimension - 1U) / BlockDimension;
+	size_t blockCountY = (height + BlockDimension - 1U) / BlockDimension;
+	return blockCountX * blockCountY * GetBlockByteSize(format);
+}
+
+std::vector<std::byte> BlockCompressor::Compress(TextureFormat format, const std::byte* pRGBA8, uint32_t width, uint32_t height, uint32_t maxThreadCount)
+{
+	std::vector<std::byte> compressedData(GetCompressedSize(format, width, height));
+	Compress(format, pRGBA8, width, height, compressedData.data(), maxThreadCount);
+	return compressedData;
+}
+
+void BlockCompressor::Compress(TextureFormat format, const std::byte* pRGBA8, uint32_t width, uint32_t height, std::byte* pOutput, uint32_t maxThreadCount)
+{
+	assert(IsSupported(format));
+	if (0U == width || 0U == height)
+	{
+		return;
+	}
+
+	uint32_t blockCountX = (width + BlockDimension - 1U) / BlockDimension;
+	uint32_t blockCountY = (height + BlockDimension - 1U) / BlockDimension;
+	uint32_t blockByteSize = GetBlockByteSize(format);
+	const auto* pPixels = reinterpret_cast<const uint8_t*>(pRGBA8);
+	auto* pBlocks = reinterpret_cast<uint8_t*>(pOutput);
+
+	cd::ParallelFor(blockCountY, [=](uint32_t blockY)
+	{
+		ColorBlock block;
+		uint8_t* pRowBlocks = pBlocks + static_cast<size_t>(blockY) * blockCountX * blockByteSize;
+		for (uint32_t blockX = 0U; blockX < blockCountX; ++blockX)
+		{
+			FetchBlock(block, pPixels, width, height, blockX, blockY);
+			CompressBlock(format, block, pRowBlocks + static_cast<size_t>(blockX) * blockByteSize);
+		}
+	}, maxThreadCount);
+}
+
+}
@@ -0,0 +1,100 @@
+#include "Image/ImageCodec.h"
+
+// stb is a git submodule. Core still builds without it but decoding will fail.
+#if __has_include("stb/stb_image.h")
+#define CD_IMAGE_CODEC_USE_STB
+// Static functions avoid symbol conflicts with tools which also build stb by themselves.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb/stb_image.h"
+#endif
+
+#include <cstring>
+
+namespace cd
+{
+
+bool ImageCodec::IsDecodeSupported()
+{
+#ifdef CD_IMAGE_CODEC_USE_STB
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool ImageCodec::GetInfo(const std::byte* pData, size_t dataSize, uint32_t& width, uint32_t& height, TextureFormat& format)
+{
+	width = 0U;
+	height = 0U;
+	format = TextureFormat::Count;
+
+#ifdef CD_IMAGE_CODEC_USE_STB
+	const auto* pBuffer = reinterpret_cast<const stbi_uc*>(pData);
+	int bufferSize = static_cast<int>(dataSize);
+
+	int imageWidth;
+	int imageHeight;
+	int channelCount;
+	if (!stbi_info_from_memory(pBuffer, bufferSize, &imageWidth, &imageHeight, &channelCount))
+	{
+		return false;
+	}
+
+	width = static_cast<uint32_t>(imageWidth);
+	height = static_cast<uint32_t>(imageHeight);
+	if (stbi_is_hdr_from_memory(pBuffer, bufferSize))
+	{
+		constexpr TextureFormat FloatFormats[] = { TextureFormat::R32F, TextureFormat::RG32F, TextureFormat::RGBA32F, TextureFormat::RGBA32F };
+		format = FloatFormats[channelCount - 1];
+	}
+	else if (stbi_is_16_bit_from_memory(pBuffer, bufferSize))
+	{
+		constexpr TextureFormat Unorm16Formats[] = { TextureFormat::R16, TextureFormat::RG16, TextureFormat::RGBA16, TextureFormat::RGBA16 };
+		format = Unorm16Formats[channelCount - 1];
+	}
+	else
+	{
+		constexpr TextureFormat Unorm8Formats[] = { TextureFormat::R8, TextureFormat::RG8, TextureFormat::RGB8, TextureFormat::RGBA8 };
+		format = Unorm8Formats[channelCount - 1];
+	}
+
+	return true;
+#else
+	(void)pData;
+	(void)dataSize;
+	return false;
+#endif
+}
+
+std::vector<std::byte> ImageCodec::Decode(const std::byte* pData, size_t dataSize, uint32_t channelCount, uint32_t& width, uint32_t& height)
+{
+	std::vector<std::byte> pixels;
+	width = 0U;
+	height = 0U;
+
+#ifdef CD_IMAGE_CODEC_USE_STB
+	int imageWidth;
+	int imageHeight;
+	stbi_uc* pPixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(pData), static_cast<int>(dataSize),
+		&imageWidth, &imageHeight, nullptr, static_cast<int>(channelCount));
+	if (!pPixels)
+	{
+		return pixels;
+	}
+
+	width = static_cast<uint32_t>(imageWidth);
+	height = static_cast<uint32_t>(imageHeight);
+	pixels.resize(static_cast<size_t>(width) * height * channelCount);
+	std::memcpy(pixels.data(), pPixels, pixels.size());
+	stbi_image_free(pPixels);
+#else
+	(void)pData;
+	(void)dataSize;
+	(void)channelCount;
+#endif
+
+	return pixels;
+}
+
+}
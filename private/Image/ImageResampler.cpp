@@ -0,0 +1,338 @@
+#include "Image/ImageResampler.h"
+
+#include "Math/SIMD.hpp"
+#include "Utilities/ParallelFor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+constexpr float KaiserRadius = 3.0f;
+constexpr float KaiserAlpha = 4.0f;
+constexpr uint32_t LinearToSRGBTableSize = 16384U;
+
+float SRGBToLinear(float value)
+{
+	return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float LinearToSRGB(float value)
+{
+	return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+const std::array<float, 256>& GetSRGBToLinearTable()
+{
+	static const std::array<float, 256> table = []()
+	{
+		std::array<float, 256> result;
+		for (uint32_t index = 0U; index < 256U; ++index)
+		{
+			result[index] = SRGBToLinear(static_cast<float>(index) / 255.0f);
+		}
+		return result;
+	}();
+
+	return table;
+}
+
+const std::array<uint8_t, LinearToSRGBTableSize>& GetLinearToSRGBTable()
+{
+	static const std::array<uint8_t, LinearToSRGBTableSize> table = []()
+	{
+		std::array<uint8_t, LinearToSRGBTableSize> result;
+		for (uint32_t index = 0U; index < LinearToSRGBTableSize; ++index)
+		{
+			float linear = (static_cast<float>(index) + 0.5f) / static_cast<float>(LinearToSRGBTableSize);
+			result[index] = static_cast<uint8_t>(std::lround(std::clamp(LinearToSRGB(linear), 0.0f, 1.0f) * 255.0f));
+		}
+		return result;
+	}();
+
+	return table;
+}
+
+// Zero order modified bessel function of the first kind.
+float Bessel0(float x)
+{
+	float sum = 1.0f;
+	float term = 1.0f;
+	float halfX = x * 0.5f;
+	for (int k = 1; k < 32; ++k)
+	{
+		term *= halfX / static_cast<float>(k);
+		float termSquare = term * term;
+		sum += termSquare;
+		if (termSquare < sum * 1e-8f)
+		{
+			break;
+		}
+	}
+
+	return sum;
+}
+
+float Sinc(float x)
+{
+	if (std::abs(x) < 1e-5f)
+	{
+		return 1.0f;
+	}
+
+	float pix = 3.1415926535897932f * x;
+	return std::sin(pix) / pix;
+}
+
+float GetFilterRadius(cd::ResampleFilter filter)
+{
+	return cd::ResampleFilter::Box == filter ? 0.5f : KaiserRadius;
+}
+
+float EvaluateFilter(cd::ResampleFilter filter, float x)
+{
+	x = std::abs(x);
+	if (cd::ResampleFilter::Box == filter)
+	{
+		return x <= 0.5f ? 1.0f : 0.0f;
+	}
+
+	if (x >= KaiserRadius)
+	{
+		return 0.0f;
+	}
+
+	float t = x / KaiserRadius;
+	return Sinc(x) * Bessel0(KaiserAlpha * std::sqrt(1.0f - t * t)) / Bessel0(KaiserAlpha);
+}
+
+// Filter taps for every target pixel in one axis. Source indices are clamped to edge already.
+struct FilterTaps
+{
+	std::vector<uint32_t> starts;
+	std::vector<uint32_t> counts;
+	std::vector<uint32_t> sourceIndices;
+	std::vector<float> weights;
+};
+
+FilterTaps BuildFilterTaps(cd::ResampleFilter filter, uint32_t sourceSize, uint32_t targetSize)
+{
+	FilterTaps taps;
+	taps.starts.resize(targetSize);
+	taps.counts.resize(targetSize);
+
+	float scale = static_cast<float>(sourceSize) / static_cast<float>(targetSize);
+	// Stretch filter when downscaling to remove frequencies which can't be represented.
+	float filterScale = std::max(scale, 1.0f);
+	float support = GetFilterRadius(filter) * filterScale;
+	for (uint32_t targetIndex = 0U; targetIndex < targetSize; ++targetIndex)
+	{
+		float center = (static_cast<float>(targetIndex) + 0.5f) * scale;
+		int first = static_cast<int>(std::floor(center - support));
+		int last = static_cast<int>(std::ceil(center + support));
+
+		uint32_t start = static_cast<uint32_t>(taps.weights.size());
+		float weightSum = 0.0f;
+		for (int sourceIndex = first; sourceIndex <= last; ++sourceIndex)
+		{
+			float weight = EvaluateFilter(filter, (static_cast<float>(sourceIndex) + 0.5f - center) / filterScale);
+			if (0.0f == weight)
+			{
+				continue;
+			}
+
+			taps.sourceIndices.push_back(static_cast<uint32_t>(std::clamp(sourceIndex, 0, static_cast<int>(sourceSize) - 1)));
+			taps.weights.push_back(weight);
+			weightSum += weight;
+		}
+
+		uint32_t count = static_cast<uint32_t>(taps.weights.size()) - start;
+		if (0U == count || 0.0f == weightSum)
+		{
+			// Nearest sample as fallback.
+			taps.weights.resize(start);
+			taps.sourceIndices.resize(start);
+			taps.sourceIndices.push_back(std::min(static_cast<uint32_t>(center), sourceSize - 1U));
+			taps.weights.push_back(1.0f);
+			count = 1U;
+			weightSum = 1.0f;
+		}
+
+		for (uint32_t tapIndex = start; tapIndex < start + count; ++tapIndex)
+		{
+			taps.weights[tapIndex] /= weightSum;
+		}
+
+		taps.starts[targetIndex] = start;
+		taps.counts[targetIndex] = count;
+	}
+
+	return taps;
+}
+
+}
+
+namespace cd
+{
+
+void ImageResampler::Resample(const float* pSource, uint32_t sourceWidth, uint32_t sourceHeight,
+	float* pTarget, uint32_t targetWidth, uint32_t targetHeight, ResampleFilter filter, uint32_t maxThreadCount)
+{
+	if (0U == sourceWidth || 0U == sourceHeight || 0U == targetWidth || 0U == targetHeight)
+	{
+		return;
+	}
+
+	FilterTaps horizontalTaps = BuildFilterTaps(filter, sourceWidth, targetWidth);
+	FilterTaps verticalTaps = BuildFilterTaps(filter, sourceHeight, targetHeight);
+
+	// Horizontal pass : sourceWidth x sourceHeight -> targetWidth x sourceHeight.
+	std::vector<float> intermediate(static_cast<size_t>(targetWidth) * sourceHeight * 4U);
+	cd::ParallelFor(sourceHeight, [&](uint32_t y)
+	{
+		const float* pSourceRow = pSource + static_cast<size_t>(y) * sourceWidth * 4U;
+		float* pIntermediateRow = intermediate.data() + static_cast<size_t>(y) * targetWidth * 4U;
+		for (uint32_t x = 0U; x < targetWidth; ++x)
+		{
+			uint32_t start = horizontalTaps.starts[x];
+			uint32_t end = start + horizontalTaps.counts[x];
+			Float4 sum = Float4::Zero();
+			for (uint32_t tapIndex = start; tapIndex < end; ++tapIndex)
+			{
+				Float4 pixel = Float4::Load(pSourceRow + horizontalTaps.sourceIndices[tapIndex] * 4U);
+				sum = Float4::MultiplyAdd(pixel, Float4::Splat(horizontalTaps.weights[tapIndex]), sum);
+			}
+			sum.Store(pIntermediateRow + x * 4U);
+		}
+	}, maxThreadCount);
+
+	// Vertical pass accumulates whole rows so memory access keeps linear.
+	cd::ParallelFor(targetHeight, [&](uint32_t y)
+	{
+		float* pTargetRow = pTarget + static_cast<size_t>(y) * targetWidth * 4U;
+		std::fill(pTargetRow, pTargetRow + targetWidth * 4U, 0.0f);
+
+		uint32_t start = verticalTaps.starts[y];
+		uint32_t end = start + verticalTaps.counts[y];
+		for (uint32_t tapIndex = start; tapIndex < end; ++tapIndex)
+		{
+			const float* pIntermediateRow = intermediate.data() + static_cast<size_t>(verticalTaps.sourceIndices[tapIndex]) * targetWidth * 4U;
+			Float4 weight = Float4::Splat(verticalTaps.weights[tapIndex]);
+			for (uint32_t x = 0U; x < targetWidth; ++x)
+			{
+				Float4 sum = Float4::Load(pTargetRow + x * 4U);
+				Float4::MultiplyAdd(Float4::Load(pIntermediateRow + x * 4U), weight, sum).Store(pTargetRow + x * 4U);
+			}
+		}
+	}, maxThreadCount);
+}
+
+void ImageResampler::ConvertToLinear(const uint8_t* pRGBA8, uint32_t pixelCount, bool isSRGB, float* pLinear)
+{
+	const std::array<float, 256>& srgbToLinear = GetSRGBToLinearTable();
+	constexpr float InverseMaxValue = 1.0f / 255.0f;
+	for (uint32_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		const uint8_t* pPixel = pRGBA8 + pixelIndex * 4U;
+		float* pResult = pLinear + pixelIndex * 4U;
+		for (uint32_t channel = 0U; channel < 3U; ++channel)
+		{
+			pResult[channel] = isSRGB ? srgbToLinear[pPixel[channel]] : static_cast<float>(pPixel[channel]) * InverseMaxValue;
+		}
+		pResult[3] = static_cast<float>(pPixel[3]) * InverseMaxValue;
+	}
+}
+
+void ImageResampler::ConvertFromLinear(const float* pLinear, uint32_t pixelCount, bool isSRGB, uint8_t* pRGBA8)
+{
+	const std::array<uint8_t, LinearToSRGBTableSize>& linearToSRGB = GetLinearToSRGBTable();
+	const Float4 zero = Float4::Zero();
+	const Float4 one = Float4::Splat(1.0f);
+	for (uint32_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		// Kaiser filter has negative lobes so results need to clamp.
+		alignas(16) float values[4];
+		Float4::Clamp(Float4::Load(pLinear + pixelIndex * 4U), zero, one).Store(values);
+
+		uint8_t* pResult = pRGBA8 + pixelIndex * 4U;
+		for (uint32_t channel = 0U; channel < 3U; ++channel)
+		{
+			pResult[channel] = isSRGB ?
+				linearToSRGB[std::min(static_cast<uint32_t>(values[channel] * LinearToSRGBTableSize), LinearToSRGBTableSize - 1U)] :
+				static_cast<uint8_t>(values[channel] * 255.0f + 0.5f);
+		}
+		pResult[3] = static_cast<uint8_t>(values[3] * 255.0f + 0.5f);
+	}
+}
+
+std::vector<std::byte> ImageResampler::Resize(const std::byte* pRGBA8, uint32_t width, uint32_t height, uint32_t targetWidth, uint32_t targetHeight,
+	bool isSRGB, bool isNormalMap, ResampleFilter filter, uint32_t maxThreadCount)
+{
+	std::vector<float> sourcePixels(static_cast<size_t>(width) * height * 4U);
+	ConvertToLinear(reinterpret_cast<const uint8_t*>(pRGBA8), width * height, isSRGB, sourcePixels.data());
+	if (isNormalMap)
+	{
+		DecodeNormals(sourcePixels.data(), width * height);
+	}
+
+	uint32_t targetPixelCount = targetWidth * targetHeight;
+	std::vector<float> targetPixels(static_cast<size_t>(targetPixelCount) * 4U);
+	Resample(sourcePixels.data(), width, height, targetPixels.data(), targetWidth, targetHeight, filter, maxThreadCount);
+	if (isNormalMap)
+	{
+		RenormalizeNormals(targetPixels.data(), targetPixelCount);
+		EncodeNormals(targetPixels.data(), targetPixelCount);
+	}
+
+	std::vector<std::byte> targetRGBA8(static_cast<size_t>(targetPixelCount) * 4U);
+	ConvertFromLinear(targetPixels.data(), targetPixelCount, isSRGB, reinterpret_cast<uint8_t*>(targetRGBA8.data()));
+	return targetRGBA8;
+}
+
+void ImageResampler::DecodeNormals(float* pLinear, uint32_t pixelCount)
+{
+	const Float4 scale(2.0f, 2.0f, 2.0f, 1.0f);
+	const Float4 bias(-1.0f, -1.0f, -1.0f, 0.0f);
+	for (uint32_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		float* pPixel = pLinear + pixelIndex * 4U;
+		Float4::MultiplyAdd(Float4::Load(pPixel), scale, bias).Store(pPixel);
+	}
+}
+
+void ImageResampler::EncodeNormals(float* pLinear, uint32_t pixelCount)
+{
+	const Float4 scale(0.5f, 0.5f, 0.5f, 1.0f);
+	const Float4 bias(0.5f, 0.5f, 0.5f, 0.0f);
+	for (uint32_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		float* pPixel = pLinear + pixelIndex * 4U;
+		Float4::MultiplyAdd(Float4::Load(pPixel), scale, bias).Store(pPixel);
+	}
+}
+
+void ImageResampler::RenormalizeNormals(float* pNormals, uint32_t pixelCount)
+{
+	for (uint32_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		float* pPixel = pNormals + pixelIndex * 4U;
+		Float4 normal = Float4::Load(pPixel);
+		float lengthSquare = Float4::Dot3(normal, normal);
+		if (lengthSquare < 1e-12f)
+		{
+			pPixel[0] = 0.0f;
+			pPixel[1] = 0.0f;
+			pPixel[2] = 1.0f;
+			continue;
+		}
+
+		float alpha = pPixel[3];
+		(normal * (1.0f / std::sqrt(lengthSquare))).Store(pPixel);
+		pPixel[3] = alpha;
+	}
+}
+
+}
@@ -0,0 +1,142 @@
+#include "Image/MipmapGenerator.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+float CalculateAlphaCoverage(const std::vector<float>& pixels, float alphaScale, float alphaReference)
+{
+	size_t pixelCount = pixels.size() / 4U;
+	size_t coveredPixelCount = 0U;
+	for (size_t pixelIndex = 0U; pixelIndex < pixelCount; ++pixelIndex)
+	{
+		if (pixels[pixelIndex * 4U + 3U] * alphaScale > alphaReference)
+		{
+			++coveredPixelCount;
+		}
+	}
+
+	return static_cast<float>(coveredPixelCount) / static_cast<float>(pixelCount);
+}
+
+// Finds an alpha scale by binary search to make coverage close to the coverage of the top level.
+void PreserveAlphaCoverage(std::vector<float>& pixels, float targetCoverage, float alphaReference)
+{
+	float minAlphaScale = 0.0f;
+	float maxAlphaScale = 4.0f;
+	float alphaScale = 1.0f;
+	for (uint32_t iteration = 0U; iteration < 10U; ++iteration)
+	{
+		float coverage = CalculateAlphaCoverage(pixels, alphaScale, alphaReference);
+		if (coverage < targetCoverage)
+		{
+			minAlphaScale = alphaScale;
+		}
+		else if (coverage > targetCoverage)
+		{
+			maxAlphaScale = alphaScale;
+		}
+		else
+		{
+			break;
+		}
+
+		alphaScale = (minAlphaScale + maxAlphaScale) * 0.5f;
+	}
+
+	for (size_t alphaIndex = 3U; alphaIndex < pixels.size(); alphaIndex += 4U)
+	{
+		pixels[alphaIndex] = std::min(pixels[alphaIndex] * alphaScale, 1.0f);
+	}
+}
+
+}
+
+namespace cd
+{
+
+uint32_t MipmapGenerator::GetMipCount(uint32_t width, uint32_t height)
+{
+	uint32_t maxSize = std::max(width, height);
+	uint32_t mipCount = 1U;
+	while (maxSize > 1U)
+	{
+		maxSize >>= 1;
+		++mipCount;
+	}
+
+	return mipCount;
+}
+
+std::vector<std::byte> MipmapGenerator::Generate(const std::byte* pRGBA8, uint32_t width, uint32_t height,
+	const MipmapGenerateOptions& options, std::vector<uint64_t>& mipOffsets)
+{
+	uint32_t mipCount = GetMipCount(width, height);
+	mipOffsets.resize(mipCount);
+
+	size_t totalSize = 0U;
+	for (uint32_t mipLevel = 0U; mipLevel < mipCount; ++mipLevel)
+	{
+		mipOffsets[mipLevel] = totalSize;
+		totalSize += static_cast<size_t>(GetMipSize(width, mipLevel)) * GetMipSize(height, mipLevel) * 4U;
+	}
+
+	std::vector<std::byte> mipChain(totalSize);
+	std::memcpy(mipChain.data(), pRGBA8, static_cast<size_t>(width) * height * 4U);
+
+	bool isSRGB = MipmapContent::Color == options.content;
+	bool isNormalMap = MipmapContent::NormalMap == options.content;
+	bool preserveAlphaCoverage = options.alphaCoverageReference > 0.0f;
+
+	std::vector<float> sourcePixels(static_cast<size_t>(width) * height * 4U);
+	ImageResampler::ConvertToLinear(reinterpret_cast<const uint8_t*>(pRGBA8), width * height, isSRGB, sourcePixels.data());
+	if (isNormalMap)
+	{
+		ImageResampler::DecodeNormals(sourcePixels.data(), width * height);
+	}
+
+	float targetAlphaCoverage = preserveAlphaCoverage ? CalculateAlphaCoverage(sourcePixels, 1.0f, options.alphaCoverageReference) : 0.0f;
+
+	std::vector<float> targetPixels;
+	std::vector<float> encodedPixels;
+	for (uint32_t mipLevel = 1U; mipLevel < mipCount; ++mipLevel)
+	{
+		uint32_t sourceWidth = GetMipSize(width, mipLevel - 1U);
+		uint32_t sourceHeight = GetMipSize(height, mipLevel - 1U);
+		uint32_t targetWidth = GetMipSize(width, mipLevel);
+		uint32_t targetHeight = GetMipSize(height, mipLevel);
+
+		targetPixels.resize(static_cast<size_t>(targetWidth) * targetHeight * 4U);
+		ImageResampler::Resample(sourcePixels.data(), sourceWidth, sourceHeight, targetPixels.data(), targetWidth, targetHeight,
+			options.filter, options.maxThreadCount);
+
+		if (isNormalMap)
+		{
+			ImageResampler::RenormalizeNormals(targetPixels.data(), targetWidth * targetHeight);
+		}
+
+		if (preserveAlphaCoverage)
+		{
+			PreserveAlphaCoverage(targetPixels, targetAlphaCoverage, options.alphaCoverageReference);
+		}
+
+		const std::vector<float>* pEncodedPixels = &targetPixels;
+		if (isNormalMap)
+		{
+			encodedPixels = targetPixels;
+			ImageResampler::EncodeNormals(encodedPixels.data(), targetWidth * targetHeight);
+			pEncodedPixels = &encodedPixels;
+		}
+
+		ImageResampler::ConvertFromLinear(pEncodedPixels->data(), targetWidth * targetHeight, isSRGB,
+			reinterpret_cast<uint8_t*>(mipChain.data() + mipOffsets[mipLevel]));
+
+		std::swap(sourcePixels, targetPixels);
+	}
+
+	return mipChain;
+}
+
+}
@@ -0,0 +1,152 @@
+#include "Image/TextureContainer.h"
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+void WriteUInt32(std::byte* pData, uint32_t value)
+{
+	for (uint32_t byteIndex = 0U; byteIndex < 4U; ++byteIndex)
+	{
+		pData[byteIndex] = static_cast<std::byte>((value >> (byteIndex * 8U)) & 0xFFU);
+	}
+}
+
+void WriteUInt64(std::byte* pData, uint64_t value)
+{
+	for (uint32_t byteIndex = 0U; byteIndex < 8U; ++byteIndex)
+	{
+		pData[byteIndex] = static_cast<std::byte>((value >> (byteIndex * 8U)) & 0xFFU);
+	}
+}
+
+uint32_t ReadUInt32(const std::byte* pData)
+{
+	uint32_t value = 0U;
+	for (uint32_t byteIndex = 0U; byteIndex < 4U; ++byteIndex)
+	{
+		value |= static_cast<uint32_t>(pData[byteIndex]) << (byteIndex * 8U);
+	}
+
+	return value;
+}
+
+uint64_t ReadUInt64(const std::byte* pData)
+{
+	uint64_t value = 0U;
+	for (uint32_t byteIndex = 0U; byteIndex < 8U; ++byteIndex)
+	{
+		value |= static_cast<uint64_t>(pData[byteIndex]) << (byteIndex * 8U);
+	}
+
+	return value;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1U) / alignment * alignment;
+}
+
+}
+
+namespace cd
+{
+
+std::vector<std::byte> TextureContainer::Build(const TextureContainerHeader& header, const std::byte* pRawData, uint64_t rawDataSize,
+	const std::vector<uint64_t>& mipOffsets)
+{
+	uint32_t mipCount = mipOffsets.empty() ? 1U : static_cast<uint32_t>(mipOffsets.size());
+	uint32_t layerCount = header.layerCount > 0U ? header.layerCount : 1U;
+	assert(0U == rawDataSize % layerCount);
+	uint64_t layerSize = rawDataSize / layerCount;
+
+	// Level sizes in one layer.
+	std::vector<uint64_t> mipSizes(mipCount);
+	for (uint32_t mipLevel = 0U; mipLevel < mipCount; ++mipLevel)
+	{
+		uint64_t mipOffset = mipOffsets.empty() ? 0U : mipOffsets[mipLevel];
+		uint64_t mipEnd = mipLevel + 1U < mipCount ? mipOffsets[mipLevel + 1U] : layerSize;
+		assert(mipEnd >= mipOffset && mipEnd <= layerSize);
+		mipSizes[mipLevel] = mipEnd - mipOffset;
+	}
+
+	// Place the smallest mip first so that a streaming read from the beginning gets a displayable texture as soon as possible.
+	std::vector<TextureContainerLevel> levels(static_cast<size_t>(mipCount) * layerCount);
+	uint64_t dataOffset = AlignUp(GetHeaderSize(mipCount, layerCount), LevelAlignment);
+	for (uint32_t mipLevel = mipCount; mipLevel-- > 0U;)
+	{
+		for (uint32_t layer = 0U; layer < layerCount; ++layer)
+		{
+			TextureContainerLevel& level = levels[mipLevel * layerCount + layer];
+			level.offset = dataOffset;
+			level.size = mipSizes[mipLevel];
+			dataOffset = AlignUp(dataOffset + level.size, LevelAlignment);
+		}
+	}
+
+	std::vector<std::byte> container(dataOffset);
+	std::byte* pHeader = container.data();
+	WriteUInt32(pHeader, Magic);
+	WriteUInt32(pHeader + 4, Version);
+	WriteUInt32(pHeader + 8, static_cast<uint32_t>(header.format));
+	WriteUInt32(pHeader + 12, header.width);
+	WriteUInt32(pHeader + 16, header.height);
+	WriteUInt32(pHeader + 20, header.depth);
+	WriteUInt32(pHeader + 24, layerCount);
+	WriteUInt32(pHeader + 28, mipCount);
+
+	std::byte* pLevelTable = pHeader + FixedHeaderSize;
+	for (uint32_t mipLevel = 0U; mipLevel < mipCount; ++mipLevel)
+	{
+		for (uint32_t layer = 0U; layer < layerCount; ++layer)
+		{
+			uint32_t levelIndex = mipLevel * layerCount + layer;
+			const TextureContainerLevel& level = levels[levelIndex];
+			WriteUInt64(pLevelTable + levelIndex * 16U, level.offset);
+			WriteUInt64(pLevelTable + levelIndex * 16U + 8U, level.size);
+
+			uint64_t sourceOffset = layer * layerSize + (mipOffsets.empty() ? 0U : mipOffsets[mipLevel]);
+			std::memcpy(container.data() + level.offset, pRawData + sourceOffset, level.size);
+		}
+	}
+
+	return container;
+}
+
+bool TextureContainer::ReadFixedHeader(const std::byte* pData, uint64_t size, TextureContainerHeader& header)
+{
+	if (size < FixedHeaderSize || ReadUInt32(pData) != Magic || ReadUInt32(pData + 4) != Version)
+	{
+		return false;
+	}
+
+	header.format = static_cast<TextureFormat>(ReadUInt32(pData + 8));
+	header.width = ReadUInt32(pData + 12);
+	header.height = ReadUInt32(pData + 16);
+	header.depth = ReadUInt32(pData + 20);
+	header.layerCount = ReadUInt32(pData + 24);
+	header.mipCount = ReadUInt32(pData + 28);
+	return header.layerCount > 0U && header.mipCount > 0U;
+}
+
+bool TextureContainer::ReadHeader(const std::byte* pData, uint64_t size, TextureContainerHeader& header, std::vector<TextureContainerLevel>& levels)
+{
+	if (!ReadFixedHeader(pData, size, header) || size < GetHeaderSize(header.mipCount, header.layerCount))
+	{
+		return false;
+	}
+
+	levels.resize(static_cast<size_t>(header.mipCount) * header.layerCount);
+	const std::byte* pLevelTable = pData + FixedHeaderSize;
+	for (size_t levelIndex = 0U; levelIndex < levels.size(); ++levelIndex)
+	{
+		levels[levelIndex].offset = ReadUInt64(pLevelTable + levelIndex * 16U);
+		levels[levelIndex].size = ReadUInt64(pLevelTable + levelIndex * 16U + 8U);
+	}
+
+	return true;
+}
+
+}
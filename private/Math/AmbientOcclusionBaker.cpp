@@ -0,0 +1,390 @@
+#include "Math/AmbientOcclusionBaker.h"
+
+#include "Math/BVHBuilder.h"
+#include "Math/SIMD.hpp"
+#include "Scene/SceneDatabase.h"
+#include "Utilities/ParallelFor.h"
+
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+
+constexpr float Pi = 3.14159265358979323846f;
+constexpr uint32_t PacketSize = 4U;
+constexpr uint32_t VertexChunkSize = 64U;
+
+// Rays of one packet share the origin. Direction components are stored by lanes.
+struct RayPacket
+{
+	cd::Point origin;
+	cd::Float4 directionX;
+	cd::Float4 directionY;
+	cd::Float4 directionZ;
+	cd::Float4 inverseDirectionX;
+	cd::Float4 inverseDirectionY;
+	cd::Float4 inverseDirectionZ;
+	cd::Float4 minDistance;
+	cd::Float4 maxDistance;
+};
+
+struct ReceiverMesh
+{
+	const cd::Mesh* pMesh;
+	std::vector<cd::Direction> vertexNormals;
+	float maxDistance;
+	float bias;
+};
+
+int IntersectBox(const RayPacket& packet, const cd::AABB& box)
+{
+	using cd::Float4;
+
+	Float4 t1x = Float4(box.Min().x() - packet.origin.x()) * packet.inverseDirectionX;
+	Float4 t2x = Float4(box.Max().x() - packet.origin.x()) * packet.inverseDirectionX;
+	Float4 t1y = Float4(box.Min().y() - packet.origin.y()) * packet.inverseDirectionY;
+	Float4 t2y = Float4(box.Max().y() - packet.origin.y()) * packet.inverseDirectionY;
+	Float4 t1z = Float4(box.Min().z() - packet.origin.z()) * packet.inverseDirectionZ;
+	Float4 t2z = Float4(box.Max().z() - packet.origin.z()) * packet.inverseDirectionZ;
+	Float4 tmin = Float4::Max(Float4::Max(Float4::Min(t1x, t2x), Float4::Min(t1y, t2y)), Float4::Max(Float4::Min(t1z, t2z), Float4::Zero()));
+	Float4 tmax = Float4::Min(Float4::Min(Float4::Max(t1x, t2x), Float4::Max(t1y, t2y)), Float4::Min(Float4::Max(t1z, t2z), packet.maxDistance));
+	return Float4::LessEqualMask(tmin, tmax);
+}
+
+// Moller-Trumbore for 4 rays against one triangle. Terms which only depend on the shared origin are scalar.
+int IntersectTriangle(const RayPacket& packet, const cd::Point& v0, const cd::Point& v1, const cd::Point& v2)
+{
+	using cd::Float4;
+
+	cd::Direction edge1 = v1 - v0;
+	cd::Direction edge2 = v2 - v0;
+	Float4 px = packet.directionY * edge2.z() - packet.directionZ * Float4(edge2.y());
+	Float4 py = packet.directionZ * edge2.x() - packet.directionX * Float4(edge2.z());
+	Float4 pz = packet.directionX * edge2.y() - packet.directionY * Float4(edge2.x());
+	Float4 determinant = Float4::MultiplyAdd(px, Float4(edge1.x()), Float4::MultiplyAdd(py, Float4(edge1.y()), pz * edge1.z()));
+	Float4 inverseDeterminant = Float4(1.0f) / determinant;
+
+	cd::Direction s = packet.origin - v0;
+	cd::Direction q = s.Cross(edge1);
+	Float4 u = Float4::MultiplyAdd(px, Float4(s.x()), Float4::MultiplyAdd(py, Float4(s.y()), pz * s.z())) * inverseDeterminant;
+	Float4 v = Float4::MultiplyAdd(packet.directionX, Float4(q.x()), Float4::MultiplyAdd(packet.directionY, Float4(q.y()), packet.directionZ * q.z())) * inverseDeterminant;
+	Float4 t = Float4(edge2.Dot(q)) * inverseDeterminant;
+
+	// Parallel rays get infinite or NaN values which fail comparisons.
+	return Float4::LessEqualMask(Float4::Zero(), u) & Float4::LessEqualMask(Float4::Zero(), v) &
+		Float4::LessEqualMask(u + v, Float4(1.0f)) & Float4::LessMask(packet.minDistance, t) & Float4::LessMask(t, packet.maxDistance);
+}
+
+// Returns lanes of activeMask which hit any polygon of the mesh.
+int OccludeByMesh(const cd::Mesh& mesh, const RayPacket& packet, int activeMask, std::vector<uint32_t>& nodeStack)
+{
+	const std::vector<cd::BVHNode>& nodes = mesh.GetBVHNodes();
+	const std::vector<uint32_t>& polygonIndexes = mesh.GetBVHPolygonIndexes();
+	if (nodes.empty())
+	{
+		return 0;
+	}
+
+	int occludedMask = 0;
+	nodeStack.clear();
+	nodeStack.push_back(0U);
+	while (!nodeStack.empty())
+	{
+		uint32_t nodeIndex = nodeStack.back();
+		nodeStack.pop_back();
+
+		const cd::BVHNode& node = nodes[nodeIndex];
+		int nodeMask = activeMask & ~occludedMask & IntersectBox(packet, node.bounds);
+		if (0 == nodeMask)
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			nodeStack.push_back(node.offset);
+			nodeStack.push_back(nodeIndex + 1U);
+			continue;
+		}
+
+		for (uint32_t index = node.offset; index < node.offset + node.primitiveCount; ++index)
+		{
+			const cd::Polygon& polygon = mesh.GetPolygon(polygonIndexes[index]);
+			occludedMask |= nodeMask & IntersectTriangle(packet, mesh.GetVertexPosition(polygon[0].Data()),
+				mesh.GetVertexPosition(polygon[1].Data()), mesh.GetVertexPosition(polygon[2].Data()));
+		}
+
+		// Any hit is enough for occlusion.
+		if (0 == (activeMask & ~occludedMask))
+		{
+			break;
+		}
+	}
+
+	return occludedMask;
+}
+
+int OccludeByScene(const cd::SceneDatabase& sceneDatabase, const RayPacket& packet, std::vector<uint32_t>& sceneNodeStack, std::vector<uint32_t>& meshNodeStack)
+{
+	constexpr int AllLanes = (1 << PacketSize) - 1;
+	const std::vector<cd::BVHNode>& nodes = sceneDatabase.GetMeshBVHNodes();
+	const std::vector<uint32_t>& meshIndexes = sceneDatabase.GetMeshBVHMeshIndexes();
+	int occludedMask = 0;
+	if (nodes.empty())
+	{
+		for (uint32_t meshIndex = 0U; meshIndex < sceneDatabase.GetMeshCount() && occludedMask != AllLanes; ++meshIndex)
+		{
+			occludedMask |= OccludeByMesh(sceneDatabase.GetMesh(meshIndex), packet, ~occludedMask & AllLanes, meshNodeStack);
+		}
+		return occludedMask;
+	}
+
+	sceneNodeStack.clear();
+	sceneNodeStack.push_back(0U);
+	while (!sceneNodeStack.empty() && occludedMask != AllLanes)
+	{
+		uint32_t nodeIndex = sceneNodeStack.back();
+		sceneNodeStack.pop_back();
+
+		const cd::BVHNode& node = nodes[nodeIndex];
+		int nodeMask = ~occludedMask & IntersectBox(packet, node.bounds);
+		if (0 == nodeMask)
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			sceneNodeStack.push_back(node.offset);
+			sceneNodeStack.push_back(nodeIndex + 1U);
+			continue;
+		}
+
+		for (uint32_t index = node.offset; index < node.offset + node.primitiveCount && occludedMask != AllLanes; ++index)
+		{
+			occludedMask |= OccludeByMesh(sceneDatabase.GetMesh(meshIndexes[index]), packet, nodeMask & ~occludedMask, meshNodeStack);
+		}
+	}
+
+	return occludedMask;
+}
+
+// Cosine weighted directions around +Z by Hammersley points.
+std::vector<cd::Direction> GenerateHemisphereDirections(uint32_t rayCount)
+{
+	std::vector<cd::Direction> directions(rayCount);
+	for (uint32_t rayIndex = 0U; rayIndex < rayCount; ++rayIndex)
+	{
+		float u1 = (static_cast<float>(rayIndex) + 0.5f) / static_cast<float>(rayCount);
+
+		// Van der Corput radical inverse by reversing bits.
+		uint32_t bits = rayIndex;
+		bits = (bits << 16U) | (bits >> 16U);
+		bits = ((bits & 0x55555555U) << 1U) | ((bits & 0xAAAAAAAAU) >> 1U);
+		bits = ((bits & 0x33333333U) << 2U) | ((bits & 0xCCCCCCCCU) >> 2U);
+		bits = ((bits & 0x0F0F0F0FU) << 4U) | ((bits & 0xF0F0F0F0U) >> 4U);
+		bits = ((bits & 0x00FF00FFU) << 8U) | ((bits & 0xFF00FF00U) >> 8U);
+		float u2 = static_cast<float>(bits) * 2.3283064365386963e-10f;
+
+		float radius = std::sqrt(u1);
+		float phi = 2.0f * Pi * u2;
+		directions[rayIndex] = cd::Direction(radius * std::cos(phi), radius * std::sin(phi), std::sqrt(std::max(0.0f, 1.0f - u1)));
+	}
+	return directions;
+}
+
+ReceiverMesh PrepareReceiverMesh(const cd::Mesh& mesh, const cd::AmbientOcclusionOptions& options)
+{
+	ReceiverMesh receiver;
+	receiver.pMesh = &mesh;
+
+	uint32_t vertexCount = mesh.GetVertexCount();
+	cd::Point minPoint(FLT_MAX);
+	cd::Point maxPoint(-FLT_MAX);
+	for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+	{
+		const cd::Point& position = mesh.GetVertexPosition(vertexIndex);
+		for (uint32_t axis = 0U; axis < 3U; ++axis)
+		{
+			minPoint[axis] = std::min(minPoint[axis], position[axis]);
+			maxPoint[axis] = std::max(maxPoint[axis], position[axis]);
+		}
+	}
+	float diagonal = vertexCount > 0U ? (maxPoint - minPoint).Length() : 0.0f;
+	receiver.maxDistance = options.maxDistance > 0.0f ? options.maxDistance : diagonal * 0.5f;
+	receiver.bias = std::max(diagonal * 1e-4f, 1e-6f);
+
+	// Use imported normals when they exist. Otherwise area weighted polygon normals.
+	receiver.vertexNormals.assign(vertexCount, cd::Direction(0.0f));
+	const std::vector<cd::Direction>& normals = mesh.GetVertexNormals();
+	bool hasNormals = normals.size() == vertexCount && std::any_of(normals.begin(), normals.end(), [](const cd::Direction& normal) { return normal.LengthSquare() > 0.0f; });
+	if (hasNormals)
+	{
+		receiver.vertexNormals = normals;
+	}
+	else
+	{
+		for (uint32_t polygonIndex = 0U; polygonIndex < mesh.GetPolygonCount(); ++polygonIndex)
+		{
+			const cd::Polygon& polygon = mesh.GetPolygon(polygonIndex);
+			const cd::Point& v0 = mesh.GetVertexPosition(polygon[0].Data());
+			cd::Direction polygonNormal = (mesh.GetVertexPosition(polygon[1].Data()) - v0).Cross(mesh.GetVertexPosition(polygon[2].Data()) - v0);
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				receiver.vertexNormals[polygon[corner].Data()] += polygonNormal;
+			}
+		}
+	}
+
+	for (cd::Direction& normal : receiver.vertexNormals)
+	{
+		if (normal.LengthSquare() > 0.0f)
+		{
+			normal.Normalize();
+		}
+	}
+
+	return receiver;
+}
+
+template<typename OccludeFunc>
+float BakeVertex(const ReceiverMesh& receiver, uint32_t vertexIndex, const std::vector<cd::Direction>& hemisphereDirections, OccludeFunc&& occlude)
+{
+	const cd::Direction& normal = receiver.vertexNormals[vertexIndex];
+	if (0.0f == normal.LengthSquare() || receiver.maxDistance <= 0.0f)
+	{
+		return 1.0f;
+	}
+
+	// Orthonormal basis without branches on normal direction. Building an Orthonormal Basis, Revisited, 2017.
+	float sign = std::copysign(1.0f, normal.z());
+	float a = -1.0f / (sign + normal.z());
+	float b = normal.x() * normal.y() * a;
+	cd::Direction tangent(1.0f + sign * normal.x() * normal.x() * a, sign * b, -sign * normal.x());
+	cd::Direction biTangent(b, sign + normal.y() * normal.y() * a, -normal.y());
+
+	// Rotate the sample pattern per vertex to turn banding into noise.
+	float angle = static_cast<float>((vertexIndex * 2654435761U) >> 8) * (2.0f * Pi / 16777216.0f);
+	float cosAngle = std::cos(angle);
+	float sinAngle = std::sin(angle);
+
+	RayPacket packet;
+	packet.origin = receiver.pMesh->GetVertexPosition(vertexIndex) + normal * receiver.bias;
+	packet.minDistance = cd::Float4(receiver.bias);
+	packet.maxDistance = cd::Float4(receiver.maxDistance);
+
+	uint32_t rayCount = static_cast<uint32_t>(hemisphereDirections.size());
+	uint32_t occludedCount = 0U;
+	alignas(16) float directions[3][PacketSize];
+	alignas(16) float inverseDirections[3][PacketSize];
+	for (uint32_t firstRay = 0U; firstRay < rayCount; firstRay += PacketSize)
+	{
+		for (uint32_t lane = 0U; lane < PacketSize; ++lane)
+		{
+			const cd::Direction& local = hemisphereDirections[firstRay + lane];
+			float x = local.x() * cosAngle - local.y() * sinAngle;
+			float y = local.x() * sinAngle + local.y() * cosAngle;
+			cd::Direction direction = tangent * x + biTangent * y + normal * local.z();
+			for (uint32_t axis = 0U; axis < 3U; ++axis)
+			{
+				// Avoid infinity times zero in slab tests.
+				float component = std::abs(direction[axis]) < 1e-12f ? std::copysign(1e-12f, direction[axis]) : direction[axis];
+				directions[axis][lane] = component;
+				inverseDirections[axis][lane] = 1.0f / component;
+			}
+		}
+
+		packet.directionX = cd::Float4::Load(directions[0]);
+		packet.directionY = cd::Float4::Load(directions[1]);
+		packet.directionZ = cd::Float4::Load(directions[2]);
+		packet.inverseDirectionX = cd::Float4::Load(inverseDirections[0]);
+		packet.inverseDirectionY = cd::Float4::Load(inverseDirections[1]);
+		packet.inverseDirectionZ = cd::Float4::Load(inverseDirections[2]);
+		occludedCount += static_cast<uint32_t>(std::popcount(static_cast<uint32_t>(occlude(packet))));
+	}
+
+	return 1.0f - static_cast<float>(occludedCount) / static_cast<float>(rayCount);
+}
+
+uint32_t GetRayCount(const cd::AmbientOcclusionOptions& options)
+{
+	return std::max(PacketSize, (options.rayCount + PacketSize - 1U) / PacketSize * PacketSize);
+}
+
+}
+
+namespace cd
+{
+
+void AmbientOcclusionBaker::Bake(const Mesh& mesh, const AmbientOcclusionOptions& options, std::vector<float>& vertexAccessibilities)
+{
+	ReceiverMesh receiver = PrepareReceiverMesh(mesh, options);
+	std::vector<Direction> hemisphereDirections = GenerateHemisphereDirections(GetRayCount(options));
+
+	uint32_t vertexCount = mesh.GetVertexCount();
+	vertexAccessibilities.resize(vertexCount);
+	ParallelFor((vertexCount + VertexChunkSize - 1U) / VertexChunkSize, [&](uint32_t chunkIndex)
+	{
+		std::vector<uint32_t> nodeStack;
+		nodeStack.reserve(64U);
+		auto occlude = [&mesh, &nodeStack](const RayPacket& packet)
+		{
+			return OccludeByMesh(mesh, packet, (1 << PacketSize) - 1, nodeStack);
+		};
+
+		uint32_t endVertexIndex = std::min(vertexCount, (chunkIndex + 1U) * VertexChunkSize);
+		for (uint32_t vertexIndex = chunkIndex * VertexChunkSize; vertexIndex < endVertexIndex; ++vertexIndex)
+		{
+			vertexAccessibilities[vertexIndex] = BakeVertex(receiver, vertexIndex, hemisphereDirections, occlude);
+		}
+	}, options.maxThreadCount);
+}
+
+void AmbientOcclusionBaker::Bake(const SceneDatabase& sceneDatabase, const AmbientOcclusionOptions& options, std::vector<std::vector<float>>& meshVertexAccessibilities)
+{
+	uint32_t meshCount = sceneDatabase.GetMeshCount();
+	std::vector<ReceiverMesh> receivers(meshCount);
+	ParallelFor(meshCount, [&sceneDatabase, &options, &receivers](uint32_t meshIndex)
+	{
+		receivers[meshIndex] = PrepareReceiverMesh(sceneDatabase.GetMesh(meshIndex), options);
+	}, options.maxThreadCount);
+	std::vector<Direction> hemisphereDirections = GenerateHemisphereDirections(GetRayCount(options));
+
+	// Split all vertices of all meshes into chunks so that one large mesh doesn't leave threads idle.
+	std::vector<std::pair<uint32_t, uint32_t>> chunks;
+	meshVertexAccessibilities.resize(meshCount);
+	for (uint32_t meshIndex = 0U; meshIndex < meshCount; ++meshIndex)
+	{
+		uint32_t vertexCount = sceneDatabase.GetMesh(meshIndex).GetVertexCount();
+		meshVertexAccessibilities[meshIndex].resize(vertexCount);
+		for (uint32_t firstVertexIndex = 0U; firstVertexIndex < vertexCount; firstVertexIndex += VertexChunkSize)
+		{
+			chunks.emplace_back(meshIndex, firstVertexIndex);
+		}
+	}
+
+	ParallelFor(static_cast<uint32_t>(chunks.size()), [&](uint32_t chunkIndex)
+	{
+		std::vector<uint32_t> sceneNodeStack;
+		std::vector<uint32_t> meshNodeStack;
+		sceneNodeStack.reserve(64U);
+		meshNodeStack.reserve(64U);
+		auto occlude = [&sceneDatabase, &sceneNodeStack, &meshNodeStack](const RayPacket& packet)
+		{
+			return OccludeByScene(sceneDatabase, packet, sceneNodeStack, meshNodeStack);
+		};
+
+		const auto& [meshIndex, firstVertexIndex] = chunks[chunkIndex];
+		const ReceiverMesh& receiver = receivers[meshIndex];
+		uint32_t endVertexIndex = std::min(receiver.pMesh->GetVertexCount(), firstVertexIndex + VertexChunkSize);
+		for (uint32_t vertexIndex = firstVertexIndex; vertexIndex < endVertexIndex; ++vertexIndex)
+		{
+			meshVertexAccessibilities[meshIndex][vertexIndex] = BakeVertex(receiver, vertexIndex, hemisphereDirections, occlude);
+		}
+	}, options.maxThreadCount);
+}
+
+}
@@ -0,0 +1,506 @@
+#include "Math/BVHBuilder.h"
+
+#include "Scene/Mesh.h"
+#include "Utilities/ParallelFor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+
+constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+// Ranges larger than it are binned by several threads.
+constexpr uint32_t ParallelBinningPrimitiveCount = 65536U;
+constexpr uint32_t BinningChunkSize = 16384U;
+
+// Ranges smaller than it are not split further by the top level builder.
+constexpr uint32_t MinSubtreePrimitiveCount = 4096U;
+
+struct BuildNode
+{
+	cd::AABB bounds;
+	uint32_t leftChild = InvalidIndex;
+	uint32_t rightChild = InvalidIndex;
+	uint32_t first = 0U;
+	uint32_t count = 0U;
+	uint32_t splitAxis = 0U;
+
+	// Top level leaves which are expanded by a subtree task.
+	uint32_t subtreeIndex = InvalidIndex;
+};
+
+struct Bin
+{
+	cd::AABB bounds = cd::AABB(cd::Point(FLT_MAX), cd::Point(-FLT_MAX));
+	uint32_t count = 0U;
+};
+
+struct BuildContext
+{
+	const std::vector<cd::AABB>& primitiveBounds;
+	const std::vector<cd::Point>& centroids;
+	std::vector<uint32_t>& primitiveIndexes;
+	uint32_t binCount;
+	uint32_t maxLeafSize;
+	float traversalCost;
+	uint32_t maxThreadCount;
+};
+
+cd::AABB InvalidBounds()
+{
+	return cd::AABB(cd::Point(FLT_MAX), cd::Point(-FLT_MAX));
+}
+
+void MergePoint(cd::AABB& bounds, const cd::Point& point)
+{
+	for (uint32_t axis = 0U; axis < 3U; ++axis)
+	{
+		bounds.Min()[axis] = std::min(bounds.Min()[axis], point[axis]);
+		bounds.Max()[axis] = std::max(bounds.Max()[axis], point[axis]);
+	}
+}
+
+float CalculateHalfArea(const cd::AABB& bounds)
+{
+	float dx = bounds.Max().x() - bounds.Min().x();
+	float dy = bounds.Max().y() - bounds.Min().y();
+	float dz = bounds.Max().z() - bounds.Min().z();
+	if (dx < 0.0f || dy < 0.0f || dz < 0.0f)
+	{
+		return 0.0f;
+	}
+
+	return dx * dy + dy * dz + dz * dx;
+}
+
+// Runs func(begin, end) on chunks of the range. Large ranges use several threads and merge results by the caller.
+template<typename Func>
+uint32_t ForEachChunk(const BuildContext& context, uint32_t first, uint32_t count, Func&& func)
+{
+	if (count < ParallelBinningPrimitiveCount || 1U == context.maxThreadCount)
+	{
+		func(0U, first, first + count);
+		return 1U;
+	}
+
+	uint32_t chunkCount = (count + BinningChunkSize - 1U) / BinningChunkSize;
+	cd::ParallelFor(chunkCount, [first, count, chunkCount, &func](uint32_t chunkIndex)
+	{
+		uint32_t begin = first + chunkIndex * (count / chunkCount);
+		uint32_t end = chunkIndex + 1U == chunkCount ? first + count : begin + count / chunkCount;
+		func(chunkIndex, begin, end);
+	}, context.maxThreadCount);
+	return chunkCount;
+}
+
+void CalculateRangeBounds(const BuildContext& context, uint32_t first, uint32_t count, cd::AABB& bounds, cd::AABB& centroidBounds)
+{
+	std::vector<cd::AABB> chunkBounds(std::max(1U, (count + BinningChunkSize - 1U) / BinningChunkSize) * 2U, InvalidBounds());
+	uint32_t chunkCount = ForEachChunk(context, first, count, [&context, &chunkBounds](uint32_t chunkIndex, uint32_t begin, uint32_t end)
+	{
+		cd::AABB& localBounds = chunkBounds[chunkIndex * 2U];
+		cd::AABB& localCentroidBounds = chunkBounds[chunkIndex * 2U + 1U];
+		for (uint32_t index = begin; index < end; ++index)
+		{
+			uint32_t primitiveIndex = context.primitiveIndexes[index];
+			localBounds.Merge(context.primitiveBounds[primitiveIndex]);
+			MergePoint(localCentroidBounds, context.centroids[primitiveIndex]);
+		}
+	});
+
+	bounds = InvalidBounds();
+	centroidBounds = InvalidBounds();
+	for (uint32_t chunkIndex = 0U; chunkIndex < chunkCount; ++chunkIndex)
+	{
+		bounds.Merge(chunkBounds[chunkIndex * 2U]);
+		centroidBounds.Merge(chunkBounds[chunkIndex * 2U + 1U]);
+	}
+}
+
+uint32_t GetBinIndex(const BuildContext& context, const cd::AABB& centroidBounds, float centroid, uint32_t axis)
+{
+	float extent = centroidBounds.Max()[axis] - centroidBounds.Min()[axis];
+	auto binIndex = static_cast<uint32_t>((centroid - centroidBounds.Min()[axis]) * (static_cast<float>(context.binCount) / extent));
+	return std::min(binIndex, context.binCount - 1U);
+}
+
+// Returns the split position in [first, first + count). Returns first + count when the range should be a leaf.
+uint32_t SplitRange(const BuildContext& context, uint32_t first, uint32_t count, const cd::AABB& bounds, const cd::AABB& centroidBounds, uint32_t& splitAxis)
+{
+	splitAxis = 0U;
+	if (count <= 1U)
+	{
+		return first + count;
+	}
+
+	// Bins of all three axes are filled in one pass.
+	uint32_t binCount = context.binCount;
+	std::vector<Bin> chunkBins(std::max(1U, (count + BinningChunkSize - 1U) / BinningChunkSize) * 3U * binCount);
+	uint32_t chunkCount = ForEachChunk(context, first, count, [&context, &centroidBounds, &chunkBins, binCount](uint32_t chunkIndex, uint32_t begin, uint32_t end)
+	{
+		Bin* pBins = &chunkBins[chunkIndex * 3U * binCount];
+		for (uint32_t index = begin; index < end; ++index)
+		{
+			uint32_t primitiveIndex = context.primitiveIndexes[index];
+			const cd::Point& centroid = context.centroids[primitiveIndex];
+			for (uint32_t axis = 0U; axis < 3U; ++axis)
+			{
+				if (centroidBounds.Max()[axis] <= centroidBounds.Min()[axis])
+				{
+					continue;
+				}
+
+				Bin& bin = pBins[axis * binCount + GetBinIndex(context, centroidBounds, centroid[axis], axis)];
+				bin.bounds.Merge(context.primitiveBounds[primitiveIndex]);
+				++bin.count;
+			}
+		}
+	});
+
+	for (uint32_t chunkIndex = 1U; chunkIndex < chunkCount; ++chunkIndex)
+	{
+		for (uint32_t binIndex = 0U; binIndex < 3U * binCount; ++binIndex)
+		{
+			chunkBins[binIndex].bounds.Merge(chunkBins[chunkIndex * 3U * binCount + binIndex].bounds);
+			chunkBins[binIndex].count += chunkBins[chunkIndex * 3U * binCount + binIndex].count;
+		}
+	}
+
+	// Sweep bins from right to left to get costs of right parts, then from left to right to evaluate every plane.
+	float bestCost = FLT_MAX;
+	uint32_t bestAxis = 0U;
+	uint32_t bestBinIndex = InvalidIndex;
+	std::vector<float> rightCosts(binCount);
+	for (uint32_t axis = 0U; axis < 3U; ++axis)
+	{
+		if (centroidBounds.Max()[axis] <= centroidBounds.Min()[axis])
+		{
+			continue;
+		}
+
+		const Bin* pBins = &chunkBins[axis * binCount];
+		cd::AABB rightBounds = InvalidBounds();
+		uint32_t rightCount = 0U;
+		for (uint32_t binIndex = binCount - 1U; binIndex > 0U; --binIndex)
+		{
+			rightBounds.Merge(pBins[binIndex].bounds);
+			rightCount += pBins[binIndex].count;
+			rightCosts[binIndex] = CalculateHalfArea(rightBounds) * static_cast<float>(rightCount);
+		}
+
+		cd::AABB leftBounds = InvalidBounds();
+		uint32_t leftCount = 0U;
+		for (uint32_t binIndex = 0U; binIndex + 1U < binCount; ++binIndex)
+		{
+			leftBounds.Merge(pBins[binIndex].bounds);
+			leftCount += pBins[binIndex].count;
+			if (0U == leftCount || count == leftCount)
+			{
+				continue;
+			}
+
+			float cost = CalculateHalfArea(leftBounds) * static_cast<float>(leftCount) + rightCosts[binIndex + 1U];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBinIndex = binIndex;
+			}
+		}
+	}
+
+	// Intersection cost of one primitive is 1.
+	float nodeHalfArea = CalculateHalfArea(bounds);
+	float leafCost = static_cast<float>(count);
+	float splitCost = InvalidIndex == bestBinIndex ? FLT_MAX :
+		context.traversalCost + (nodeHalfArea > 0.0f ? bestCost / nodeHalfArea : static_cast<float>(count));
+	if (splitCost >= leafCost && count <= context.maxLeafSize)
+	{
+		return first + count;
+	}
+
+	auto itBegin = context.primitiveIndexes.begin() + first;
+	auto itEnd = itBegin + count;
+	if (bestBinIndex != InvalidIndex)
+	{
+		splitAxis = bestAxis;
+		auto itSplit = std::partition(itBegin, itEnd, [&context, &centroidBounds, bestAxis, bestBinIndex](uint32_t primitiveIndex)
+		{
+			return GetBinIndex(context, centroidBounds, context.centroids[primitiveIndex][bestAxis], bestAxis) <= bestBinIndex;
+		});
+		return static_cast<uint32_t>(itSplit - context.primitiveIndexes.begin());
+	}
+
+	// Centroids are at the same place or no plane separates them so split by median to bound leaf size.
+	cd::Point extent = centroidBounds.Size();
+	splitAxis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0U : (extent.y() >= extent.z() ? 1U : 2U);
+	auto itMiddle = itBegin + count / 2U;
+	std::nth_element(itBegin, itMiddle, itEnd, [&context, splitAxis](uint32_t lhs, uint32_t rhs)
+	{
+		return context.centroids[lhs][splitAxis] < context.centroids[rhs][splitAxis];
+	});
+	return first + count / 2U;
+}
+
+uint32_t BuildSubtree(const BuildContext& context, std::vector<BuildNode>& nodes, uint32_t first, uint32_t count)
+{
+	uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+	nodes.emplace_back();
+
+	cd::AABB centroidBounds;
+	CalculateRangeBounds(context, first, count, nodes[nodeIndex].bounds, centroidBounds);
+	nodes[nodeIndex].first = first;
+	nodes[nodeIndex].count = count;
+
+	uint32_t splitAxis;
+	uint32_t split = SplitRange(context, first, count, nodes[nodeIndex].bounds, centroidBounds, splitAxis);
+	if (split == first + count)
+	{
+		return nodeIndex;
+	}
+
+	nodes[nodeIndex].splitAxis = splitAxis;
+	uint32_t leftChild = BuildSubtree(context, nodes, first, split - first);
+	uint32_t rightChild = BuildSubtree(context, nodes, split, first + count - split);
+	nodes[nodeIndex].leftChild = leftChild;
+	nodes[nodeIndex].rightChild = rightChild;
+	return nodeIndex;
+}
+
+struct SubtreeTask
+{
+	uint32_t first;
+	uint32_t count;
+	std::vector<BuildNode> nodes;
+};
+
+// Splits large ranges until there are enough subtrees to keep all threads busy.
+uint32_t BuildTopLevel(const BuildContext& context, std::vector<BuildNode>& nodes, std::vector<SubtreeTask>& tasks,
+	uint32_t first, uint32_t count, uint32_t depth, uint32_t maxDepth)
+{
+	uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+	nodes.emplace_back();
+	if (depth >= maxDepth || count < MinSubtreePrimitiveCount)
+	{
+		nodes[nodeIndex].subtreeIndex = static_cast<uint32_t>(tasks.size());
+		tasks.push_back(SubtreeTask{ first, count, {} });
+		return nodeIndex;
+	}
+
+	cd::AABB centroidBounds;
+	CalculateRangeBounds(context, first, count, nodes[nodeIndex].bounds, centroidBounds);
+	nodes[nodeIndex].first = first;
+	nodes[nodeIndex].count = count;
+
+	uint32_t splitAxis;
+	uint32_t split = SplitRange(context, first, count, nodes[nodeIndex].bounds, centroidBounds, splitAxis);
+	if (split == first + count)
+	{
+		return nodeIndex;
+	}
+
+	nodes[nodeIndex].splitAxis = splitAxis;
+	uint32_t leftChild = BuildTopLevel(context, nodes, tasks, first, split - first, depth + 1U, maxDepth);
+	uint32_t rightChild = BuildTopLevel(context, nodes, tasks, split, first + count - split, depth + 1U, maxDepth);
+	nodes[nodeIndex].leftChild = leftChild;
+	nodes[nodeIndex].rightChild = rightChild;
+	return nodeIndex;
+}
+
+void FlattenNodes(const std::vector<BuildNode>& buildNodes, uint32_t nodeIndex, const std::vector<SubtreeTask>& tasks, std::vector<cd::BVHNode>& nodes)
+{
+	const BuildNode& buildNode = buildNodes[nodeIndex];
+	if (buildNode.subtreeIndex != InvalidIndex)
+	{
+		FlattenNodes(tasks[buildNode.subtreeIndex].nodes, 0U, tasks, nodes);
+		return;
+	}
+
+	uint32_t flatIndex = static_cast<uint32_t>(nodes.size());
+	cd::BVHNode& node = nodes.emplace_back();
+	node.bounds = buildNode.bounds;
+	if (InvalidIndex == buildNode.leftChild)
+	{
+		node.offset = buildNode.first;
+		node.primitiveCount = static_cast<uint16_t>(buildNode.count);
+		node.splitAxis = 0U;
+		return;
+	}
+
+	node.primitiveCount = 0U;
+	node.splitAxis = static_cast<uint16_t>(buildNode.splitAxis);
+	FlattenNodes(buildNodes, buildNode.leftChild, tasks, nodes);
+	nodes[flatIndex].offset = static_cast<uint32_t>(nodes.size());
+	FlattenNodes(buildNodes, buildNode.rightChild, tasks, nodes);
+}
+
+bool IntersectTriangle(const cd::Ray& ray, const cd::Point& v0, const cd::Point& v1, const cd::Point& v2, float& t)
+{
+	// Moller-Trumbore. Both sides are hit.
+	cd::Direction edge1 = v1 - v0;
+	cd::Direction edge2 = v2 - v0;
+	cd::Direction p = ray.Direction().Cross(edge2);
+	float determinant = edge1.Dot(p);
+	if (std::abs(determinant) < FLT_MIN)
+	{
+		return false;
+	}
+
+	float inverseDeterminant = 1.0f / determinant;
+	cd::Direction s = ray.Origin() - v0;
+	float u = s.Dot(p) * inverseDeterminant;
+	if (u < 0.0f || u > 1.0f)
+	{
+		return false;
+	}
+
+	cd::Direction q = s.Cross(edge1);
+	float v = ray.Direction().Dot(q) * inverseDeterminant;
+	if (v < 0.0f || u + v > 1.0f)
+	{
+		return false;
+	}
+
+	t = edge2.Dot(q) * inverseDeterminant;
+	return t >= 0.0f;
+}
+
+}
+
+namespace cd
+{
+
+void BVHBuilder::Build(const std::vector<AABB>& primitiveBounds, const BVHBuildOptions& options,
+	std::vector<BVHNode>& nodes, std::vector<uint32_t>& primitiveIndexes)
+{
+	nodes.clear();
+	auto primitiveCount = static_cast<uint32_t>(primitiveBounds.size());
+	primitiveIndexes.resize(primitiveCount);
+	std::iota(primitiveIndexes.begin(), primitiveIndexes.end(), 0U);
+	if (0U == primitiveCount)
+	{
+		return;
+	}
+
+	std::vector<Point> centroids(primitiveCount);
+	ParallelFor((primitiveCount + BinningChunkSize - 1U) / BinningChunkSize, [&primitiveBounds, &centroids, primitiveCount](uint32_t chunkIndex)
+	{
+		uint32_t end = std::min(primitiveCount, (chunkIndex + 1U) * BinningChunkSize);
+		for (uint32_t primitiveIndex = chunkIndex * BinningChunkSize; primitiveIndex < end; ++primitiveIndex)
+		{
+			centroids[primitiveIndex] = primitiveBounds[primitiveIndex].Center();
+		}
+	}, options.maxThreadCount);
+
+	// Leaf size is stored in 16 bits.
+	BuildContext context{ primitiveBounds, centroids, primitiveIndexes,
+		std::clamp(options.binCount, 2U, 256U), std::clamp(options.maxLeafSize, 1U, static_cast<uint32_t>(UINT16_MAX)),
+		options.traversalCost, options.maxThreadCount };
+
+	// About 4 subtrees per thread balance uneven subtree sizes.
+	uint32_t threadCount = options.maxThreadCount > 0U ? std::min(options.maxThreadCount, GetParallelThreadCount()) : GetParallelThreadCount();
+	uint32_t maxTopLevelDepth = 1U == threadCount ? 0U : static_cast<uint32_t>(std::ceil(std::log2(static_cast<float>(threadCount)))) + 2U;
+
+	std::vector<BuildNode> topLevelNodes;
+	std::vector<SubtreeTask> tasks;
+	BuildTopLevel(context, topLevelNodes, tasks, 0U, primitiveCount, 0U, maxTopLevelDepth);
+
+	// Subtrees own disjoint ranges of primitive indexes.
+	BuildContext subtreeContext = context;
+	subtreeContext.maxThreadCount = 1U;
+	ParallelFor(static_cast<uint32_t>(tasks.size()), [&subtreeContext, &tasks](uint32_t taskIndex)
+	{
+		SubtreeTask& task = tasks[taskIndex];
+		BuildSubtree(subtreeContext, task.nodes, task.first, task.count);
+	}, options.maxThreadCount);
+
+	size_t nodeCount = topLevelNodes.size();
+	for (const SubtreeTask& task : tasks)
+	{
+		nodeCount += task.nodes.size();
+	}
+	nodes.reserve(nodeCount);
+	FlattenNodes(topLevelNodes, 0U, tasks, nodes);
+}
+
+void BVHBuilder::Build(Mesh& mesh, const BVHBuildOptions& options)
+{
+	uint32_t polygonCount = mesh.GetPolygonCount();
+	std::vector<AABB> polygonBounds(polygonCount, InvalidBounds());
+	for (uint32_t polygonIndex = 0U; polygonIndex < polygonCount; ++polygonIndex)
+	{
+		const Polygon& polygon = mesh.GetPolygon(polygonIndex);
+		for (uint32_t corner = 0U; corner < 3U; ++corner)
+		{
+			MergePoint(polygonBounds[polygonIndex], mesh.GetVertexPosition(polygon[corner].Data()));
+		}
+	}
+
+	Build(polygonBounds, options, mesh.GetBVHNodes(), mesh.GetBVHPolygonIndexes());
+}
+
+bool BVHBuilder::Raycast(const Mesh& mesh, const Ray& ray, uint32_t& hitPolygonIndex, float& hitDistance)
+{
+	const std::vector<BVHNode>& nodes = mesh.GetBVHNodes();
+	const std::vector<uint32_t>& polygonIndexes = mesh.GetBVHPolygonIndexes();
+	hitPolygonIndex = InvalidIndex;
+	hitDistance = FLT_MAX;
+	if (nodes.empty())
+	{
+		return false;
+	}
+
+	Point inverseDirection(1.0f / ray.Direction().x(), 1.0f / ray.Direction().y(), 1.0f / ray.Direction().z());
+	std::vector<uint32_t> nodeStack;
+	nodeStack.reserve(64U);
+	nodeStack.push_back(0U);
+	while (!nodeStack.empty())
+	{
+		uint32_t nodeIndex = nodeStack.back();
+		nodeStack.pop_back();
+
+		const BVHNode& node = nodes[nodeIndex];
+		float tmin;
+		float tmax;
+		if (!node.bounds.Intersects(ray.Origin(), inverseDirection, tmin, tmax) || tmin > hitDistance)
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			for (uint32_t index = node.offset; index < node.offset + node.primitiveCount; ++index)
+			{
+				const Polygon& polygon = mesh.GetPolygon(polygonIndexes[index]);
+				float t;
+				if (IntersectTriangle(ray, mesh.GetVertexPosition(polygon[0].Data()), mesh.GetVertexPosition(polygon[1].Data()),
+					mesh.GetVertexPosition(polygon[2].Data()), t) && t < hitDistance)
+				{
+					hitDistance = t;
+					hitPolygonIndex = polygonIndexes[index];
+				}
+			}
+			continue;
+		}
+
+		// Push the far child first so that the near child is visited first.
+		if (ray.Direction()[node.splitAxis] < 0.0f)
+		{
+			nodeStack.push_back(nodeIndex + 1U);
+			nodeStack.push_back(node.offset);
+		}
+		else
+		{
+			nodeStack.push_back(node.offset);
+			nodeStack.push_back(nodeIndex + 1U);
+		}
+	}
+
+	return hitPolygonIndex != InvalidIndex;
+}
+
+}
@@ -0,0 +1,686 @@
+#include "Math/LightmapUVGenerator.h"
+
+#include "Image/AtlasPacker.h"
+#include "Scene/Mesh.h"
+#include "Scene/VertexFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t InvalidIndex = UINT32_MAX;
+constexpr double Pi = 3.14159265358979323846;
+
+struct Double3
+{
+	double x;
+	double y;
+	double z;
+
+	Double3 operator+(const Double3& other) const { return Double3{ x + other.x, y + other.y, z + other.z }; }
+	Double3 operator-(const Double3& other) const { return Double3{ x - other.x, y - other.y, z - other.z }; }
+	Double3 operator*(double value) const { return Double3{ x * value, y * value, z * value }; }
+	double Dot(const Double3& other) const { return x * other.x + y * other.y + z * other.z; }
+	Double3 Cross(const Double3& other) const { return Double3{ y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x }; }
+	double Length() const { return std::sqrt(Dot(*this)); }
+};
+
+// Welds vertices by exact position so that UV seams of the source mesh don't split charts.
+struct PositionKey
+{
+	uint32_t bits[3];
+
+	bool operator==(const PositionKey& other) const { return 0 == std::memcmp(bits, other.bits, sizeof(bits)); }
+};
+
+struct PositionKeyHash
+{
+	size_t operator()(const PositionKey& key) const
+	{
+		uint64_t hash = 14695981039346656037ULL;
+		for (uint32_t value : key.bits)
+		{
+			hash = (hash ^ value) * 1099511628211ULL;
+		}
+		return static_cast<size_t>(hash);
+	}
+};
+
+PositionKey MakePositionKey(const cd::Point& position)
+{
+	PositionKey key;
+	for (uint32_t axis = 0U; axis < 3U; ++axis)
+	{
+		// Adding zero turns -0.0 into +0.0.
+		float value = position[axis] + 0.0f;
+		std::memcpy(&key.bits[axis], &value, sizeof(float));
+	}
+	return key;
+}
+
+uint64_t MakeEdgeKey(uint32_t vertexA, uint32_t vertexB)
+{
+	return (static_cast<uint64_t>(std::min(vertexA, vertexB)) << 32) | std::max(vertexA, vertexB);
+}
+
+struct EdgeUsage
+{
+	uint32_t polygonA = InvalidIndex;
+	uint32_t polygonB = InvalidIndex;
+	uint32_t count = 0U;
+};
+
+struct Chart
+{
+	Double3 normal;
+	double area = 0.0;
+	std::vector<uint32_t> polygonIndexes;
+
+	// Chart vertices are welded vertices. cornerLocalIndexes has 3 local indexes per polygon.
+	std::vector<uint32_t> weldedVertexIDs;
+	std::vector<uint32_t> cornerLocalIndexes;
+
+	// 2 values per local vertex in world units.
+	std::vector<double> uvs;
+	double minU = 0.0;
+	double minV = 0.0;
+	double maxU = 0.0;
+	double maxV = 0.0;
+};
+
+double CalculateSignedArea(const std::vector<double>& uvs, uint32_t localA, uint32_t localB, uint32_t localC)
+{
+	double abU = uvs[localB * 2U] - uvs[localA * 2U];
+	double abV = uvs[localB * 2U + 1U] - uvs[localA * 2U + 1U];
+	double acU = uvs[localC * 2U] - uvs[localA * 2U];
+	double acV = uvs[localC * 2U + 1U] - uvs[localA * 2U + 1U];
+	return 0.5 * (abU * acV - abV * acU);
+}
+
+// Returns the count of non-degenerate triangles which are flipped or collapsed in uv space.
+uint32_t CountFlippedTriangles(const Chart& chart, const std::vector<double>& uvs, const std::vector<double>& triangleAreas)
+{
+	uint32_t flippedCount = 0U;
+	for (size_t triangleIndex = 0U; triangleIndex < triangleAreas.size(); ++triangleIndex)
+	{
+		if (triangleAreas[triangleIndex] <= 0.0)
+		{
+			continue;
+		}
+
+		const uint32_t* pCorners = &chart.cornerLocalIndexes[triangleIndex * 3U];
+		if (CalculateSignedArea(uvs, pCorners[0], pCorners[1], pCorners[2]) <= 0.0)
+		{
+			++flippedCount;
+		}
+	}
+	return flippedCount;
+}
+
+// Least squares conformal maps. Every triangle contributes |sum(W_j * U_j)|^2 / (2 * area) in complex numbers
+// where W_j comes from the triangle in its own 2D frame and U_j = u_j + i * v_j.
+// Two pinned vertices remove the similarity freedom and the system is solved by matrix-free CGLS.
+void SolveConformalMap(const Chart& chart, const std::vector<Double3>& weldedPositions, std::vector<double>& uvs)
+{
+	size_t triangleCount = chart.polygonIndexes.size();
+	size_t localVertexCount = chart.weldedVertexIDs.size();
+
+	// 3 complex coefficients per triangle.
+	std::vector<double> coefficients(triangleCount * 6U, 0.0);
+	for (size_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const uint32_t* pCorners = &chart.cornerLocalIndexes[triangleIndex * 3U];
+		const Double3& p0 = weldedPositions[chart.weldedVertexIDs[pCorners[0]]];
+		const Double3& p1 = weldedPositions[chart.weldedVertexIDs[pCorners[1]]];
+		const Double3& p2 = weldedPositions[chart.weldedVertexIDs[pCorners[2]]];
+
+		Double3 edge1 = p1 - p0;
+		Double3 edge2 = p2 - p0;
+		double edge1Length = edge1.Length();
+		double doubleArea = edge1.Cross(edge2).Length();
+		if (edge1Length <= 0.0 || doubleArea <= 1e-20)
+		{
+			continue;
+		}
+
+		Double3 axisX = edge1 * (1.0 / edge1Length);
+		double x1 = edge1Length;
+		double x2 = edge2.Dot(axisX);
+		double y2 = doubleArea / edge1Length;
+
+		// Local coordinates are (0, 0), (x1, 0), (x2, y2) which is counter clockwise.
+		double weight = 1.0 / std::sqrt(doubleArea);
+		double* pCoefficients = &coefficients[triangleIndex * 6U];
+		pCoefficients[0] = (x2 - x1) * weight;
+		pCoefficients[1] = y2 * weight;
+		pCoefficients[2] = -x2 * weight;
+		pCoefficients[3] = -y2 * weight;
+		pCoefficients[4] = x1 * weight;
+		pCoefficients[5] = 0.0;
+	}
+
+	auto MultiplyA = [&](const std::vector<double>& x, std::vector<double>& result)
+	{
+		for (size_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+		{
+			const uint32_t* pCorners = &chart.cornerLocalIndexes[triangleIndex * 3U];
+			const double* pCoefficients = &coefficients[triangleIndex * 6U];
+			double real = 0.0;
+			double imaginary = 0.0;
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				double a = pCoefficients[corner * 2U];
+				double b = pCoefficients[corner * 2U + 1U];
+				double u = x[pCorners[corner] * 2U];
+				double v = x[pCorners[corner] * 2U + 1U];
+				real += a * u - b * v;
+				imaginary += a * v + b * u;
+			}
+			result[triangleIndex * 2U] = real;
+			result[triangleIndex * 2U + 1U] = imaginary;
+		}
+	};
+
+	auto MultiplyATranspose = [&](const std::vector<double>& r, std::vector<double>& result)
+	{
+		std::fill(result.begin(), result.end(), 0.0);
+		for (size_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+		{
+			const uint32_t* pCorners = &chart.cornerLocalIndexes[triangleIndex * 3U];
+			const double* pCoefficients = &coefficients[triangleIndex * 6U];
+			double real = r[triangleIndex * 2U];
+			double imaginary = r[triangleIndex * 2U + 1U];
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				double a = pCoefficients[corner * 2U];
+				double b = pCoefficients[corner * 2U + 1U];
+				result[pCorners[corner] * 2U] += a * real + b * imaginary;
+				result[pCorners[corner] * 2U + 1U] += a * imaginary - b * real;
+			}
+		}
+	};
+
+	// Pin two vertices which are far away from each other in the initial guess.
+	auto FindFarthestVertex = [&uvs, localVertexCount](uint32_t fromIndex)
+	{
+		uint32_t farthestIndex = fromIndex;
+		double farthestDistance = -1.0;
+		for (uint32_t localIndex = 0U; localIndex < localVertexCount; ++localIndex)
+		{
+			double du = uvs[localIndex * 2U] - uvs[fromIndex * 2U];
+			double dv = uvs[localIndex * 2U + 1U] - uvs[fromIndex * 2U + 1U];
+			double distance = du * du + dv * dv;
+			if (distance > farthestDistance)
+			{
+				farthestDistance = distance;
+				farthestIndex = localIndex;
+			}
+		}
+		return farthestIndex;
+	};
+	uint32_t pinA = FindFarthestVertex(0U);
+	uint32_t pinB = FindFarthestVertex(pinA);
+
+	std::vector<double> freeMask(localVertexCount * 2U, 1.0);
+	freeMask[pinA * 2U] = freeMask[pinA * 2U + 1U] = 0.0;
+	freeMask[pinB * 2U] = freeMask[pinB * 2U + 1U] = 0.0;
+
+	auto SquaredNorm = [](const std::vector<double>& values)
+	{
+		return std::inner_product(values.begin(), values.end(), values.begin(), 0.0);
+	};
+
+	std::vector<double> residual(triangleCount * 2U);
+	std::vector<double> gradient(localVertexCount * 2U);
+	std::vector<double> direction(localVertexCount * 2U);
+	std::vector<double> product(triangleCount * 2U);
+
+	MultiplyA(uvs, residual);
+	for (double& value : residual)
+	{
+		value = -value;
+	}
+	MultiplyATranspose(residual, gradient);
+	for (size_t index = 0U; index < gradient.size(); ++index)
+	{
+		gradient[index] *= freeMask[index];
+	}
+	direction = gradient;
+
+	double gamma = SquaredNorm(gradient);
+	double initialGamma = gamma;
+	uint32_t maxIterationCount = static_cast<uint32_t>(std::min<size_t>(std::max<size_t>(localVertexCount * 2U, 64U), 1000U));
+	for (uint32_t iteration = 0U; iteration < maxIterationCount && gamma > initialGamma * 1e-12 && gamma > 1e-30; ++iteration)
+	{
+		MultiplyA(direction, product);
+		double productNorm = SquaredNorm(product);
+		if (productNorm <= 0.0)
+		{
+			break;
+		}
+
+		double alpha = gamma / productNorm;
+		for (size_t index = 0U; index < uvs.size(); ++index)
+		{
+			uvs[index] += alpha * direction[index];
+		}
+		for (size_t index = 0U; index < residual.size(); ++index)
+		{
+			residual[index] -= alpha * product[index];
+		}
+
+		MultiplyATranspose(residual, gradient);
+		for (size_t index = 0U; index < gradient.size(); ++index)
+		{
+			gradient[index] *= freeMask[index];
+		}
+
+		double nextGamma = SquaredNorm(gradient);
+		double beta = nextGamma / gamma;
+		for (size_t index = 0U; index < direction.size(); ++index)
+		{
+			direction[index] = gradient[index] + beta * direction[index];
+		}
+		gamma = nextGamma;
+	}
+}
+
+void ParameterizeChart(Chart& chart, const cd::Mesh& mesh, const std::vector<uint32_t>& vertexWeldedIDs, const std::vector<Double3>& weldedPositions)
+{
+	std::unordered_map<uint32_t, uint32_t> weldedLocalIndexes;
+	chart.cornerLocalIndexes.reserve(chart.polygonIndexes.size() * 3U);
+	for (uint32_t polygonIndex : chart.polygonIndexes)
+	{
+		const cd::Polygon& polygon = mesh.GetPolygon(polygonIndex);
+		for (uint32_t corner = 0U; corner < 3U; ++corner)
+		{
+			uint32_t weldedID = vertexWeldedIDs[polygon[corner].Data()];
+			auto [itLocal, inserted] = weldedLocalIndexes.emplace(weldedID, static_cast<uint32_t>(chart.weldedVertexIDs.size()));
+			if (inserted)
+			{
+				chart.weldedVertexIDs.push_back(weldedID);
+			}
+			chart.cornerLocalIndexes.push_back(itLocal->second);
+		}
+	}
+
+	// Initial guess is the projection on the plane of the chart normal.
+	Double3 normal = chart.normal;
+	if (normal.Length() <= 0.0)
+	{
+		normal = Double3{ 0.0, 0.0, 1.0 };
+	}
+	Double3 helper = std::abs(normal.x) < 0.9 ? Double3{ 1.0, 0.0, 0.0 } : Double3{ 0.0, 1.0, 0.0 };
+	Double3 tangent = helper.Cross(normal);
+	tangent = tangent * (1.0 / tangent.Length());
+	Double3 biTangent = normal.Cross(tangent);
+
+	size_t localVertexCount = chart.weldedVertexIDs.size();
+	std::vector<double> planarUVs(localVertexCount * 2U);
+	for (size_t localIndex = 0U; localIndex < localVertexCount; ++localIndex)
+	{
+		const Double3& position = weldedPositions[chart.weldedVertexIDs[localIndex]];
+		planarUVs[localIndex * 2U] = position.Dot(tangent);
+		planarUVs[localIndex * 2U + 1U] = position.Dot(biTangent);
+	}
+
+	size_t triangleCount = chart.polygonIndexes.size();
+	std::vector<double> triangleAreas(triangleCount);
+	for (size_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const uint32_t* pCorners = &chart.cornerLocalIndexes[triangleIndex * 3U];
+		const Double3& p0 = weldedPositions[chart.weldedVertexIDs[pCorners[0]]];
+		triangleAreas[triangleIndex] = 0.5 * (weldedPositions[chart.weldedVertexIDs[pCorners[1]]] - p0).Cross(
+			weldedPositions[chart.weldedVertexIDs[pCorners[2]]] - p0).Length();
+		chart.area += triangleAreas[triangleIndex];
+	}
+
+	chart.uvs = planarUVs;
+	if (triangleCount > 1U && localVertexCount > 3U)
+	{
+		std::vector<double> conformalUVs = planarUVs;
+		SolveConformalMap(chart, weldedPositions, conformalUVs);
+
+		double signedArea = 0.0;
+		bool isFinite = true;
+		for (size_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+		{
+			const uint32_t* pCorners = &chart.cornerLocalIndexes[triangleIndex * 3U];
+			signedArea += CalculateSignedArea(conformalUVs, pCorners[0], pCorners[1], pCorners[2]);
+		}
+		for (double value : conformalUVs)
+		{
+			isFinite &= std::isfinite(value);
+		}
+
+		// Mirrored result keeps conformality so flip it back instead of rejecting it.
+		if (signedArea < 0.0)
+		{
+			for (size_t localIndex = 0U; localIndex < localVertexCount; ++localIndex)
+			{
+				conformalUVs[localIndex * 2U] = -conformalUVs[localIndex * 2U];
+			}
+		}
+
+		if (isFinite && signedArea != 0.0 &&
+			CountFlippedTriangles(chart, conformalUVs, triangleAreas) <= CountFlippedTriangles(chart, planarUVs, triangleAreas))
+		{
+			chart.uvs = cd::MoveTemp(conformalUVs);
+		}
+	}
+
+	// Scale to world units so that all charts share the same texel density.
+	double uvArea = 0.0;
+	for (size_t triangleIndex = 0U; triangleIndex < triangleCount; ++triangleIndex)
+	{
+		const uint32_t* pCorners = &chart.cornerLocalIndexes[triangleIndex * 3U];
+		uvArea += std::abs(CalculateSignedArea(chart.uvs, pCorners[0], pCorners[1], pCorners[2]));
+	}
+	if (uvArea > 0.0 && chart.area > 0.0)
+	{
+		double scale = std::sqrt(chart.area / uvArea);
+		for (double& value : chart.uvs)
+		{
+			value *= scale;
+		}
+	}
+
+	// Rotate the chart to the smallest bounding rectangle which wastes less space in packing.
+	double bestAngle = 0.0;
+	double bestRectArea = DBL_MAX;
+	constexpr uint32_t RotationStepCount = 16U;
+	for (uint32_t step = 0U; step < RotationStepCount; ++step)
+	{
+		double angle = 0.5 * Pi * step / RotationStepCount;
+		double cosAngle = std::cos(angle);
+		double sinAngle = std::sin(angle);
+		double minU = DBL_MAX;
+		double minV = DBL_MAX;
+		double maxU = -DBL_MAX;
+		double maxV = -DBL_MAX;
+		for (size_t localIndex = 0U; localIndex < localVertexCount; ++localIndex)
+		{
+			double u = chart.uvs[localIndex * 2U];
+			double v = chart.uvs[localIndex * 2U + 1U];
+			double rotatedU = u * cosAngle - v * sinAngle;
+			double rotatedV = u * sinAngle + v * cosAngle;
+			minU = std::min(minU, rotatedU);
+			maxU = std::max(maxU, rotatedU);
+			minV = std::min(minV, rotatedV);
+			maxV = std::max(maxV, rotatedV);
+		}
+
+		double rectArea = (maxU - minU) * (maxV - minV);
+		if (rectArea < bestRectArea)
+		{
+			bestRectArea = rectArea;
+			bestAngle = angle;
+		}
+	}
+
+	double cosAngle = std::cos(bestAngle);
+	double sinAngle = std::sin(bestAngle);
+	chart.minU = chart.minV = DBL_MAX;
+	chart.maxU = chart.maxV = -DBL_MAX;
+	for (size_t localIndex = 0U; localIndex < localVertexCount; ++localIndex)
+	{
+		double u = chart.uvs[localIndex * 2U];
+		double v = chart.uvs[localIndex * 2U + 1U];
+		chart.uvs[localIndex * 2U] = u * cosAngle - v * sinAngle;
+		chart.uvs[localIndex * 2U + 1U] = u * sinAngle + v * cosAngle;
+		chart.minU = std::min(chart.minU, chart.uvs[localIndex * 2U]);
+		chart.maxU = std::max(chart.maxU, chart.uvs[localIndex * 2U]);
+		chart.minV = std::min(chart.minV, chart.uvs[localIndex * 2U + 1U]);
+		chart.maxV = std::max(chart.maxV, chart.uvs[localIndex * 2U + 1U]);
+	}
+}
+
+}
+
+namespace cd
+{
+
+bool LightmapUVGenerator::Generate(Mesh& mesh, uint32_t uvSetIndex, const LightmapUVOptions& options)
+{
+	uint32_t vertexCount = mesh.GetVertexCount();
+	uint32_t polygonCount = mesh.GetPolygonCount();
+	if (0U == polygonCount || uvSetIndex >= cd::MaxUVSetCount || 0U == options.resolution)
+	{
+		return false;
+	}
+
+	std::vector<uint32_t> vertexWeldedIDs(vertexCount);
+	std::vector<Double3> weldedPositions;
+	{
+		std::unordered_map<PositionKey, uint32_t, PositionKeyHash> positionWeldedIDs;
+		positionWeldedIDs.reserve(vertexCount);
+		for (uint32_t vertexIndex = 0U; vertexIndex < vertexCount; ++vertexIndex)
+		{
+			const cd::Point& position = mesh.GetVertexPosition(vertexIndex);
+			auto [itWelded, inserted] = positionWeldedIDs.emplace(MakePositionKey(position), static_cast<uint32_t>(weldedPositions.size()));
+			if (inserted)
+			{
+				weldedPositions.push_back(Double3{ position.x(), position.y(), position.z() });
+			}
+			vertexWeldedIDs[vertexIndex] = itWelded->second;
+		}
+	}
+
+	std::vector<Double3> polygonNormals(polygonCount);
+	std::vector<double> polygonAreas(polygonCount);
+	std::unordered_map<uint64_t, EdgeUsage> edgeUsages;
+	edgeUsages.reserve(polygonCount * 3U);
+	for (uint32_t polygonIndex = 0U; polygonIndex < polygonCount; ++polygonIndex)
+	{
+		const cd::Polygon& polygon = mesh.GetPolygon(polygonIndex);
+		uint32_t weldedIDs[3] = { vertexWeldedIDs[polygon[0].Data()], vertexWeldedIDs[polygon[1].Data()], vertexWeldedIDs[polygon[2].Data()] };
+		Double3 cross = (weldedPositions[weldedIDs[1]] - weldedPositions[weldedIDs[0]]).Cross(weldedPositions[weldedIDs[2]] - weldedPositions[weldedIDs[0]]);
+		double crossLength = cross.Length();
+		polygonAreas[polygonIndex] = 0.5 * crossLength;
+		polygonNormals[polygonIndex] = crossLength > 0.0 ? cross * (1.0 / crossLength) : Double3{ 0.0, 0.0, 0.0 };
+
+		for (uint32_t corner = 0U; corner < 3U; ++corner)
+		{
+			uint32_t weldedA = weldedIDs[corner];
+			uint32_t weldedB = weldedIDs[(corner + 1U) % 3U];
+			if (weldedA == weldedB)
+			{
+				continue;
+			}
+
+			EdgeUsage& edgeUsage = edgeUsages[MakeEdgeKey(weldedA, weldedB)];
+			(0U == edgeUsage.count ? edgeUsage.polygonA : edgeUsage.polygonB) = polygonIndex;
+			++edgeUsage.count;
+		}
+	}
+
+	// Only manifold edges connect polygons in the same chart.
+	std::vector<std::array<uint32_t, 3>> polygonNeighbors(polygonCount, { InvalidIndex, InvalidIndex, InvalidIndex });
+	for (uint32_t polygonIndex = 0U; polygonIndex < polygonCount; ++polygonIndex)
+	{
+		const cd::Polygon& polygon = mesh.GetPolygon(polygonIndex);
+		for (uint32_t corner = 0U; corner < 3U; ++corner)
+		{
+			uint32_t weldedA = vertexWeldedIDs[polygon[corner].Data()];
+			uint32_t weldedB = vertexWeldedIDs[polygon[(corner + 1U) % 3U].Data()];
+			if (weldedA == weldedB)
+			{
+				continue;
+			}
+
+			const EdgeUsage& edgeUsage = edgeUsages[MakeEdgeKey(weldedA, weldedB)];
+			if (2U == edgeUsage.count)
+			{
+				polygonNeighbors[polygonIndex][corner] = edgeUsage.polygonA == polygonIndex ? edgeUsage.polygonB : edgeUsage.polygonA;
+			}
+		}
+	}
+
+	// Grow charts from the largest polygons. A polygon joins when it is inside the normal cone of both the seed and the chart.
+	double cosMaxAngle = std::cos(std::clamp(static_cast<double>(options.chartMaxAngle), 0.0, 89.0) * Pi / 180.0);
+	std::vector<uint32_t> seedPolygonIndexes(polygonCount);
+	std::iota(seedPolygonIndexes.begin(), seedPolygonIndexes.end(), 0U);
+	std::stable_sort(seedPolygonIndexes.begin(), seedPolygonIndexes.end(), [&polygonAreas](uint32_t lhs, uint32_t rhs)
+	{
+		return polygonAreas[lhs] > polygonAreas[rhs];
+	});
+
+	std::vector<uint32_t> polygonChartIDs(polygonCount, InvalidIndex);
+	std::vector<Chart> charts;
+	for (uint32_t seedPolygonIndex : seedPolygonIndexes)
+	{
+		if (polygonChartIDs[seedPolygonIndex] != InvalidIndex)
+		{
+			continue;
+		}
+
+		uint32_t chartID = static_cast<uint32_t>(charts.size());
+		Chart& chart = charts.emplace_back();
+		const Double3& seedNormal = polygonNormals[seedPolygonIndex];
+		Double3 normalSum = seedNormal * polygonAreas[seedPolygonIndex];
+		chart.normal = seedNormal;
+		chart.polygonIndexes.push_back(seedPolygonIndex);
+		polygonChartIDs[seedPolygonIndex] = chartID;
+
+		for (size_t queueIndex = 0U; queueIndex < chart.polygonIndexes.size(); ++queueIndex)
+		{
+			for (uint32_t neighborPolygonIndex : polygonNeighbors[chart.polygonIndexes[queueIndex]])
+			{
+				if (InvalidIndex == neighborPolygonIndex || polygonChartIDs[neighborPolygonIndex] != InvalidIndex)
+				{
+					continue;
+				}
+
+				const Double3& neighborNormal = polygonNormals[neighborPolygonIndex];
+				bool isDegenerate = polygonAreas[neighborPolygonIndex] <= 0.0;
+				if (!isDegenerate && (neighborNormal.Dot(seedNormal) < cosMaxAngle || neighborNormal.Dot(chart.normal) < cosMaxAngle))
+				{
+					continue;
+				}
+
+				polygonChartIDs[neighborPolygonIndex] = chartID;
+				chart.polygonIndexes.push_back(neighborPolygonIndex);
+				normalSum = normalSum + neighborNormal * polygonAreas[neighborPolygonIndex];
+				double normalSumLength = normalSum.Length();
+				if (normalSumLength > 0.0)
+				{
+					chart.normal = normalSum * (1.0 / normalSumLength);
+				}
+			}
+		}
+	}
+
+	double totalRectArea = 0.0;
+	for (Chart& chart : charts)
+	{
+		ParameterizeChart(chart, mesh, vertexWeldedIDs, weldedPositions);
+		totalRectArea += (chart.maxU - chart.minU) * (chart.maxV - chart.minV);
+	}
+
+	// Start from an optimistic texel density and shrink it until all charts fit into one page.
+	uint32_t chartCount = static_cast<uint32_t>(charts.size());
+	double pageArea = static_cast<double>(options.resolution) * options.resolution;
+	double texelsPerUnit = totalRectArea > 0.0 ? std::sqrt(pageArea * 0.9 / totalRectArea) : 0.0;
+	std::vector<AtlasItem> items(chartCount);
+	std::vector<AtlasPlacement> placements;
+	bool isPacked = false;
+	for (uint32_t attempt = 0U; attempt < 64U && !isPacked; ++attempt)
+	{
+		for (uint32_t chartIndex = 0U; chartIndex < chartCount; ++chartIndex)
+		{
+			const Chart& chart = charts[chartIndex];
+			items[chartIndex].width = std::max(static_cast<uint32_t>(std::ceil((chart.maxU - chart.minU) * texelsPerUnit)), 1U) + options.padding * 2U;
+			items[chartIndex].height = std::max(static_cast<uint32_t>(std::ceil((chart.maxV - chart.minV) * texelsPerUnit)), 1U) + options.padding * 2U;
+		}
+
+		isPacked = 1U == AtlasPacker::Pack(options.resolution, options.resolution, items, placements) &&
+			std::all_of(placements.begin(), placements.end(), [](const AtlasPlacement& placement) { return 0U == placement.page; });
+		if (!isPacked)
+		{
+			texelsPerUnit *= 0.9;
+		}
+	}
+
+	if (!isPacked)
+	{
+		return false;
+	}
+
+	// A vertex used by several charts is split. The first chart keeps the original vertex.
+	std::vector<uint32_t> newToOldVertexIndexes(vertexCount);
+	std::iota(newToOldVertexIndexes.begin(), newToOldVertexIndexes.end(), 0U);
+	std::vector<uint32_t> vertexChartIDs(vertexCount, InvalidIndex);
+	std::unordered_map<uint64_t, uint32_t> splitVertexIndexes;
+	std::vector<cd::UV> lightmapUVs(vertexCount, cd::UV(0.0f, 0.0f));
+	double inverseResolution = 1.0 / options.resolution;
+	for (uint32_t chartIndex = 0U; chartIndex < chartCount; ++chartIndex)
+	{
+		const Chart& chart = charts[chartIndex];
+		const AtlasPlacement& placement = placements[chartIndex];
+		double offsetU = placement.x + options.padding;
+		double offsetV = placement.y + options.padding;
+		for (size_t triangleIndex = 0U; triangleIndex < chart.polygonIndexes.size(); ++triangleIndex)
+		{
+			cd::Polygon& polygon = mesh.GetPolygon(chart.polygonIndexes[triangleIndex]);
+			for (uint32_t corner = 0U; corner < 3U; ++corner)
+			{
+				uint32_t oldVertexIndex = polygon[corner].Data();
+				uint32_t newVertexIndex = oldVertexIndex;
+				if (InvalidIndex == vertexChartIDs[oldVertexIndex])
+				{
+					vertexChartIDs[oldVertexIndex] = chartIndex;
+				}
+				else if (vertexChartIDs[oldVertexIndex] != chartIndex)
+				{
+					auto [itSplit, inserted] = splitVertexIndexes.emplace((static_cast<uint64_t>(oldVertexIndex) << 32) | chartIndex,
+						static_cast<uint32_t>(newToOldVertexIndexes.size()));
+					if (inserted)
+					{
+						newToOldVertexIndexes.push_back(oldVertexIndex);
+						lightmapUVs.emplace_back(0.0f, 0.0f);
+					}
+					newVertexIndex = itSplit->second;
+				}
+
+				uint32_t localIndex = chart.cornerLocalIndexes[triangleIndex * 3U + corner];
+				double u = (offsetU + (chart.uvs[localIndex * 2U] - chart.minU) * texelsPerUnit) * inverseResolution;
+				double v = (offsetV + (chart.uvs[localIndex * 2U + 1U] - chart.minV) * texelsPerUnit) * inverseResolution;
+				lightmapUVs[newVertexIndex] = cd::UV(static_cast<float>(u), static_cast<float>(v));
+				polygon[corner] = cd::VertexID(newVertexIndex);
+			}
+		}
+	}
+
+	if (newToOldVertexIndexes.size() != vertexCount)
+	{
+		mesh.RemapVertices(newToOldVertexIndexes);
+	}
+
+	if (uvSetIndex >= mesh.GetVertexUVSetCount())
+	{
+		uint32_t uvLayoutCount = static_cast<uint32_t>(std::count_if(mesh.GetVertexFormat().GetVertexLayout().begin(), mesh.GetVertexFormat().GetVertexLayout().end(),
+			[](const VertexAttributeLayout& layout) { return VertexAttributeType::UV == layout.vertexAttributeType; }));
+		for (uint32_t layoutIndex = uvLayoutCount; layoutIndex <= uvSetIndex; ++layoutIndex)
+		{
+			mesh.GetVertexFormat().AddAttributeLayout(VertexAttributeType::UV, GetAttributeValueType<UV::ValueType>(), UV::Size);
+		}
+		mesh.SetVertexUVSetCount(uvSetIndex + 1U);
+	}
+
+	for (uint32_t vertexIndex = 0U; vertexIndex < mesh.GetVertexCount(); ++vertexIndex)
+	{
+		mesh.SetVertexUV(uvSetIndex, vertexIndex, lightmapUVs[vertexIndex]);
+	}
+
+	return true;
+}
+
+}
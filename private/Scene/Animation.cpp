@@ -99,6 +99,51 @@ const std::vector<TrackID>& Animation::GetBoneTrackIDs() const
     return m_pAnimationImpl->GetBoneTrackIDs();
 }
 
+void Animation::SetAABB(AABB aabb)
+{
+    m_pAnimationImpl->SetAABB(MoveTemp(aabb));
+}
+
+AABB& Animation::GetAABB()
+{
+    return m_pAnimationImpl->GetAABB();
+}
+
+const AABB& Animation::GetAABB() const
+{
+    return m_pAnimationImpl->GetAABB();
+}
+
+void Animation::SetWindowAABBDuration(float duration)
+{
+    m_pAnimationImpl->SetWindowAABBDuration(duration);
+}
+
+float Animation::GetWindowAABBDuration() const
+{
+    return m_pAnimationImpl->GetWindowAABBDuration();
+}
+
+void Animation::SetWindowAABBs(std::vector<AABB> aabbs)
+{
+    m_pAnimationImpl->SetWindowAABBs(MoveTemp(aabbs));
+}
+
+uint32_t Animation::GetWindowAABBCount() const
+{
+    return m_pAnimationImpl->GetWindowAABBCount();
+}
+
+std::vector<AABB>& Animation::GetWindowAABBs()
+{
+    return m_pAnimationImpl->GetWindowAABBs();
+}
+
+const std::vector<AABB>& Animation::GetWindowAABBs() const
+{
+    return m_pAnimationImpl->GetWindowAABBs();
+}
+
 Animation& Animation::operator<<(InputArchive& inputArchive)
 {
     *m_pAnimationImpl << inputArchive;
@@ -3,6 +3,7 @@
 #include "Base/Template.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/Box.hpp"
 #include "Scene/KeyFrame.hpp"
 #include "Scene/ObjectID.h"
 #include "Scene/Track.h"
@@ -47,6 +48,17 @@ public:
 	std::vector<TrackID>& GetBoneTrackIDs() { return m_boneTrackIDs; }
 	const std::vector<TrackID>& GetBoneTrackIDs() const { return m_boneTrackIDs; }
 
+	void SetAABB(AABB aabb) { m_aabb = cd::MoveTemp(aabb); }
+	AABB& GetAABB() { return m_aabb; }
+	const AABB& GetAABB() const { return m_aabb; }
+
+	void SetWindowAABBDuration(float duration) { m_windowAABBDuration = duration; }
+	float GetWindowAABBDuration() const { return m_windowAABBDuration; }
+	void SetWindowAABBs(std::vector<AABB> aabbs) { m_windowAABBs = cd::MoveTemp(aabbs); }
+	uint32_t GetWindowAABBCount() const { return static_cast<uint32_t>(m_windowAABBs.size()); }
+	std::vector<AABB>& GetWindowAABBs() { return m_windowAABBs; }
+	const std::vector<AABB>& GetWindowAABBs() const { return m_windowAABBs; }
+
 	template<bool SwapBytesOrder>
 	AnimationImpl& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
 	{
@@ -60,19 +72,34 @@ public:
 
 		Init(AnimationID(animationID), cd::MoveTemp(animationName));
 		SetDuration(duration);
+		SetTicksPerSecond(ticksPerSecond);
 
 		m_boneTrackIDs.resize(boneTrackCount);
 		inputArchive.ImportBuffer(m_boneTrackIDs.data());
 
+		uint32_t windowAABBCount;
+		inputArchive >> GetAABB() >> m_windowAABBDuration >> windowAABBCount;
+		m_windowAABBs.resize(windowAABBCount);
+		for (AABB& windowAABB : m_windowAABBs)
+		{
+			inputArchive >> windowAABB;
+		}
+
 		return *this;
 	}
 
 	template<bool SwapBytesOrder>
 	const AnimationImpl& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
 	{
-		outputArchive << GetID().Data() << GetName() << GetDuration() << GetTicksPerSecnod();
+		outputArchive << GetID().Data() << GetName() << GetDuration() << GetTicksPerSecnod() << GetBoneTrackCount();
 		outputArchive.ExportBuffer(GetBoneTrackIDs().data(), GetBoneTrackIDs().size());
 
+		outputArchive << GetAABB() << GetWindowAABBDuration() << GetWindowAABBCount();
+		for (const AABB& windowAABB : GetWindowAABBs())
+		{
+			outputArchive << windowAABB;
+		}
+
 		return *this;
 	}
 
@@ -80,6 +107,9 @@ private:
 	AnimationID m_id;
 	float m_duration;
 	float m_ticksPerSecond;
+	AABB m_aabb = AABB::Empty();
+	float m_windowAABBDuration = 0.0f;
+	std::vector<AABB> m_windowAABBs;
 
 	std::string m_name;
 	std::vector<TrackID> m_boneTrackIDs;
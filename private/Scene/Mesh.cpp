@@ -151,6 +151,26 @@ const std::vector<Morph>& Mesh::GetMorphs() const
 	return m_pMeshImpl->GetMorphs();
 }
 
+std::vector<BVHNode>& Mesh::GetBVHNodes()
+{
+	return m_pMeshImpl->GetBVHNodes();
+}
+
+const std::vector<BVHNode>& Mesh::GetBVHNodes() const
+{
+	return m_pMeshImpl->GetBVHNodes();
+}
+
+std::vector<uint32_t>& Mesh::GetBVHPolygonIndexes()
+{
+	return m_pMeshImpl->GetBVHPolygonIndexes();
+}
+
+const std::vector<uint32_t>& Mesh::GetBVHPolygonIndexes() const
+{
+	return m_pMeshImpl->GetBVHPolygonIndexes();
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Vertex geometry data
 //////////////////////////////////////////////////////////////////////////
@@ -395,6 +415,51 @@ const VertexWeight& Mesh::GetVertexWeight(uint32_t boneIndex, uint32_t vertexInd
 	return m_pMeshImpl->GetVertexWeight(boneIndex, vertexIndex);
 }
 
+void Mesh::SetBonePalette(std::vector<BoneID> bonePalette)
+{
+	m_pMeshImpl->SetBonePalette(cd::MoveTemp(bonePalette));
+}
+
+std::vector<BoneID>& Mesh::GetBonePalette()
+{
+	return m_pMeshImpl->GetBonePalette();
+}
+
+const std::vector<BoneID>& Mesh::GetBonePalette() const
+{
+	return m_pMeshImpl->GetBonePalette();
+}
+
+void Mesh::SetPackedInfluenceCount(uint32_t influenceCount)
+{
+	m_pMeshImpl->SetPackedInfluenceCount(influenceCount);
+}
+
+uint32_t Mesh::GetPackedInfluenceCount() const
+{
+	return m_pMeshImpl->GetPackedInfluenceCount();
+}
+
+std::vector<uint8_t>& Mesh::GetPackedBoneIndexes()
+{
+	return m_pMeshImpl->GetPackedBoneIndexes();
+}
+
+const std::vector<uint8_t>& Mesh::GetPackedBoneIndexes() const
+{
+	return m_pMeshImpl->GetPackedBoneIndexes();
+}
+
+std::vector<uint16_t>& Mesh::GetPackedBoneWeights()
+{
+	return m_pMeshImpl->GetPackedBoneWeights();
+}
+
+const std::vector<uint16_t>& Mesh::GetPackedBoneWeights() const
+{
+	return m_pMeshImpl->GetPackedBoneWeights();
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Vertex connectivity data
 //////////////////////////////////////////////////////////////////////////
@@ -529,6 +594,11 @@ void Mesh::RemovePolygonData(PolygonID p)
 	m_pMeshImpl->RemovePolygonData(p);
 }
 
+void Mesh::RemapVertices(const std::vector<uint32_t>& newToOldVertexIndexes)
+{
+	m_pMeshImpl->RemapVertices(newToOldVertexIndexes);
+}
+
 Mesh& Mesh::operator<<(InputArchive& inputArchive)
 {
 	*m_pMeshImpl << inputArchive;
@@ -1,5 +1,6 @@
 #include "MeshImpl.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace
@@ -13,6 +14,41 @@ void SwapArrayElement(std::vector<T>& data, uint32_t v0, uint32_t v1)
 	data[v1] = cd::MoveTemp(temp);
 };
 
+template<typename T>
+void GatherArrayElements(std::vector<T>& data, const std::vector<uint32_t>& sourceIndexes)
+{
+	if (data.empty())
+	{
+		return;
+	}
+
+	std::vector<T> gatheredData;
+	gatheredData.reserve(sourceIndexes.size());
+	for (uint32_t sourceIndex : sourceIndexes)
+	{
+		gatheredData.push_back(data[sourceIndex]);
+	}
+	data = cd::MoveTemp(gatheredData);
+};
+
+// Every element index refers to a group of stride elements.
+template<typename T>
+void GatherArrayElements(std::vector<T>& data, const std::vector<uint32_t>& sourceIndexes, uint32_t stride)
+{
+	if (data.empty())
+	{
+		return;
+	}
+
+	std::vector<T> gatheredData;
+	gatheredData.reserve(sourceIndexes.size() * stride);
+	for (uint32_t sourceIndex : sourceIndexes)
+	{
+		gatheredData.insert(gatheredData.end(), data.begin() + sourceIndex * stride, data.begin() + (sourceIndex + 1U) * stride);
+	}
+	data = cd::MoveTemp(gatheredData);
+};
+
 template<typename T>
 void RemoveArrayElement(std::vector<T>& data, uint32_t v0)
 {
@@ -399,4 +435,92 @@ void MeshImpl::Unify()
 	}
 }
 
-}
\ No newline at end of file
+void MeshImpl::RemapVertices(const std::vector<uint32_t>& newToOldVertexIndexes)
+{
+	uint32_t oldVertexCount = m_vertexCount;
+	GatherArrayElements(m_vertexPositions, newToOldVertexIndexes);
+	GatherArrayElements(m_vertexNormals, newToOldVertexIndexes);
+	GatherArrayElements(m_vertexTangents, newToOldVertexIndexes);
+	GatherArrayElements(m_vertexBiTangents, newToOldVertexIndexes);
+
+	for (uint32_t uvSetIndex = 0U; uvSetIndex < m_vertexUVSetCount; ++uvSetIndex)
+	{
+		GatherArrayElements(m_vertexUVSets[uvSetIndex], newToOldVertexIndexes);
+	}
+
+	for (uint32_t colorSetIndex = 0U; colorSetIndex < m_vertexColorSetCount; ++colorSetIndex)
+	{
+		GatherArrayElements(m_vertexColorSets[colorSetIndex], newToOldVertexIndexes);
+	}
+
+	for (uint32_t influenceIndex = 0U; influenceIndex < m_vertexInfluenceCount; ++influenceIndex)
+	{
+		GatherArrayElements(m_vertexBoneIDs[influenceIndex], newToOldVertexIndexes);
+		GatherArrayElements(m_vertexWeights[influenceIndex], newToOldVertexIndexes);
+	}
+
+	GatherArrayElements(m_packedBoneIndexes, newToOldVertexIndexes, m_packedInfluenceCount);
+	GatherArrayElements(m_packedBoneWeights, newToOldVertexIndexes, m_packedInfluenceCount);
+
+	m_vertexAdjacentVertexArrays.clear();
+	m_vertexAdjacentPolygonArrays.clear();
+	m_vertexCount = static_cast<uint32_t>(newToOldVertexIndexes.size());
+
+	if (m_morphTargets.empty())
+	{
+		return;
+	}
+
+	// Every old vertex maps to all new vertices copied from it.
+	std::vector<uint32_t> oldVertexNewVertexOffsets(oldVertexCount + 1U, 0U);
+	for (uint32_t oldVertexIndex : newToOldVertexIndexes)
+	{
+		++oldVertexNewVertexOffsets[oldVertexIndex + 1U];
+	}
+
+	for (uint32_t oldVertexIndex = 0U; oldVertexIndex < oldVertexCount; ++oldVertexIndex)
+	{
+		oldVertexNewVertexOffsets[oldVertexIndex + 1U] += oldVertexNewVertexOffsets[oldVertexIndex];
+	}
+
+	std::vector<uint32_t> oldVertexNewVertexIndexes(newToOldVertexIndexes.size());
+	std::vector<uint32_t> oldVertexNewVertexCounts(oldVertexCount, 0U);
+	for (uint32_t newVertexIndex = 0U; newVertexIndex < newToOldVertexIndexes.size(); ++newVertexIndex)
+	{
+		uint32_t oldVertexIndex = newToOldVertexIndexes[newVertexIndex];
+		oldVertexNewVertexIndexes[oldVertexNewVertexOffsets[oldVertexIndex] + oldVertexNewVertexCounts[oldVertexIndex]++] = newVertexIndex;
+	}
+
+	for (Morph& morph : m_morphTargets)
+	{
+		std::vector<uint32_t> morphSourceIndexes;
+		std::vector<uint32_t> morphNewSourceIDs;
+		for (uint32_t morphVertexIndex = 0U; morphVertexIndex < morph.GetVertexCount(); ++morphVertexIndex)
+		{
+			uint32_t oldVertexIndex = morph.GetVertexSourceID(morphVertexIndex).Data();
+			if (oldVertexIndex >= oldVertexCount)
+			{
+				continue;
+			}
+
+			for (uint32_t offset = oldVertexNewVertexOffsets[oldVertexIndex]; offset < oldVertexNewVertexOffsets[oldVertexIndex + 1U]; ++offset)
+			{
+				morphSourceIndexes.push_back(morphVertexIndex);
+				morphNewSourceIDs.push_back(oldVertexNewVertexIndexes[offset]);
+			}
+		}
+
+		// Channels which were dropped by compression stay empty.
+		morph.GatherVertices(morphSourceIndexes);
+		for (uint32_t morphVertexIndex = 0U; morphVertexIndex < morphNewSourceIDs.size(); ++morphVertexIndex)
+		{
+			morph.SetVertexSourceID(morphVertexIndex, morphNewSourceIDs[morphVertexIndex]);
+		}
+	}
+
+	// Morphs whose vertices are all removed can't be loaded.
+	m_morphTargets.erase(std::remove_if(m_morphTargets.begin(), m_morphTargets.end(), [](const Morph& morph) { return 0U == morph.GetVertexCount(); }),
+		m_morphTargets.end());
+}
+
+}
@@ -3,6 +3,7 @@
 #include "Base/Template.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/BVHBuilder.h"
 #include "Math/Box.hpp"
 #include "Scene/Morph.h"
 #include "Scene/VertexFormat.h"
@@ -64,6 +65,11 @@ public:
 	std::vector<Morph>& GetMorphs() { return m_morphTargets; }
 	const std::vector<Morph>& GetMorphs() const { return m_morphTargets; }
 
+	std::vector<BVHNode>& GetBVHNodes() { return m_bvhNodes; }
+	const std::vector<BVHNode>& GetBVHNodes() const { return m_bvhNodes; }
+	std::vector<uint32_t>& GetBVHPolygonIndexes() { return m_bvhPolygonIndexes; }
+	const std::vector<uint32_t>& GetBVHPolygonIndexes() const { return m_bvhPolygonIndexes; }
+
 	void SetVertexPosition(uint32_t vertexIndex, const Point& position);
 	Point& GetVertexPosition(uint32_t vertexIndex) { return m_vertexPositions[vertexIndex]; }
 	const Point& GetVertexPosition(uint32_t vertexIndex) const { return m_vertexPositions[vertexIndex]; }
@@ -117,6 +123,16 @@ public:
 	std::vector<VertexWeight>& GetVertexWeights(uint32_t boneIndex) { return m_vertexWeights[boneIndex]; }
 	const std::vector<VertexWeight>& GetVertexWeights(uint32_t boneIndex) const { return m_vertexWeights[boneIndex]; }
 
+	void SetBonePalette(std::vector<BoneID> bonePalette) { m_bonePalette = MoveTemp(bonePalette); }
+	std::vector<BoneID>& GetBonePalette() { return m_bonePalette; }
+	const std::vector<BoneID>& GetBonePalette() const { return m_bonePalette; }
+	void SetPackedInfluenceCount(uint32_t influenceCount) { m_packedInfluenceCount = influenceCount; }
+	uint32_t GetPackedInfluenceCount() const { return m_packedInfluenceCount; }
+	std::vector<uint8_t>& GetPackedBoneIndexes() { return m_packedBoneIndexes; }
+	const std::vector<uint8_t>& GetPackedBoneIndexes() const { return m_packedBoneIndexes; }
+	std::vector<uint16_t>& GetPackedBoneWeights() { return m_packedBoneWeights; }
+	const std::vector<uint16_t>& GetPackedBoneWeights() const { return m_packedBoneWeights; }
+
 	uint32_t GetVertexAdjacentVertexCount(uint32_t vertexIndex) const { return static_cast<uint32_t>(m_vertexAdjacentVertexArrays[vertexIndex].size()); }
 	void AddVertexAdjacentVertexID(uint32_t vertexIndex, VertexID vertexID);
 	VertexIDArray& GetVertexAdjacentVertexArray(uint32_t vertexIndex) { return m_vertexAdjacentVertexArrays[vertexIndex]; }
@@ -150,6 +166,10 @@ public:
 	// After unify, all IDs cached by users should clean up.
 	void Unify();
 
+	// Rebuilds vertex data so that new vertex i copies old vertex newToOldVertexIndexes[i], which can split or reorder vertices.
+	// Morph targets follow their source vertices. Polygons are not remapped and connectivity data is cleared.
+	void RemapVertices(const std::vector<uint32_t>& newToOldVertexIndexes);
+
 	template<bool SwapBytesOrder>
 	MeshImpl& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
 	{
@@ -199,6 +219,23 @@ public:
 
 		inputArchive.ImportBuffer(GetPolygons().data());
 
+		uint32_t bvhNodeCount;
+		uint32_t bvhPolygonIndexCount;
+		inputArchive >> bvhNodeCount >> bvhPolygonIndexCount;
+		m_bvhNodes.resize(bvhNodeCount);
+		inputArchive.ImportBuffer(m_bvhNodes.data());
+		m_bvhPolygonIndexes.resize(bvhPolygonIndexCount);
+		inputArchive.ImportBuffer(m_bvhPolygonIndexes.data());
+
+		uint32_t bonePaletteSize;
+		inputArchive >> bonePaletteSize >> m_packedInfluenceCount;
+		m_bonePalette.resize(bonePaletteSize);
+		inputArchive.ImportBuffer(m_bonePalette.data());
+		m_packedBoneIndexes.resize(m_packedInfluenceCount * GetVertexCount());
+		inputArchive.ImportBuffer(m_packedBoneIndexes.data());
+		m_packedBoneWeights.resize(m_packedInfluenceCount * GetVertexCount());
+		inputArchive.ImportBuffer(m_packedBoneWeights.data());
+
 		return *this;
 	}
 
@@ -236,6 +273,15 @@ public:
 
 		outputArchive.ExportBuffer(GetPolygons().data(), GetPolygons().size());
 
+		outputArchive << static_cast<uint32_t>(m_bvhNodes.size()) << static_cast<uint32_t>(m_bvhPolygonIndexes.size());
+		outputArchive.ExportBuffer(m_bvhNodes.data(), m_bvhNodes.size());
+		outputArchive.ExportBuffer(m_bvhPolygonIndexes.data(), m_bvhPolygonIndexes.size());
+
+		outputArchive << static_cast<uint32_t>(m_bonePalette.size()) << m_packedInfluenceCount;
+		outputArchive.ExportBuffer(m_bonePalette.data(), m_bonePalette.size());
+		outputArchive.ExportBuffer(m_packedBoneIndexes.data(), m_packedBoneIndexes.size());
+		outputArchive.ExportBuffer(m_packedBoneWeights.data(), m_packedBoneWeights.size());
+
 		return *this;
 	}
 
@@ -254,6 +300,10 @@ private:
 	// morph targets
 	std::vector<Morph>			m_morphTargets;
 
+	// polygon BVH which is built by BVHBuilder
+	std::vector<BVHNode>		m_bvhNodes;
+	std::vector<uint32_t>		m_bvhPolygonIndexes;
+
 	// vertex geometry data
 	// TODO : Remove m_vertexFormat.
 	// We can generate VertexFormat immediately based on current vertex data types.
@@ -271,6 +321,12 @@ private:
 	std::vector<BoneID>			m_vertexBoneIDs[MaxBoneInfluenceCount];
 	std::vector<VertexWeight>	m_vertexWeights[MaxBoneInfluenceCount];
 
+	// packed skin data which is built by SkinningOptimizer
+	std::vector<BoneID>			m_bonePalette;
+	uint32_t					m_packedInfluenceCount = 0U;
+	std::vector<uint8_t>		m_packedBoneIndexes;
+	std::vector<uint16_t>		m_packedBoneWeights;
+
 	// vertex connectivity data
 	// For geometry processing algorithms, it is common to query connectivity data.
 	std::vector<VertexIDArray>	m_vertexAdjacentVertexArrays;
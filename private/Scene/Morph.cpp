@@ -204,6 +204,26 @@ const std::vector<Direction>& Morph::GetVertexBiTangents() const
 	return m_pMorphImpl->GetVertexBiTangents();
 }
 
+void Morph::GatherVertices(const std::vector<uint32_t>& vertexIndexes)
+{
+	m_pMorphImpl->GatherVertices(vertexIndexes);
+}
+
+uint32_t Morph::RemoveUnchangedVertices(float threshold)
+{
+	return m_pMorphImpl->RemoveUnchangedVertices(threshold);
+}
+
+void Morph::Quantize()
+{
+	m_pMorphImpl->Quantize();
+}
+
+bool Morph::IsQuantized() const
+{
+	return m_pMorphImpl->IsQuantized();
+}
+
 Morph& Morph::operator<<(InputArchive& inputArchive)
 {
 	*m_pMorphImpl << inputArchive;
@@ -1,6 +1,8 @@
 #include "MorphImpl.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 namespace cd
 {
@@ -68,4 +70,128 @@ void MorphImpl::SetVertexBiTangent(uint32_t vertexIndex, const Direction& biTang
 	m_vertexBiTangents[vertexIndex] = biTangent;
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+// Compression
+////////////////////////////////////////////////////////////////////////////////////
+
+void MorphImpl::GatherVertices(const std::vector<uint32_t>& vertexIndexes)
+{
+	auto GatherChannel = [&vertexIndexes](auto& data)
+	{
+		if (data.empty())
+		{
+			return;
+		}
+
+		std::remove_reference_t<decltype(data)> gatheredData;
+		gatheredData.reserve(vertexIndexes.size());
+		for (uint32_t vertexIndex : vertexIndexes)
+		{
+			gatheredData.push_back(data[vertexIndex]);
+		}
+		data = MoveTemp(gatheredData);
+	};
+
+	GatherChannel(m_vertexSourceIDs);
+	GatherChannel(m_vertexPositions);
+	GatherChannel(m_vertexNormals);
+	GatherChannel(m_vertexTangents);
+	GatherChannel(m_vertexBiTangents);
+	m_vertexCount = static_cast<uint32_t>(vertexIndexes.size());
+}
+
+uint32_t MorphImpl::RemoveUnchangedVertices(float threshold)
+{
+	auto IsChanged = [threshold](const std::vector<Vec3f>& deltas, uint32_t vertexIndex)
+	{
+		if (deltas.empty())
+		{
+			return false;
+		}
+
+		const Vec3f& delta = deltas[vertexIndex];
+		return std::abs(delta.x()) > threshold || std::abs(delta.y()) > threshold || std::abs(delta.z()) > threshold;
+	};
+
+	bool isNormalChanged = false;
+	bool isTangentChanged = false;
+	bool isBiTangentChanged = false;
+	std::vector<uint32_t> keptVertexIndexes;
+	for (uint32_t vertexIndex = 0U; vertexIndex < m_vertexCount; ++vertexIndex)
+	{
+		bool isNormalChangedAtVertex = IsChanged(m_vertexNormals, vertexIndex);
+		bool isTangentChangedAtVertex = IsChanged(m_vertexTangents, vertexIndex);
+		bool isBiTangentChangedAtVertex = IsChanged(m_vertexBiTangents, vertexIndex);
+		if (IsChanged(m_vertexPositions, vertexIndex) || isNormalChangedAtVertex || isTangentChangedAtVertex || isBiTangentChangedAtVertex)
+		{
+			keptVertexIndexes.push_back(vertexIndex);
+		}
+
+		isNormalChanged |= isNormalChangedAtVertex;
+		isTangentChanged |= isTangentChangedAtVertex;
+		isBiTangentChanged |= isBiTangentChangedAtVertex;
+	}
+
+	if (!isNormalChanged)
+	{
+		m_vertexNormals.clear();
+	}
+	if (!isTangentChanged)
+	{
+		m_vertexTangents.clear();
+	}
+	if (!isBiTangentChanged)
+	{
+		m_vertexBiTangents.clear();
+	}
+
+	uint32_t removedVertexCount = m_vertexCount - static_cast<uint32_t>(keptVertexIndexes.size());
+	GatherVertices(keptVertexIndexes);
+	return removedVertexCount;
+}
+
+void MorphImpl::Quantize()
+{
+	// Snap deltas so that what is serialized is the same as what is in memory.
+	for (std::vector<Vec3f>* pDeltas : { &m_vertexPositions, &m_vertexNormals, &m_vertexTangents, &m_vertexBiTangents })
+	{
+		std::vector<int16_t> codes;
+		float scale = EncodeDeltas(*pDeltas, codes);
+		DecodeDeltas(scale, codes, *pDeltas);
+	}
+
+	m_isQuantized = true;
+}
+
+float MorphImpl::EncodeDeltas(const std::vector<Vec3f>& deltas, std::vector<int16_t>& codes)
+{
+	float scale = 0.0f;
+	for (const Vec3f& delta : deltas)
+	{
+		scale = std::max({ scale, std::abs(delta.x()), std::abs(delta.y()), std::abs(delta.z()) });
+	}
+
+	codes.resize(deltas.size() * 3U);
+	float inverseScale = scale > 0.0f ? 32767.0f / scale : 0.0f;
+	for (size_t deltaIndex = 0U; deltaIndex < deltas.size(); ++deltaIndex)
+	{
+		for (uint32_t componentIndex = 0U; componentIndex < 3U; ++componentIndex)
+		{
+			codes[deltaIndex * 3U + componentIndex] = static_cast<int16_t>(std::round(deltas[deltaIndex][componentIndex] * inverseScale));
+		}
+	}
+
+	return scale;
+}
+
+void MorphImpl::DecodeDeltas(float scale, const std::vector<int16_t>& codes, std::vector<Vec3f>& deltas)
+{
+	float codeScale = scale / 32767.0f;
+	deltas.resize(codes.size() / 3U);
+	for (size_t deltaIndex = 0U; deltaIndex < deltas.size(); ++deltaIndex)
+	{
+		deltas[deltaIndex] = Vec3f(codes[deltaIndex * 3U] * codeScale, codes[deltaIndex * 3U + 1U] * codeScale, codes[deltaIndex * 3U + 2U] * codeScale);
+	}
+}
+
 }
\ No newline at end of file
@@ -72,19 +72,34 @@ public:
 	std::vector<Direction>& GetVertexBiTangents() { return m_vertexBiTangents; }
 	const std::vector<Direction>& GetVertexBiTangents() const { return m_vertexBiTangents; }
 
+	void GatherVertices(const std::vector<uint32_t>& vertexIndexes);
+
+	// Returns the number of removed vertices. Normal, tangent and bitangent deltas are dropped when no vertex changes them.
+	uint32_t RemoveUnchangedVertices(float threshold);
+
+	void Quantize();
+	bool IsQuantized() const { return m_isQuantized; }
+
 	template<bool SwapBytesOrder>
 	MorphImpl& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
 	{
 		std::string name;
 		uint32_t id;
+		float weight;
 		uint32_t vertexCount;
-		inputArchive >> name >> id >> vertexCount;
+		bool isQuantized;
+		uint8_t channelMask;
+		inputArchive >> name >> id >> weight >> vertexCount >> isQuantized >> channelMask;
 
 		Init(MorphID(id), MoveTemp(name), vertexCount);
-		inputArchive.ImportBuffer(GetVertexPositions().data());
-		inputArchive.ImportBuffer(GetVertexNormals().data());
-		inputArchive.ImportBuffer(GetVertexTangents().data());
-		inputArchive.ImportBuffer(GetVertexBiTangents().data());
+		SetWeight(weight);
+		m_isQuantized = isQuantized;
+		inputArchive.ImportBuffer(GetVertexSourceIDs().data());
+
+		ImportDeltas(inputArchive, GetVertexPositions());
+		ImportDeltas(inputArchive, GetVertexNormals(), channelMask & NormalChannel);
+		ImportDeltas(inputArchive, GetVertexTangents(), channelMask & TangentChannel);
+		ImportDeltas(inputArchive, GetVertexBiTangents(), channelMask & BiTangentChannel);
 
 		return *this;
 	}
@@ -92,19 +107,75 @@ public:
 	template<bool SwapBytesOrder>
 	const MorphImpl& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
 	{
-		outputArchive << GetName() << GetID().Data() << GetVertexCount();
-		outputArchive.ExportBuffer(GetVertexPositions().data(), GetVertexPositions().size());
-		outputArchive.ExportBuffer(GetVertexNormals().data(), GetVertexNormals().size());
-		outputArchive.ExportBuffer(GetVertexTangents().data(), GetVertexTangents().size());
-		outputArchive.ExportBuffer(GetVertexBiTangents().data(), GetVertexBiTangents().size());
+		uint8_t channelMask = (GetVertexNormals().empty() ? 0U : NormalChannel) |
+			(GetVertexTangents().empty() ? 0U : TangentChannel) |
+			(GetVertexBiTangents().empty() ? 0U : BiTangentChannel);
+		outputArchive << GetName() << GetID().Data() << GetWeight() << GetVertexCount() << IsQuantized() << channelMask;
+		outputArchive.ExportBuffer(GetVertexSourceIDs().data(), GetVertexSourceIDs().size());
+
+		ExportDeltas(outputArchive, GetVertexPositions());
+		ExportDeltas(outputArchive, GetVertexNormals());
+		ExportDeltas(outputArchive, GetVertexTangents());
+		ExportDeltas(outputArchive, GetVertexBiTangents());
 
 		return *this;
 	}
 
+private:
+	static constexpr uint8_t NormalChannel = 1U << 0;
+	static constexpr uint8_t TangentChannel = 1U << 1;
+	static constexpr uint8_t BiTangentChannel = 1U << 2;
+
+	// Quantized deltas are 16 bits signed codes of components divided by the max absolute component of the channel.
+	static float EncodeDeltas(const std::vector<Vec3f>& deltas, std::vector<int16_t>& codes);
+	static void DecodeDeltas(float scale, const std::vector<int16_t>& codes, std::vector<Vec3f>& deltas);
+
+	template<bool SwapBytesOrder>
+	void ImportDeltas(TInputArchive<SwapBytesOrder>& inputArchive, std::vector<Vec3f>& deltas, bool hasChannel = true) const
+	{
+		if (!hasChannel)
+		{
+			deltas.clear();
+			return;
+		}
+
+		if (!IsQuantized())
+		{
+			inputArchive.ImportBuffer(deltas.data());
+			return;
+		}
+
+		float scale;
+		std::vector<int16_t> codes(deltas.size() * 3U);
+		inputArchive >> scale;
+		inputArchive.ImportBuffer(codes.data());
+		DecodeDeltas(scale, codes, deltas);
+	}
+
+	template<bool SwapBytesOrder>
+	void ExportDeltas(TOutputArchive<SwapBytesOrder>& outputArchive, const std::vector<Vec3f>& deltas) const
+	{
+		if (deltas.empty())
+		{
+			return;
+		}
+
+		if (!IsQuantized())
+		{
+			outputArchive.ExportBuffer(deltas.data(), deltas.size());
+			return;
+		}
+
+		std::vector<int16_t> codes;
+		outputArchive << EncodeDeltas(deltas, codes);
+		outputArchive.ExportBuffer(codes.data(), codes.size());
+	}
+
 private:
 	std::string					m_name;
 	MorphID						m_id;
-	float						m_weight;
+	float						m_weight = 0.0f;
+	bool						m_isQuantized = false;
 
 	uint32_t					m_vertexCount;
 	std::vector<VertexID>		m_vertexSourceIDs;
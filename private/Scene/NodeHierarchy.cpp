@@ -0,0 +1,236 @@
+#include "Scene/NodeHierarchy.h"
+
+#include "Math/SIMD.hpp"
+#include "Scene/Node.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+
+constexpr uint32_t LaneCount = 4U;
+
+enum TransformComponent : uint32_t
+{
+	TranslationX = 0U,
+	TranslationY,
+	TranslationZ,
+	RotationX,
+	RotationY,
+	RotationZ,
+	RotationW,
+	ScaleX,
+	ScaleY,
+	ScaleZ,
+};
+
+}
+
+namespace cd
+{
+
+NodeHierarchy::NodeHierarchy(const std::vector<Node>& nodes)
+{
+	Init(nodes);
+}
+
+void NodeHierarchy::Init(const std::vector<Node>& nodes)
+{
+	auto nodeCount = static_cast<uint32_t>(nodes.size());
+
+	uint32_t nodeIDCount = 0U;
+	for (const Node& node : nodes)
+	{
+		nodeIDCount = std::max(nodeIDCount, node.GetID().Data() + 1U);
+	}
+
+	std::vector<uint32_t> nodeIDToSourceIndexes(nodeIDCount, InvalidIndex);
+	for (uint32_t sourceIndex = 0U; sourceIndex < nodeCount; ++sourceIndex)
+	{
+		nodeIDToSourceIndexes[nodes[sourceIndex].GetID().Data()] = sourceIndex;
+	}
+
+	auto GetSourceParentIndex = [&nodes, &nodeIDToSourceIndexes](uint32_t sourceIndex)
+	{
+		const NodeID& parentID = nodes[sourceIndex].GetParentID();
+		return parentID.IsValid() && parentID.Data() < nodeIDToSourceIndexes.size() ? nodeIDToSourceIndexes[parentID.Data()] : InvalidIndex;
+	};
+
+	// Depths are calculated by walking up to the first node whose depth is known.
+	std::vector<uint32_t> depths(nodeCount, InvalidIndex);
+	std::vector<uint32_t> chain;
+	for (uint32_t sourceIndex = 0U; sourceIndex < nodeCount; ++sourceIndex)
+	{
+		chain.clear();
+		uint32_t currentIndex = sourceIndex;
+		while (currentIndex != InvalidIndex && InvalidIndex == depths[currentIndex] && chain.size() <= nodeCount)
+		{
+			chain.push_back(currentIndex);
+			currentIndex = GetSourceParentIndex(currentIndex);
+		}
+
+		uint32_t depth = currentIndex != InvalidIndex && depths[currentIndex] != InvalidIndex ? depths[currentIndex] + 1U : 0U;
+		for (auto itChain = chain.rbegin(); itChain != chain.rend(); ++itChain)
+		{
+			if (InvalidIndex == depths[*itChain])
+			{
+				depths[*itChain] = depth++;
+			}
+		}
+	}
+
+	std::vector<uint32_t> sortedSourceIndexes(nodeCount);
+	std::iota(sortedSourceIndexes.begin(), sortedSourceIndexes.end(), 0U);
+	std::stable_sort(sortedSourceIndexes.begin(), sortedSourceIndexes.end(), [&depths](uint32_t lhs, uint32_t rhs) { return depths[lhs] < depths[rhs]; });
+
+	// Padding lanes are identity transforms so that they don't produce NaNs.
+	uint32_t paddedNodeCount = (nodeCount + LaneCount - 1U) / LaneCount * LaneCount;
+	const Transform identity = Transform::Identity();
+	for (uint32_t componentIndex = 0U; componentIndex < TransformComponentCount; ++componentIndex)
+	{
+		m_localTransforms[componentIndex].assign(paddedNodeCount, *(identity.Begin() + componentIndex));
+	}
+
+	m_nodeIDs.resize(nodeCount);
+	m_parentIndexes.resize(nodeCount);
+	for (uint32_t nodeIndex = 0U; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		const Node& node = nodes[sortedSourceIndexes[nodeIndex]];
+		m_nodeIDs[nodeIndex] = node.GetID().Data();
+		SetLocalTransform(nodeIndex, node.GetTransform());
+	}
+	BuildNodeIDToIndexes();
+
+	for (uint32_t nodeIndex = 0U; nodeIndex < nodeCount; ++nodeIndex)
+	{
+		uint32_t sourceParentIndex = GetSourceParentIndex(sortedSourceIndexes[nodeIndex]);
+		uint32_t parentIndex = InvalidIndex != sourceParentIndex ? m_nodeIDToIndexes[nodes[sourceParentIndex].GetID().Data()] : InvalidIndex;
+		m_parentIndexes[nodeIndex] = parentIndex < nodeIndex ? parentIndex : InvalidIndex;
+	}
+
+	UpdateWorldMatrices();
+}
+
+void NodeHierarchy::Clear()
+{
+	m_nodeIDs.clear();
+	m_parentIndexes.clear();
+	m_nodeIDToIndexes.clear();
+	for (std::vector<float>& components : m_localTransforms)
+	{
+		components.clear();
+	}
+	m_worldMatrices.clear();
+}
+
+void NodeHierarchy::BuildNodeIDToIndexes()
+{
+	uint32_t nodeIDCount = 0U;
+	for (uint32_t nodeID : m_nodeIDs)
+	{
+		nodeIDCount = std::max(nodeIDCount, nodeID + 1U);
+	}
+
+	m_nodeIDToIndexes.assign(nodeIDCount, InvalidIndex);
+	for (uint32_t nodeIndex = 0U; nodeIndex < GetNodeCount(); ++nodeIndex)
+	{
+		m_nodeIDToIndexes[m_nodeIDs[nodeIndex]] = nodeIndex;
+	}
+}
+
+Transform NodeHierarchy::GetLocalTransform(uint32_t nodeIndex) const
+{
+	Transform transform;
+	for (uint32_t componentIndex = 0U; componentIndex < TransformComponentCount; ++componentIndex)
+	{
+		*(transform.Begin() + componentIndex) = m_localTransforms[componentIndex][nodeIndex];
+	}
+
+	return transform;
+}
+
+void NodeHierarchy::SetLocalTransform(uint32_t nodeIndex, const Transform& transform)
+{
+	for (uint32_t componentIndex = 0U; componentIndex < TransformComponentCount; ++componentIndex)
+	{
+		m_localTransforms[componentIndex][nodeIndex] = *(transform.Begin() + componentIndex);
+	}
+}
+
+void NodeHierarchy::UpdateWorldMatrices()
+{
+	uint32_t nodeCount = GetNodeCount();
+	m_worldMatrices.resize(nodeCount);
+
+	Float4 one = Float4::Splat(1.0f);
+	for (uint32_t firstNodeIndex = 0U; firstNodeIndex < nodeCount; firstNodeIndex += LaneCount)
+	{
+		Float4 components[TransformComponentCount];
+		for (uint32_t componentIndex = 0U; componentIndex < TransformComponentCount; ++componentIndex)
+		{
+			components[componentIndex] = Float4::Load(&m_localTransforms[componentIndex][firstNodeIndex]);
+		}
+
+		// The same formula as Quaternion::ToMatrix3x3 for 4 nodes.
+		Float4 tx = components[RotationX] + components[RotationX];
+		Float4 ty = components[RotationY] + components[RotationY];
+		Float4 tz = components[RotationZ] + components[RotationZ];
+		Float4 twx = tx * components[RotationW];
+		Float4 twy = ty * components[RotationW];
+		Float4 twz = tz * components[RotationW];
+		Float4 txx = tx * components[RotationX];
+		Float4 txy = ty * components[RotationX];
+		Float4 txz = tz * components[RotationX];
+		Float4 tyy = ty * components[RotationY];
+		Float4 tyz = tz * components[RotationY];
+		Float4 tzz = tz * components[RotationZ];
+
+		// Rows of the upper 3x4 part of local matrices. Element [row * 4 + column] of lane i belongs to node firstNodeIndex + i.
+		alignas(16) float localElements[12][LaneCount];
+		((one - (tyy + tzz)) * components[ScaleX]).Store(localElements[0 * 4 + 0]);
+		((txy + twz) * components[ScaleY]).Store(localElements[0 * 4 + 1]);
+		((txz - twy) * components[ScaleZ]).Store(localElements[0 * 4 + 2]);
+		components[TranslationX].Store(localElements[0 * 4 + 3]);
+		((txy - twz) * components[ScaleX]).Store(localElements[1 * 4 + 0]);
+		((one - (txx + tzz)) * components[ScaleY]).Store(localElements[1 * 4 + 1]);
+		((tyz + twx) * components[ScaleZ]).Store(localElements[1 * 4 + 2]);
+		components[TranslationY].Store(localElements[1 * 4 + 3]);
+		((txz + twy) * components[ScaleX]).Store(localElements[2 * 4 + 0]);
+		((tyz - twx) * components[ScaleY]).Store(localElements[2 * 4 + 1]);
+		((one - (txx + tyy)) * components[ScaleZ]).Store(localElements[2 * 4 + 2]);
+		components[TranslationZ].Store(localElements[2 * 4 + 3]);
+
+		// Lanes are solved in order so a parent in the same group is always ready before its children.
+		uint32_t laneCount = std::min(LaneCount, nodeCount - firstNodeIndex);
+		for (uint32_t lane = 0U; lane < laneCount; ++lane)
+		{
+			uint32_t nodeIndex = firstNodeIndex + lane;
+			Matrix4x4& worldMatrix = m_worldMatrices[nodeIndex];
+			uint32_t parentIndex = m_parentIndexes[nodeIndex];
+			if (InvalidIndex == parentIndex)
+			{
+				for (int columnIndex = 0; columnIndex < 4; ++columnIndex)
+				{
+					worldMatrix.GetColumn(columnIndex) = Vec4f(localElements[columnIndex][lane], localElements[4 + columnIndex][lane],
+						localElements[8 + columnIndex][lane], 3 == columnIndex ? 1.0f : 0.0f);
+				}
+				continue;
+			}
+
+			// Column major parent * local. The last row of local matrices is (0, 0, 0, 1).
+			const float* pParent = m_worldMatrices[parentIndex].Begin();
+			Float4 parentColumns[4] = { Float4::Load(pParent), Float4::Load(pParent + 4), Float4::Load(pParent + 8), Float4::Load(pParent + 12) };
+			for (int columnIndex = 0; columnIndex < 4; ++columnIndex)
+			{
+				Float4 column = 3 == columnIndex ? parentColumns[3] : Float4::Zero();
+				column = Float4::MultiplyAdd(parentColumns[0], Float4::Splat(localElements[columnIndex][lane]), column);
+				column = Float4::MultiplyAdd(parentColumns[1], Float4::Splat(localElements[4 + columnIndex][lane]), column);
+				column = Float4::MultiplyAdd(parentColumns[2], Float4::Splat(localElements[8 + columnIndex][lane]), column);
+				column.Store(worldMatrix.Begin() + columnIndex * 4);
+			}
+		}
+	}
+}
+
+}
@@ -124,6 +124,16 @@ uint32_t SceneDatabase::GetNodeCount() const
 	return m_pSceneDatabaseImpl->GetNodeCount();
 }
 
+NodeHierarchy& SceneDatabase::GetNodeHierarchy()
+{
+	return m_pSceneDatabaseImpl->GetNodeHierarchy();
+}
+
+const NodeHierarchy& SceneDatabase::GetNodeHierarchy() const
+{
+	return m_pSceneDatabaseImpl->GetNodeHierarchy();
+}
+
 ///////////////////////////////////////////////////////////////////
 // Mesh
 ///////////////////////////////////////////////////////////////////
@@ -157,6 +167,26 @@ uint32_t SceneDatabase::GetMeshCount() const
 	return m_pSceneDatabaseImpl->GetMeshCount();
 }
 
+std::vector<BVHNode>& SceneDatabase::GetMeshBVHNodes()
+{
+	return m_pSceneDatabaseImpl->GetMeshBVHNodes();
+}
+
+const std::vector<BVHNode>& SceneDatabase::GetMeshBVHNodes() const
+{
+	return m_pSceneDatabaseImpl->GetMeshBVHNodes();
+}
+
+std::vector<uint32_t>& SceneDatabase::GetMeshBVHMeshIndexes()
+{
+	return m_pSceneDatabaseImpl->GetMeshBVHMeshIndexes();
+}
+
+const std::vector<uint32_t>& SceneDatabase::GetMeshBVHMeshIndexes() const
+{
+	return m_pSceneDatabaseImpl->GetMeshBVHMeshIndexes();
+}
+
 ///////////////////////////////////////////////////////////////////
 // Morph
 ///////////////////////////////////////////////////////////////////
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Base/Template.h"
+#include "Math/BVHBuilder.h"
 #include "Math/Box.hpp"
 #include "Math/UnitSystem.hpp"
 #include "Scene/Animation.h"
@@ -11,6 +12,7 @@
 #include "Scene/Mesh.h"
 #include "Scene/Morph.h"
 #include "Scene/Node.h"
+#include "Scene/NodeHierarchy.h"
 #include "Scene/Texture.h"
 #include "Scene/Track.h"
 
@@ -60,6 +62,8 @@ public:
 	const Node& GetNode(uint32_t index) const { return m_nodes[index]; }
 	const Node* GetNodeByName(const char* pName) const;
 	uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_nodes.size()); }
+	NodeHierarchy& GetNodeHierarchy() { return m_nodeHierarchy; }
+	const NodeHierarchy& GetNodeHierarchy() const { return m_nodeHierarchy; }
 
 	// Mesh
 	void AddMesh(Mesh mesh) { m_meshes.emplace_back(MoveTemp(mesh)); }
@@ -68,6 +72,10 @@ public:
 	void SetMeshCount(uint32_t count) { m_meshes.reserve(count); }
 	const Mesh& GetMesh(uint32_t index) const { return m_meshes[index];  }
 	uint32_t GetMeshCount() const { return static_cast<uint32_t>(m_meshes.size()); }
+	std::vector<BVHNode>& GetMeshBVHNodes() { return m_meshBVHNodes; }
+	const std::vector<BVHNode>& GetMeshBVHNodes() const { return m_meshBVHNodes; }
+	std::vector<uint32_t>& GetMeshBVHMeshIndexes() { return m_meshBVHMeshIndexes; }
+	const std::vector<uint32_t>& GetMeshBVHMeshIndexes() const { return m_meshBVHMeshIndexes; }
 
 	// Morph
 	void AddMorph(Morph morph) { m_morphs.emplace_back(MoveTemp(morph)); }
@@ -234,6 +242,16 @@ public:
 			AddTrack(Track(inputArchive));
 		}
 
+		uint32_t meshBVHNodeCount;
+		uint32_t meshBVHMeshIndexCount;
+		inputArchive >> meshBVHNodeCount >> meshBVHMeshIndexCount;
+		m_meshBVHNodes.resize(meshBVHNodeCount);
+		inputArchive.ImportBuffer(m_meshBVHNodes.data());
+		m_meshBVHMeshIndexes.resize(meshBVHMeshIndexCount);
+		inputArchive.ImportBuffer(m_meshBVHMeshIndexes.data());
+
+		m_nodeHierarchy << inputArchive;
+
 		return *this;
 	}
 
@@ -306,6 +324,12 @@ public:
 			track >> outputArchive;
 		}
 
+		outputArchive << static_cast<uint32_t>(m_meshBVHNodes.size()) << static_cast<uint32_t>(m_meshBVHMeshIndexes.size());
+		outputArchive.ExportBuffer(m_meshBVHNodes.data(), m_meshBVHNodes.size());
+		outputArchive.ExportBuffer(m_meshBVHMeshIndexes.data(), m_meshBVHMeshIndexes.size());
+
+		m_nodeHierarchy >> outputArchive;
+
 		return *this;
 	}
 
@@ -317,11 +341,16 @@ private:
 
 	// Hierarchy data to present relationships between meshes.
 	std::vector<Node> m_nodes;
+	NodeHierarchy m_nodeHierarchy;
 
 	// Mesh data both for StatciMesh and SkinMesh.
 	std::vector<Mesh> m_meshes;
 	std::vector<Morph> m_morphs;
 
+	// BVH over mesh AABBs for scene queries.
+	std::vector<BVHNode> m_meshBVHNodes;
+	std::vector<uint32_t> m_meshBVHMeshIndexes;
+
 	// Texturing data.
 	std::vector<Material> m_materials;
 	std::vector<Texture> m_textures;
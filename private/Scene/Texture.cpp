@@ -39,6 +39,11 @@ Texture::~Texture()
     }
 }
 
+void Texture::SetID(TextureID id)
+{
+    m_pTextureImpl->SetID(id);
+}
+
 TextureID Texture::GetID() const
 {
     return m_pTextureImpl->GetID();
@@ -84,6 +89,26 @@ void Texture::SetVMapMode(cd::TextureMapMode mapMode)
     m_pTextureImpl->SetVMapMode(mapMode);
 }
 
+const cd::Vec2f& Texture::GetUVOffset() const
+{
+    return m_pTextureImpl->GetUVOffset();
+}
+
+void Texture::SetUVOffset(cd::Vec2f uvOffset)
+{
+    m_pTextureImpl->SetUVOffset(cd::MoveTemp(uvOffset));
+}
+
+const cd::Vec2f& Texture::GetUVScale() const
+{
+    return m_pTextureImpl->GetUVScale();
+}
+
+void Texture::SetUVScale(cd::Vec2f uvScale)
+{
+    m_pTextureImpl->SetUVScale(cd::MoveTemp(uvScale));
+}
+
 cd::TextureFormat Texture::GetFormat() const
 {
     return m_pTextureImpl->GetFormat();
@@ -154,6 +179,16 @@ void Texture::SetRawData(std::vector<std::byte> rawData)
     m_pTextureImpl->SetRawData(cd::MoveTemp(rawData));
 }
 
+const std::shared_ptr<const std::vector<std::byte>>& Texture::GetSharedRawData() const
+{
+    return m_pTextureImpl->GetSharedRawData();
+}
+
+void Texture::SetRawData(std::shared_ptr<const std::vector<std::byte>> pRawData)
+{
+    m_pTextureImpl->SetRawData(cd::MoveTemp(pRawData));
+}
+
 void Texture::ClearRawData()
 {
     m_pTextureImpl->ClearRawData();
@@ -164,6 +199,31 @@ bool Texture::ExistRawData() const
     return m_pTextureImpl->ExistRawData();
 }
 
+cd::TextureRawDataType Texture::GetRawDataType() const
+{
+    return m_pTextureImpl->GetRawDataType();
+}
+
+void Texture::SetRawDataType(cd::TextureRawDataType type)
+{
+    m_pTextureImpl->SetRawDataType(type);
+}
+
+uint32_t Texture::GetMipCount() const
+{
+    return m_pTextureImpl->GetMipCount();
+}
+
+const std::vector<uint64_t>& Texture::GetMipOffsets() const
+{
+    return m_pTextureImpl->GetMipOffsets();
+}
+
+void Texture::SetMipOffsets(std::vector<uint64_t> mipOffsets)
+{
+    m_pTextureImpl->SetMipOffsets(cd::MoveTemp(mipOffsets));
+}
+
 Texture& Texture::operator<<(InputArchive& inputArchive)
 {
     *m_pTextureImpl << inputArchive;
@@ -8,10 +8,18 @@ TextureImpl::TextureImpl(TextureID textureID, const char* pName, MaterialTexture
 	Init(textureID, pName, textureType);
 }
 
+const std::vector<std::byte>& TextureImpl::GetRawData() const
+{
+	static const std::vector<std::byte> emptyRawData;
+	return m_pRawData ? *m_pRawData : emptyRawData;
+}
+
 void TextureImpl::ClearRawData()
 {
 	m_format = TextureFormat::Count;
-	m_rawData.clear();
+	m_pRawData.reset();
+	m_mipOffsets.clear();
+	m_rawDataType = TextureRawDataType::Pixels;
 	m_width = 0;
 	m_height = 0;
 	m_depth = 0;
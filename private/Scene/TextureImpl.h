@@ -7,6 +7,7 @@
 #include "Scene/ObjectID.h"
 #include "Scene/TextureFormat.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -31,6 +32,7 @@ public:
 
 	void Init(TextureID textureID, std::string name, MaterialTextureType textureType);
 
+	void SetID(TextureID id) { m_id = id; }
 	TextureID GetID() const { return m_id; }
 
 	const std::string& GetName() const { return m_name; }
@@ -80,10 +82,21 @@ public:
 	uint32_t& GetDepth() { return m_depth; }
 	void SetDepth(uint32_t depth) { m_depth = depth; }
 
-	const std::vector<std::byte>& GetRawData() const { return m_rawData; }
-	void SetRawData(std::vector<std::byte> rawData) { m_rawData = cd::MoveTemp(rawData); }
+	// Raw data is immutable after setting so textures referencing the same file can share one buffer.
+	const std::vector<std::byte>& GetRawData() const;
+	const std::shared_ptr<const std::vector<std::byte>>& GetSharedRawData() const { return m_pRawData; }
+	void SetRawData(std::vector<std::byte> rawData) { m_pRawData = std::make_shared<const std::vector<std::byte>>(cd::MoveTemp(rawData)); }
+	void SetRawData(std::shared_ptr<const std::vector<std::byte>> pRawData) { m_pRawData = cd::MoveTemp(pRawData); }
 	void ClearRawData();
-	bool ExistRawData() const { return !m_rawData.empty(); }
+	bool ExistRawData() const { return m_pRawData && !m_pRawData->empty(); }
+
+	cd::TextureRawDataType GetRawDataType() const { return m_rawDataType; }
+	void SetRawDataType(cd::TextureRawDataType type) { m_rawDataType = type; }
+
+	// Mip levels are stored contiguously in raw data. Empty offsets means only one level.
+	uint32_t GetMipCount() const { return m_mipOffsets.empty() ? 1U : static_cast<uint32_t>(m_mipOffsets.size()); }
+	const std::vector<uint64_t>& GetMipOffsets() const { return m_mipOffsets; }
+	void SetMipOffsets(std::vector<uint64_t> mipOffsets) { m_mipOffsets = cd::MoveTemp(mipOffsets); }
 
 	// Serialization
 	template<bool SwapBytesOrder>
@@ -109,8 +122,18 @@ public:
 
 		size_t rawDataSize;
 		inputArchive >> GetPath() >> GetWidth() >> GetHeight() >> GetDepth() >> rawDataSize;
-		m_rawData.resize(rawDataSize);
-		inputArchive.ImportBuffer(m_rawData.data());
+		std::vector<std::byte> rawData(rawDataSize);
+		inputArchive.ImportBuffer(rawData.data());
+		SetRawData(cd::MoveTemp(rawData));
+
+		uint32_t mipOffsetCount;
+		inputArchive >> mipOffsetCount;
+		m_mipOffsets.resize(mipOffsetCount);
+		inputArchive.ImportBuffer(m_mipOffsets.data());
+
+		uint8_t rawDataType;
+		inputArchive >> rawDataType;
+		SetRawDataType(static_cast<cd::TextureRawDataType>(rawDataType));
 
 		return *this;
 	}
@@ -122,8 +145,13 @@ public:
 			static_cast<uint8_t>(GetUMapMode()) << static_cast<uint8_t>(GetVMapMode()) << GetUVOffset() << GetUVScale() <<
 			static_cast<uint32_t>(m_format) << UseMipMap();
 
-		outputArchive << GetPath() << GetWidth() << GetHeight() << GetDepth() << m_rawData.size();
-		outputArchive.ExportBuffer(m_rawData.data(), m_rawData.size());
+		const std::vector<std::byte>& rawData = GetRawData();
+		outputArchive << GetPath() << GetWidth() << GetHeight() << GetDepth() << rawData.size();
+		outputArchive.ExportBuffer(rawData.data(), rawData.size());
+
+		outputArchive << static_cast<uint32_t>(m_mipOffsets.size());
+		outputArchive.ExportBuffer(m_mipOffsets.data(), m_mipOffsets.size());
+		outputArchive << static_cast<uint8_t>(GetRawDataType());
 
 		return *this;
 	}
@@ -150,7 +178,9 @@ private:
 	uint32_t m_width;
 	uint32_t m_height;
 	uint32_t m_depth;
-	std::vector<std::byte> m_rawData;
+	std::shared_ptr<const std::vector<std::byte>> m_pRawData;
+	std::vector<uint64_t> m_mipOffsets;
+	cd::TextureRawDataType m_rawDataType;
 };
 
 }
\ No newline at end of file
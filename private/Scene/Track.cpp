@@ -134,6 +134,31 @@ const std::vector<ScaleKey>& Track::GetScaleKeys() const
     return m_pTrackImpl->GetScaleKeys();
 }
 
+void Track::SetQuantized(bool quantized)
+{
+    m_pTrackImpl->SetQuantized(quantized);
+}
+
+bool Track::IsQuantized() const
+{
+    return m_pTrackImpl->IsQuantized();
+}
+
+void Track::SetKeyInterval(float keyInterval)
+{
+    m_pTrackImpl->SetKeyInterval(keyInterval);
+}
+
+float Track::GetKeyInterval() const
+{
+    return m_pTrackImpl->GetKeyInterval();
+}
+
+bool Track::IsUniform() const
+{
+    return m_pTrackImpl->IsUniform();
+}
+
 Track& Track::operator<<(InputArchive& inputArchive)
 {
     *m_pTrackImpl << inputArchive;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Animation/KeyFrameQuantizer.hpp"
 #include "Base/Template.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
@@ -53,6 +54,14 @@ public:
 	std::vector<ScaleKey>& GetScaleKeys() { return m_scaleKeys; }
 	const std::vector<ScaleKey>& GetScaleKeys() const { return m_scaleKeys; }
 
+	void SetQuantized(bool quantized) { m_isQuantized = quantized; }
+	bool IsQuantized() const { return m_isQuantized; }
+
+	void SetKeyInterval(float keyInterval) { m_keyInterval = keyInterval; }
+	float GetKeyInterval() const { return m_keyInterval; }
+	bool IsUniform() const { return m_keyInterval > 0.0f; }
+	float GetUniformKeyTime(uint32_t keyIndex) const { return static_cast<float>(keyIndex) * m_keyInterval; }
+
 	template<bool SwapBytesOrder>
 	TrackImpl& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
 	{
@@ -61,20 +70,19 @@ public:
 		uint32_t translationKeyCount;
 		uint32_t rotationKeyCount;
 		uint32_t scaleKeyCount;
+		bool isQuantized;
+		float keyInterval;
 
 		inputArchive >> trackID >> trackName
-			>> translationKeyCount >> rotationKeyCount >> scaleKeyCount;
+			>> translationKeyCount >> rotationKeyCount >> scaleKeyCount >> isQuantized >> keyInterval;
 
 		Init(TrackID(trackID), cd::MoveTemp(trackName));
+		SetQuantized(isQuantized);
+		SetKeyInterval(keyInterval);
 
-		SetTranslationKeyCount(translationKeyCount);
-		inputArchive.ImportBuffer(GetTranslationKeys().data());
-
-		SetRotationKeyCount(rotationKeyCount);
-		inputArchive.ImportBuffer(GetRotationKeys().data());
-
-		SetScaleKeyCount(scaleKeyCount);
-		inputArchive.ImportBuffer(GetScaleKeys().data());
+		ImportKeys(inputArchive, translationKeyCount, GetTranslationKeys());
+		ImportKeys(inputArchive, rotationKeyCount, GetRotationKeys());
+		ImportKeys(inputArchive, scaleKeyCount, GetScaleKeys());
 
 		return *this;
 	}
@@ -83,15 +91,92 @@ public:
 	const TrackImpl& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
 	{
 		outputArchive << GetID().Data() << GetName()
-			<< GetTranslationKeyCount() << GetRotationKeyCount() << GetScaleKeyCount();
+			<< GetTranslationKeyCount() << GetRotationKeyCount() << GetScaleKeyCount() << IsQuantized() << GetKeyInterval();
 
-		outputArchive.ExportBuffer(GetTranslationKeys().data(), GetTranslationKeys().size());
-		outputArchive.ExportBuffer(GetRotationKeys().data(), GetRotationKeys().size());
-		outputArchive.ExportBuffer(GetScaleKeys().data(), GetScaleKeys().size());
+		ExportKeys(outputArchive, GetTranslationKeys());
+		ExportKeys(outputArchive, GetRotationKeys());
+		ExportKeys(outputArchive, GetScaleKeys());
 
 		return *this;
 	}
 
+private:
+	// Quantized keys are stored as 16 bits codes and decoded to float keys after loading.
+	// Times of uniform tracks are implicit so only values are stored.
+	template<bool SwapBytesOrder, typename KeyFrameValue, KeyFrameType KeyType>
+	void ImportKeys(TInputArchive<SwapBytesOrder>& inputArchive, uint32_t keyCount, std::vector<KeyFrame<KeyFrameValue, KeyType>>& keys) const
+	{
+		if (IsQuantized())
+		{
+			QuantizedKeyFrames quantizedKeys;
+			inputArchive >> quantizedKeys.startTime >> quantizedKeys.timeRange >> quantizedKeys.valueMin >> quantizedKeys.valueRange;
+
+			quantizedKeys.timeCodes.resize(keyCount);
+			if (!IsUniform())
+			{
+				inputArchive.ImportBuffer(quantizedKeys.timeCodes.data());
+			}
+
+			quantizedKeys.valueCodes.resize(keyCount * 3U);
+			inputArchive.ImportBuffer(quantizedKeys.valueCodes.data());
+
+			KeyFrameQuantizer::Decode(quantizedKeys, keys);
+		}
+		else if (IsUniform())
+		{
+			std::vector<KeyFrameValue> values(keyCount);
+			inputArchive.ImportBuffer(values.data());
+
+			keys.resize(keyCount);
+			for (uint32_t keyIndex = 0U; keyIndex < keyCount; ++keyIndex)
+			{
+				keys[keyIndex].SetValue(cd::MoveTemp(values[keyIndex]));
+			}
+		}
+		else
+		{
+			keys.resize(keyCount);
+			inputArchive.ImportBuffer(keys.data());
+		}
+
+		if (IsUniform())
+		{
+			for (uint32_t keyIndex = 0U; keyIndex < keyCount; ++keyIndex)
+			{
+				keys[keyIndex].SetTime(GetUniformKeyTime(keyIndex));
+			}
+		}
+	}
+
+	template<bool SwapBytesOrder, typename KeyFrameValue, KeyFrameType KeyType>
+	void ExportKeys(TOutputArchive<SwapBytesOrder>& outputArchive, const std::vector<KeyFrame<KeyFrameValue, KeyType>>& keys) const
+	{
+		if (IsQuantized())
+		{
+			QuantizedKeyFrames quantizedKeys = KeyFrameQuantizer::Encode(keys);
+			outputArchive << quantizedKeys.startTime << quantizedKeys.timeRange << quantizedKeys.valueMin << quantizedKeys.valueRange;
+			if (!IsUniform())
+			{
+				outputArchive.ExportBuffer(quantizedKeys.timeCodes.data(), quantizedKeys.timeCodes.size());
+			}
+			outputArchive.ExportBuffer(quantizedKeys.valueCodes.data(), quantizedKeys.valueCodes.size());
+		}
+		else if (IsUniform())
+		{
+			std::vector<KeyFrameValue> values;
+			values.reserve(keys.size());
+			for (const auto& key : keys)
+			{
+				values.push_back(key.GetValue());
+			}
+			outputArchive.ExportBuffer(values.data(), values.size());
+		}
+		else
+		{
+			outputArchive.ExportBuffer(keys.data(), keys.size());
+		}
+	}
+
 private:
 	TrackID m_id;
 	std::string m_name;
@@ -99,6 +184,9 @@ private:
 	std::vector<TranslationKey> m_translationKeys;
 	std::vector<RotationKey> m_rotationKeys;
 	std::vector<ScaleKey> m_scaleKeys;
+
+	bool m_isQuantized = false;
+	float m_keyInterval = 0.0f;
 };
 
 }
\ No newline at end of file
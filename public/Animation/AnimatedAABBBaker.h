@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+
+namespace cd
+{
+
+class Animation;
+class SceneDatabase;
+
+// AnimatedAABBBaker records bounds of skinned vertices while an animation plays.
+// Vertices are bounded per bone in bone space once. Every frame transforms bone bounds by world matrices instead of skinning vertices.
+// A linear blend skinned vertex is a weighted average of its bone transformed positions so it is always inside the union of bone bounds.
+// Bounds are in skeleton space which is the space of PoseEvaluator world matrices.
+class CORE_API AnimatedAABBBaker final
+{
+public:
+	// Utility class doesn't allow to construct.
+	AnimatedAABBBaker() = delete;
+	AnimatedAABBBaker(const AnimatedAABBBaker&) = delete;
+	AnimatedAABBBaker& operator=(const AnimatedAABBBaker&) = delete;
+	AnimatedAABBBaker(AnimatedAABBBaker&&) = delete;
+	AnimatedAABBBaker& operator=(AnimatedAABBBaker&&) = delete;
+	~AnimatedAABBBaker() = delete;
+
+	// Frames are sampled at sampleRate frames per second and windowFrameCount frames are merged into a window AABB.
+	// Adjacent windows share their boundary frames. Bounds are exact at frames, so sample rates should not be lower than key rates.
+	// Returns false if the scene doesn't have skinned vertices.
+	static bool Bake(const SceneDatabase& sceneDatabase, Animation& animation, float sampleRate, uint32_t windowFrameCount);
+};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+
+namespace cd
+{
+
+class Track;
+
+struct AnimationCompressionOptions
+{
+	// Errors are measured as the displacement of a virtual vertex which is errorDistance away from the bone in bone space.
+	// Translation errors are the displacement itself. Rotation and scale errors grow with errorDistance.
+	float maxError = 0.001f;
+	float errorDistance = 1.0f;
+
+	// Snap keys to 16 bits codes and mark the track to be serialized in quantized form.
+	// It adds errors up to 1/65536 of value ranges and time ranges of every channel.
+	bool quantize = true;
+};
+
+// AnimationCompressor removes keys which can be reproduced by interpolating their neighbors within the error bound.
+// Translations and scales are linearly interpolated and rotations are spherically interpolated as the track sampler does.
+class CORE_API AnimationCompressor final
+{
+public:
+	// Utility class doesn't allow to construct.
+	AnimationCompressor() = delete;
+	AnimationCompressor(const AnimationCompressor&) = delete;
+	AnimationCompressor& operator=(const AnimationCompressor&) = delete;
+	AnimationCompressor(AnimationCompressor&&) = delete;
+	AnimationCompressor& operator=(AnimationCompressor&&) = delete;
+	~AnimationCompressor() = delete;
+
+	// Returns the number of removed keys. Uniform tracks keep all keys.
+	static uint32_t ReduceKeys(Track& track, const AnimationCompressionOptions& options);
+
+	// Snaps keys to quantized values so what is serialized is the same as what is in memory.
+	// Returns false and keeps the track unchanged when quantized times can't keep keys strictly ordered.
+	static bool Quantize(Track& track);
+
+	static uint32_t Compress(Track& track, const AnimationCompressionOptions& options);
+};
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+
+namespace cd
+{
+
+class Animation;
+class Track;
+
+// AnimationResampler bakes tracks to keys at a uniform interval from time 0 to the animation duration.
+// All non-empty channels of a resampled track have the same key count so keys of every channel share indexes.
+// Empty channels stay empty so that bones keep their rest values.
+class CORE_API AnimationResampler final
+{
+public:
+	// Key counts also size baked textures and AABB windows so sample rates and key counts are bounded.
+	static constexpr float DefaultSampleRate = 30.0f;
+	static constexpr float MaxSampleRate = 1000.0f;
+	static constexpr uint32_t MaxKeyCount = 1U << 20U;
+
+public:
+	// Utility class doesn't allow to construct.
+	AnimationResampler() = delete;
+	AnimationResampler(const AnimationResampler&) = delete;
+	AnimationResampler& operator=(const AnimationResampler&) = delete;
+	AnimationResampler(AnimationResampler&&) = delete;
+	AnimationResampler& operator=(AnimationResampler&&) = delete;
+	~AnimationResampler() = delete;
+
+	// Returns the key interval in ticks which is the closest one to sampleRate keys per second and divides duration exactly.
+	// Non-positive or non-finite sample rates fall back to DefaultSampleRate and larger ones are clamped to MaxSampleRate.
+	// keyCount never exceeds MaxKeyCount.
+	static float CalculateKeyInterval(const Animation& animation, float sampleRate, uint32_t& keyCount);
+
+	static void Resample(Track& track, float keyInterval, uint32_t keyCount);
+};
+
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "Scene/KeyFrame.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+// 16 bits quantized form of one key channel.
+// Times are normalized in [startTime, startTime + timeRange] and vector values are normalized in [valueMin, valueMin + valueRange] per component.
+// Rotations use smallest three encoding which doesn't need a value range.
+struct QuantizedKeyFrames
+{
+	float startTime = 0.0f;
+	float timeRange = 0.0f;
+	Vec3f valueMin = Vec3f::Zero();
+	Vec3f valueRange = Vec3f::Zero();
+
+	// One code per key.
+	std::vector<uint16_t> timeCodes;
+
+	// Three codes per key.
+	std::vector<uint16_t> valueCodes;
+};
+
+class KeyFrameQuantizer final
+{
+public:
+	static constexpr uint32_t MaxCode = 65535U;
+	static constexpr uint32_t MaxRotationCode = 32767U;
+
+public:
+	// Utility class doesn't allow to construct.
+	KeyFrameQuantizer() = delete;
+	KeyFrameQuantizer(const KeyFrameQuantizer&) = delete;
+	KeyFrameQuantizer& operator=(const KeyFrameQuantizer&) = delete;
+	KeyFrameQuantizer(KeyFrameQuantizer&&) = delete;
+	KeyFrameQuantizer& operator=(KeyFrameQuantizer&&) = delete;
+	~KeyFrameQuantizer() = delete;
+
+	static uint16_t QuantizeUnorm(float value, uint32_t maxCode = MaxCode)
+	{
+		return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * static_cast<float>(maxCode) + 0.5f);
+	}
+
+	static float DequantizeUnorm(uint32_t code, uint32_t maxCode = MaxCode)
+	{
+		return static_cast<float>(code) / static_cast<float>(maxCode);
+	}
+
+	// Smallest three : the largest component is dropped and recovered from unit length. The others are in [-1/sqrt(2), 1/sqrt(2)] and stored in 15 bits.
+	// The index of the dropped component is stored in the highest bits of the first two codes.
+	static void EncodeRotation(const Quaternion& rotation, uint16_t* pCodes)
+	{
+		Quaternion unitRotation = rotation;
+		unitRotation.Normalize();
+
+		int largestIndex = 0;
+		for (int componentIndex = 1; componentIndex < 4; ++componentIndex)
+		{
+			if (std::abs(unitRotation.Data(componentIndex)) > std::abs(unitRotation.Data(largestIndex)))
+			{
+				largestIndex = componentIndex;
+			}
+		}
+
+		// q and -q are the same rotation so the dropped component is always positive.
+		float sign = unitRotation.Data(largestIndex) < 0.0f ? -1.0f : 1.0f;
+		int codeIndex = 0;
+		for (int componentIndex = 0; componentIndex < 4; ++componentIndex)
+		{
+			if (componentIndex != largestIndex)
+			{
+				float value = unitRotation.Data(componentIndex) * sign;
+				pCodes[codeIndex++] = QuantizeUnorm((value * Sqrt2 + 1.0f) * 0.5f, MaxRotationCode);
+			}
+		}
+
+		pCodes[0] |= static_cast<uint16_t>((largestIndex >> 1) << 15);
+		pCodes[1] |= static_cast<uint16_t>((largestIndex & 1) << 15);
+	}
+
+	static Quaternion DecodeRotation(const uint16_t* pCodes)
+	{
+		int largestIndex = ((pCodes[0] >> 15) << 1) | (pCodes[1] >> 15);
+
+		Quaternion rotation = Quaternion::Identity();
+		float lengthSquare = 0.0f;
+		int codeIndex = 0;
+		for (int componentIndex = 0; componentIndex < 4; ++componentIndex)
+		{
+			if (componentIndex != largestIndex)
+			{
+				float value = (DequantizeUnorm(pCodes[codeIndex++] & MaxRotationCode, MaxRotationCode) * 2.0f - 1.0f) / Sqrt2;
+				rotation.Data(componentIndex) = value;
+				lengthSquare += value * value;
+			}
+		}
+		rotation.Data(largestIndex) = std::sqrt(std::max(1.0f - lengthSquare, 0.0f));
+
+		return rotation;
+	}
+
+	template<typename KeyFrameValue, KeyFrameType KeyType>
+	static QuantizedKeyFrames Encode(const std::vector<KeyFrame<KeyFrameValue, KeyType>>& keys)
+	{
+		QuantizedKeyFrames quantizedKeys;
+		if (keys.empty())
+		{
+			return quantizedKeys;
+		}
+
+		quantizedKeys.startTime = keys.front().GetTime();
+		quantizedKeys.timeRange = keys.back().GetTime() - quantizedKeys.startTime;
+		float inverseTimeRange = quantizedKeys.timeRange > 0.0f ? 1.0f / quantizedKeys.timeRange : 0.0f;
+
+		if constexpr (KeyFrameType::Rotation != KeyType)
+		{
+			Vec3f valueMax = keys.front().GetValue();
+			quantizedKeys.valueMin = valueMax;
+			for (const auto& key : keys)
+			{
+				for (int componentIndex = 0; componentIndex < 3; ++componentIndex)
+				{
+					quantizedKeys.valueMin[componentIndex] = std::min(quantizedKeys.valueMin[componentIndex], key.GetValue()[componentIndex]);
+					valueMax[componentIndex] = std::max(valueMax[componentIndex], key.GetValue()[componentIndex]);
+				}
+			}
+			quantizedKeys.valueRange = valueMax - quantizedKeys.valueMin;
+		}
+
+		quantizedKeys.timeCodes.resize(keys.size());
+		quantizedKeys.valueCodes.resize(keys.size() * 3U);
+		for (size_t keyIndex = 0U; keyIndex < keys.size(); ++keyIndex)
+		{
+			const auto& key = keys[keyIndex];
+			quantizedKeys.timeCodes[keyIndex] = QuantizeUnorm((key.GetTime() - quantizedKeys.startTime) * inverseTimeRange);
+
+			uint16_t* pValueCodes = &quantizedKeys.valueCodes[keyIndex * 3U];
+			if constexpr (KeyFrameType::Rotation == KeyType)
+			{
+				EncodeRotation(key.GetValue(), pValueCodes);
+			}
+			else
+			{
+				for (int componentIndex = 0; componentIndex < 3; ++componentIndex)
+				{
+					float range = quantizedKeys.valueRange[componentIndex];
+					float value = key.GetValue()[componentIndex] - quantizedKeys.valueMin[componentIndex];
+					pValueCodes[componentIndex] = QuantizeUnorm(range > 0.0f ? value / range : 0.0f);
+				}
+			}
+		}
+
+		return quantizedKeys;
+	}
+
+	template<typename KeyFrameValue, KeyFrameType KeyType>
+	static void Decode(const QuantizedKeyFrames& quantizedKeys, std::vector<KeyFrame<KeyFrameValue, KeyType>>& keys)
+	{
+		keys.resize(quantizedKeys.timeCodes.size());
+		for (size_t keyIndex = 0U; keyIndex < keys.size(); ++keyIndex)
+		{
+			auto& key = keys[keyIndex];
+			key.SetTime(quantizedKeys.startTime + DequantizeUnorm(quantizedKeys.timeCodes[keyIndex]) * quantizedKeys.timeRange);
+
+			const uint16_t* pValueCodes = &quantizedKeys.valueCodes[keyIndex * 3U];
+			if constexpr (KeyFrameType::Rotation == KeyType)
+			{
+				key.SetValue(DecodeRotation(pValueCodes));
+			}
+			else
+			{
+				Vec3f value;
+				for (int componentIndex = 0; componentIndex < 3; ++componentIndex)
+				{
+					value[componentIndex] = quantizedKeys.valueMin[componentIndex] + DequantizeUnorm(pValueCodes[componentIndex]) * quantizedKeys.valueRange[componentIndex];
+				}
+				key.SetValue(value);
+			}
+		}
+	}
+
+private:
+	static constexpr float Sqrt2 = 1.41421356f;
+};
+
+}
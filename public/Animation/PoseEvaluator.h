@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Animation/TrackSampler.h"
+#include "Base/Export.h"
+#include "Math/Matrix.hpp"
+#include "Math/Transform.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Animation;
+class SceneDatabase;
+
+// PoseEvaluator flattens bones of a scene into arrays sorted by depth so parents are always before children.
+// Poses are evaluated in two passes :
+// 1. Sample tracks of all animated bones. Keys are searched by cursors and interpolated by 4 bones at once in SIMD lanes.
+// 2. Concatenate local matrices to world matrices in one linear pass over the parent index array.
+// Time is in animation ticks which is the same unit as key times.
+// World matrices are in skeleton space which doesn't contain transforms of nodes above root bones.
+class CORE_API PoseEvaluator final
+{
+public:
+	static constexpr uint32_t InvalidIndex = 0xFFFFFFFF;
+
+public:
+	PoseEvaluator() = default;
+	explicit PoseEvaluator(const SceneDatabase& sceneDatabase, const Animation* pAnimation = nullptr);
+	PoseEvaluator(const PoseEvaluator&) = default;
+	PoseEvaluator& operator=(const PoseEvaluator&) = default;
+	PoseEvaluator(PoseEvaluator&&) = default;
+	PoseEvaluator& operator=(PoseEvaluator&&) = default;
+	~PoseEvaluator() = default;
+
+	// Tracks are bound to bones by name. Null animation evaluates the rest pose.
+	void Init(const SceneDatabase& sceneDatabase, const Animation* pAnimation = nullptr);
+
+	uint32_t GetBoneCount() const { return static_cast<uint32_t>(m_boneIDs.size()); }
+	uint32_t GetAnimatedBoneCount() const { return static_cast<uint32_t>(m_trackSamplers.size()); }
+
+	// Arrays in evaluation order.
+	const std::vector<uint32_t>& GetBoneIDs() const { return m_boneIDs; }
+	const std::vector<uint32_t>& GetParentIndexes() const { return m_parentIndexes; }
+	const std::vector<Transform>& GetRestTransforms() const { return m_restTransforms; }
+
+	// Returns InvalidIndex if the bone doesn't exist.
+	uint32_t GetBoneIndex(uint32_t boneID) const { return boneID < m_boneIDToIndexes.size() ? m_boneIDToIndexes[boneID] : InvalidIndex; }
+
+	// Bones without tracks keep rest transforms.
+	void SampleLocalTransforms(float time, std::vector<Transform>& localTransforms);
+
+	// Scales are applied per local axis before rotations. Rotations follow the convention of Quaternion::ToMatrix3x3.
+	void SolveWorldMatrices(const std::vector<Transform>& localTransforms, std::vector<Matrix4x4>& worldMatrices) const;
+
+	// World matrices multiplied by bone offset matrices. They are indexed by bone ID which is what vertex bone IDs refer to.
+	void CalculateSkinningMatrices(const std::vector<Matrix4x4>& worldMatrices, std::vector<Matrix4x4>& skinningMatrices) const;
+
+	void Evaluate(float time, std::vector<Matrix4x4>& skinningMatrices);
+
+private:
+	std::vector<uint32_t> m_boneIDs;
+	std::vector<uint32_t> m_parentIndexes;
+	std::vector<uint32_t> m_boneIDToIndexes;
+	std::vector<Transform> m_restTransforms;
+	std::vector<Matrix4x4> m_offsetMatrices;
+
+	// Animated bones.
+	std::vector<TrackSampler> m_trackSamplers;
+	std::vector<TrackCursor> m_trackCursors;
+	std::vector<uint32_t> m_trackBoneIndexes;
+
+	// Interpolation inputs in SoA which are reused between evaluations. Sizes are padded to multiples of 4.
+	std::vector<float> m_batchValues[8];
+	std::vector<float> m_batchFactors;
+	std::vector<Transform> m_localTransforms;
+	std::vector<Matrix4x4> m_worldMatrices;
+};
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Mesh;
+
+// SkinningOptimizer prepares skinned meshes for GPU skinning which has a fixed influence count per vertex
+// and a limited bone matrix palette per draw call.
+class CORE_API SkinningOptimizer final
+{
+public:
+	// 8 bits local bone indexes can't address more bones.
+	static constexpr uint32_t MaxPaletteSize = 256U;
+
+public:
+	// Utility class doesn't allow to construct.
+	SkinningOptimizer() = delete;
+	SkinningOptimizer(const SkinningOptimizer&) = delete;
+	SkinningOptimizer& operator=(const SkinningOptimizer&) = delete;
+	SkinningOptimizer(SkinningOptimizer&&) = delete;
+	SkinningOptimizer& operator=(SkinningOptimizer&&) = delete;
+	~SkinningOptimizer() = delete;
+
+	// Keeps the largest influences of every vertex sorted by weights in descending order and renormalizes their weights.
+	// Returns the number of vertices which lost influences.
+	static uint32_t LimitInfluences(Mesh& mesh, uint32_t maxInfluenceCount);
+
+	// Splits polygons to parts which use no more than maxPaletteSize bones. Vertices shared by parts are duplicated.
+	// Returns an empty array when the mesh already fits. Otherwise the first part has the ID and the name of the source mesh.
+	// Morphs of parts keep IDs and names of source morphs so that one weight binding by ID drives the same morph on every part.
+	static std::vector<Mesh> SplitByPalette(const Mesh& mesh, uint32_t maxPaletteSize);
+
+	// Builds the bone palette and packs influences to 8 bits local bone indexes and 16 bits unorm weights which sum to 1.
+	// Returns false when the mesh uses more than MaxPaletteSize bones.
+	static bool PackInfluences(Mesh& mesh);
+};
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Math/Transform.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Track;
+
+// Key positions found by the last sampling of every channel.
+// Monotonic playback finds the next keys in constant time by starting from them instead of searching from the beginning.
+struct TrackCursor
+{
+	uint32_t translationKeyIndex = 0U;
+	uint32_t rotationKeyIndex = 0U;
+	uint32_t scaleKeyIndex = 0U;
+};
+
+// TrackSampler stores times and values of every key channel in separated contiguous arrays and samples them at any time.
+// Translations and scales are linearly interpolated and rotations are spherically interpolated. Times out of key range are clamped.
+// Empty channels return identity values. Keys of uniform tracks are located by dividing time by the key interval without searching.
+class CORE_API TrackSampler final
+{
+public:
+	TrackSampler() = default;
+	explicit TrackSampler(const Track& track);
+	TrackSampler(const TrackSampler&) = default;
+	TrackSampler& operator=(const TrackSampler&) = default;
+	TrackSampler(TrackSampler&&) = default;
+	TrackSampler& operator=(TrackSampler&&) = default;
+	~TrackSampler() = default;
+
+	void Init(const Track& track);
+
+	const std::vector<float>& GetTranslationTimes() const { return m_translationTimes; }
+	const std::vector<Vec3f>& GetTranslations() const { return m_translations; }
+	const std::vector<float>& GetRotationTimes() const { return m_rotationTimes; }
+	const std::vector<Quaternion>& GetRotations() const { return m_rotations; }
+	const std::vector<float>& GetScaleTimes() const { return m_scaleTimes; }
+	const std::vector<Vec3f>& GetScales() const { return m_scales; }
+	float GetKeyInterval() const { return m_keyInterval; }
+
+	// Samplers which share the same track data can use their own cursors in different threads.
+	Vec3f SampleTranslation(float time, TrackCursor& cursor) const;
+	Quaternion SampleRotation(float time, TrackCursor& cursor) const;
+	Vec3f SampleScale(float time, TrackCursor& cursor) const;
+	Transform Sample(float time, TrackCursor& cursor) const;
+
+	// Uses the cursor owned by the sampler.
+	Transform Sample(float time) { return Sample(time, m_cursor); }
+	void ResetCursor() { m_cursor = TrackCursor(); }
+
+	// Returns keyIndex which makes times[keyIndex] <= time < times[keyIndex + 1] and the interpolation factor between them.
+	// cursorKeyIndex is the search hint and is updated to keyIndex.
+	static uint32_t FindKey(const std::vector<float>& times, float time, uint32_t& cursorKeyIndex, float& factor);
+
+	// The same as FindKey for keys at multiples of keyInterval.
+	static uint32_t FindUniformKey(uint32_t keyCount, float keyInterval, float time, float& factor);
+
+private:
+	std::vector<float> m_translationTimes;
+	std::vector<Vec3f> m_translations;
+	std::vector<float> m_rotationTimes;
+	std::vector<Quaternion> m_rotations;
+	std::vector<float> m_scaleTimes;
+	std::vector<Vec3f> m_scales;
+	float m_keyInterval = 0.0f;
+
+	TrackCursor m_cursor;
+};
+
+}
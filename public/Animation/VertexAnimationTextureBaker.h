@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+
+namespace cd
+{
+
+class Animation;
+class Mesh;
+class SceneDatabase;
+class Texture;
+
+// VertexAnimationTextureBaker plays an animation on a skinned mesh and stores deformed vertices in a RGBA16F texture.
+// Runtime fetches vertices from the texture instead of skinning them so that instances only differ in their frame index.
+// Vertices are laid out in rows of at most MaxTextureWidth texels. One frame takes rowsPerFrame rows.
+// The upper half of the texture stores positions of all frames and the lower half stores normals in the same layout.
+// Lookup UVs are (column + 0.5) / width and (row + 0.5) / rowsPerFrame which don't depend on the animation length.
+// So a vertex of frame f is at (u, (f + v) / (2 * frameCount)) and its normal is 0.5 below it.
+class CORE_API VertexAnimationTextureBaker final
+{
+public:
+	static constexpr uint32_t MaxTextureWidth = 4096U;
+
+public:
+	// Utility class doesn't allow to construct.
+	VertexAnimationTextureBaker() = delete;
+	VertexAnimationTextureBaker(const VertexAnimationTextureBaker&) = delete;
+	VertexAnimationTextureBaker& operator=(const VertexAnimationTextureBaker&) = delete;
+	VertexAnimationTextureBaker(VertexAnimationTextureBaker&&) = delete;
+	VertexAnimationTextureBaker& operator=(VertexAnimationTextureBaker&&) = delete;
+	~VertexAnimationTextureBaker() = delete;
+
+	// Writes lookup UVs into uvSetIndex. UV set count and vertex format grow when needed.
+	static bool GenerateLookupUVs(Mesh& mesh, uint32_t uvSetIndex);
+
+	// Frames are sampled at sampleRate frames per second and are evaluated in parallel.
+	// Positions and normals are in skeleton space. Vertices without valid influences keep their rest positions.
+	// Texture format, size and pixels are overwritten. Returns false if the mesh isn't skinned.
+	static bool Bake(const SceneDatabase& sceneDatabase, const Animation& animation, const Mesh& mesh, float sampleRate, Texture& texture);
+};
+
+}
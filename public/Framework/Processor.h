@@ -1,7 +1,11 @@
 #pragma once
 
 #include "Base/Export.h"
+#include "Image/ImageResampler.h"
+#include "Scene/MaterialTextureType.h"
+#include "Scene/TextureFormat.h"
 
+#include <cstdint>
 #include <memory>
 
 namespace cd
@@ -20,6 +24,10 @@ class ProcessorImpl;
 
 class CORE_API Processor final
 {
+public:
+	// Selects the first UV set which doesn't hold data yet.
+	static constexpr uint32_t NextFreeUVSetIndex = 0xFFFFFFFF;
+
 public:
 	Processor() = delete;
 	explicit Processor(IProducer* pProducer, IConsumer* pConsumer, cd::SceneDatabase* pHostSceneDatabase = nullptr);
@@ -39,19 +47,243 @@ public:
 	bool IsCalculateAABBForSceneDatabaseEnabled() const;
 
 	// Flatten objects hierarchy for SceneDatabase.
-	// Currently, we only support to flatten cd::Node and cd::Mesh for static meshes.
+	// Node transforms are baked into mesh vertices. Skinned meshes also bake them into bone offsets so their skinned results don't change.
+	// Nothing is flattened if skinned meshes which share bones are under different node transforms.
 	void SetFlattenSceneDatabaseEnable(bool enable);
 	bool IsFlattenSceneDatabaseEnabled() const;
 
+	// Sort nodes by depth and store their local transforms in SoA arrays with world matrices solved in one linear pass.
+	// It is exported with SceneDatabase so runtime updates transforms without walking node children.
+	void SetBuildNodeHierarchyEnable(bool enable);
+	bool IsBuildNodeHierarchyEnabled() const;
+
+	// Keep the largest bone influences of skinned mesh vertices, split meshes which use more bones than the palette size
+	// and pack influences to 8 bits local bone indexes and 16 bits unorm weights for GPU skinning.
+	void SetPrepareSkinningEnable(bool enable);
+	bool IsPrepareSkinningEnabled() const;
+
+	void SetMaxSkinInfluenceCount(uint32_t influenceCount);
+	uint32_t GetMaxSkinInfluenceCount() const;
+
+	// Max bones used by a draw call which is 256 at most.
+	void SetSkinPaletteSize(uint32_t paletteSize);
+	uint32_t GetSkinPaletteSize() const;
+
 	void SetCalculateConnetivityDataEnable(bool enable);
 	bool IsCalculateConnetivityDataEnabled() const;
 
+	// Unwrap meshes into non-overlapping charts and pack them into a new UV set for lightmap baking.
+	// Vertices on chart seams are split so it runs before connectivity data calculation.
+	void SetGenerateLightmapUVsEnable(bool enable);
+	bool IsGenerateLightmapUVsEnabled() const;
+
+	// UV sets between existing ones and the lightmap UV set are filled by zero.
+	void SetLightmapUVSetIndex(uint32_t uvSetIndex);
+	uint32_t GetLightmapUVSetIndex() const;
+
+	// Texel resolution of the lightmap which decides chart scale.
+	void SetLightmapResolution(uint32_t resolution);
+	uint32_t GetLightmapResolution() const;
+
+	// Empty texels around every chart.
+	void SetLightmapPadding(uint32_t padding);
+	uint32_t GetLightmapPadding() const;
+
+	// Max angle in degrees between polygon normals and the chart normal.
+	void SetLightmapChartMaxAngle(float degrees);
+	float GetLightmapChartMaxAngle() const;
+
+	// Build binned SAH BVHs over polygons of every mesh and over mesh AABBs of the scene. BVHs are serialized with the scene.
+	// Enable flatten and AABB calculation so that mesh AABBs are in world space.
+	void SetBuildBVHEnable(bool enable);
+	bool IsBuildBVHEnabled() const;
+
+	// Max primitive count in one leaf.
+	void SetBVHMaxLeafSize(uint32_t size);
+	uint32_t GetBVHMaxLeafSize() const;
+
+	// Bake per vertex ambient occlusion by hemisphere rays through BVHs and write it to a vertex color set.
+	// Missing BVHs are built before baking.
+	void SetBakeVertexAOEnable(bool enable);
+	bool IsBakeVertexAOEnabled() const;
+
+	// Occluders are all meshes of the flattened scene. Otherwise every mesh only occludes itself.
+	void SetVertexAOSceneOcclusionEnable(bool enable);
+	bool IsVertexAOSceneOcclusionEnabled() const;
+
+	// Accessibility is written to RGB and alpha is 1. Existing colors in the set are replaced.
+	void SetVertexAOColorSetIndex(uint32_t colorSetIndex);
+	uint32_t GetVertexAOColorSetIndex() const;
+
+	void SetVertexAORayCount(uint32_t rayCount);
+	uint32_t GetVertexAORayCount() const;
+
+	// 0 means half diagonal of every receiving mesh.
+	void SetVertexAOMaxDistance(float distance);
+	float GetVertexAOMaxDistance() const;
+
+	// Bake tracks to keys at a uniform rate. Translation, rotation and scale keys are aligned and their times are implicit.
+	// Compression keeps all keys of resampled tracks and only quantizes them.
+	void SetResampleAnimationsEnable(bool enable);
+	bool IsResampleAnimationsEnabled() const;
+
+	// Keys per second. Invalid rates fall back to AnimationResampler::DefaultSampleRate and rates are clamped to AnimationResampler::MaxSampleRate.
+	void SetAnimationSampleRate(float sampleRate);
+	float GetAnimationSampleRate() const;
+
+	// Remove animation keys which can be reproduced by interpolation within the error bound.
+	void SetCompressAnimationsEnable(bool enable);
+	bool IsCompressAnimationsEnabled() const;
+
+	// Max displacement of a virtual vertex which is error distance away from the bone.
+	void SetAnimationCompressionMaxError(float maxError);
+	float GetAnimationCompressionMaxError() const;
+
+	void SetAnimationCompressionErrorDistance(float distance);
+	float GetAnimationCompressionErrorDistance() const;
+
+	// Serialize compressed tracks as 16 bits times, translations, scales and smallest three rotations.
+	void SetQuantizeAnimationsEnable(bool enable);
+	bool IsQuantizeAnimationsEnabled() const;
+
+	// Remove morph target vertices which don't move and optionally quantize deltas to 16 bits.
+	void SetCompressMorphsEnable(bool enable);
+	bool IsCompressMorphsEnabled() const;
+
+	void SetMorphDeltaThreshold(float threshold);
+	float GetMorphDeltaThreshold() const;
+
+	void SetQuantizeMorphsEnable(bool enable);
+	bool IsQuantizeMorphsEnabled() const;
+
+	// Record skinned vertex bounds of every animation over the whole clip and over windows of frames.
+	// Frames are sampled at the animation sample rate.
+	void SetBakeAnimatedAABBsEnable(bool enable);
+	bool IsBakeAnimatedAABBsEnabled() const;
+
+	void SetAnimatedAABBWindowFrameCount(uint32_t frameCount);
+	uint32_t GetAnimatedAABBWindowFrameCount() const;
+
+	// Bake positions and normals of every skinned mesh under every animation into RGBA16F textures.
+	// Frames are sampled at the animation sample rate. Baked meshes get texel lookup coordinates in the UV set.
+	// Textures are named <mesh name>_<animation name>_VAT which is the contract to find the texture of a mesh and an animation.
+	// Meshes without any baked texture don't get lookup coordinates.
+	void SetBakeVertexAnimationTexturesEnable(bool enable);
+	bool IsBakeVertexAnimationTexturesEnabled() const;
+
+	// Defaults to NextFreeUVSetIndex. An explicit UV set which already holds data isn't overwritten.
+	void SetVertexAnimationUVSetIndex(uint32_t uvSetIndex);
+	uint32_t GetVertexAnimationUVSetIndex() const;
+
+	// Search folders are scanned recursively only once to build a file name index.
+	// Then missing textures are resolved by their file names without touching filesystem again.
 	void AddExtraTextureSearchFolder(const char* pFolderPath);
 	bool IsSearchMissingTexturesEnabled() const;
 
+	void SetSearchTexturesCaseInsensitiveEnable(bool enable);
+	bool IsSearchTexturesCaseInsensitiveEnabled() const;
+
+	// Save the file name index of search folders to reuse it in later runs with the same search folders.
+	// Delete the cache file to rebuild the index after files in search folders change.
+	void SetTextureSearchIndexCacheFilePath(const char* pFilePath);
+	const char* GetTextureSearchIndexCacheFilePath() const;
+
+	// Textures which have the same contents and sampler settings are merged into one.
+	// Material texture IDs are remapped to the kept texture and texture IDs are compacted.
+	void SetDeduplicateTexturesEnable(bool enable);
+	bool IsDeduplicateTexturesEnabled() const;
+
+	// Fill width, height and format of file textures by parsing image headers only.
+	void SetProbeTextureMetadataEnable(bool enable);
+	bool IsProbeTextureMetadataEnabled() const;
+
 	void SetEmbedTextureFilesEnable(bool enable);
 	bool IsEmbedTextureFilesEnabled() const;
 
+	// Max count of files which are read at the same time when embedding or probing textures.
+	// It isn't capped by the CPU count because file reads mostly wait. 0 means using all hardware threads.
+	void SetEmbedTextureFilesIOThreadCount(uint32_t count);
+	uint32_t GetEmbedTextureFilesIOThreadCount() const;
+
+	// Merge materials which have the same parameters and texture types into atlas materials to reduce draw calls.
+	// Textures are packed into atlases and the first UV set of meshes is remapped. Only meshes whose UVs are inside [0, 1] are merged.
+	void SetBakeTextureAtlasesEnable(bool enable);
+	bool IsBakeTextureAtlasesEnabled() const;
+
+	void SetTextureAtlasMaxSize(uint32_t size);
+	uint32_t GetTextureAtlasMaxSize() const;
+
+	// Texels around every region which repeat region edges to avoid bleeding.
+	void SetTextureAtlasPadding(uint32_t padding);
+	uint32_t GetTextureAtlasPadding() const;
+
+	// Analyze texel density, UV utilization, overlapped area and flipped triangles of every mesh and material.
+	void SetAnalyzeUVStatisticsEnable(bool enable);
+	bool IsAnalyzeUVStatisticsEnabled() const;
+
+	void SetUVStatisticsUVSetIndex(uint32_t uvSetIndex);
+	uint32_t GetUVStatisticsUVSetIndex() const;
+
+	// Coverage grid resolution of [0, 1] UV square which measures utilization and overlapped area.
+	void SetUVStatisticsResolution(uint32_t resolution);
+	uint32_t GetUVStatisticsResolution() const;
+
+	// Write statistics to a json file. Empty path means no report file.
+	void SetUVStatisticsReportFilePath(const char* pFilePath);
+	const char* GetUVStatisticsReportFilePath() const;
+
+	// Materials whose max mesh texel density is larger than min mesh texel density by the ratio are reported as inconsistent.
+	void SetTexelDensityToleranceRatio(float ratio);
+	float GetTexelDensityToleranceRatio() const;
+
+	// Texels per world unit. Textures denser than it get a max resolution for texture budget enforcement. 0 means disabled.
+	void SetTargetTexelDensity(float texelsPerUnit);
+	float GetTargetTexelDensity() const;
+
+	// Downscale oversize textures by the max resolution of their texture types and the total memory budget.
+	// Textures are resized to RGBA8 pixels by a Kaiser filter in linear space.
+	void SetEnforceTextureBudgetEnable(bool enable);
+	bool IsEnforceTextureBudgetEnabled() const;
+
+	// 0 means no limit.
+	void SetTextureMaxResolution(cd::MaterialTextureType textureType, uint32_t maxResolution);
+	uint32_t GetTextureMaxResolution(cd::MaterialTextureType textureType) const;
+
+	// Estimated by compression formats and mip chains. The largest textures are halved until all textures fit. 0 means no limit.
+	void SetTextureMemoryBudget(uint64_t bytes);
+	uint64_t GetTextureMemoryBudget() const;
+
+	// Generate full mip chains for textures which use mipmap. Levels are stored as RGBA8 in texture raw data.
+	// Color textures are filtered in linear space and normal maps are renormalized.
+	void SetGenerateMipmapsEnable(bool enable);
+	bool IsGenerateMipmapsEnabled() const;
+
+	void SetMipmapFilter(cd::ResampleFilter filter);
+	cd::ResampleFilter GetMipmapFilter() const;
+
+	// Preserve alpha test coverage of BaseColor and AlphaMap textures. 0 means disabled.
+	void SetMipmapAlphaCoverageReference(float reference);
+	float GetMipmapAlphaCoverageReference() const;
+
+	// Decode textures and compress them to BCn formats. Compressed blocks are stored in texture raw data.
+	// Textures which already have a compressed format or a non RGBA8 pixel format are skipped.
+	void SetCompressTexturesEnable(bool enable);
+	bool IsCompressTexturesEnabled() const;
+
+	// Set TextureFormat::Count to skip compressing a texture type.
+	void SetTextureCompressionFormat(cd::MaterialTextureType textureType, cd::TextureFormat format);
+	cd::TextureFormat GetTextureCompressionFormat(cd::MaterialTextureType textureType) const;
+
+	// Pack texture pixels and mip levels into TextureContainer which has a level table for streaming.
+	// Runs after mipmap generation and compression so that the container stores final GPU data.
+	void SetPackTextureContainersEnable(bool enable);
+	bool IsPackTextureContainersEnabled() const;
+
+	// Write every container to a standalone file in the folder and refer to it by texture path instead of raw data.
+	// Empty folder means containers are kept in texture raw data.
+	void SetTextureContainerOutputFolder(const char* pFolder);
+	const char* GetTextureContainerOutputFolder() const;
+
 	const cd::SceneDatabase* GetSceneDatabase() const;
 	void Run();
 
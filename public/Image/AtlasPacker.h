@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+struct AtlasItem
+{
+	uint32_t width = 0U;
+	uint32_t height = 0U;
+};
+
+struct AtlasPlacement
+{
+	static constexpr uint32_t InvalidPage = UINT32_MAX;
+
+	uint32_t page = InvalidPage;
+	uint32_t x = 0U;
+	uint32_t y = 0U;
+};
+
+// AtlasPacker places rectangles into as few fixed size pages as possible by skyline bottom-left heuristic.
+// Items are inserted from the tallest to the shortest. Every item tries existing pages before opening a new page.
+class CORE_API AtlasPacker final
+{
+public:
+	// Utility class doesn't allow to construct.
+	AtlasPacker() = delete;
+	AtlasPacker(const AtlasPacker&) = delete;
+	AtlasPacker& operator=(const AtlasPacker&) = delete;
+	AtlasPacker(AtlasPacker&&) = delete;
+	AtlasPacker& operator=(AtlasPacker&&) = delete;
+	~AtlasPacker() = delete;
+
+	// Returns page count. placements[i] is the place of items[i]. Items larger than page size get InvalidPage.
+	static uint32_t Pack(uint32_t pageWidth, uint32_t pageHeight, const std::vector<AtlasItem>& items, std::vector<AtlasPlacement>& placements);
+};
+
+}
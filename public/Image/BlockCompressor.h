@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Scene/TextureFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+// BlockCompressor encodes RGBA8 pixels to BCn formats on CPU.
+// Supported formats : BC1(RGB + 1 bit alpha), BC3(RGBA), BC4(R), BC5(RG), BC7(RGBA, mode 6).
+// Image size doesn't need to be multiple of 4. Border blocks replicate edge pixels.
+class CORE_API BlockCompressor final
+{
+public:
+	// Utility class doesn't allow to construct.
+	BlockCompressor() = delete;
+	BlockCompressor(const BlockCompressor&) = delete;
+	BlockCompressor& operator=(const BlockCompressor&) = delete;
+	BlockCompressor(BlockCompressor&&) = delete;
+	BlockCompressor& operator=(BlockCompressor&&) = delete;
+	~BlockCompressor() = delete;
+
+	static bool IsSupported(TextureFormat format);
+
+	// Bytes of one 4x4 block.
+	static uint32_t GetBlockByteSize(TextureFormat format);
+	static size_t GetCompressedSize(TextureFormat format, uint32_t width, uint32_t height);
+
+	// Rows of blocks are compressed in parallel. maxThreadCount 0 means using all hardware threads.
+	static std::vector<std::byte> Compress(TextureFormat format, const std::byte* pRGBA8, uint32_t width, uint32_t height, uint32_t maxThreadCount = 0U);
+
+	// pOutput should have GetCompressedSize bytes at least.
+	static void Compress(TextureFormat format, const std::byte* pRGBA8, uint32_t width, uint32_t height, std::byte* pOutput, uint32_t maxThreadCount = 0U);
+};
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Scene/TextureFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+// ImageCodec decodes image files(png, jpg, tga, bmp, psd, hdr...) to 8 bits per channel pixels.
+// It is implemented by stb_image which is built into core as static functions.
+class CORE_API ImageCodec final
+{
+public:
+	// Utility class doesn't allow to construct.
+	ImageCodec() = delete;
+	ImageCodec(const ImageCodec&) = delete;
+	ImageCodec& operator=(const ImageCodec&) = delete;
+	ImageCodec(ImageCodec&&) = delete;
+	ImageCodec& operator=(ImageCodec&&) = delete;
+	~ImageCodec() = delete;
+
+	// Returns false if core was built without stb.
+	static bool IsDecodeSupported();
+
+	// Parses image header only. Format is the pixel format after decoding without channel conversion.
+	// Only the header part of data is touched so it works well with memory mapped files.
+	static bool GetInfo(const std::byte* pData, size_t dataSize, uint32_t& width, uint32_t& height, TextureFormat& format);
+
+	// Pixels are converted to channelCount channels. Returns an empty vector if failed to decode.
+	static std::vector<std::byte> Decode(const std::byte* pData, size_t dataSize, uint32_t channelCount, uint32_t& width, uint32_t& height);
+};
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+enum class ResampleFilter
+{
+	Box,
+	Kaiser,
+};
+
+// ImageResampler scales linear float RGBA images by a separable filter.
+// Horizontal and vertical passes process rows in parallel and every pixel is filtered as one SIMD vector.
+// Image borders are clamped to edge.
+class CORE_API ImageResampler final
+{
+public:
+	// Utility class doesn't allow to construct.
+	ImageResampler() = delete;
+	ImageResampler(const ImageResampler&) = delete;
+	ImageResampler& operator=(const ImageResampler&) = delete;
+	ImageResampler(ImageResampler&&) = delete;
+	ImageResampler& operator=(ImageResampler&&) = delete;
+	~ImageResampler() = delete;
+
+	// pSource has sourceWidth * sourceHeight * 4 floats. pTarget has targetWidth * targetHeight * 4 floats.
+	static void Resample(const float* pSource, uint32_t sourceWidth, uint32_t sourceHeight,
+		float* pTarget, uint32_t targetWidth, uint32_t targetHeight,
+		ResampleFilter filter = ResampleFilter::Kaiser, uint32_t maxThreadCount = 0U);
+
+	// Resizes RGBA8 pixels. Filtering happens in linear space. Normal maps are renormalized after filtering.
+	static std::vector<std::byte> Resize(const std::byte* pRGBA8, uint32_t width, uint32_t height, uint32_t targetWidth, uint32_t targetHeight,
+		bool isSRGB, bool isNormalMap, ResampleFilter filter = ResampleFilter::Kaiser, uint32_t maxThreadCount = 0U);
+
+	// Conversions between RGBA8 and linear float RGBA. Gamma is decoded/encoded for RGB channels when isSRGB is true.
+	static void ConvertToLinear(const uint8_t* pRGBA8, uint32_t pixelCount, bool isSRGB, float* pLinear);
+	static void ConvertFromLinear(const float* pLinear, uint32_t pixelCount, bool isSRGB, uint8_t* pRGBA8);
+
+	// Conversions between unsigned normalized normals [0, 1] and signed normals [-1, 1] in linear float RGBA.
+	static void DecodeNormals(float* pLinear, uint32_t pixelCount);
+	static void EncodeNormals(float* pLinear, uint32_t pixelCount);
+	// Filtered normals become shorter so they need to renormalize.
+	static void RenormalizeNormals(float* pNormals, uint32_t pixelCount);
+};
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Image/ImageResampler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+enum class MipmapContent
+{
+	Color,     // RGB channels are gamma encoded.
+	Linear,    // All channels are linear data such as roughness, metallic, occlusion.
+	NormalMap, // RGB channels are unsigned normalized vectors which are renormalized after filtering.
+};
+
+struct MipmapGenerateOptions
+{
+	MipmapContent content = MipmapContent::Color;
+	ResampleFilter filter = ResampleFilter::Kaiser;
+
+	// Preserve the ratio of pixels whose alpha is greater than the reference value for alpha tested textures.
+	// Zero means not to preserve alpha coverage.
+	float alphaCoverageReference = 0.0f;
+
+	uint32_t maxThreadCount = 0U;
+};
+
+// MipmapGenerator generates a full mip chain from RGBA8 pixels until 1x1.
+// Filtering happens in linear space and every level is filtered from the previous level.
+class CORE_API MipmapGenerator final
+{
+public:
+	// Utility class doesn't allow to construct.
+	MipmapGenerator() = delete;
+	MipmapGenerator(const MipmapGenerator&) = delete;
+	MipmapGenerator& operator=(const MipmapGenerator&) = delete;
+	MipmapGenerator(MipmapGenerator&&) = delete;
+	MipmapGenerator& operator=(MipmapGenerator&&) = delete;
+	~MipmapGenerator() = delete;
+
+	static uint32_t GetMipCount(uint32_t width, uint32_t height);
+	static uint32_t GetMipSize(uint32_t size, uint32_t mipLevel) { return size >> mipLevel > 0U ? size >> mipLevel : 1U; }
+
+	// Returns all levels stored contiguously from the largest to the smallest. mipOffsets stores byte offset of every level.
+	static std::vector<std::byte> Generate(const std::byte* pRGBA8, uint32_t width, uint32_t height,
+		const MipmapGenerateOptions& options, std::vector<uint64_t>& mipOffsets);
+};
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Scene/TextureFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+struct TextureContainerHeader
+{
+	TextureFormat format = TextureFormat::Count;
+	uint32_t width = 0U;
+	uint32_t height = 0U;
+	uint32_t depth = 1U;
+	uint32_t layerCount = 1U;
+	uint32_t mipCount = 1U;
+};
+
+// Location of one mip level of one layer in the container.
+struct TextureContainerLevel
+{
+	uint64_t offset = 0U;
+	uint64_t size = 0U;
+};
+
+// TextureContainer is a streaming friendly texture payload which is similar to KTX2 :
+// | Fixed header | Level table (mipCount * layerCount) | Level data from the smallest mip to the largest mip |
+// Runtime only needs to read GetHeaderSize bytes to know where every level is, then fetches low mips first and high mips on demand.
+// Level table is indexed by mipLevel * layerCount + layer. Level data is aligned to 16 bytes. All values are little endian.
+class CORE_API TextureContainer final
+{
+public:
+	static constexpr uint32_t Magic = 0x58544443U; // "CDTX"
+	static constexpr uint32_t Version = 1U;
+	static constexpr uint32_t FixedHeaderSize = 32U;
+	static constexpr uint32_t LevelAlignment = 16U;
+
+public:
+	// Utility class doesn't allow to construct.
+	TextureContainer() = delete;
+	TextureContainer(const TextureContainer&) = delete;
+	TextureContainer& operator=(const TextureContainer&) = delete;
+	TextureContainer(TextureContainer&&) = delete;
+	TextureContainer& operator=(TextureContainer&&) = delete;
+	~TextureContainer() = delete;
+
+	// Fixed header and level table size.
+	static uint64_t GetHeaderSize(uint32_t mipCount, uint32_t layerCount) { return FixedHeaderSize + static_cast<uint64_t>(mipCount) * layerCount * sizeof(uint64_t) * 2U; }
+
+	// Raw data stores layers contiguously and mip levels contiguously in every layer, as texture raw data does.
+	// mipOffsets are byte offsets of levels in one layer. Empty mipOffsets means only one level.
+	static std::vector<std::byte> Build(const TextureContainerHeader& header, const std::byte* pRawData, uint64_t rawDataSize,
+		const std::vector<uint64_t>& mipOffsets);
+
+	// Parses fixed header from the first FixedHeaderSize bytes.
+	static bool ReadFixedHeader(const std::byte* pData, uint64_t size, TextureContainerHeader& header);
+
+	// Parses fixed header and level table from the first GetHeaderSize bytes. Level data is not required.
+	static bool ReadHeader(const std::byte* pData, uint64_t size, TextureContainerHeader& header, std::vector<TextureContainerLevel>& levels);
+};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Mesh;
+class SceneDatabase;
+
+struct AmbientOcclusionOptions
+{
+	// Cosine weighted hemisphere rays per vertex. Rounded up to a multiple of 4 which is the ray packet size.
+	uint32_t rayCount = 64U;
+
+	// Occluders farther than it are ignored. 0 means half diagonal of the receiving mesh AABB.
+	float maxDistance = 0.0f;
+
+	// 0 means all hardware threads.
+	uint32_t maxThreadCount = 0U;
+};
+
+// AmbientOcclusionBaker calculates per vertex accessibility in [0, 1] where 1 means not occluded.
+// Rays are traced in packets of 4 which share the vertex position as origin so ray-box and ray-triangle tests are SIMD.
+// Occluder meshes should have BVHs built by BVHBuilder.
+class CORE_API AmbientOcclusionBaker final
+{
+public:
+	// Utility class doesn't allow to construct.
+	AmbientOcclusionBaker() = delete;
+	AmbientOcclusionBaker(const AmbientOcclusionBaker&) = delete;
+	AmbientOcclusionBaker& operator=(const AmbientOcclusionBaker&) = delete;
+	AmbientOcclusionBaker(AmbientOcclusionBaker&&) = delete;
+	AmbientOcclusionBaker& operator=(AmbientOcclusionBaker&&) = delete;
+	~AmbientOcclusionBaker() = delete;
+
+	// The mesh only occludes itself.
+	static void Bake(const Mesh& mesh, const AmbientOcclusionOptions& options, std::vector<float>& vertexAccessibilities);
+
+	// All meshes occlude each other by the scene BVH over mesh AABBs. Vertex positions should be in world space such as flattened scenes.
+	static void Bake(const SceneDatabase& sceneDatabase, const AmbientOcclusionOptions& options, std::vector<std::vector<float>>& meshVertexAccessibilities);
+};
+
+}
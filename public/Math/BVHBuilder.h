@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "Math/Box.hpp"
+#include "Math/Ray.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace cd
+{
+
+class Mesh;
+
+// Flattened BVH node. Nodes are stored in depth first order so the first child of an interior node is the next node.
+struct BVHNode
+{
+	AABB bounds;
+
+	// Leaf node : index of its first primitive in the primitive index array.
+	// Interior node : index of its second child.
+	uint32_t offset;
+
+	// 0 means interior node.
+	uint16_t primitiveCount;
+
+	// Interior node : the axis which children are split along. Traversal visits the near child first by ray direction.
+	uint16_t splitAxis;
+
+	bool IsLeaf() const { return primitiveCount > 0U; }
+};
+
+static_assert(32 == sizeof(BVHNode));
+static_assert(std::is_standard_layout_v<BVHNode> && std::is_trivial_v<BVHNode>);
+
+struct BVHBuildOptions
+{
+	// Centroid bins per axis to evaluate surface area heuristic splits.
+	uint32_t binCount = 16U;
+
+	// Leaves never hold more primitives than it.
+	uint32_t maxLeafSize = 4U;
+
+	// Cost of visiting a node relative to intersecting a primitive.
+	float traversalCost = 1.0f;
+
+	// 0 means all hardware threads.
+	uint32_t maxThreadCount = 0U;
+};
+
+// BVHBuilder builds bounding volume hierarchies by binned surface area heuristic.
+// Top levels split large ranges with parallel binning. Then subtrees are built in parallel and stitched into one node array.
+class CORE_API BVHBuilder final
+{
+public:
+	// Utility class doesn't allow to construct.
+	BVHBuilder() = delete;
+	BVHBuilder(const BVHBuilder&) = delete;
+	BVHBuilder& operator=(const BVHBuilder&) = delete;
+	BVHBuilder(BVHBuilder&&) = delete;
+	BVHBuilder& operator=(BVHBuilder&&) = delete;
+	~BVHBuilder() = delete;
+
+	// Leaves refer to ranges of primitiveIndexes which store indexes into primitiveBounds.
+	static void Build(const std::vector<AABB>& primitiveBounds, const BVHBuildOptions& options,
+		std::vector<BVHNode>& nodes, std::vector<uint32_t>& primitiveIndexes);
+
+	// Builds a BVH over polygons and stores it in the mesh.
+	static void Build(Mesh& mesh, const BVHBuildOptions& options);
+
+	// Returns the closest polygon hit by the ray by the BVH stored in the mesh. hitDistance is in ray direction units.
+	static bool Raycast(const Mesh& mesh, const Ray& ray, uint32_t& hitPolygonIndex, float& hitDistance);
+};
+
+}
@@ -86,9 +86,9 @@ public:
 		oldEdge *= static_cast<T>(0.5);
 
 		TVector<T, 3> newEdge(
-			std::abs(transform.Data(0, 0)) * oldEdge.x() + std::abs(transform.Data(1, 0)) * oldEdge.y() + std::abs(transform.Data(2, 0)) * oldEdge.z(),
-			std::abs(transform.Data(0, 1)) * oldEdge.x() + std::abs(transform.Data(1, 1)) * oldEdge.y() + std::abs(transform.Data(2, 1)) * oldEdge.z(),
-			std::abs(transform.Data(0, 2)) * oldEdge.x() + std::abs(transform.Data(1, 2)) * oldEdge.y() + std::abs(transform.Data(2, 2)) * oldEdge.z());
+			std::abs(transform.Data(0, 0)) * oldEdge.x() + std::abs(transform.Data(0, 1)) * oldEdge.y() + std::abs(transform.Data(0, 2)) * oldEdge.z(),
+			std::abs(transform.Data(1, 0)) * oldEdge.x() + std::abs(transform.Data(1, 1)) * oldEdge.y() + std::abs(transform.Data(1, 2)) * oldEdge.z(),
+			std::abs(transform.Data(2, 0)) * oldEdge.x() + std::abs(transform.Data(2, 1)) * oldEdge.y() + std::abs(transform.Data(2, 2)) * oldEdge.z());
 
 		result.Min() = newCenter - newEdge;
 		result.Max() = newCenter + newEdge;
@@ -101,37 +101,32 @@ public:
 		// TODO : For 2D Rect.
 		static_assert(3 == N);
 
-		// TODO : have a look at "Fast Ray-Box Intersection" Graphics Gems, 1990.
-		// We can cache it inside Ray class to speed up calculations.
-		T dirfracx = 1.0f / ray.Direction().x();
-		T dirfracy = 1.0f / ray.Direction().y();
-		T dirfracz = 1.0f / ray.Direction().z();
-
-		T t1 = (m_min.x() - ray.Origin().x()) * dirfracx;
-		T t2 = (m_max.x() - ray.Origin().x()) * dirfracx;
-		T t3 = (m_min.y() - ray.Origin().y()) * dirfracy;
-		T t4 = (m_max.y() - ray.Origin().y()) * dirfracy;
-		T t5 = (m_min.z() - ray.Origin().z()) * dirfracz;
-		T t6 = (m_max.z() - ray.Origin().z()) * dirfracz;
-		T tmin = std::max(std::max(std::min(t1, t2), std::min(t3, t4)), std::min(t5, t6));
-		T tmax = std::min(std::min(std::max(t1, t2), std::max(t3, t4)), std::max(t5, t6));
+		PointType inverseDirection(static_cast<T>(1) / ray.Direction().x(), static_cast<T>(1) / ray.Direction().y(), static_cast<T>(1) / ray.Direction().z());
+		T tmin;
+		T tmax;
+		bool isIntersected = Intersects(ray.Origin(), inverseDirection, tmin, tmax);
+		t = isIntersected ? tmin : tmax;
+		return isIntersected;
+	}
 
-		// if tmax < 0, ray (line) is intersecting AABB, but the whole AABB is behind us
-		if (tmax < 0)
-		{
-			t = tmax;
-			return false;
-		}
+	// Slab test by a precomputed reciprocal ray direction which is shared by all boxes in one traversal.
+	// tmin and tmax are entry and exit parameters of the ray line. tmin is negative when origin is inside the box.
+	bool Intersects(const PointType& origin, const PointType& inverseDirection, T& tmin, T& tmax) const
+	{
+		static_assert(3 == N);
 
-		// if tmin > tmax, ray doesn't intersect AABB
-		if (tmin > tmax)
-		{
-			t = tmax;
-			return false;
-		}
+		T t1 = (m_min.x() - origin.x()) * inverseDirection.x();
+		T t2 = (m_max.x() - origin.x()) * inverseDirection.x();
+		T t3 = (m_min.y() - origin.y()) * inverseDirection.y();
+		T t4 = (m_max.y() - origin.y()) * inverseDirection.y();
+		T t5 = (m_min.z() - origin.z()) * inverseDirection.z();
+		T t6 = (m_max.z() - origin.z()) * inverseDirection.z();
+		tmin = std::max(std::max(std::min(t1, t2), std::min(t3, t4)), std::min(t5, t6));
+		tmax = std::min(std::min(std::max(t1, t2), std::max(t3, t4)), std::max(t5, t6));
 
-		t = tmin;
-		return true;
+		// if tmax < 0, ray (line) is intersecting AABB, but the whole AABB is behind us
+		// if tmin > tmax, ray doesn't intersect AABB
+		return tmax >= 0 && tmin <= tmax;
 	}
 
 private:
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Base/Export.h"
+
+#include <cstdint>
+
+namespace cd
+{
+
+class Mesh;
+
+struct LightmapUVOptions
+{
+	// Lightmap size in texels. Charts are scaled to fill one resolution x resolution page.
+	uint32_t resolution = 512U;
+
+	// Empty texels around every chart to avoid light bleeding by bilinear filter.
+	uint32_t padding = 2U;
+
+	// Max angle in degrees between a polygon normal and the average normal of its chart.
+	float chartMaxAngle = 60.0f;
+};
+
+// LightmapUVGenerator creates a non-overlapping UV set for lightmap baking.
+// Polygons are grouped into charts by normal cone, every chart is flattened by least squares conformal maps
+// and charts are packed into one page with a uniform texel density.
+// Vertices on chart seams are split so that other vertex attributes are duplicated.
+class CORE_API LightmapUVGenerator final
+{
+public:
+	// Utility class doesn't allow to construct.
+	LightmapUVGenerator() = delete;
+	LightmapUVGenerator(const LightmapUVGenerator&) = delete;
+	LightmapUVGenerator& operator=(const LightmapUVGenerator&) = delete;
+	LightmapUVGenerator(LightmapUVGenerator&&) = delete;
+	LightmapUVGenerator& operator=(LightmapUVGenerator&&) = delete;
+	~LightmapUVGenerator() = delete;
+
+	// Writes lightmap UVs into uvSetIndex. UV set count and vertex format grow when needed.
+	// Returns false when the mesh has no polygons or charts can't fit into the page.
+	static bool Generate(Mesh& mesh, uint32_t uvSetIndex, const LightmapUVOptions& options);
+};
+
+}
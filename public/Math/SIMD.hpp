@@ -0,0 +1,236 @@
+#pragma once
+
+#include "Base/Platform.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CD_SIMD_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define CD_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace cd
+{
+
+// Float4 wraps 4 floats in one SIMD register. SSE2 for x64, NEON for arm64 and scalar codes for others.
+// It only contains operations which are needed by batch processing codes such as image filters and pose evaluation.
+class Float4 final
+{
+public:
+#if defined(CD_SIMD_SSE)
+	using NativeType = __m128;
+#elif defined(CD_SIMD_NEON)
+	using NativeType = float32x4_t;
+#else
+	struct NativeType { float v[4]; };
+#endif
+
+public:
+	Float4() = default;
+	explicit Float4(NativeType value) : m_value(value) {}
+	explicit Float4(float value) { *this = Splat(value); }
+	explicit Float4(float x, float y, float z, float w)
+	{
+		alignas(16) float values[4] = { x, y, z, w };
+		*this = Load(values);
+	}
+	Float4(const Float4&) = default;
+	Float4& operator=(const Float4&) = default;
+	Float4(Float4&&) = default;
+	Float4& operator=(Float4&&) = default;
+	~Float4() = default;
+
+	static CD_FORCEINLINE Float4 Zero() { return Splat(0.0f); }
+
+	static CD_FORCEINLINE Float4 Splat(float value)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_set1_ps(value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vdupq_n_f32(value));
+#else
+		return Float4(NativeType{ { value, value, value, value } });
+#endif
+	}
+
+	// Unaligned load and store.
+	static CD_FORCEINLINE Float4 Load(const float* pValues)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_loadu_ps(pValues));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vld1q_f32(pValues));
+#else
+		return Float4(NativeType{ { pValues[0], pValues[1], pValues[2], pValues[3] } });
+#endif
+	}
+
+	CD_FORCEINLINE void Store(float* pValues) const
+	{
+#if defined(CD_SIMD_SSE)
+		_mm_storeu_ps(pValues, m_value);
+#elif defined(CD_SIMD_NEON)
+		vst1q_f32(pValues, m_value);
+#else
+		std::copy(m_value.v, m_value.v + 4, pValues);
+#endif
+	}
+
+	CD_FORCEINLINE float Get(int index) const
+	{
+		alignas(16) float values[4];
+		Store(values);
+		return values[index];
+	}
+
+	CD_FORCEINLINE NativeType Native() const { return m_value; }
+
+	friend CD_FORCEINLINE Float4 operator+(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_add_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vaddq_f32(a.m_value, b.m_value));
+#else
+		return Float4(a.Get(0) + b.Get(0), a.Get(1) + b.Get(1), a.Get(2) + b.Get(2), a.Get(3) + b.Get(3));
+#endif
+	}
+
+	friend CD_FORCEINLINE Float4 operator-(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_sub_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vsubq_f32(a.m_value, b.m_value));
+#else
+		return Float4(a.Get(0) - b.Get(0), a.Get(1) - b.Get(1), a.Get(2) - b.Get(2), a.Get(3) - b.Get(3));
+#endif
+	}
+
+	friend CD_FORCEINLINE Float4 operator*(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_mul_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vmulq_f32(a.m_value, b.m_value));
+#else
+		return Float4(a.Get(0) * b.Get(0), a.Get(1) * b.Get(1), a.Get(2) * b.Get(2), a.Get(3) * b.Get(3));
+#endif
+	}
+
+	friend CD_FORCEINLINE Float4 operator/(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_div_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vdivq_f32(a.m_value, b.m_value));
+#else
+		return Float4(a.Get(0) / b.Get(0), a.Get(1) / b.Get(1), a.Get(2) / b.Get(2), a.Get(3) / b.Get(3));
+#endif
+	}
+
+	friend CD_FORCEINLINE Float4 operator*(const Float4& a, float b) { return a * Splat(b); }
+
+	CD_FORCEINLINE Float4& operator+=(const Float4& other) { return *this = *this + other; }
+	CD_FORCEINLINE Float4& operator-=(const Float4& other) { return *this = *this - other; }
+	CD_FORCEINLINE Float4& operator*=(const Float4& other) { return *this = *this * other; }
+
+	// a * b + c
+	static CD_FORCEINLINE Float4 MultiplyAdd(const Float4& a, const Float4& b, const Float4& c)
+	{
+#if defined(CD_SIMD_NEON)
+		return Float4(vfmaq_f32(c.m_value, a.m_value, b.m_value));
+#else
+		return a * b + c;
+#endif
+	}
+
+	static CD_FORCEINLINE Float4 Min(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_min_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vminq_f32(a.m_value, b.m_value));
+#else
+		return Float4(std::min(a.Get(0), b.Get(0)), std::min(a.Get(1), b.Get(1)), std::min(a.Get(2), b.Get(2)), std::min(a.Get(3), b.Get(3)));
+#endif
+	}
+
+	static CD_FORCEINLINE Float4 Max(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_max_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vmaxq_f32(a.m_value, b.m_value));
+#else
+		return Float4(std::max(a.Get(0), b.Get(0)), std::max(a.Get(1), b.Get(1)), std::max(a.Get(2), b.Get(2)), std::max(a.Get(3), b.Get(3)));
+#endif
+	}
+
+	static CD_FORCEINLINE Float4 Clamp(const Float4& value, const Float4& minValue, const Float4& maxValue)
+	{
+		return Min(Max(value, minValue), maxValue);
+	}
+
+	static CD_FORCEINLINE Float4 Sqrt(const Float4& value)
+	{
+#if defined(CD_SIMD_SSE)
+		return Float4(_mm_sqrt_ps(value.m_value));
+#elif defined(CD_SIMD_NEON)
+		return Float4(vsqrtq_f32(value.m_value));
+#else
+		return Float4(std::sqrt(value.Get(0)), std::sqrt(value.Get(1)), std::sqrt(value.Get(2)), std::sqrt(value.Get(3)));
+#endif
+	}
+
+	// Comparisons return a 4 bits mask whose bit i is set when lane i passes. NaN lanes always fail.
+	static CD_FORCEINLINE int LessMask(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return _mm_movemask_ps(_mm_cmplt_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		static const uint32_t laneBits[4] = { 1U, 2U, 4U, 8U };
+		return static_cast<int>(vaddvq_u32(vandq_u32(vcltq_f32(a.m_value, b.m_value), vld1q_u32(laneBits))));
+#else
+		return (a.Get(0) < b.Get(0) ? 1 : 0) | (a.Get(1) < b.Get(1) ? 2 : 0) | (a.Get(2) < b.Get(2) ? 4 : 0) | (a.Get(3) < b.Get(3) ? 8 : 0);
+#endif
+	}
+
+	static CD_FORCEINLINE int LessEqualMask(const Float4& a, const Float4& b)
+	{
+#if defined(CD_SIMD_SSE)
+		return _mm_movemask_ps(_mm_cmple_ps(a.m_value, b.m_value));
+#elif defined(CD_SIMD_NEON)
+		static const uint32_t laneBits[4] = { 1U, 2U, 4U, 8U };
+		return static_cast<int>(vaddvq_u32(vandq_u32(vcleq_f32(a.m_value, b.m_value), vld1q_u32(laneBits))));
+#else
+		return (a.Get(0) <= b.Get(0) ? 1 : 0) | (a.Get(1) <= b.Get(1) ? 2 : 0) | (a.Get(2) <= b.Get(2) ? 4 : 0) | (a.Get(3) <= b.Get(3) ? 8 : 0);
+#endif
+	}
+
+	// Sum of the first three lanes.
+	static CD_FORCEINLINE float Dot3(const Float4& a, const Float4& b)
+	{
+		Float4 product = a * b;
+		return product.Get(0) + product.Get(1) + product.Get(2);
+	}
+
+	static CD_FORCEINLINE float Dot4(const Float4& a, const Float4& b)
+	{
+		Float4 product = a * b;
+#if defined(CD_SIMD_NEON)
+		return vaddvq_f32(product.m_value);
+#else
+		return product.Get(0) + product.Get(1) + product.Get(2) + product.Get(3);
+#endif
+	}
+
+private:
+	NativeType m_value;
+};
+
+}
@@ -66,10 +66,14 @@ public:
 		result.GetColumn(3)[1] = m_translation.y();
 		result.GetColumn(3)[2] = m_translation.z();
 
-		result.GetColumn(0)[0] *= m_scale.x();
-		result.GetColumn(1)[1] *= m_scale.y();
-		result.GetColumn(2)[2] *= m_scale.z();
-		
+		// Scales are applied per local axis so every rotation column is scaled.
+		for (int rowIndex = 0; rowIndex < 3; ++rowIndex)
+		{
+			result.GetColumn(0)[rowIndex] *= m_scale.x();
+			result.GetColumn(1)[rowIndex] *= m_scale.y();
+			result.GetColumn(2)[rowIndex] *= m_scale.z();
+		}
+
 		return result;
 	}
 
@@ -3,6 +3,7 @@
 #include "Base/Export.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/Box.hpp"
 #include "Scene/KeyFrame.hpp"
 #include "Scene/ObjectID.h"
 
@@ -48,6 +49,19 @@ public:
 	std::vector<TrackID>& GetBoneTrackIDs();
 	const std::vector<TrackID>& GetBoneTrackIDs() const;
 
+	// Bounds of skinned vertices in skeleton space over the whole animation.
+	void SetAABB(AABB aabb);
+	AABB& GetAABB();
+	const AABB& GetAABB() const;
+
+	// Window i bounds skinned vertices from time i * duration to (i + 1) * duration. Duration is in ticks.
+	void SetWindowAABBDuration(float duration);
+	float GetWindowAABBDuration() const;
+	void SetWindowAABBs(std::vector<AABB> aabbs);
+	uint32_t GetWindowAABBCount() const;
+	std::vector<AABB>& GetWindowAABBs();
+	const std::vector<AABB>& GetWindowAABBs() const;
+
 	Animation& operator<<(InputArchive& inputArchive);
 	Animation& operator<<(InputArchiveSwapBytes& inputArchive);
 	const Animation& operator>>(OutputArchive& outputArchive) const;
@@ -12,6 +12,7 @@
 namespace cd
 {
 
+struct BVHNode;
 class VertexFormat;
 class MeshImpl;
 
@@ -54,12 +55,19 @@ public:
 	void SetMaterialID(uint32_t materialIndex);
 	MaterialID GetMaterialID() const;
 
+	// Morph IDs are local to the mesh. Meshes split from the same mesh reuse IDs of the morphs they were split from.
 	uint32_t GetMorphCount() const;
 	Morph& GetMorph(uint32_t morphIndex);
 	const Morph& GetMorph(uint32_t morphIndex) const;
 	std::vector<Morph>& GetMorphs();
 	const std::vector<Morph>& GetMorphs() const;
 
+	// Polygon BVH in depth first order. Leaves refer to ranges of BVH polygon indexes. Empty when it is not built.
+	std::vector<BVHNode>& GetBVHNodes();
+	const std::vector<BVHNode>& GetBVHNodes() const;
+	std::vector<uint32_t>& GetBVHPolygonIndexes();
+	const std::vector<uint32_t>& GetBVHPolygonIndexes() const;
+
 	void SetVertexPosition(uint32_t vertexIndex, const Point& position);
 	std::vector<Point>& GetVertexPositions();
 	Point& GetVertexPosition(uint32_t vertexIndex);
@@ -113,6 +121,18 @@ public:
 	VertexWeight& GetVertexWeight(uint32_t boneIndex, uint32_t vertexIndex);
 	const VertexWeight& GetVertexWeight(uint32_t boneIndex, uint32_t vertexIndex) const;
 
+	// Packed skin data for GPU skinning. Every vertex has GetPackedInfluenceCount() local bone indexes and unorm weights in a row.
+	// Local bone indexes refer to the bone palette which stores bone IDs.
+	void SetBonePalette(std::vector<BoneID> bonePalette);
+	std::vector<BoneID>& GetBonePalette();
+	const std::vector<BoneID>& GetBonePalette() const;
+	void SetPackedInfluenceCount(uint32_t influenceCount);
+	uint32_t GetPackedInfluenceCount() const;
+	std::vector<uint8_t>& GetPackedBoneIndexes();
+	const std::vector<uint8_t>& GetPackedBoneIndexes() const;
+	std::vector<uint16_t>& GetPackedBoneWeights();
+	const std::vector<uint16_t>& GetPackedBoneWeights() const;
+
 	uint32_t GetVertexAdjacentVertexCount(uint32_t vertexIndex) const;
 	void AddVertexAdjacentVertexID(uint32_t vertexIndex, VertexID vertexID);
 	VertexIDArray& GetVertexAdjacentVertexArray(uint32_t vertexIndex);
@@ -143,6 +163,9 @@ public:
 	bool IsPolygonValid(PolygonID p) const;
 	void RemovePolygonData(PolygonID p);
 
+	// New vertex i copies old vertex newToOldVertexIndexes[i]. Polygons are not remapped and connectivity data is cleared.
+	void RemapVertices(const std::vector<uint32_t>& newToOldVertexIndexes);
+
 	Mesh& operator<<(InputArchive& inputArchive);
 	Mesh& operator<<(InputArchiveSwapBytes& inputArchive);
 	const Mesh& operator>>(OutputArchive& outputArchive) const;
@@ -13,6 +13,8 @@ namespace cd
 class VertexFormat;
 class MorphImpl;
 
+// Morph targets are sparse. Every morph vertex stores the index of the mesh vertex which it moves as source ID
+// and deltas which are added to attributes of that vertex.
 class CORE_API Morph final
 {
 public:
@@ -69,6 +71,16 @@ public:
 	std::vector<Direction>& GetVertexBiTangents();
 	const std::vector<Direction>& GetVertexBiTangents() const;
 
+	// Keeps vertices at vertexIndexes in order. An index may repeat to duplicate a vertex. Empty channels stay empty.
+	void GatherVertices(const std::vector<uint32_t>& vertexIndexes);
+
+	// Removes vertices whose deltas are all within the threshold. Returns the number of removed vertices.
+	uint32_t RemoveUnchangedVertices(float threshold);
+
+	// Snaps deltas to 16 bits codes which are also used in serialization.
+	void Quantize();
+	bool IsQuantized() const;
+
 	Morph& operator<<(InputArchive& inputArchive);
 	Morph& operator<<(InputArchiveSwapBytes& inputArchive);
 	const Morph& operator>>(OutputArchive& outputArchive) const;
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Base/Export.h"
+#include "IO/InputArchive.hpp"
+#include "IO/OutputArchive.hpp"
+#include "Math/Matrix.hpp"
+#include "Math/Transform.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cd
+{
+
+class Node;
+
+// NodeHierarchy stores nodes of a scene in linear arrays sorted by depth so parents are always before children.
+// Local transforms are stored in SoA arrays of every transform component which are padded to multiples of 4 nodes.
+// World matrices are solved in one linear pass without recursion :
+// local matrices of 4 nodes are built at once in SIMD lanes and multiplied by world matrices of their parents which are already solved.
+class CORE_API NodeHierarchy final
+{
+public:
+	static constexpr uint32_t InvalidIndex = 0xFFFFFFFF;
+
+	// Components in the memory layout of Transform : translation xyz, rotation xyzw and scale xyz.
+	static constexpr uint32_t TransformComponentCount = Transform::Size;
+
+public:
+	NodeHierarchy() = default;
+	explicit NodeHierarchy(const std::vector<Node>& nodes);
+	NodeHierarchy(const NodeHierarchy&) = default;
+	NodeHierarchy& operator=(const NodeHierarchy&) = default;
+	NodeHierarchy(NodeHierarchy&&) = default;
+	NodeHierarchy& operator=(NodeHierarchy&&) = default;
+	~NodeHierarchy() = default;
+
+	// Broken parent loops are cut as roots. World matrices are solved after building.
+	void Init(const std::vector<Node>& nodes);
+	void Clear();
+
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_nodeIDs.size()); }
+	bool IsEmpty() const { return m_nodeIDs.empty(); }
+
+	// Arrays in hierarchy order.
+	const std::vector<uint32_t>& GetNodeIDs() const { return m_nodeIDs; }
+	const std::vector<uint32_t>& GetParentIndexes() const { return m_parentIndexes; }
+	const std::vector<Matrix4x4>& GetWorldMatrices() const { return m_worldMatrices; }
+
+	// Returns InvalidIndex if the node doesn't exist.
+	uint32_t GetNodeIndex(uint32_t nodeID) const { return nodeID < m_nodeIDToIndexes.size() ? m_nodeIDToIndexes[nodeID] : InvalidIndex; }
+
+	// Changing local transforms doesn't update world matrices until UpdateWorldMatrices.
+	Transform GetLocalTransform(uint32_t nodeIndex) const;
+	void SetLocalTransform(uint32_t nodeIndex, const Transform& transform);
+	const std::vector<float>& GetLocalTransformComponents(uint32_t componentIndex) const { return m_localTransforms[componentIndex]; }
+
+	// Scales are applied per local axis before rotations. Rotations follow the convention of Quaternion::ToMatrix3x3.
+	void UpdateWorldMatrices();
+
+	template<bool SwapBytesOrder>
+	NodeHierarchy& operator<<(TInputArchive<SwapBytesOrder>& inputArchive)
+	{
+		uint32_t nodeCount;
+		uint32_t paddedNodeCount;
+		inputArchive >> nodeCount >> paddedNodeCount;
+
+		m_nodeIDs.resize(nodeCount);
+		inputArchive.ImportBuffer(m_nodeIDs.data());
+		m_parentIndexes.resize(nodeCount);
+		inputArchive.ImportBuffer(m_parentIndexes.data());
+		for (std::vector<float>& components : m_localTransforms)
+		{
+			components.resize(paddedNodeCount);
+			inputArchive.ImportBuffer(components.data());
+		}
+		m_worldMatrices.resize(nodeCount);
+		inputArchive.ImportBuffer(m_worldMatrices.data());
+
+		BuildNodeIDToIndexes();
+
+		return *this;
+	}
+
+	template<bool SwapBytesOrder>
+	const NodeHierarchy& operator>>(TOutputArchive<SwapBytesOrder>& outputArchive) const
+	{
+		outputArchive << GetNodeCount() << static_cast<uint32_t>(m_localTransforms[0].size());
+
+		outputArchive.ExportBuffer(m_nodeIDs.data(), m_nodeIDs.size());
+		outputArchive.ExportBuffer(m_parentIndexes.data(), m_parentIndexes.size());
+		for (const std::vector<float>& components : m_localTransforms)
+		{
+			outputArchive.ExportBuffer(components.data(), components.size());
+		}
+		outputArchive.ExportBuffer(m_worldMatrices.data(), m_worldMatrices.size());
+
+		return *this;
+	}
+
+private:
+	void BuildNodeIDToIndexes();
+
+private:
+	std::vector<uint32_t> m_nodeIDs;
+	std::vector<uint32_t> m_parentIndexes;
+	std::vector<uint32_t> m_nodeIDToIndexes;
+	std::vector<float> m_localTransforms[TransformComponentCount];
+	std::vector<Matrix4x4> m_worldMatrices;
+};
+
+}
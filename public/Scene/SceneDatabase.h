@@ -21,6 +21,8 @@
 namespace cd
 {
 
+struct BVHNode;
+class NodeHierarchy;
 class SceneDatabaseImpl;
 
 class CORE_API SceneDatabase final
@@ -64,6 +66,10 @@ public:
 	const Node* GetNodeByName(const char* pName) const;
 	uint32_t GetNodeCount() const;
 
+	// Nodes sorted by depth with SoA local transforms and cached world matrices. Empty when it is not built.
+	NodeHierarchy& GetNodeHierarchy();
+	const NodeHierarchy& GetNodeHierarchy() const;
+
 	// Mesh
 	void AddMesh(Mesh mesh);
 	std::vector<Mesh>& GetMeshes();
@@ -72,6 +78,12 @@ public:
 	const Mesh& GetMesh(uint32_t index) const;
 	uint32_t GetMeshCount() const;
 
+	// BVH over mesh AABBs in depth first order. Leaves refer to ranges of BVH mesh indexes. Empty when it is not built.
+	std::vector<BVHNode>& GetMeshBVHNodes();
+	const std::vector<BVHNode>& GetMeshBVHNodes() const;
+	std::vector<uint32_t>& GetMeshBVHMeshIndexes();
+	const std::vector<uint32_t>& GetMeshBVHMeshIndexes() const;
+
 	// Morph
 	void AddMorph(Morph morph);
 	std::vector<Morph>& GetMorphs();
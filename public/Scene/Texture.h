@@ -3,10 +3,12 @@
 #include "Base/Export.h"
 #include "IO/InputArchive.hpp"
 #include "IO/OutputArchive.hpp"
+#include "Math/Vector.hpp"
 #include "Scene/MaterialTextureType.h"
 #include "Scene/ObjectID.h"
 #include "Scene/TextureFormat.h"
 
+#include <memory>
 #include <vector>
 
 namespace cd
@@ -30,6 +32,7 @@ public:
 	Texture& operator=(Texture&&) noexcept;
 	~Texture();
 
+	void SetID(TextureID id);
 	TextureID GetID() const;
 	
 	const char* GetName() const;
@@ -45,6 +48,12 @@ public:
 	cd::TextureMapMode GetVMapMode() const;
 	void SetVMapMode(cd::TextureMapMode mapMode);
 
+	const cd::Vec2f& GetUVOffset() const;
+	void SetUVOffset(cd::Vec2f uvOffset);
+
+	const cd::Vec2f& GetUVScale() const;
+	void SetUVScale(cd::Vec2f uvScale);
+
 	// File texture data
 	const char* GetPath() const;
 	void SetPath(const char* pFilePath);
@@ -68,8 +77,19 @@ public:
 
 	const std::vector<std::byte>& GetRawData() const;
 	void SetRawData(std::vector<std::byte> rawData);
+	// Textures which reference the same file can share one raw data buffer.
+	const std::shared_ptr<const std::vector<std::byte>>& GetSharedRawData() const;
+	void SetRawData(std::shared_ptr<const std::vector<std::byte>> pRawData);
 	void ClearRawData();
 	bool ExistRawData() const;
+
+	cd::TextureRawDataType GetRawDataType() const;
+	void SetRawDataType(cd::TextureRawDataType type);
+
+	// Mip levels are stored contiguously in raw data. Empty offsets means only one level.
+	uint32_t GetMipCount() const;
+	const std::vector<uint64_t>& GetMipOffsets() const;
+	void SetMipOffsets(std::vector<uint64_t> mipOffsets);
 	
 	Texture& operator<<(InputArchive& inputArchive);
 	Texture& operator<<(InputArchiveSwapBytes& inputArchive);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace cd
 {
 
@@ -109,4 +111,12 @@ enum class TextureFormat : uint32_t
 	Count
 };
 
+// What texture raw data stores.
+enum class TextureRawDataType : uint8_t
+{
+	Pixels = 0, // Pixels in texture format. Mip levels are stored contiguously.
+	ImageFile,  // Image file data such as png, jpg which needs to decode. Texture format describes decoded pixels.
+	Container,  // TextureContainer data with a level table for streaming. Texture path refers to the container file if raw data is empty.
+};
+
 }
\ No newline at end of file
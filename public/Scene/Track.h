@@ -55,6 +55,16 @@ public:
 	std::vector<ScaleKey>& GetScaleKeys();
 	const std::vector<ScaleKey>& GetScaleKeys() const;
 
+	// Quantized tracks are serialized as 16 bits codes. Keys should already be snapped to quantized values by AnimationCompressor.
+	void SetQuantized(bool quantized);
+	bool IsQuantized() const;
+
+	// Keys of uniform tracks are at multiples of the key interval from time 0 so they can be indexed by time directly.
+	// Their times are implicit in serialization. 0 means keys have irregular times.
+	void SetKeyInterval(float keyInterval);
+	float GetKeyInterval() const;
+	bool IsUniform() const;
+
 	Track& operator<<(InputArchive& inputArchive);
 	Track& operator<<(InputArchiveSwapBytes& inputArchive);
 	const Track& operator>>(OutputArchive& outputArchive) const;
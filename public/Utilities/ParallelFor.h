@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace cd
+{
+
+// Returns a thread count which is suitable to split CPU bound jobs.
+inline uint32_t GetParallelThreadCount()
+{
+	return std::max(1U, std::thread::hardware_concurrency());
+}
+
+// Runs func(index) for index in [0, count) on a group of worker threads.
+// Workers fetch indexes one by one from an atomic counter so unbalanced jobs still keep all threads busy.
+// maxThreadCount sets concurrency explicitly which is useful to bound memory usage or to overlap I/O requests.
+// It may exceed the hardware thread count because I/O bound workers mostly wait. 0 means using all hardware threads.
+// The calling thread also works as a worker so small tasks don't pay thread creation cost.
+template<typename Func>
+void ParallelFor(uint32_t count, Func&& func, uint32_t maxThreadCount = 0U)
+{
+	if (0U == count)
+	{
+		return;
+	}
+
+	uint32_t threadCount = std::min(count, maxThreadCount > 0U ? maxThreadCount : GetParallelThreadCount());
+
+	if (1U == threadCount)
+	{
+		for (uint32_t index = 0U; index < count; ++index)
+		{
+			func(index);
+		}
+		return;
+	}
+
+	std::atomic<uint32_t> nextIndex = 0U;
+	auto worker = [&nextIndex, &func, count]()
+	{
+		for (uint32_t index = nextIndex.fetch_add(1U); index < count; index = nextIndex.fetch_add(1U))
+		{
+			func(index);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1U);
+	for (uint32_t threadIndex = 1U; threadIndex < threadCount; ++threadIndex)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+}